@@ -88,6 +88,10 @@ class KernelDef {
 
   bool IsConflict(const KernelDef& other) const;
 
+  // Hash of everything that identifies this kernel. Stable across processes and builds as long as
+  // the kernel definition doesn't change, so it can be stored to check that the same kernel is picked later.
+  uint64_t GetHash() const;
+
  private:
   friend class KernelDefBuilder;
 
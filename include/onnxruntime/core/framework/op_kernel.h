@@ -49,6 +49,16 @@ class OpKernel {
     ORT_NOT_IMPLEMENTED(__FUNCTION__, " is not implemented");
   }
 
+  // Override this function to pre-pack a constant initializer once during session initialization.
+  // 'input_idx' is the index of the input of this kernel that the tensor is for.
+  // Set 'is_packed' to true if the kernel has kept a packed copy of the tensor and will not read the
+  // input at that index in Compute. If every consumer of the initializer packs it, the session may
+  // release the original tensor.
+  virtual Status PrePack(const Tensor& /*tensor*/, int /*input_idx*/, bool& is_packed) {
+    is_packed = false;
+    return Status::OK();
+  }
+
   const OrtMemoryInfo& Allocator(int id, OrtMemType mem_type) const {
     return op_kernel_info_.GetMemoryInfo(id, mem_type);
   }
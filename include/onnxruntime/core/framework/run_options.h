@@ -22,6 +22,10 @@ struct OrtRunOptions {
   // be forced to terminate with an error status.
   bool terminate = false;
 
+  // Set to 'true' to return the regions of the session's memory arenas that are
+  // entirely free to the device at the end of the Run() call.
+  bool shrink_memory_arenas = false;
+
   OrtRunOptions() = default;
   ~OrtRunOptions() = default;
 
@@ -116,7 +116,7 @@ class OrtMutex {
   OrtMutex& operator=(const OrtMutex&) = delete;
 
   void lock() { nsync::nsync_mu_lock(&data_); }
-  bool try_lock() noexcept { return nsync::nsync_mu_trylock(&data_) == 0; }
+  bool try_lock() noexcept { return nsync::nsync_mu_trylock(&data_) != 0; }
   void unlock() noexcept { nsync::nsync_mu_unlock(&data_); }
 
   using native_handle_type = nsync::nsync_mu*;
@@ -171,6 +171,23 @@ typedef struct OrtAllocator {
   const struct OrtMemoryInfo*(ORT_API_CALL* Info)(const struct OrtAllocator* this_);
 } OrtAllocator;
 
+// Statistics of an arena allocator, see SessionGetArenaStats.
+typedef struct OrtArenaStats {
+  int64_t num_allocs;              // Number of allocations.
+  int64_t bytes_in_use;            // Bytes currently handed out to callers.
+  int64_t total_allocated_bytes;   // Bytes the arena has allocated from the device.
+  int64_t max_bytes_in_use;        // Peak of bytes_in_use.
+  int64_t max_alloc_size;          // Largest single allocation.
+  int64_t bytes_limit;             // Upper limit of total_allocated_bytes.
+  int64_t num_arena_extensions;    // Number of times the arena allocated a new region from the device.
+  int64_t bytes_in_thread_caches;  // Freed bytes held in per-thread caches.
+  int64_t num_thread_cache_hits;   // Allocations served from a per-thread cache.
+  int64_t num_lock_contentions;    // Number of times a thread had to wait for the arena lock.
+  int64_t lock_wait_ns;            // Total time spent waiting for the arena lock, in nanoseconds.
+  int64_t free_bytes;              // Bytes in free chunks of the arena.
+  int64_t largest_free_block;      // Largest free chunk. 1 - largest_free_block / free_bytes is the fragmentation.
+} OrtArenaStats;
+
 typedef void(ORT_API_CALL* OrtLoggingFunction)(
     void* param, OrtLoggingLevel severity, const char* category, const char* logid, const char* code_location,
     const char* message);
@@ -190,6 +207,12 @@ typedef enum ExecutionMode {
   ORT_PARALLEL = 1,
 } ExecutionMode;
 
+// How a memory arena grows when it runs out of memory.
+typedef enum OrtArenaExtendStrategy {
+  ORT_ARENA_EXTEND_NEXT_POWER_OF_TWO = 0,  // allocate a region twice the size of the previous one
+  ORT_ARENA_EXTEND_SAME_AS_REQUESTED = 1,  // allocate a region just large enough for the request
+} OrtArenaExtendStrategy;
+
 struct OrtKernelInfo;
 typedef struct OrtKernelInfo OrtKernelInfo;
 struct OrtKernelContext;
@@ -772,6 +795,65 @@ struct OrtApi {
       NO_EXCEPTION;
 
   ORT_CLASS_RELEASE(ThreadingOptions);
+
+  /*
+  * Load models from files by memory-mapping them. Large initializers are used in place from the mapping
+  * rather than copied, so processes that load the same model share its memory.
+  * The model file must not be modified while a session created from it is alive.
+  */
+  OrtStatus*(ORT_API_CALL* EnableMmapModelLoading)(_Inout_ OrtSessionOptions* options)NO_EXCEPTION;
+
+  /*
+  * Get the statistics of the arena the session uses for the memory described by 'mem_info'.
+  * Fails if that memory is not managed by an arena.
+  */
+  OrtStatus*(ORT_API_CALL* SessionGetArenaStats)(_In_ const OrtSession* sess, _In_ const OrtMemoryInfo* mem_info,
+                                                 _Out_ OrtArenaStats* out)NO_EXCEPTION;
+
+  /*
+  * Release the regions of the session's memory arenas that are entirely free back to the device
+  * at the end of each Run() using these run options.
+  */
+  OrtStatus*(ORT_API_CALL* RunOptionsSetArenaShrinkage)(_Inout_ OrtRunOptions* options, int value)NO_EXCEPTION;
+
+  // Set how the CPU memory arena grows. Default is ORT_ARENA_EXTEND_NEXT_POWER_OF_TWO.
+  OrtStatus*(ORT_API_CALL* SetArenaExtendStrategy)(_Inout_ OrtSessionOptions* options,
+                                                   OrtArenaExtendStrategy strategy)NO_EXCEPTION;
+
+  /*
+  * After each Run(), shrink the memory arenas that hold more than 'bytes' bytes allocated from the device.
+  * 0 (the default) disables the policy.
+  */
+  OrtStatus*(ORT_API_CALL* SetArenaShrinkHighWatermark)(_Inout_ OrtSessionOptions* options, size_t bytes)NO_EXCEPTION;
+
+  /*
+  * Save the state of the session to 'path' once it is initialized: the optimized model together with the
+  * execution plan and kernel choices. A session created from that file skips graph optimization, partitioning
+  * and planning. The file is only valid for the build of onnxruntime and the execution providers it was created
+  * with; if they don't match the model in the file is optimized again.
+  */
+  OrtStatus*(ORT_API_CALL* SetOptimizedSessionStateFilePath)(_Inout_ OrtSessionOptions* options,
+                                                             _In_ const ORTCHAR_T* path)NO_EXCEPTION;
+
+  /*
+  * Save the state of an initialized session again, including the memory patterns of the runs so far.
+  * Requires SetOptimizedSessionStateFilePath to have been called on the options the session was created with.
+  */
+  OrtStatus*(ORT_API_CALL* SessionSaveState)(_In_ const OrtSession* sess, _In_ const ORTCHAR_T* path)NO_EXCEPTION;
+
+  /*
+  * Return the output of each ZipMap node that is a graph output as a float tensor with the probabilities, and add
+  * an output named '<output name>_labels' with the class labels, instead of returning a sequence of maps.
+  * The labels tensor is shared by all the runs of the session.
+  * A model or session state saved by the session keeps these outputs and can only be loaded with this option.
+  */
+  OrtStatus*(ORT_API_CALL* EnableColumnarZipMapOutput)(_Inout_ OrtSessionOptions* options)NO_EXCEPTION;
+
+  /*
+  * Give each thread that allocates from the CPU memory arena a cache of small freed chunks, so that concurrent
+  * Run() calls on the same session don't all serialize on the arena lock. Each cache holds up to 4MB.
+  */
+  OrtStatus*(ORT_API_CALL* EnableCpuArenaThreadCache)(_Inout_ OrtSessionOptions* options)NO_EXCEPTION;
 };
 
 /*
@@ -158,6 +158,9 @@ struct RunOptions : Base<OrtRunOptions> {
   RunOptions& SetTerminate();
   // unset the terminate flag so this RunOptions instance can be used in a new Session::Run call
   RunOptions& UnsetTerminate();
+
+  // return the unused memory of the session's arenas at the end of Session::Run calls made with this instance
+  RunOptions& SetArenaShrinkage(bool shrink);
 };
 
 struct SessionOptions : Base<OrtSessionOptions> {
@@ -189,6 +192,16 @@ struct SessionOptions : Base<OrtSessionOptions> {
   SessionOptions& Add(OrtCustomOpDomain* custom_op_domain);
 
   SessionOptions& DisablePerSessionThreads();
+
+  SessionOptions& EnableMmapModelLoading();
+
+  SessionOptions& SetArenaExtendStrategy(OrtArenaExtendStrategy strategy);
+  SessionOptions& SetArenaShrinkHighWatermark(size_t bytes);
+  SessionOptions& SetOptimizedSessionStateFilePath(const ORTCHAR_T* path);
+
+  SessionOptions& EnableColumnarZipMapOutput();
+
+  SessionOptions& EnableCpuArenaThreadCache();
 };
 
 struct ModelMetadata : Base<OrtModelMetadata> {
@@ -228,6 +241,9 @@ struct Session : Base<OrtSession> {
   TypeInfo GetInputTypeInfo(size_t index) const;
   TypeInfo GetOutputTypeInfo(size_t index) const;
   TypeInfo GetOverridableInitializerTypeInfo(size_t index) const;
+
+  OrtArenaStats GetArenaStats(const OrtMemoryInfo* mem_info) const;
+  void SaveState(const ORTCHAR_T* path) const;
 };
 
 struct TensorTypeAndShapeInfo : Base<OrtTensorTypeAndShapeInfo> {
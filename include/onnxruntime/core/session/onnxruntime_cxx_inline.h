@@ -147,6 +147,11 @@ inline RunOptions& RunOptions::UnsetTerminate() {
   return *this;
 }
 
+inline RunOptions& RunOptions::SetArenaShrinkage(bool shrink) {
+  ThrowOnError(Global<void>::api_.RunOptionsSetArenaShrinkage(p_, shrink ? 1 : 0));
+  return *this;
+}
+
 inline SessionOptions::SessionOptions() {
   ThrowOnError(Global<void>::api_.CreateSessionOptions(&p_));
 }
@@ -348,6 +353,16 @@ inline TypeInfo Session::GetOverridableInitializerTypeInfo(size_t index) const {
   return TypeInfo{out};
 }
 
+inline OrtArenaStats Session::GetArenaStats(const OrtMemoryInfo* mem_info) const {
+  OrtArenaStats out;
+  ThrowOnError(Global<void>::api_.SessionGetArenaStats(p_, mem_info, &out));
+  return out;
+}
+
+inline void Session::SaveState(const ORTCHAR_T* path) const {
+  ThrowOnError(Global<void>::api_.SessionSaveState(p_, path));
+}
+
 inline ONNXTensorElementDataType TensorTypeAndShapeInfo::GetElementType() const {
   ONNXTensorElementDataType out;
   ThrowOnError(Global<void>::api_.GetTensorElementType(p_, &out));
@@ -609,4 +624,34 @@ inline SessionOptions& SessionOptions::DisablePerSessionThreads() {
   ThrowOnError(Global<void>::api_.DisablePerSessionThreads(p_));
   return *this;
 }
+
+inline SessionOptions& SessionOptions::EnableMmapModelLoading() {
+  ThrowOnError(Global<void>::api_.EnableMmapModelLoading(p_));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::SetArenaExtendStrategy(OrtArenaExtendStrategy strategy) {
+  ThrowOnError(Global<void>::api_.SetArenaExtendStrategy(p_, strategy));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::SetArenaShrinkHighWatermark(size_t bytes) {
+  ThrowOnError(Global<void>::api_.SetArenaShrinkHighWatermark(p_, bytes));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::SetOptimizedSessionStateFilePath(const ORTCHAR_T* path) {
+  ThrowOnError(Global<void>::api_.SetOptimizedSessionStateFilePath(p_, path));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::EnableColumnarZipMapOutput() {
+  ThrowOnError(Global<void>::api_.EnableColumnarZipMapOutput(p_));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::EnableCpuArenaThreadCache() {
+  ThrowOnError(Global<void>::api_.EnableCpuArenaThreadCache(p_));
+  return *this;
+}
 }  // namespace Ort
\ No newline at end of file
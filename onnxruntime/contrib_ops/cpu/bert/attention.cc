@@ -1,14 +1,14 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
-#include "attention.h"
+#include "attention_cpu_base.h"
 #include "core/framework/tensorprotoutils.h"
 #include "onnx/defs/schema.h"
 #include "core/util/eigen_common_wrapper.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 #include "core/providers/cpu/math/gemm_helper.h"
-#include "core/providers/cpu/math/softmax.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/cpu/tensor/transpose.h"
 #include "core/common/safeint.h"
 
@@ -16,6 +16,15 @@ using onnxruntime::concurrency::ThreadPool;
 
 namespace onnxruntime {
 namespace contrib {
+
+template <typename T>
+class Attention : public OpKernel, public AttentionCPUBase {
+ public:
+  explicit Attention(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+};
+
 // These ops are internal-only, so register outside of onnx
 #define REGISTER_KERNEL_TYPED(T)                                                                          \
   ONNX_OPERATOR_TYPED_KERNEL_EX(Attention, kMSDomain, 1, T, kCpuExecutionProvider,                        \
@@ -28,31 +37,38 @@ AttentionBase::AttentionBase(const OpKernelInfo& info) {
   int64_t num_heads = 0;
   ORT_ENFORCE(info.GetAttr("num_heads", &num_heads).IsOK() && num_heads > 0);
   num_heads_ = static_cast<int>(num_heads);
+
+  is_unidirectional_ = info.GetAttrOrDefault<int64_t>("unidirectional", 0) == 1;
 }
 
-Status AttentionBase::CheckInputs(const OpKernelContext* context) const {
+Status AttentionBase::CheckInputs(const TensorShape& input_shape,
+                                  const TensorShape& weights_shape,
+                                  const TensorShape& bias_shape,
+                                  const Tensor* mask_index,
+                                  const Tensor* past) const {
   // Input and output shapes:
   //   Input 0 - input       : (batch_size, sequence_length, hidden_size)
   //   Input 1 - weights     : (hidden_size, 3 * hidden_size)
   //   Input 2 - bias        : (3 * hidden_size)
-  //   Input 3 - mask_index  : (batch_size)
-  //   Output                : (batch_size, sequence_length, hidden_size)
+  //   Input 3 - mask_index  : (batch_size) or (batch_size, past_sequence_length + sequence_length)
+  //   Input 4 - past        : (2, batch_size, num_heads, past_sequence_length, head_size)
+  //   Output 0              : (batch_size, sequence_length, hidden_size)
+  //   Output 1 - present    : (2, batch_size, num_heads, past_sequence_length + sequence_length, head_size)
 
-  const Tensor* input = context->Input<Tensor>(0);
-  const auto dims = input->Shape().GetDims();
+  const auto dims = input_shape.GetDims();
   if (dims.size() != 3) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 0 is expected to have 3 dimensions, got ",
                            dims.size());
   }
   int batch_size = static_cast<int>(dims[0]);
+  int sequence_length = static_cast<int>(dims[1]);
   int hidden_size = static_cast<int>(dims[2]);
   if (hidden_size % num_heads_ != 0) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
                            "Input 0 dimension 2 should be divisiable by value of the num_heads attribute.");
   }
 
-  const Tensor* weights = context->Input<Tensor>(1);
-  const auto weights_dims = weights->Shape().GetDims();
+  const auto weights_dims = weights_shape.GetDims();
   if (weights_dims.size() != 2) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 1 is expected to have 2 dimensions, got ",
                            weights_dims.size());
@@ -65,8 +81,7 @@ Status AttentionBase::CheckInputs(const OpKernelContext* context) const {
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 1 dimension 1 should be 3 times of dimension 0");
   }
 
-  const Tensor* bias = context->Input<Tensor>(2);
-  const auto bias_dims = bias->Shape().GetDims();
+  const auto bias_dims = bias_shape.GetDims();
   if (bias_dims.size() != 1) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 2 is expected to have 1 dimension, got ",
                            bias_dims.size());
@@ -76,32 +91,62 @@ Status AttentionBase::CheckInputs(const OpKernelContext* context) const {
                            "Input 2 dimension 0 should have same length as dimension 1 of input 1");
   }
 
-  const Tensor* mask_index = context->Input<Tensor>(3);
-  const auto mask_dims = mask_index->Shape().GetDims();
-  if (mask_dims.size() != 1) {
-    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 3 is expected to have 1 dimension, got ",
-                           mask_dims.size());
+  int past_sequence_length = 0;
+  if (past != nullptr) {
+    const auto past_dims = past->Shape().GetDims();
+    if (past_dims.size() != 5) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 4 is expected to have 5 dimension, got ",
+                             past_dims.size());
+    }
+    if (past_dims[0] != 2) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Inputs 4 dimension 0 shall have length of 2");
+    }
+    if (static_cast<int>(past_dims[1]) != batch_size) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Inputs 4 and 0 shall have same length at dimension 1");
+    }
+    if (static_cast<int>(past_dims[2]) != num_heads_) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Inputs 4 dimension 2 shall have length of num_heads", num_heads_);
+    }
+    if (static_cast<int>(past_dims[4]) != hidden_size / num_heads_) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Inputs 4 dimension 4 shall have length of hidden_size / num_heads");
+    }
+    past_sequence_length = static_cast<int>(past_dims[3]);
   }
-  if (static_cast<int>(mask_dims[0]) != batch_size) {
-    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Inputs 3 and 0 shall have same length at dimension 0");
+
+  if (mask_index != nullptr) {
+    const auto mask_dims = mask_index->Shape().GetDims();
+    if (mask_dims.size() != 1 && mask_dims.size() != 2) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 3 is expected to have 1 or 2 dimensions, got ",
+                             mask_dims.size());
+    }
+    if (static_cast<int>(mask_dims[0]) != batch_size) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Inputs 3 and 0 shall have same length at dimension 0");
+    }
+    if (mask_dims.size() == 2 && static_cast<int>(mask_dims[1]) != past_sequence_length + sequence_length) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Input 3 dimension 1 shall have length of past_sequence_length + sequence_length");
+    }
   }
 
   return Status::OK();
 }
 
 template <typename T>
-Attention<T>::Attention(const OpKernelInfo& info) : OpKernel(info), AttentionBase(info) {
+Attention<T>::Attention(const OpKernelInfo& info) : OpKernel(info), AttentionCPUBase(info) {
 }
 
 template <typename T>
 Status Attention<T>::Compute(OpKernelContext* context) const {
-  auto* tp = context->GetOperatorThreadPool();
-  ORT_RETURN_IF_ERROR(CheckInputs(context));
-
   const Tensor* input = context->Input<Tensor>(0);
   const Tensor* weights = context->Input<Tensor>(1);
   const Tensor* bias = context->Input<Tensor>(2);
   const Tensor* mask_index = context->Input<Tensor>(3);
+  const Tensor* past = context->Input<Tensor>(4);
+  ORT_RETURN_IF_ERROR(CheckInputs(input->Shape(), weights->Shape(), bias->Shape(), mask_index, past));
+
+  auto* tp = context->GetOperatorThreadPool();
 
   const auto dims = input->Shape().GetDims();
   const int batch_size = static_cast<int>(dims[0]);
@@ -109,22 +154,45 @@ Status Attention<T>::Compute(OpKernelContext* context) const {
   const int hidden_size = static_cast<int>(dims[2]);
   const int head_size = hidden_size / num_heads_;
 
+  // Key and value of the current tokens are appended to those of the past tokens, so attention
+  // is computed over all_sequence_length = past_sequence_length + sequence_length positions.
+  const int past_sequence_length = (past != nullptr) ? static_cast<int>(past->Shape().GetDims()[3]) : 0;
+  const int all_sequence_length = past_sequence_length + sequence_length;
+
   TensorShape output_shape(dims);
   Tensor* output = context->Output(0, output_shape);
 
+  std::vector<int64_t> present_dims{2, batch_size, num_heads_, all_sequence_length, head_size};
+  TensorShape present_shape(present_dims);
+  Tensor* present = context->Output(1, present_shape);
+
   constexpr size_t element_size = sizeof(T);
 
   AllocatorPtr allocator;
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
 
+  // The present output, when requested, doubles as the key/value cache that attention reads from.
+  // Otherwise a temporary buffer holds the concatenated key and value.
+  const size_t present_chunk_size = SafeInt<size_t>(batch_size) * num_heads_ * all_sequence_length * head_size;
+  BufferUniquePtr present_buffer;
+  T* present_data = nullptr;
+  if (present != nullptr) {
+    present_data = present->template MutableData<T>();
+  } else {
+    auto data = allocator->Alloc(SafeInt<size_t>(2) * present_chunk_size * element_size);
+    present_buffer = BufferUniquePtr(data, BufferDeleter(allocator));
+    present_data = reinterpret_cast<T*>(data);
+  }
+  const T* past_data = (past != nullptr) ? past->template Data<T>() : nullptr;
+  const size_t past_chunk_size = SafeInt<size_t>(batch_size) * num_heads_ * past_sequence_length * head_size;
+
   // STEP.1: gemm_data(BS, 3NH) = input(BS, NH) x weights(NH, 3NH) + bias(3NH)
-  auto gemm_data = allocator->Alloc(SafeInt<size_t>(batch_size) * sequence_length * 3 * hidden_size * element_size);
+  // Q is kept in its own buffer. K and V of the current tokens are written after the past tokens in present.
+  auto gemm_data = allocator->Alloc(SafeInt<size_t>(batch_size) * sequence_length * hidden_size * element_size);
   BufferUniquePtr gemm_buffer(gemm_data, BufferDeleter(allocator));
   auto Q = reinterpret_cast<T*>(gemm_data);
-  auto K = Q + batch_size * sequence_length * hidden_size;
-  auto V = K + batch_size * sequence_length * hidden_size;
-
-  T* QKV[3] = {Q, K, V};
+  auto K = present_data;
+  auto V = present_data + present_chunk_size;
 
   {
     const int loop_len = 3 * batch_size * num_heads_;
@@ -139,15 +207,28 @@ Status Attention<T>::Compute(OpKernelContext* context) const {
         const int batch_index = static_cast<int>((i / 3) / num_heads_);
         const int head_index = static_cast<int>((i / 3) % num_heads_);
         const int qkv_index = static_cast<int>(i % 3);
+        const int batch_head_index = batch_index * num_heads_ + head_index;
 
         int input_offset = batch_index * sequence_length * hidden_size;
         int weights_offset = qkv_index * hidden_size + head_index * head_size;
-        T* qkv_dest = QKV[qkv_index];
-        int qkv_offset = (batch_index * num_heads_ + head_index) * (sequence_length * head_size);
+
+        T* qkv_dest;
+        if (qkv_index == 0) {
+          qkv_dest = Q + batch_head_index * (sequence_length * head_size);
+        } else {
+          // copy past (B.N.)P x H in front of the current tokens: (B.N.)(P+S) x H
+          qkv_dest = (qkv_index == 1 ? K : V) + batch_head_index * (all_sequence_length * head_size);
+          if (past_sequence_length > 0) {
+            const T* past_src = past_data + (qkv_index - 1) * past_chunk_size +
+                                batch_head_index * (past_sequence_length * head_size);
+            memcpy(qkv_dest, past_src, SafeInt<size_t>(past_sequence_length) * head_size * sizeof(T));
+            qkv_dest += past_sequence_length * head_size;
+          }
+        }
 
         // broadcast 3NH -> (3.B.N.S.H)
         const T* broadcast_data_src = bias_data + weights_offset;
-        T* broadcast_data_dest = QKV[qkv_index] + qkv_offset;
+        T* broadcast_data_dest = qkv_dest;
         for (int seq_index = 0; seq_index < sequence_length; seq_index++) {
           memcpy(broadcast_data_dest, broadcast_data_src, head_size * sizeof(T));
           broadcast_data_dest += head_size;
@@ -169,7 +250,7 @@ Status Attention<T>::Compute(OpKernelContext* context) const {
                                         weights_data + weights_offset,  // B
                                         3 * hidden_size,                // ldb    = 3NH
                                         1.0f,                           // beta
-                                        qkv_dest + qkv_offset,          // C
+                                        qkv_dest,                       // C
                                         head_size,                      // ldc
                                         nullptr                         // use single-thread
         );
@@ -177,131 +258,8 @@ Status Attention<T>::Compute(OpKernelContext* context) const {
     });
   }
 
-  // STEP.2: scratch(B, N, S, S) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, S, H -> B, N, H, S) + 1 x mask_index(B -> B, 1,
-  // 1, 1)
-  auto scratch_data =
-      allocator->Alloc(SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * sequence_length * element_size);
-  BufferUniquePtr scratch_buffer(scratch_data, BufferDeleter(allocator));
-
-  {
-    auto scratch_broadcast_data = allocator->Alloc(SafeInt<size_t>(batch_size) * sequence_length * element_size);
-    BufferUniquePtr scratch_broadcast_buffer(scratch_broadcast_data, BufferDeleter(allocator));
-    memset(scratch_broadcast_data, 0, batch_size * sequence_length * element_size);
-    T* p_scratch_broadcast_current_data = reinterpret_cast<T*>(scratch_broadcast_data);
-    for (int b_i = 0; b_i < batch_size; b_i++) {
-      // TODO: mask_index can be used in softmax to save some calculation.
-      int mask = mask_index->template Data<int32_t>()[b_i];
-      for (int m_i = mask; m_i < sequence_length; m_i++) {
-        p_scratch_broadcast_current_data[m_i] = static_cast<T>(-10000.0);
-      }
-      p_scratch_broadcast_current_data += sequence_length;
-    }
-
-    const int loop_len = batch_size * num_heads_;
-    const float alpha = 1.0f / sqrt(static_cast<float>(head_size));
-
-    // The cost of Gemm
-    const double cost =
-        static_cast<double>(head_size) * static_cast<double>(sequence_length) * static_cast<double>(sequence_length);
-    ThreadPool::TryParallelFor(tp, loop_len, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
-      for (std::ptrdiff_t i = begin; i != end; ++i) {
-        const std::ptrdiff_t batch_index = i / num_heads_;
-        // broadcast masks (B) -> (B.N.)S.S
-        const T* broadcast_data_src = reinterpret_cast<T*>(scratch_broadcast_data) + batch_index * sequence_length;
-        T* broadcast_data_dest = reinterpret_cast<T*>(scratch_data) + sequence_length * sequence_length * i;
-        for (int seq_index = 0; seq_index < sequence_length; seq_index++) {
-          memcpy(broadcast_data_dest, broadcast_data_src, sequence_length * sizeof(T));
-          broadcast_data_dest += sequence_length;
-        }
-
-        // gemm
-
-        //                   original           transposed            iteration
-        // A: Q              (BxNxSxH)          (B.N.)S x H            S x H
-        // B: K'             (BxNxSxH)          (B.N.)H x S            H x S
-        // C: scratch_data   (BxNxSxS)          (B.N.)S x S            S x S
-
-        math::Gemm<T, ThreadPool>(CblasNoTrans, CblasTrans, sequence_length, sequence_length, head_size, alpha,
-                                  Q + sequence_length * head_size * i, K + sequence_length * head_size * i, 1.0,
-                                  reinterpret_cast<T*>(scratch_data) + sequence_length * sequence_length * i, nullptr);
-      }
-    });
-  }
-
-  // STEP.3: P(B, N, S, S) = Softmax(scratch)
-  {
-    const int N = batch_size * num_heads_ * sequence_length;
-    const int D = sequence_length;
-
-    ThreadPool::TryParallelFor(tp, N, sequence_length * 2.0, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
-      for (std::ptrdiff_t j = begin; j != end; ++j) {
-        float* x = reinterpret_cast<T*>(scratch_data) + j * D;
-        float* y = x;
-
-        // e^x is represented as infinity if x is large enough, like 100.f.
-        // Infinity divided by Infinity is a NAN. Thus, softmax gets a NAN if
-        // one or more item are large enough. a math transform as below is
-        // leveraged to get a stable softmax: e^xi/(e^x1 + ...e^xn) = e^(xi -
-        // max) / (e^(x1 - max) + ... + e^(xn - max))
-        float max = -std::numeric_limits<float>::infinity();
-        for (int i = 0; i < D; i++) {
-          if (max < x[i])
-            max = x[i];
-        }
-        for (int i = 0; i < D; i++) {
-          y[i] = expf(x[i] - max);
-        }
-
-        double sum = 0.0;
-
-        for (int i = 0; i < D; i++) {
-          sum += x[i];
-        }
-
-        if (sum == 0) {
-          for (int i = 0; i < D; i++) {
-            y[i] = 1.0f / (float)D;
-          }
-        } else {
-          for (int i = 0; i < D; i++) {
-            y[i] = x[i] / (float)sum;
-          }
-        }
-      }
-    });
-  }
-
-  // STEP.4: out_tmp(B, N, S, H) = P(B, N, S, S) x V(B, N, S, H)
-  auto out_tmp_data =
-      allocator->Alloc(SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * head_size * element_size);
-  BufferUniquePtr out_tmp_buffer(out_tmp_data, BufferDeleter(allocator));
-  // cost of MatMul
-  const double cost =
-      static_cast<double>(sequence_length) * static_cast<double>(head_size) * static_cast<double>(sequence_length);
-  ThreadPool::TryParallelFor(tp, batch_size * num_heads_, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
-    const int sequence_length_mul_head_size = sequence_length * head_size;
-    for (std::ptrdiff_t i = begin; i != end; ++i) {
-      T* current_tmp_data = reinterpret_cast<T*>(out_tmp_data) + sequence_length_mul_head_size * i;
-      math::MatMul<T>(sequence_length, head_size, sequence_length,
-                      reinterpret_cast<T*>(scratch_data) + sequence_length_mul_head_size * i,
-                      V + sequence_length_mul_head_size * i, current_tmp_data, nullptr);
-
-      // transpose: out(B, S, N, H) = transpose out_tmp(B, N, S, H)
-      const int batch_index = static_cast<int>(i / num_heads_);
-      const int head_index = static_cast<int>(i % num_heads_);
-      T* src = current_tmp_data;
-      T* dest =
-          output->template MutableData<T>() + (batch_index * sequence_length * num_heads_ + head_index) * head_size;
-      const auto bytes_to_copy = SafeInt<size_t>(head_size) * sizeof(T);
-      for (int j = 0; j < sequence_length; j++) {
-        memcpy(dest, src, bytes_to_copy);
-        src += head_size;
-        dest += hidden_size;
-      }
-    }
-  });
-
-  return Status::OK();
+  return ApplyAttention(Q, K, V, mask_index, output, batch_size, sequence_length, past_sequence_length, head_size,
+                        hidden_size, context);
 }
 
 }  // namespace contrib
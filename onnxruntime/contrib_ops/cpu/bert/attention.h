@@ -12,16 +12,16 @@ namespace contrib {
 class AttentionBase {
  protected:
   AttentionBase(const OpKernelInfo& info);
-  Status CheckInputs(const OpKernelContext* context) const;
 
-  int num_heads_;  // number of attention heads
-};
+  // mask_index and past are optional and can be nullptr.
+  Status CheckInputs(const TensorShape& input_shape,
+                     const TensorShape& weights_shape,
+                     const TensorShape& bias_shape,
+                     const Tensor* mask_index,
+                     const Tensor* past) const;
 
-template <typename T>
-class Attention : public OpKernel, public AttentionBase {
- public:
-  explicit Attention(const OpKernelInfo& info);
-  Status Compute(OpKernelContext* context) const override;
+  int num_heads_;           // number of attention heads
+  bool is_unidirectional_;  // whether every token can only attend to previous tokens.
 };
 
 }  // namespace contrib
@@ -0,0 +1,218 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cmath>
+
+#include "attention.h"
+#include "core/common/safeint.h"
+#include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
+#include "core/util/math.h"
+#include "core/mlas/inc/mlas.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+class AttentionCPUBase : public AttentionBase {
+ protected:
+  AttentionCPUBase(const OpKernelInfo& info) : AttentionBase(info) {}
+
+  // Computes output(B, S, N, H) = Softmax(1/sqrt(H) x Q x K' + mask) x V, where
+  //   Q is (B, N, S, H), and K and V are (B, N, S*, H) with S* = past_sequence_length + sequence_length.
+  // mask_index is optional and can be nullptr.
+  template <typename T>
+  Status ApplyAttention(const T* Q,
+                        const T* K,
+                        const T* V,
+                        const Tensor* mask_index,
+                        Tensor* output,
+                        int batch_size,
+                        int sequence_length,
+                        int past_sequence_length,
+                        int head_size,
+                        int hidden_size,
+                        OpKernelContext* context) const;
+};
+
+template <typename T>
+Status AttentionCPUBase::ApplyAttention(const T* Q,
+                                        const T* K,
+                                        const T* V,
+                                        const Tensor* mask_index,
+                                        Tensor* output,
+                                        int batch_size,
+                                        int sequence_length,
+                                        int past_sequence_length,
+                                        int head_size,
+                                        int hidden_size,
+                                        OpKernelContext* context) const {
+  using concurrency::ThreadPool;
+
+  auto* tp = context->GetOperatorThreadPool();
+  const int all_sequence_length = past_sequence_length + sequence_length;
+  constexpr size_t element_size = sizeof(T);
+
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+
+  // Keys at and after the valid length of a batch are padding and are left out of the QK' gemm, the softmax and
+  // the PV gemm. Without mask_index all keys are valid. A 1D mask_index holds the valid length. A 2D mask_index
+  // holds 1 for the positions to attend and 0 for the padding: the valid length ends after the last attended
+  // position and the padding before it gets the usual -10000 bias. When no position is valid, every position gets
+  // the same bias, which doesn't change the softmax, so all positions are used without a bias.
+  const int32_t* mask_index_data = (mask_index != nullptr) ? mask_index->template Data<int32_t>() : nullptr;
+  const bool is_mask_2d = (mask_index != nullptr) && mask_index->Shape().NumDimensions() == 2;
+  std::vector<int> key_lengths(batch_size);
+  bool has_mask_holes = false;
+  for (int b_i = 0; b_i < batch_size; b_i++) {
+    int key_length = 0;
+    if (mask_index_data == nullptr) {
+      key_length = all_sequence_length;
+    } else if (is_mask_2d) {
+      const int32_t* mask = mask_index_data + b_i * all_sequence_length;
+      for (int m_i = 0; m_i < all_sequence_length; m_i++) {
+        if (mask[m_i] != 0) {
+          has_mask_holes |= (key_length != m_i);
+          key_length = m_i + 1;
+        }
+      }
+    } else {
+      key_length = std::min(mask_index_data[b_i], static_cast<int32_t>(all_sequence_length));
+    }
+    key_lengths[b_i] = (key_length > 0) ? key_length : all_sequence_length;
+  }
+
+  // STEP.2: scratch(B, N, S, L) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, L, H -> B, N, H, L)
+  // where L <= S* = past_sequence_length + sequence_length is the valid length of the batch.
+  // Rows of scratch have a stride of S*.
+  auto scratch_data =
+      allocator->Alloc(SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * all_sequence_length * element_size);
+  BufferUniquePtr scratch_buffer(scratch_data, BufferDeleter(allocator));
+  T* scratch = reinterpret_cast<T*>(scratch_data);
+
+  {
+    const int loop_len = batch_size * num_heads_;
+    const float alpha = 1.0f / sqrt(static_cast<float>(head_size));
+
+    // The cost of Gemm
+    const double cost = static_cast<double>(head_size) * static_cast<double>(sequence_length) *
+                        static_cast<double>(all_sequence_length);
+    ThreadPool::TryParallelFor(tp, loop_len, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+      for (std::ptrdiff_t i = begin; i != end; ++i) {
+        const int key_length = key_lengths[i / num_heads_];
+
+        //                   original           transposed            iteration
+        // A: Q              (BxNxSxH)          (B.N.)S x H            S x H
+        // B: K'             (BxNxS*xH)         (B.N.)H x S*           H x L
+        // C: scratch        (BxNxSxS*)         (B.N.)S x S*           S x L
+
+        math::GemmEx<float, ThreadPool>(CblasNoTrans,                                  // TransA = no
+                                        CblasTrans,                                    // TransB = yes
+                                        sequence_length,                               // M      = S
+                                        key_length,                                    // N      = L
+                                        head_size,                                     // K      = H
+                                        alpha,                                         // alpha
+                                        Q + sequence_length * head_size * i,           // A
+                                        head_size,                                     // lda    = H
+                                        K + all_sequence_length * head_size * i,       // B
+                                        head_size,                                     // ldb    = H
+                                        0.0f,                                          // beta
+                                        scratch + sequence_length * all_sequence_length * i,  // C
+                                        all_sequence_length,                           // ldc    = S*
+                                        nullptr                                        // use single-thread
+        );
+      }
+    });
+  }
+
+  // STEP.3: P(B, N, S, L) = Softmax(scratch)
+  // A unidirectional query at position past_sequence_length + s_i only attends the keys up to its own position,
+  // so its probabilities after that are zero.
+  {
+    const int N = batch_size * num_heads_ * sequence_length;
+
+    ThreadPool::TryParallelFor(tp, N, all_sequence_length * 2.0, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+      for (std::ptrdiff_t j = begin; j != end; ++j) {
+        const int batch_index = static_cast<int>(j / (num_heads_ * sequence_length));
+        const int s_i = static_cast<int>(j % sequence_length);
+        const int key_length = key_lengths[batch_index];
+        int row_length = key_length;
+        if (is_unidirectional_) {
+          row_length = std::min(row_length, past_sequence_length + s_i + 1);
+        }
+
+        float* x = scratch + j * all_sequence_length;
+
+        if (has_mask_holes) {
+          const int32_t* mask = mask_index_data + batch_index * all_sequence_length;
+          for (int m_i = 0; m_i < row_length; m_i++) {
+            if (mask[m_i] == 0) {
+              x[m_i] += -10000.0f;
+            }
+          }
+        }
+
+        MlasComputeSoftmax(x, x, 1, row_length, false, nullptr);
+
+        for (int m_i = row_length; m_i < key_length; m_i++) {
+          x[m_i] = 0.0f;
+        }
+      }
+    });
+  }
+
+  // STEP.4: out_tmp(B, N, S, H) = P(B, N, S, L) x V(B, N, L, H)
+  auto out_tmp_data =
+      allocator->Alloc(SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * head_size * element_size);
+  BufferUniquePtr out_tmp_buffer(out_tmp_data, BufferDeleter(allocator));
+  // cost of MatMul
+  const double cost =
+      static_cast<double>(sequence_length) * static_cast<double>(head_size) * static_cast<double>(all_sequence_length);
+  ThreadPool::TryParallelFor(tp, batch_size * num_heads_, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    const int sequence_length_mul_head_size = sequence_length * head_size;
+    for (std::ptrdiff_t i = begin; i != end; ++i) {
+      const int batch_index = static_cast<int>(i / num_heads_);
+      const int head_index = static_cast<int>(i % num_heads_);
+      T* current_tmp_data = reinterpret_cast<T*>(out_tmp_data) + sequence_length_mul_head_size * i;
+
+      //                   original           transposed            iteration
+      // A: P              (BxNxSxS*)         (B.N.)S x S*           S x L
+      // B: V              (BxNxS*xH)         (B.N.)S* x H           L x H
+      // C: out_tmp        (BxNxSxH)          (B.N.)S x H            S x H
+
+      math::GemmEx<float, ThreadPool>(CblasNoTrans,                                  // TransA = no
+                                      CblasNoTrans,                                  // TransB = no
+                                      sequence_length,                               // M      = S
+                                      head_size,                                     // N      = H
+                                      key_lengths[batch_index],                      // K      = L
+                                      1.0f,                                          // alpha
+                                      scratch + sequence_length * all_sequence_length * i,  // A
+                                      all_sequence_length,                           // lda    = S*
+                                      V + all_sequence_length * head_size * i,       // B
+                                      head_size,                                     // ldb    = H
+                                      0.0f,                                          // beta
+                                      current_tmp_data,                              // C
+                                      head_size,                                     // ldc    = H
+                                      nullptr                                        // use single-thread
+      );
+
+      // transpose: out(B, S, N, H) = transpose out_tmp(B, N, S, H)
+      T* src = current_tmp_data;
+      T* dest =
+          output->template MutableData<T>() + (batch_index * sequence_length * num_heads_ + head_index) * head_size;
+      const auto bytes_to_copy = SafeInt<size_t>(head_size) * sizeof(T);
+      for (int j = 0; j < sequence_length; j++) {
+        memcpy(dest, src, bytes_to_copy);
+        src += head_size;
+        dest += hidden_size;
+      }
+    }
+  });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
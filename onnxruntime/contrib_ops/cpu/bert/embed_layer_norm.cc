@@ -3,6 +3,7 @@
 
 #include "embed_layer_norm.h"
 #include "embed_layer_norm_helper.h"
+#include "core/providers/common.h"
 #include "core/util/math_cpuonly.h"
 #include "core/platform/threadpool.h"
 
@@ -24,24 +25,56 @@ namespace contrib {
 
 REGISTER_KERNEL_TYPED(float)
 
-template <typename T>
-EmbedLayerNorm<T>::EmbedLayerNorm(const OpKernelInfo& info) : OpKernel(info) {}
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    QEmbedLayerNormalization,
+    kMSDomain,
+    1,
+    float,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<int32_t>())
+        .TypeConstraint("T2", DataTypeImpl::GetTensorType<uint8_t>()),
+    QEmbedLayerNorm<float>);
+
+namespace {
+
+// An embedding table of shape (length, hidden_size). Quantized tables carry the parameters to dequantize them.
+template <typename TEmbedding>
+struct EmbeddingTable {
+  const TEmbedding* data;
+  int length;
+  float scale;
+  TEmbedding zero_point;
+};
+
+template <typename TEmbedding>
+EmbeddingTable<TEmbedding> GetEmbeddingTable(const Tensor& embedding, float scale, TEmbedding zero_point) {
+  return {embedding.template Data<TEmbedding>(), static_cast<int>(embedding.Shape()[0]), scale, zero_point};
+}
 
-template <typename T>
-Status EmbedLayerNorm<T>::Compute(OpKernelContext* context) const {
-  ORT_RETURN_IF_ERROR(embed_layer_norm::CheckInputs(context));
+inline float Dequantize(const EmbeddingTable<float>& table, int64_t index) {
+  return table.data[index];
+}
 
+inline float Dequantize(const EmbeddingTable<uint8_t>& table, int64_t index) {
+  return static_cast<float>(static_cast<int32_t>(table.data[index]) - static_cast<int32_t>(table.zero_point)) *
+         table.scale;
+}
+
+template <typename T, typename TEmbedding>
+Status ComputeEmbedLayerNorm(OpKernelContext* context,
+                             const EmbeddingTable<TEmbedding>& word_embedding,
+                             const EmbeddingTable<TEmbedding>& position_embedding,
+                             const EmbeddingTable<TEmbedding>& segment_embedding) {
   const Tensor* input_ids = context->Input<Tensor>(0);
   const Tensor* segment_ids = context->Input<Tensor>(1);
-  const Tensor* word_embedding = context->Input<Tensor>(2);
-  const Tensor* position_embedding = context->Input<Tensor>(3);
-  const Tensor* segment_embedding = context->Input<Tensor>(4);
   const Tensor* gamma = context->Input<Tensor>(5);
   const Tensor* beta = context->Input<Tensor>(6);
   const Tensor* mask = context->Input<Tensor>(7);  // optional. nullptr if not provided
 
   const auto input_dims = input_ids->Shape().GetDims();
-  int64_t hidden_size = word_embedding->Shape()[1];
+  int64_t hidden_size = context->Input<Tensor>(2)->Shape()[1];
 
   std::vector<int64_t> out_dims;
   out_dims.reserve(3);
@@ -59,15 +92,12 @@ Status EmbedLayerNorm<T>::Compute(OpKernelContext* context) const {
   int batch_size = static_cast<int>(input_dims[0]);
   int sequence_length = static_cast<int>(input_dims[1]);
 
-  int word_embedding_length = static_cast<int>(word_embedding->Shape()[0]);
-  int position_embedding_length = static_cast<int>(position_embedding->Shape()[0]);
-  int segment_embedding_length = static_cast<int>(segment_embedding->Shape()[0]);
+  int word_embedding_length = word_embedding.length;
+  int position_embedding_length = position_embedding.length;
+  int segment_embedding_length = segment_embedding.length;
 
   auto input_ids_data = input_ids->template Data<int32_t>();
   auto segment_ids_data = segment_ids->template Data<int32_t>();
-  auto word_embedding_data = word_embedding->template Data<T>();
-  auto position_embedding_data = position_embedding->template Data<T>();
-  auto segment_embedding_data = segment_embedding->template Data<T>();
   auto gamma_data = gamma->template Data<T>();
   auto beta_data = beta->template Data<T>();
   auto output_data = output->template MutableData<T>();
@@ -95,13 +125,14 @@ Status EmbedLayerNorm<T>::Compute(OpKernelContext* context) const {
       }
 
       T* y = output_data + index * hidden_size;
-      const T* input_word_embedding = word_embedding_data + word_col_index * hidden_size;
-      const T* input_position_embedding = position_embedding_data + position_col_index * hidden_size;
-      const T* input_segment_embedding = segment_embedding_data + segment_col_index * hidden_size;
+      const int64_t word_offset = word_col_index * hidden_size;
+      const int64_t position_offset = position_col_index * hidden_size;
+      const int64_t segment_offset = segment_col_index * hidden_size;
 
       T sum = static_cast<T>(0);
       for (int i = 0; i < hidden_size; i++) {
-        T subtotal = input_word_embedding[i] + input_position_embedding[i] + input_segment_embedding[i];
+        T subtotal = Dequantize(word_embedding, word_offset + i) + Dequantize(position_embedding, position_offset + i) +
+                     Dequantize(segment_embedding, segment_offset + i);
         y[i] = subtotal;
         sum += subtotal;
       }
@@ -138,5 +169,45 @@ Status EmbedLayerNorm<T>::Compute(OpKernelContext* context) const {
   return Status::OK();
 }
 
+}  // namespace
+
+template <typename T>
+EmbedLayerNorm<T>::EmbedLayerNorm(const OpKernelInfo& info) : OpKernel(info) {}
+
+template <typename T>
+Status EmbedLayerNorm<T>::Compute(OpKernelContext* context) const {
+  ORT_RETURN_IF_ERROR(embed_layer_norm::CheckInputs(context));
+
+  return ComputeEmbedLayerNorm<T>(context,
+                                  GetEmbeddingTable<T>(*context->Input<Tensor>(2), 1.0f, 0),
+                                  GetEmbeddingTable<T>(*context->Input<Tensor>(3), 1.0f, 0),
+                                  GetEmbeddingTable<T>(*context->Input<Tensor>(4), 1.0f, 0));
+}
+
+template <typename T>
+QEmbedLayerNorm<T>::QEmbedLayerNorm(const OpKernelInfo& info) : OpKernel(info) {}
+
+template <typename T>
+Status QEmbedLayerNorm<T>::Compute(OpKernelContext* context) const {
+  // Inputs 0 - 7 are the same as EmbedLayerNormalization, except that the embeddings are quantized.
+  //   Input 8 - 10  : scales of the word, position and segment embeddings
+  //   Input 11 - 13 : zero points of the word, position and segment embeddings
+  ORT_RETURN_IF_ERROR(embed_layer_norm::CheckInputs(context));
+
+  EmbeddingTable<uint8_t> tables[3];
+  for (int i = 0; i < 3; i++) {
+    const Tensor* scale = context->Input<Tensor>(8 + i);
+    const Tensor* zero_point = context->Input<Tensor>(11 + i);
+    ORT_RETURN_IF_NOT(IsScalarOr1ElementVector(scale),
+                      "QEmbedLayerNormalization : input ", 8 + i, " must be a scalar or 1D tensor of size 1");
+    ORT_RETURN_IF_NOT(IsScalarOr1ElementVector(zero_point),
+                      "QEmbedLayerNormalization : input ", 11 + i, " must be a scalar or 1D tensor of size 1");
+    tables[i] = GetEmbeddingTable<uint8_t>(*context->Input<Tensor>(2 + i), *scale->template Data<float>(),
+                                           *zero_point->template Data<uint8_t>());
+  }
+
+  return ComputeEmbedLayerNorm<T>(context, tables[0], tables[1], tables[2]);
+}
+
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -14,5 +14,13 @@ class EmbedLayerNorm : public OpKernel {
   explicit EmbedLayerNorm(const OpKernelInfo& info);
   Status Compute(OpKernelContext* context) const override;
 };
+
+// EmbedLayerNormalization with uint8 embedding tables. Each table is dequantized with its own scale and zero point.
+template <typename T>
+class QEmbedLayerNorm : public OpKernel {
+ public:
+  explicit QEmbedLayerNorm(const OpKernelInfo& info);
+  Status Compute(OpKernelContext* context) const override;
+};
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -0,0 +1,237 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/fused_elementwise.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/util/math_cpuonly.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_KERNEL_EX(
+    FusedElementwise,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    FusedElementwise);
+
+namespace {
+
+// Number of elements pushed through the whole chain at a time. Small enough that the output tile and the tiles of
+// a few full sized operands stay in L1 while every step runs over them.
+constexpr std::ptrdiff_t kFusedElementwiseTileSize = 1024;
+
+using OpCode = FusedElementwise::OpCode;
+
+const std::unordered_map<std::string, OpCode>& GetOpCodeMap() {
+  static const std::unordered_map<std::string, OpCode> op_codes = {
+      {"Add", OpCode::Add},
+      {"Sub", OpCode::Sub},
+      {"Mul", OpCode::Mul},
+      {"Div", OpCode::Div},
+      {"Relu", OpCode::Relu},
+      {"Sigmoid", OpCode::Sigmoid},
+      {"Tanh", OpCode::Tanh},
+      {"Erf", OpCode::Erf},
+      {"Neg", OpCode::Neg},
+      {"Abs", OpCode::Abs},
+      {"Exp", OpCode::Exp},
+      {"Log", OpCode::Log},
+      {"Sqrt", OpCode::Sqrt},
+      {"Reciprocal", OpCode::Reciprocal},
+  };
+  return op_codes;
+}
+
+bool IsBinary(OpCode op) {
+  return op == OpCode::Add || op == OpCode::Sub || op == OpCode::Mul || op == OpCode::Div;
+}
+
+// Rough per element cost of a step, relative to a single add, for the thread pool cost model.
+double StepCost(OpCode op) {
+  switch (op) {
+    case OpCode::Sigmoid:
+    case OpCode::Tanh:
+    case OpCode::Erf:
+    case OpCode::Exp:
+    case OpCode::Log:
+      return 10.0;
+    case OpCode::Div:
+    case OpCode::Sqrt:
+    case OpCode::Reciprocal:
+      return 4.0;
+    default:
+      return 1.0;
+  }
+}
+
+struct Operand {
+  const float* data;
+  bool is_scalar;
+};
+
+template <typename Op>
+void ApplyBinary(EigenVectorArrayMap<float>& y, const Operand& operand, std::ptrdiff_t offset, bool operand_is_lhs,
+                 Op op) {
+  if (operand.is_scalar) {
+    const float scalar = *operand.data;
+    if (operand_is_lhs) {
+      y = op(scalar, y);
+    } else {
+      y = op(y, scalar);
+    }
+  } else {
+    ConstEigenVectorArrayMap<float> other(operand.data + offset, y.size());
+    if (operand_is_lhs) {
+      y = op(other, y);
+    } else {
+      y = op(y, other);
+    }
+  }
+}
+
+void RunSteps(const std::vector<FusedElementwise::Step>& steps, const std::vector<Operand>& operands,
+              const float* x_data, float* y_data, std::ptrdiff_t offset, std::ptrdiff_t count) {
+  EigenVectorArrayMap<float> y(y_data + offset, count);
+  y = ConstEigenVectorArrayMap<float>(x_data + offset, count);
+
+  for (size_t i = 0; i < steps.size(); ++i) {
+    const auto& step = steps[i];
+    switch (step.op) {
+      case OpCode::Add:
+        ApplyBinary(y, operands[i], offset, step.operand_is_lhs, [](const auto& a, const auto& b) { return a + b; });
+        break;
+      case OpCode::Sub:
+        ApplyBinary(y, operands[i], offset, step.operand_is_lhs, [](const auto& a, const auto& b) { return a - b; });
+        break;
+      case OpCode::Mul:
+        ApplyBinary(y, operands[i], offset, step.operand_is_lhs, [](const auto& a, const auto& b) { return a * b; });
+        break;
+      case OpCode::Div:
+        ApplyBinary(y, operands[i], offset, step.operand_is_lhs, [](const auto& a, const auto& b) { return a / b; });
+        break;
+      case OpCode::Relu:
+        y = y.cwiseMax(0.0f);
+        break;
+      case OpCode::Sigmoid:
+        MlasComputeLogistic(y.data(), y.data(), static_cast<size_t>(count));
+        break;
+      case OpCode::Tanh:
+        MlasComputeTanh(y.data(), y.data(), static_cast<size_t>(count));
+        break;
+      case OpCode::Erf:
+        MlasComputeErf(y.data(), y.data(), static_cast<size_t>(count));
+        break;
+      case OpCode::Neg:
+        y = -y;
+        break;
+      case OpCode::Abs:
+        y = y.abs();
+        break;
+      case OpCode::Exp:
+        y = y.exp();
+        break;
+      case OpCode::Log:
+        y = y.log();
+        break;
+      case OpCode::Sqrt:
+        y = y.sqrt();
+        break;
+      case OpCode::Reciprocal:
+        y = y.inverse();
+        break;
+    }
+  }
+}
+
+}  // namespace
+
+FusedElementwise::FusedElementwise(const OpKernelInfo& info) : OpKernel(info) {
+  std::vector<std::string> ops;
+  ORT_ENFORCE(info.GetAttrs<std::string>("ops", ops).IsOK(), "FusedElementwise requires the 'ops' attribute.");
+  std::vector<int64_t> operand_positions;
+  ORT_ENFORCE(info.GetAttrs<int64_t>("operand_positions", operand_positions).IsOK(),
+              "FusedElementwise requires the 'operand_positions' attribute.");
+  ORT_ENFORCE(ops.size() == operand_positions.size(),
+              "FusedElementwise: 'ops' and 'operand_positions' must have the same length.");
+
+  const auto& op_codes = GetOpCodeMap();
+  int next_operand = 1;
+  steps_.reserve(ops.size());
+  for (size_t i = 0; i < ops.size(); ++i) {
+    auto it = op_codes.find(ops[i]);
+    ORT_ENFORCE(it != op_codes.end(), "FusedElementwise: unsupported op ", ops[i]);
+
+    Step step{it->second, -1, false};
+    if (IsBinary(step.op)) {
+      ORT_ENFORCE(operand_positions[i] == 0 || operand_positions[i] == 1,
+                  "FusedElementwise: invalid operand position for binary op ", ops[i]);
+      step.operand = next_operand++;
+      step.operand_is_lhs = operand_positions[i] == 0;
+    } else {
+      ORT_ENFORCE(operand_positions[i] == -1, "FusedElementwise: unary op ", ops[i], " cannot take an operand.");
+    }
+    steps_.push_back(step);
+  }
+
+  ORT_ENFORCE(static_cast<int>(info.GetInputCount()) == next_operand,
+              "FusedElementwise: expected ", next_operand, " inputs but got ", info.GetInputCount());
+}
+
+Status FusedElementwise::Compute(OpKernelContext* context) const {
+  const Tensor& X = *context->Input<Tensor>(0);
+  const TensorShape& shape = X.Shape();
+  const int64_t size = shape.Size();
+
+  // Resolve the operand of each step up front so the tile loop only deals with raw pointers.
+  std::vector<Operand> operands(steps_.size(), Operand{nullptr, false});
+  double bytes_loaded = sizeof(float);
+  double compute_cycles = 0.0;
+  for (size_t i = 0; i < steps_.size(); ++i) {
+    const Step& step = steps_[i];
+    compute_cycles += StepCost(step.op);
+    if (step.operand < 0) {
+      continue;
+    }
+
+    const Tensor& operand = *context->Input<Tensor>(step.operand);
+    const int64_t operand_size = operand.Shape().Size();
+    if (operand_size == 1) {
+      operands[i] = Operand{operand.Data<float>(), true};
+    } else if (operand_size == size) {
+      operands[i] = Operand{operand.Data<float>(), false};
+      bytes_loaded += sizeof(float);
+    } else {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "FusedElementwise: input ", step.operand, " with shape ",
+                             operand.Shape(), " is neither a scalar nor the shape of the input ", shape);
+    }
+  }
+
+  Tensor& Y = *context->Output(0, shape);
+  if (size == 0) {
+    return Status::OK();
+  }
+
+  const float* x_data = X.Data<float>();
+  float* y_data = Y.MutableData<float>();
+
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(size),
+      TensorOpCost{bytes_loaded, static_cast<double>(sizeof(float)), compute_cycles},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t tile = first; tile < last; tile += kFusedElementwiseTileSize) {
+          RunSteps(steps_, operands, x_data, y_data, tile, std::min(kFusedElementwiseTileSize, last - tile));
+        }
+      });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
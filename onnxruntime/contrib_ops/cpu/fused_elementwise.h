@@ -0,0 +1,53 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+/**
+Evaluates a chain of element-wise ops produced by the ElementwiseFusion transformer.
+The chain is compiled into a list of steps once, and each tile of the output is run through every step
+while it is still in cache, so the intermediate tensors of the original graph are never materialized.
+*/
+class FusedElementwise final : public OpKernel {
+ public:
+  explicit FusedElementwise(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+  enum class OpCode : uint8_t {
+    Add,
+    Sub,
+    Mul,
+    Div,
+    Relu,
+    Sigmoid,
+    Tanh,
+    Erf,
+    Neg,
+    Abs,
+    Exp,
+    Log,
+    Sqrt,
+    Reciprocal,
+  };
+
+  struct Step {
+    OpCode op;
+    // Index of the kernel input holding the extra operand of a binary op, or -1 for unary ops.
+    int operand;
+    // Whether the extra operand is the left hand side of the binary op.
+    bool operand_is_lhs;
+  };
+
+ private:
+  std::vector<Step> steps_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
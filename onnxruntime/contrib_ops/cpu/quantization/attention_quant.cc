@@ -0,0 +1,187 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/bert/attention_cpu_base.h"
+#include "core/common/safeint.h"
+#include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/common.h"
+#include "core/util/qmath.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Attention with a quantized input and weights. The input projection is an integer gemm, and the result is
+// dequantized to compute the attention in float.
+template <typename T>
+class QAttention : public OpKernel, public AttentionCPUBase {
+ public:
+  explicit QAttention(const OpKernelInfo& info) : OpKernel(info), AttentionCPUBase(info) {}
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  template <typename TWeight>
+  Status ComputeProjection(const Tensor& input, uint8_t input_zero_point, const Tensor& weights,
+                           const Tensor* weight_zero_point_tensor, int32_t* gemm_output,
+                           concurrency::ThreadPool* tp) const;
+};
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    QAttention,
+    1,
+    float,
+    KernelDefBuilder()
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<uint8_t>())
+        .TypeConstraint("T2", {DataTypeImpl::GetTensorType<int8_t>(), DataTypeImpl::GetTensorType<uint8_t>()})
+        .TypeConstraint("T3", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T4", DataTypeImpl::GetTensorType<int32_t>()),
+    QAttention<float>);
+
+namespace {
+
+// gemm_output(BS, 3NH) = input(BS, NH) x weights(NH, 3NH), with the zero points subtracted from both operands.
+void QGemm(int M, int N, int K, const uint8_t* input, uint8_t input_zero_point, const uint8_t* weights,
+           uint8_t weight_zero_point, int32_t* output, concurrency::ThreadPool* tp) {
+  QGemmu8u8_s32(M, N, K, input, K, input_zero_point, weights, N, weight_zero_point, output, N, tp);
+}
+
+void QGemm(int M, int N, int K, const uint8_t* input, uint8_t input_zero_point, const int8_t* weights,
+           int8_t weight_zero_point, int32_t* output, concurrency::ThreadPool* tp) {
+  QGemmu8s8_s32(M, N, K, input, K, input_zero_point, weights, N, weight_zero_point, output, N, tp);
+}
+
+}  // namespace
+
+template <typename T>
+template <typename TWeight>
+Status QAttention<T>::ComputeProjection(const Tensor& input, uint8_t input_zero_point, const Tensor& weights,
+                                        const Tensor* weight_zero_point_tensor, int32_t* gemm_output,
+                                        concurrency::ThreadPool* tp) const {
+  TWeight weight_zero_point = 0;
+  if (weight_zero_point_tensor != nullptr) {
+    ORT_RETURN_IF_NOT(IsScalarOr1ElementVector(weight_zero_point_tensor),
+                      "QAttention : weight zero point must be a scalar or 1D tensor of size 1");
+    weight_zero_point = *weight_zero_point_tensor->template Data<TWeight>();
+  }
+
+  const auto& dims = input.Shape().GetDims();
+  const int M = static_cast<int>(dims[0] * dims[1]);
+  const int K = static_cast<int>(dims[2]);
+  const int N = 3 * K;
+  QGemm(M, N, K, input.template Data<uint8_t>(), input_zero_point, weights.template Data<TWeight>(),
+        weight_zero_point, gemm_output, tp);
+  return Status::OK();
+}
+
+template <typename T>
+Status QAttention<T>::Compute(OpKernelContext* context) const {
+  // Input and output shapes:
+  //   Input 0 - input             : (batch_size, sequence_length, hidden_size)
+  //   Input 1 - weights           : (hidden_size, 3 * hidden_size)
+  //   Input 2 - bias              : (3 * hidden_size)
+  //   Input 3 - input_scale       : scalar
+  //   Input 4 - weight_scale      : scalar or (3 * hidden_size)
+  //   Input 5 - mask_index        : nullptr, (batch_size) or (batch_size, sequence_length)
+  //   Input 6 - input_zero_point  : scalar
+  //   Input 7 - weight_zero_point : scalar
+  //   Output                      : (batch_size, sequence_length, hidden_size)
+  const Tensor* input = context->Input<Tensor>(0);
+  const Tensor* weights = context->Input<Tensor>(1);
+  const Tensor* bias = context->Input<Tensor>(2);
+  const Tensor* input_scale_tensor = context->Input<Tensor>(3);
+  const Tensor* weight_scale_tensor = context->Input<Tensor>(4);
+  const Tensor* mask_index = context->Input<Tensor>(5);
+  const Tensor* input_zero_point_tensor = context->Input<Tensor>(6);
+  const Tensor* weight_zero_point_tensor = context->Input<Tensor>(7);
+  ORT_RETURN_IF_ERROR(CheckInputs(input->Shape(), weights->Shape(), bias->Shape(), mask_index, nullptr));
+
+  ORT_RETURN_IF_NOT(IsScalarOr1ElementVector(input_scale_tensor),
+                    "QAttention : input scale must be a scalar or 1D tensor of size 1");
+  const T input_scale = *input_scale_tensor->template Data<T>();
+
+  const auto& dims = input->Shape().GetDims();
+  const int batch_size = static_cast<int>(dims[0]);
+  const int sequence_length = static_cast<int>(dims[1]);
+  const int hidden_size = static_cast<int>(dims[2]);
+  const int head_size = hidden_size / num_heads_;
+
+  // The weights are quantized per tensor, or per column of the (hidden_size, 3 * hidden_size) matrix.
+  const int64_t weight_scale_size = weight_scale_tensor->Shape().Size();
+  ORT_RETURN_IF_NOT(weight_scale_tensor->Shape().NumDimensions() <= 1 &&
+                        (weight_scale_size == 1 || weight_scale_size == 3 * hidden_size),
+                    "QAttention : weight scale must be a scalar or 1D tensor of size 1 or 3 * hidden_size");
+  const T* weight_scale = weight_scale_tensor->template Data<T>();
+  const bool is_weight_scale_per_column = weight_scale_size != 1;
+
+  uint8_t input_zero_point = 0;
+  if (input_zero_point_tensor != nullptr) {
+    ORT_RETURN_IF_NOT(IsScalarOr1ElementVector(input_zero_point_tensor),
+                      "QAttention : input zero point must be a scalar or 1D tensor of size 1");
+    input_zero_point = *input_zero_point_tensor->template Data<uint8_t>();
+  }
+
+  Tensor* output = context->Output(0, input->Shape());
+
+  auto* tp = context->GetOperatorThreadPool();
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+
+  // STEP.1: gemm_data(BS, 3NH) = input(BS, NH) x weights(NH, 3NH), computed as a single integer gemm.
+  const size_t qkv_size = SafeInt<size_t>(batch_size) * sequence_length * hidden_size;
+  auto gemm_data = allocator->Alloc(SafeInt<size_t>(3) * qkv_size * sizeof(int32_t));
+  BufferUniquePtr gemm_buffer(gemm_data, BufferDeleter(allocator));
+  auto gemm_output = reinterpret_cast<int32_t*>(gemm_data);
+
+  if (weights->IsDataType<int8_t>()) {
+    ORT_RETURN_IF_ERROR(ComputeProjection<int8_t>(*input, input_zero_point, *weights, weight_zero_point_tensor,
+                                                  gemm_output, tp));
+  } else {
+    ORT_RETURN_IF_ERROR(ComputeProjection<uint8_t>(*input, input_zero_point, *weights, weight_zero_point_tensor,
+                                                   gemm_output, tp));
+  }
+
+  // Dequantize and add the bias while scattering the gemm output (B, S, 3, N, H) into Q, K and V (3, B, N, S, H).
+  auto qkv_data = allocator->Alloc(SafeInt<size_t>(3) * qkv_size * sizeof(T));
+  BufferUniquePtr qkv_buffer(qkv_data, BufferDeleter(allocator));
+  auto Q = reinterpret_cast<T*>(qkv_data);
+  auto K = Q + qkv_size;
+  auto V = K + qkv_size;
+
+  {
+    const int loop_len = 3 * batch_size * num_heads_;
+    const T* bias_data = bias->template Data<T>();
+    const double cost = static_cast<double>(sequence_length) * static_cast<double>(head_size);
+    concurrency::ThreadPool::TryParallelFor(tp, loop_len, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+      for (std::ptrdiff_t i = begin; i != end; ++i) {
+        const int batch_index = static_cast<int>((i / 3) / num_heads_);
+        const int head_index = static_cast<int>((i / 3) % num_heads_);
+        const int qkv_index = static_cast<int>(i % 3);
+        const int batch_head_index = batch_index * num_heads_ + head_index;
+
+        const int column_offset = qkv_index * hidden_size + head_index * head_size;
+        const int32_t* src = gemm_output + SafeInt<size_t>(batch_index) * sequence_length * 3 * hidden_size +
+                             column_offset;
+        T* dest = Q + qkv_index * qkv_size + SafeInt<size_t>(batch_head_index) * sequence_length * head_size;
+        const T* bias_src = bias_data + column_offset;
+        const T* scale_src = weight_scale + (is_weight_scale_per_column ? column_offset : 0);
+
+        for (int seq_index = 0; seq_index < sequence_length; seq_index++) {
+          for (int h = 0; h < head_size; h++) {
+            const T scale = input_scale * scale_src[is_weight_scale_per_column ? h : 0];
+            dest[h] = static_cast<T>(src[h]) * scale + bias_src[h];
+          }
+          src += 3 * hidden_size;
+          dest += head_size;
+        }
+      }
+    });
+  }
+
+  // STEP.2 - STEP.4: attention over the dequantized Q, K and V.
+  return ApplyAttention(Q, K, V, mask_index, output, batch_size, sequence_length, 0, head_size, hidden_size,
+                        context);
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,110 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/quantization/qlinear_binary_op.h"
+#include "contrib_ops/cpu/quantization/qlinear_util.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/math/element_wise_ops.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+namespace {
+
+using QLinearBinaryFunction = void(MLASCALL*)(const uint8_t* InputA, float ScaleA, uint8_t ZeroPointA,
+                                              const uint8_t* InputB, float ScaleB, uint8_t ZeroPointB,
+                                              float ScaleC, uint8_t ZeroPointC, uint8_t* OutputC,
+                                              size_t N, bool IsScalarB);
+
+// Both operations are commutative, so a scalar A is handled by swapping the operands.
+Status QLinearBinaryCompute(OpKernelContext& context, QLinearBinaryFunction compute) {
+  const auto& A = *context.Input<Tensor>(0);
+  const auto& B = *context.Input<Tensor>(3);
+
+  float A_scale, B_scale, C_scale;
+  uint8_t A_zero_point, B_zero_point, C_zero_point;
+  ORT_RETURN_IF_ERROR(GetQuantizationParameters(context, 1, 2, A_scale, A_zero_point));
+  ORT_RETURN_IF_ERROR(GetQuantizationParameters(context, 4, 5, B_scale, B_zero_point));
+  ORT_RETURN_IF_ERROR(GetQuantizationParameters(context, 6, 7, C_scale, C_zero_point));
+
+  TBroadcaster<uint8_t, uint8_t> bc(A, B);
+  Tensor& C = *context.Output(0, bc.GetOutputShape());
+  const int64_t output_size = C.Shape().Size();
+  if (output_size == 0) {
+    return Status::OK();
+  }
+
+  if (static_cast<int64_t>(bc.GetSpanSize()) == output_size) {
+    // The output is a single span: the shapes match or one of the inputs is a scalar. Split it across the
+    // thread pool.
+    const uint8_t* A_data = A.template Data<uint8_t>();
+    const uint8_t* B_data = B.template Data<uint8_t>();
+    uint8_t* C_data = C.template MutableData<uint8_t>();
+    const bool A_is_scalar = bc.IsInput0Scalar();
+    const bool B_is_scalar = bc.IsInput1Scalar();
+
+    concurrency::ThreadPool::TryParallelFor(
+        context.GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(output_size), TensorOpCost{1.0, 1.0, 2.0},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          const auto count = static_cast<size_t>(last - first);
+          if (A_is_scalar) {
+            compute(B_data + first, B_scale, B_zero_point, A_data, A_scale, A_zero_point,
+                    C_scale, C_zero_point, C_data + first, count, true);
+          } else {
+            compute(A_data + first, A_scale, A_zero_point, B_is_scalar ? B_data : B_data + first, B_scale,
+                    B_zero_point, C_scale, C_zero_point, C_data + first, count, B_is_scalar);
+          }
+        });
+    return Status::OK();
+  }
+
+  TBroadcastOutput<uint8_t> output(bc.GetSpanSize(), C);
+  BroadcastLoopSpan(
+      bc, output,
+      [&](gsl::span<uint8_t> output_span, const uint8_t& input0, gsl::span<const uint8_t> input1) {
+        compute(input1.data(), B_scale, B_zero_point, &input0, A_scale, A_zero_point,
+                C_scale, C_zero_point, output_span.data(), output_span.size(), true);
+      },
+      [&](gsl::span<uint8_t> output_span, gsl::span<const uint8_t> input0, const uint8_t& input1) {
+        compute(input0.data(), A_scale, A_zero_point, &input1, B_scale, B_zero_point,
+                C_scale, C_zero_point, output_span.data(), output_span.size(), true);
+      },
+      [&](gsl::span<uint8_t> output_span, gsl::span<const uint8_t> input0, gsl::span<const uint8_t> input1) {
+        compute(input0.data(), A_scale, A_zero_point, input1.data(), B_scale, B_zero_point,
+                C_scale, C_zero_point, output_span.data(), output_span.size(), false);
+      });
+
+  return Status::OK();
+}
+
+}  // namespace
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    QLinearAdd,
+    1,
+    uint8_t,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<uint8_t>()),
+    QLinearAdd<uint8_t>);
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    QLinearMul,
+    1,
+    uint8_t,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<uint8_t>()),
+    QLinearMul<uint8_t>);
+
+template <>
+Status QLinearAdd<uint8_t>::Compute(OpKernelContext* context) const {
+  return QLinearBinaryCompute(*context, MlasQLinearAdd);
+}
+
+template <>
+Status QLinearMul<uint8_t>::Compute(OpKernelContext* context) const {
+  return QLinearBinaryCompute(*context, MlasQLinearMul);
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,141 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/quantization/qlinear_pool.h"
+#include "contrib_ops/cpu/quantization/qlinear_util.h"
+#include "core/platform/threadpool.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    QLinearAveragePool,
+    1,
+    uint8_t,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<uint8_t>()),
+    QLinearAveragePool<uint8_t>);
+
+namespace {
+
+// Averages one channel of a 1D, 2D or 3D input. Missing spatial dimensions have a size, kernel and stride of 1.
+// The window sums are accumulated in integers and only the average is requantized:
+//   Y = Y_zero_point + (X_scale / Y_scale) * (sum(X) - count * X_zero_point) / divisor
+struct QLinearAveragePoolTask final {
+  const uint8_t* X_data;
+  uint8_t* Y_data;
+  int64_t input_shape[3];
+  int64_t output_shape[3];
+  int64_t kernel_shape[3];
+  int64_t strides[3];
+  int64_t pads[3];
+  bool count_include_pad;
+  float scale;
+  int32_t X_zero_point;
+  int32_t Y_zero_point;
+
+  TensorOpCost Cost() const {
+    const double loop_count = static_cast<double>(output_shape[0] * output_shape[1] * output_shape[2] *
+                                                  kernel_shape[0] * kernel_shape[1] * kernel_shape[2]);
+    return TensorOpCost{loop_count, static_cast<double>(output_shape[0] * output_shape[1] * output_shape[2]),
+                        loop_count};
+  }
+
+  void operator()(std::ptrdiff_t begin, std::ptrdiff_t end) const {
+    for (std::ptrdiff_t c = begin; c < end; ++c) {
+      RunChannel(c);
+    }
+  }
+
+  void RunChannel(std::ptrdiff_t c) const {
+    const int64_t x_step = input_shape[0] * input_shape[1] * input_shape[2];
+    const int64_t y_step = output_shape[0] * output_shape[1] * output_shape[2];
+    const uint8_t* x_d = X_data + c * x_step;
+    uint8_t* y_d = Y_data + c * y_step;
+    const int64_t kernel_size = kernel_shape[0] * kernel_shape[1] * kernel_shape[2];
+
+    for (int64_t ph = 0; ph < output_shape[0]; ++ph) {
+      int64_t hstart = ph * strides[0] - pads[0];
+      const int64_t hend = std::min(hstart + kernel_shape[0], input_shape[0]);
+      hstart = std::max(hstart, static_cast<int64_t>(0));
+
+      for (int64_t pw = 0; pw < output_shape[1]; ++pw) {
+        int64_t wstart = pw * strides[1] - pads[1];
+        const int64_t wend = std::min(wstart + kernel_shape[1], input_shape[1]);
+        wstart = std::max(wstart, static_cast<int64_t>(0));
+
+        for (int64_t pd = 0; pd < output_shape[2]; ++pd) {
+          int64_t dstart = pd * strides[2] - pads[2];
+          const int64_t dend = std::min(dstart + kernel_shape[2], input_shape[2]);
+          dstart = std::max(dstart, static_cast<int64_t>(0));
+
+          int32_t sum = 0;
+          for (int64_t h = hstart; h < hend; ++h) {
+            for (int64_t w = wstart; w < wend; ++w) {
+              const uint8_t* x_row = x_d + (h * input_shape[1] + w) * input_shape[2];
+              for (int64_t d = dstart; d < dend; ++d) {
+                sum += x_row[d];
+              }
+            }
+          }
+
+          const int64_t count = (hend - hstart) * (wend - wstart) * (dend - dstart);
+          const int64_t divisor = count_include_pad ? kernel_size : count;
+          const float value = scale * static_cast<float>(sum - static_cast<int32_t>(count) * X_zero_point) /
+                              static_cast<float>(divisor);
+          int32_t quantized = static_cast<int32_t>(std::nearbyintf(value)) + Y_zero_point;
+          quantized = std::min(std::max(quantized, 0), 255);
+          y_d[(ph * output_shape[1] + pw) * output_shape[2] + pd] = static_cast<uint8_t>(quantized);
+        }
+      }
+    }
+  }
+};
+
+}  // namespace
+
+template <>
+Status QLinearAveragePool<uint8_t>::Compute(OpKernelContext* context) const {
+  const auto* X = context->Input<Tensor>(0);
+  const TensorShape& x_shape = X->Shape();
+  const size_t spatial_dims = pool_attrs_.kernel_shape.size();
+  ORT_RETURN_IF_NOT(x_shape.NumDimensions() == spatial_dims + 2,
+                    "Input dimension doesn't match the kernel shape: ", x_shape);
+
+  float X_scale, Y_scale;
+  uint8_t X_zero_point, Y_zero_point;
+  ORT_RETURN_IF_ERROR(GetQuantizationParameters(*context, 1, 2, X_scale, X_zero_point));
+  ORT_RETURN_IF_ERROR(GetQuantizationParameters(*context, 3, 4, Y_scale, Y_zero_point));
+
+  std::vector<int64_t> pads = pool_attrs_.pads;
+  std::vector<int64_t> output_dims = pool_attrs_.SetOutputSize(x_shape, x_shape[1], &pads);
+  Tensor* Y = context->Output(0, output_dims);
+
+  QLinearAveragePoolTask task;
+  task.X_data = X->template Data<uint8_t>();
+  task.Y_data = Y->template MutableData<uint8_t>();
+  for (size_t i = 0; i < 3; ++i) {
+    const bool has_dim = i < spatial_dims;
+    task.input_shape[i] = has_dim ? x_shape[i + 2] : 1;
+    task.output_shape[i] = has_dim ? output_dims[i + 2] : 1;
+    task.kernel_shape[i] = has_dim ? pool_attrs_.kernel_shape[i] : 1;
+    task.strides[i] = has_dim ? pool_attrs_.strides[i] : 1;
+    task.pads[i] = has_dim ? pads[i] : 0;
+  }
+  task.count_include_pad = pool_attrs_.count_include_pad;
+  task.scale = X_scale / Y_scale;
+  task.X_zero_point = X_zero_point;
+  task.Y_zero_point = Y_zero_point;
+
+  const int64_t total_channels = x_shape[0] * x_shape[1];
+  concurrency::ThreadPool::TryParallelFor(context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(total_channels),
+                                          task.Cost(), task);
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,28 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+#include "core/providers/cpu/nn/pool_attributes.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+template <typename T>
+class QLinearAveragePool final : public OpKernel {
+ public:
+  QLinearAveragePool(const OpKernelInfo& info) : OpKernel(info), pool_attrs_(info, "AveragePool", 10) {
+    ORT_ENFORCE(pool_attrs_.kernel_shape.size() >= 1 && pool_attrs_.kernel_shape.size() <= 3,
+                "QLinearAveragePool only supports 1D, 2D and 3D pooling.");
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  PoolAttributes pool_attrs_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
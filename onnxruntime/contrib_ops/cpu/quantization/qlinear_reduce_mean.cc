@@ -0,0 +1,127 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/quantization/qlinear_reduce_mean.h"
+#include "contrib_ops/cpu/quantization/qlinear_util.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/common.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    QLinearReduceMean,
+    1,
+    uint8_t,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<uint8_t>()),
+    QLinearReduceMean<uint8_t>);
+
+template <>
+Status QLinearReduceMean<uint8_t>::Compute(OpKernelContext* context) const {
+  const auto* X = context->Input<Tensor>(0);
+  const auto& input_dims = X->Shape().GetDims();
+  const auto rank = static_cast<int64_t>(input_dims.size());
+
+  float X_scale, Y_scale;
+  uint8_t X_zero_point, Y_zero_point;
+  ORT_RETURN_IF_ERROR(GetQuantizationParameters(*context, 1, 2, X_scale, X_zero_point));
+  ORT_RETURN_IF_ERROR(GetQuantizationParameters(*context, 3, 4, Y_scale, Y_zero_point));
+
+  std::vector<bool> reduced(input_dims.size(), axes_.empty());
+  for (int64_t axis : axes_) {
+    reduced[static_cast<size_t>(HandleNegativeAxis(axis, rank))] = true;
+  }
+
+  std::vector<int64_t> output_dims;
+  for (size_t i = 0; i < input_dims.size(); ++i) {
+    if (!reduced[i]) {
+      output_dims.push_back(input_dims[i]);
+    } else if (keepdims_) {
+      output_dims.push_back(1);
+    }
+  }
+
+  Tensor* Y = context->Output(0, output_dims);
+  const int64_t output_size = Y->Shape().Size();
+  if (output_size == 0) {
+    return Status::OK();
+  }
+
+  // Merge adjacent dimensions that are either all reduced or all kept, dropping dimensions of size 1.
+  std::vector<int64_t> merged_dims;
+  std::vector<bool> merged_reduced;
+  for (size_t i = 0; i < input_dims.size(); ++i) {
+    if (input_dims[i] == 1) {
+      continue;
+    }
+    if (!merged_dims.empty() && merged_reduced.back() == reduced[i]) {
+      merged_dims.back() *= input_dims[i];
+    } else {
+      merged_dims.push_back(input_dims[i]);
+      merged_reduced.push_back(reduced[i]);
+    }
+  }
+
+  // If the innermost dimension is reduced, it's summed as a contiguous run. The other dimensions are expanded
+  // into the input offsets of each output element and of each run to sum for an output element.
+  int64_t run_length = 1;
+  size_t outer_dims = merged_dims.size();
+  if (!merged_dims.empty() && merged_reduced.back()) {
+    run_length = merged_dims.back();
+    --outer_dims;
+  }
+
+  std::vector<int64_t> output_offsets{0};
+  std::vector<int64_t> run_offsets{0};
+  int64_t stride = run_length;
+  for (size_t i = outer_dims; i-- > 0;) {
+    auto& offsets = merged_reduced[i] ? run_offsets : output_offsets;
+    std::vector<int64_t> expanded;
+    expanded.reserve(offsets.size() * static_cast<size_t>(merged_dims[i]));
+    for (int64_t j = 0; j < merged_dims[i]; ++j) {
+      for (int64_t offset : offsets) {
+        expanded.push_back(j * stride + offset);
+      }
+    }
+    offsets = std::move(expanded);
+    stride *= merged_dims[i];
+  }
+
+  const int64_t reduce_count = static_cast<int64_t>(run_offsets.size()) * run_length;
+  ORT_RETURN_IF_NOT(reduce_count > 0, "Can't compute the mean of an empty set of elements.");
+
+  const uint8_t* X_data = X->template Data<uint8_t>();
+  uint8_t* Y_data = Y->template MutableData<uint8_t>();
+  const float scale = X_scale / Y_scale / static_cast<float>(reduce_count);
+  const int64_t zero_point_sum = reduce_count * X_zero_point;
+  const int32_t output_zero_point = Y_zero_point;
+
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(output_size),
+      TensorOpCost{static_cast<double>(reduce_count), 1.0, static_cast<double>(reduce_count)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          const uint8_t* x = X_data + output_offsets[i];
+          int64_t sum = 0;
+          for (int64_t run_offset : run_offsets) {
+            const uint8_t* run = x + run_offset;
+            for (int64_t k = 0; k < run_length; ++k) {
+              sum += run[k];
+            }
+          }
+          int32_t quantized = static_cast<int32_t>(std::nearbyintf(scale * static_cast<float>(sum - zero_point_sum))) +
+                              output_zero_point;
+          quantized = std::min(std::max(quantized, 0), 255);
+          Y_data[i] = static_cast<uint8_t>(quantized);
+        }
+      });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
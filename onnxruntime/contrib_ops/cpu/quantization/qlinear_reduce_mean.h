@@ -0,0 +1,28 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+template <typename T>
+class QLinearReduceMean final : public OpKernel {
+ public:
+  QLinearReduceMean(const OpKernelInfo& info) : OpKernel(info) {
+    axes_ = info.GetAttrsOrDefault<int64_t>("axes");
+    keepdims_ = info.GetAttrOrDefault<int64_t>("keepdims", 1) != 0;
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  std::vector<int64_t> axes_;
+  bool keepdims_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
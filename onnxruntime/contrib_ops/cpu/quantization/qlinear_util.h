@@ -0,0 +1,35 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Reads the per-tensor scale and the optional zero point (0 if it's missing) of a quantized input or output of
+// the QLinear* ops.
+template <typename T>
+Status GetQuantizationParameters(const OpKernelContext& context, int scale_index, int zero_point_index,
+                                 float& scale, T& zero_point) {
+  const auto* scale_tensor = context.Input<Tensor>(scale_index);
+  ORT_RETURN_IF_NOT(scale_tensor != nullptr && scale_tensor->Shape().Size() == 1,
+                    "Input ", scale_index, " must be a scalar or 1D tensor of size 1");
+  scale = *scale_tensor->template Data<float>();
+  ORT_RETURN_IF_NOT(scale > 0.0f, "Input ", scale_index, " must be a positive scale");
+
+  zero_point = 0;
+  const auto* zero_point_tensor = context.Input<Tensor>(zero_point_index);
+  if (zero_point_tensor != nullptr) {
+    ORT_RETURN_IF_NOT(zero_point_tensor->Shape().Size() == 1,
+                      "Input ", zero_point_index, " must be a scalar or 1D tensor of size 1");
+    zero_point = *zero_point_tensor->template Data<T>();
+  }
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
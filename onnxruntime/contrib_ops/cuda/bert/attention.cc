@@ -35,7 +35,16 @@ Attention<T>::Attention(const OpKernelInfo& info) : CudaKernel(info), AttentionB
 
 template <typename T>
 Status Attention<T>::ComputeInternal(OpKernelContext* context) const {
-  ORT_RETURN_IF_ERROR(CheckInputs(context));
+  ORT_RETURN_IF_ERROR(CheckInputs(context->Input<Tensor>(0)->Shape(), context->Input<Tensor>(1)->Shape(),
+                                  context->Input<Tensor>(2)->Shape(), context->Input<Tensor>(3),
+                                  context->Input<Tensor>(4)));
+  if (context->Input<Tensor>(4) != nullptr || context->OutputCount() > 1 || is_unidirectional_) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED,
+                           "past, present and unidirectional are not supported by the CUDA Attention kernel");
+  }
+  if (context->Input<Tensor>(3)->Shape().NumDimensions() != 1) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "2D mask_index is not supported by the CUDA Attention kernel");
+  }
   // Input and output shapes:
   //   Input 0 - input       : (batch_size, sequence_length, hidden_size)
   //   Input 1 - weights     : (hidden_size, 3 * hidden_size)
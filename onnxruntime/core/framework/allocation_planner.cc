@@ -354,6 +354,7 @@ class PlannerImpl {
 
     // Initialize node_has_fence.
     plan_.node_has_fence.resize(graph_viewer_.MaxNodeIndex());
+    plan_.node_priority.resize(graph_viewer_.MaxNodeIndex());
 
     // Initialize allocation plan:
     plan_.allocation_plan.resize(num_ml_values);
@@ -669,6 +670,23 @@ class PlannerImpl {
     return Status::OK();
   }
 
+  // Compute the critical path length of every node by walking the nodes in reverse topological order.
+  Status ComputeNodePriorities() {
+    for (auto it = plan_.execution_plan.rbegin(), end = plan_.execution_plan.rend(); it != end; ++it) {
+      auto pnode = graph_viewer_.GetNode(it->node_index);
+      if (pnode == nullptr) return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Can not find the node ", it->node_index);
+
+      int priority = 0;
+      for (auto edge = pnode->OutputEdgesBegin(), edge_end = pnode->OutputEdgesEnd(); edge != edge_end; ++edge) {
+        priority = std::max(priority, plan_.node_priority[edge->GetNode().Index()]);
+      }
+
+      plan_.node_priority[it->node_index] = priority + 1;
+    }
+
+    return Status::OK();
+  }
+
   // Convert information in a freelist (about which ml-value becomes free when) into
   // a deallocation plan in the format required in an ExecutionPlan
   void GenerateDeallocationPlan() {
@@ -729,6 +747,9 @@ Status PlannerImpl::CreatePlan() {
   // Determine nodes that need fence check. This needs to be done after ComputeUseCounts and ComputeReusePlan.
   ORT_RETURN_IF_ERROR(ComputeFenceCheck());
 
+  // Determine critical path priority hints for the parallel executor.
+  ORT_RETURN_IF_ERROR(ComputeNodePriorities());
+
   // convert information in the freelist_ into a deallocation plan in required format
   GenerateDeallocationPlan();
 
@@ -22,8 +22,14 @@ using namespace ::onnxruntime::common;
 AllocatorPtr CreateAllocator(DeviceAllocatorRegistrationInfo info, OrtDevice::DeviceId device_id) {
   auto device_allocator = std::unique_ptr<IDeviceAllocator>(info.factory(device_id));
   if (device_allocator->AllowsArena()) {
+#if defined(USE_MIMALLOC_ARENA_ALLOCATOR)
     return std::shared_ptr<IArenaAllocator>(
           onnxruntime::make_unique<TArenaAllocator>(std::move(device_allocator), info.max_mem));
+#else
+    return std::shared_ptr<IArenaAllocator>(
+          onnxruntime::make_unique<TArenaAllocator>(std::move(device_allocator), info.max_mem, info.use_thread_cache,
+                                                    info.arena_extend_strategy));
+#endif
   }
 
   return AllocatorPtr(std::move(device_allocator));
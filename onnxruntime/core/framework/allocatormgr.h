@@ -14,6 +14,10 @@ struct DeviceAllocatorRegistrationInfo {
   OrtMemType mem_type;
   DeviceAllocatorFactory factory;
   size_t max_mem;
+  // Put per-thread caches of small freed chunks in front of the arena. Ignored by arenas that don't support it.
+  bool use_thread_cache = false;
+  // How the arena grows when it runs out of memory. Ignored by arenas that don't support it.
+  OrtArenaExtendStrategy arena_extend_strategy = ORT_ARENA_EXTEND_NEXT_POWER_OF_TWO;
 };
 
 AllocatorPtr CreateAllocator(DeviceAllocatorRegistrationInfo info, OrtDevice::DeviceId device_id = 0);
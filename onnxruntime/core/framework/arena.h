@@ -3,12 +3,71 @@
 
 #pragma once
 
+#include <sstream>
 #include <string>
 
 #include "core/common/common.h"
 #include "core/framework/allocator.h"
 
 namespace onnxruntime {
+// Runtime statistics collected by an allocator.
+struct AllocatorStats {
+  int64_t num_allocs;             // Number of allocations.
+  int64_t bytes_in_use;           // Number of bytes in use.
+  int64_t total_allocated_bytes;  // The total number of allocated bytes by the allocator.
+  int64_t max_bytes_in_use;       // The maximum bytes in use.
+  int64_t max_alloc_size;         // The max single allocation seen.
+                                  // The upper limit what the allocator can allocate, if such a limit
+                                  // is known. Certain allocator may return 0 to indicate the limit is
+                                  // unknown.
+  int64_t bytes_limit;
+
+  int64_t num_arena_extensions;    // Number of times the arena allocated a new region from the device.
+  int64_t bytes_in_thread_caches;  // Bytes of freed chunks held in per-thread caches. Not included in bytes_in_use.
+  int64_t num_thread_cache_hits;   // Allocations served from a per-thread cache without taking the arena lock.
+  int64_t num_lock_contentions;    // Number of times the arena lock was already held by another thread.
+  int64_t lock_wait_ns;            // Total time spent waiting for the arena lock, in nanoseconds.
+  int64_t free_bytes;              // Bytes in free chunks of the arena.
+  int64_t largest_free_block;      // Size of the largest free chunk. 1 - largest_free_block / free_bytes
+                                   // measures the fragmentation of the free memory.
+
+  AllocatorStats() { Clear(); }
+
+  void Clear() {
+    this->num_allocs = 0;
+    this->bytes_in_use = 0;
+    this->max_bytes_in_use = 0;
+    this->max_alloc_size = 0;
+    this->bytes_limit = 0;
+    this->total_allocated_bytes = 0;
+    this->num_arena_extensions = 0;
+    this->bytes_in_thread_caches = 0;
+    this->num_thread_cache_hits = 0;
+    this->num_lock_contentions = 0;
+    this->lock_wait_ns = 0;
+    this->free_bytes = 0;
+    this->largest_free_block = 0;
+  }
+
+  std::string DebugString() const {
+    std::ostringstream ss;
+    ss << "Limit:           " << this->bytes_limit << "\n"
+       << "InUse:          " << this->bytes_in_use << "\n"
+       << "TotalAllocated: " << this->total_allocated_bytes << "\n"
+       << "MaxInUse:       " << this->max_bytes_in_use << "\n"
+       << "NumAllocs:      " << this->num_allocs << "\n"
+       << "MaxAllocSize:   " << this->max_alloc_size << "\n"
+       << "NumExtensions:  " << this->num_arena_extensions << "\n"
+       << "ThreadCached:   " << this->bytes_in_thread_caches << "\n"
+       << "CacheHits:      " << this->num_thread_cache_hits << "\n"
+       << "LockContention: " << this->num_lock_contentions << "\n"
+       << "LockWaitNs:     " << this->lock_wait_ns << "\n"
+       << "FreeBytes:      " << this->free_bytes << "\n"
+       << "LargestFree:    " << this->largest_free_block << "\n";
+    return ss.str();
+  }
+};
+
 // The interface for arena which manage memory allocations
 // Arena will hold a pool of pre-allocate memories and manage their lifecycle.
 // Need an underline IResourceAllocator to allocate memories.
@@ -27,6 +86,15 @@ class IArenaAllocator : public IAllocator {
   virtual size_t Used() const = 0;
   virtual size_t Max() const = 0;
   const OrtMemoryInfo& Info() const override = 0;
+  // Fills in the statistics collected by the arena.
+  virtual void GetStats(AllocatorStats* /*stats*/) {
+    ORT_NOT_IMPLEMENTED(__FUNCTION__, " is not implemented");
+  }
+  // Returns the memory that is not in use back to the device.
+  // Arenas that cannot release memory do nothing.
+  virtual Status Shrink() {
+    return Status::OK();
+  }
   // allocate host pinned memory?
 };
 
@@ -68,6 +136,11 @@ class DummyArena : public IArenaAllocator {
     return info_;
   }
 
+  // Every allocation goes straight to the device allocator, so the arena itself holds no memory.
+  void GetStats(AllocatorStats* stats) override {
+    stats->Clear();
+  }
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(DummyArena);
 
@@ -75,38 +148,4 @@ class DummyArena : public IArenaAllocator {
   OrtMemoryInfo info_;
 };
 
-// Runtime statistics collected by an allocator.
-struct AllocatorStats {
-  int64_t num_allocs;             // Number of allocations.
-  int64_t bytes_in_use;           // Number of bytes in use.
-  int64_t total_allocated_bytes;  // The total number of allocated bytes by the allocator.
-  int64_t max_bytes_in_use;       // The maximum bytes in use.
-  int64_t max_alloc_size;         // The max single allocation seen.
-                                  // The upper limit what the allocator can allocate, if such a limit
-                                  // is known. Certain allocator may return 0 to indicate the limit is
-                                  // unknown.
-  int64_t bytes_limit;
-
-  AllocatorStats() { Clear(); }
-
-  void Clear() {
-    this->num_allocs = 0;
-    this->bytes_in_use = 0;
-    this->max_bytes_in_use = 0;
-    this->max_alloc_size = 0;
-    this->bytes_limit = 0;
-    this->total_allocated_bytes = 0;
-  }
-
-  std::string DebugString() const {
-    std::ostringstream ss;
-    ss << "Limit:           " << this->bytes_limit << "\n"
-       << "InUse:          " << this->bytes_in_use << "\n"
-       << "TotalAllocated: " << this->total_allocated_bytes << "\n"
-       << "MaxInUse:       " << this->max_bytes_in_use << "\n"
-       << "NumAllocs:      " << this->num_allocs << "\n"
-       << "MaxAllocSize:   " << this->max_alloc_size << "\n";
-    return ss.str();
-  }
-};
 }  // namespace onnxruntime
@@ -3,14 +3,49 @@
 
 #include "core/framework/bfc_arena.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <unordered_map>
+#include <unordered_set>
+
 namespace onnxruntime {
+static std::atomic<uint64_t> next_arena_id{1};
+
+namespace {
+// The arenas with a thread cache that have not been destroyed yet. Threads use it to drop the entries of destroyed
+// arenas from their thread local cache maps, which the arena itself cannot reach.
+struct LiveArenas {
+  OrtMutex mutex;
+  std::unordered_set<uint64_t> ids;
+  // Incremented whenever an arena is destroyed, so threads only prune their map when something changed.
+  std::atomic<uint64_t> destroyed_count{0};
+};
+
+LiveArenas& GetLiveArenas() {
+  static LiveArenas live_arenas;
+  return live_arenas;
+}
+}  // namespace
+
 BFCArena::BFCArena(std::unique_ptr<IDeviceAllocator> resource_allocator,
-                   size_t total_memory)
+                   size_t total_memory,
+                   bool enable_thread_cache,
+                   OrtArenaExtendStrategy extend_strategy)
     : device_allocator_(std::move(resource_allocator)),
       free_chunks_list_(kInvalidChunkHandle),
       next_allocation_id_(1),
       info_(device_allocator_->Info().name, OrtAllocatorType::OrtArenaAllocator,
-            device_allocator_->Info().device, device_allocator_->Info().id, device_allocator_->Info().mem_type) {
+            device_allocator_->Info().device, device_allocator_->Info().id, device_allocator_->Info().mem_type),
+      enable_thread_cache_(enable_thread_cache),
+      extend_strategy_(extend_strategy),
+      arena_id_(next_arena_id++) {
+  if (enable_thread_cache_) {
+    auto& live_arenas = GetLiveArenas();
+    std::lock_guard<OrtMutex> guard(live_arenas.mutex);
+    live_arenas.ids.insert(arena_id_);
+  }
+
   LOGS_DEFAULT(INFO) << "Creating BFCArena for " << device_allocator_->Info().name;
   curr_region_allocation_bytes_ = RoundedBytes(std::min(total_memory, size_t{1048576}));
 
@@ -37,6 +72,13 @@ BFCArena::BFCArena(std::unique_ptr<IDeviceAllocator> resource_allocator,
 }
 
 BFCArena::~BFCArena() {
+  if (enable_thread_cache_) {
+    auto& live_arenas = GetLiveArenas();
+    std::lock_guard<OrtMutex> guard(live_arenas.mutex);
+    live_arenas.ids.erase(arena_id_);
+    ++live_arenas.destroyed_count;
+  }
+
   for (const auto& region : region_manager_.regions()) {
     device_allocator_->Free(region.ptr());
   }
@@ -70,13 +112,17 @@ bool BFCArena::Extend(size_t rounded_bytes) {
   // allocation, keep multiplying by a power of two until that is
   // sufficient.
   bool increased_allocation = false;
-  while (rounded_bytes > curr_region_allocation_bytes_) {
-    curr_region_allocation_bytes_ *= 2;
-    increased_allocation = true;
+  if (extend_strategy_ == ORT_ARENA_EXTEND_NEXT_POWER_OF_TWO) {
+    while (rounded_bytes > curr_region_allocation_bytes_) {
+      curr_region_allocation_bytes_ *= 2;
+      increased_allocation = true;
+    }
   }
 
   // Try allocating.
-  size_t bytes = std::min(curr_region_allocation_bytes_, available_bytes);
+  size_t bytes = extend_strategy_ == ORT_ARENA_EXTEND_NEXT_POWER_OF_TWO
+                     ? std::min(curr_region_allocation_bytes_, available_bytes)
+                     : rounded_bytes;
   auto safe_alloc = [this](size_t alloc_bytes) {
     void* new_mem = nullptr;
     try {
@@ -115,13 +161,15 @@ bool BFCArena::Extend(size_t rounded_bytes) {
   }
 
   // we allocated the same number of bytes as the current region, so we have 2x that now
-  if (!increased_allocation) {
+  if (extend_strategy_ == ORT_ARENA_EXTEND_NEXT_POWER_OF_TWO && !increased_allocation) {
     curr_region_allocation_bytes_ *= 2;
   }
 
   LOGS_DEFAULT(INFO) << "Extended allocation by " << bytes
                      << " bytes.";
 
+  ++stats_.num_arena_extensions;
+
   stats_.total_allocated_bytes += bytes;
   LOGS_DEFAULT(INFO) << "Total allocated bytes: "
                      << stats_.total_allocated_bytes;
@@ -179,15 +227,169 @@ size_t BFCArena::RoundedBytes(size_t bytes) {
   return rounded_bytes;
 }
 
+std::unique_lock<OrtMutex> BFCArena::LockArena() {
+  std::unique_lock<OrtMutex> lock(lock_, std::try_to_lock);
+  if (!lock.owns_lock()) {
+    auto start = std::chrono::steady_clock::now();
+    lock.lock();
+    ++stats_.num_lock_contentions;
+    stats_.lock_wait_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                               std::chrono::steady_clock::now() - start)
+                               .count();
+  }
+  return lock;
+}
+
+// The thread caches of a thread by arena id. When the thread exits, the caches of the arenas that are still alive
+// are handed back to them, so their chunks return to the bins and the arenas stop tracking them.
+class BFCArena::ThreadCacheMap {
+ public:
+  struct Entry {
+    BFCArena* arena = nullptr;
+    ThreadCache* thread_cache = nullptr;
+  };
+
+  ~ThreadCacheMap() {
+    auto& live_arenas = GetLiveArenas();
+    // holding the mutex keeps the live arenas from being destroyed while their caches are released
+    std::lock_guard<OrtMutex> guard(live_arenas.mutex);
+    for (auto& entry : entries) {
+      if (live_arenas.ids.count(entry.first) != 0) {
+        entry.second.arena->ReleaseThreadCache(entry.second.thread_cache);
+      }
+    }
+  }
+
+  std::unordered_map<uint64_t, Entry> entries;
+  uint64_t pruned_destroyed_count = 0;
+};
+
+BFCArena::ThreadCache* BFCArena::GetThreadCache() {
+  // Most threads only ever use one arena, so remember the last lookup.
+  thread_local uint64_t last_arena_id = 0;
+  thread_local ThreadCache* last_thread_cache = nullptr;
+  thread_local ThreadCacheMap thread_caches;
+
+  if (last_arena_id != arena_id_) {
+    // Drop the entries of the arenas destroyed since the last pruning. Their caches have been freed with the arena,
+    // so the pointers are never dereferenced, but the map would otherwise grow with every arena the thread touched.
+    auto& live_arenas = GetLiveArenas();
+    const uint64_t destroyed_count = live_arenas.destroyed_count.load(std::memory_order_acquire);
+    if (destroyed_count != thread_caches.pruned_destroyed_count) {
+      std::lock_guard<OrtMutex> guard(live_arenas.mutex);
+      auto& entries = thread_caches.entries;
+      for (auto it = entries.begin(); it != entries.end();) {
+        if (live_arenas.ids.count(it->first) == 0) {
+          it = entries.erase(it);
+        } else {
+          ++it;
+        }
+      }
+      thread_caches.pruned_destroyed_count = destroyed_count;
+    }
+
+    auto& entry = thread_caches.entries[arena_id_];
+    if (entry.thread_cache == nullptr) {
+      auto lock = LockArena();
+      thread_caches_.push_back(onnxruntime::make_unique<ThreadCache>());
+      entry.arena = this;
+      entry.thread_cache = thread_caches_.back().get();
+    }
+
+    last_arena_id = arena_id_;
+    last_thread_cache = entry.thread_cache;
+  }
+
+  return last_thread_cache;
+}
+
+void BFCArena::ReleaseThreadCache(ThreadCache* thread_cache) {
+  auto lock = LockArena();
+  FlushThreadCacheLocked(*thread_cache, true);
+  // keep the hits of the cache in the stats
+  stats_.num_thread_cache_hits += thread_cache->hits;
+  auto it = std::find_if(thread_caches_.begin(), thread_caches_.end(),
+                         [thread_cache](const std::unique_ptr<ThreadCache>& entry) {
+                           return entry.get() == thread_cache;
+                         });
+  if (it != thread_caches_.end()) {
+    thread_caches_.erase(it);
+  }
+}
+
+void* BFCArena::TakeFromThreadCache(ThreadCache& thread_cache, size_t rounded_bytes) {
+  if (rounded_bytes > kMaxThreadCacheChunkSize) {
+    return nullptr;
+  }
+
+  std::lock_guard<OrtMutex> guard(thread_cache.mutex);
+  auto& chunks = thread_cache.free_chunks[ThreadCacheClass(rounded_bytes)];
+  if (chunks.empty()) {
+    return nullptr;
+  }
+
+  void* p = chunks.back();
+  chunks.pop_back();
+  thread_cache.cached_bytes -= rounded_bytes;
+  ++thread_cache.hits;
+  return p;
+}
+
+void BFCArena::FlushThreadCacheLocked(ThreadCache& thread_cache, bool release_cached_chunks) {
+  std::lock_guard<OrtMutex> guard(thread_cache.mutex);
+  for (void* p : thread_cache.pending_frees) {
+    if (reserved_chunks_.find(p) == reserved_chunks_.end()) {
+      ChunkHandle h = region_manager_.get_handle(p);
+      ORT_ENFORCE(h != kInvalidChunkHandle);
+      const Chunk* c = ChunkFromHandle(h);
+      if (!release_cached_chunks && c->size <= kMaxThreadCacheChunkSize &&
+          thread_cache.cached_bytes + c->size <= kMaxThreadCacheBytes) {
+        thread_cache.free_chunks[ThreadCacheClass(c->size)].push_back(p);
+        thread_cache.cached_bytes += c->size;
+        continue;
+      }
+    }
+
+    FreeLocked(p);
+  }
+  thread_cache.pending_frees.clear();
+
+  if (release_cached_chunks) {
+    for (auto& chunks : thread_cache.free_chunks) {
+      for (void* p : chunks) {
+        DeallocateRawInternal(p);
+      }
+      chunks.clear();
+    }
+    thread_cache.cached_bytes = 0;
+  }
+}
+
+void BFCArena::DrainThreadCachesLocked() {
+  for (auto& thread_cache : thread_caches_) {
+    FlushThreadCacheLocked(*thread_cache, true);
+  }
+}
+
 void* BFCArena::Alloc(size_t size) {
-  return AllocateRawInternal(size, false);
+  if (!enable_thread_cache_ || size == 0) {
+    return AllocateRawInternal(size, false, nullptr);
+  }
+
+  ThreadCache* thread_cache = GetThreadCache();
+  void* p = TakeFromThreadCache(*thread_cache, RoundedBytes(size));
+  if (p != nullptr) {
+    return p;
+  }
+
+  return AllocateRawInternal(size, false, thread_cache);
 }
 
 void* BFCArena::Reserve(size_t size) {
   if (size == 0)
     return nullptr;
 
-  std::lock_guard<OrtMutex> lock(lock_);
+  auto lock = LockArena();
   void* ptr = device_allocator_->Alloc(size);
   ORT_ENFORCE(reserved_chunks_.find(ptr) == reserved_chunks_.end());
   reserved_chunks_.insert(std::pair<void*, size_t>(ptr, size));
@@ -216,7 +418,8 @@ size_t BFCArena::AllocatedSize(const void* ptr) {
 }
 
 void* BFCArena::AllocateRawInternal(size_t num_bytes,
-                                    bool dump_log_on_failure) {
+                                    bool dump_log_on_failure,
+                                    ThreadCache* thread_cache) {
   if (num_bytes == 0) {
     LOGS_DEFAULT(VERBOSE) << "tried to allocate 0 bytes";
     return nullptr;
@@ -229,12 +432,32 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
   // The BFC allocator tries to find the best fit first.
   BinNum bin_num = BinNumForSize(rounded_bytes);
 
-  std::lock_guard<OrtMutex> lock(lock_);
+  auto lock = LockArena();
+
+  // We hold the lock anyway, so return the frees this thread has queued first.
+  // They may contain a chunk of the requested size.
+  if (thread_cache != nullptr) {
+    FlushThreadCacheLocked(*thread_cache, false);
+    void* p = TakeFromThreadCache(*thread_cache, rounded_bytes);
+    if (p != nullptr) {
+      return p;
+    }
+  }
+
   void* ptr = FindChunkPtr(bin_num, rounded_bytes, num_bytes);
   if (ptr != nullptr) {
     return ptr;
   }
 
+  // Memory held in thread caches may be enough to avoid growing the arena.
+  if (enable_thread_cache_) {
+    DrainThreadCachesLocked();
+    ptr = FindChunkPtr(bin_num, rounded_bytes, num_bytes);
+    if (ptr != nullptr) {
+      return ptr;
+    }
+  }
+
   LOGS_DEFAULT(INFO) << "Extending BFCArena for " << device_allocator_->Info().name
                      << ". bin_num:" << bin_num << " rounded_bytes:" << rounded_bytes;
 
@@ -260,8 +483,58 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
 }
 
 void BFCArena::GetStats(AllocatorStats* stats) {
-  std::lock_guard<OrtMutex> lock(lock_);
+  auto lock = LockArena();
   *stats = stats_;
+
+  // Cached chunks are in use as far as the bins are concerned.
+  for (auto& thread_cache : thread_caches_) {
+    FlushThreadCacheLocked(*thread_cache, false);
+    std::lock_guard<OrtMutex> guard(thread_cache->mutex);
+    stats->bytes_in_thread_caches += static_cast<int64_t>(thread_cache->cached_bytes);
+    stats->num_thread_cache_hits += thread_cache->hits;
+  }
+  stats->bytes_in_use -= stats->bytes_in_thread_caches;
+  stats->num_allocs += stats->num_thread_cache_hits;
+
+  for (BinNum b = 0; b < kNumBins; b++) {
+    for (ChunkHandle h : BinFromIndex(b)->free_chunks) {
+      auto size = static_cast<int64_t>(ChunkFromHandle(h)->size);
+      stats->free_bytes += size;
+      stats->largest_free_block = std::max(stats->largest_free_block, size);
+    }
+  }
+}
+
+Status BFCArena::Shrink() {
+  auto lock = LockArena();
+  DrainThreadCachesLocked();
+
+  // A region is unused when it has been coalesced back into a single free chunk.
+  std::vector<void*> unused_regions;
+  for (const auto& region : region_manager_.regions()) {
+    ChunkHandle h = region_manager_.get_handle(region.ptr());
+    const Chunk* c = ChunkFromHandle(h);
+    if (!c->in_use() && c->size == region.memory_size()) {
+      unused_regions.push_back(region.ptr());
+    }
+  }
+
+  for (void* ptr : unused_regions) {
+    ChunkHandle h = region_manager_.get_handle(ptr);
+    size_t bytes = ChunkFromHandle(h)->size;
+    RemoveFreeChunkFromBin(h);
+    DeleteChunk(h);
+    region_manager_.RemoveAllocationRegion(ptr);
+    device_allocator_->Free(ptr);
+    stats_.total_allocated_bytes -= static_cast<int64_t>(bytes);
+  }
+
+  if (!unused_regions.empty()) {
+    LOGS_DEFAULT(INFO) << "Released " << unused_regions.size() << " regions. Total allocated bytes: "
+                       << stats_.total_allocated_bytes;
+  }
+
+  return Status::OK();
 }
 
 void* BFCArena::FindChunkPtr(BinNum bin_num, size_t rounded_bytes,
@@ -351,7 +624,27 @@ void BFCArena::Free(void* p) {
   if (p == nullptr) {
     return;
   }
-  std::lock_guard<OrtMutex> lock(lock_);
+
+  if (enable_thread_cache_) {
+    ThreadCache* thread_cache = GetThreadCache();
+    {
+      std::lock_guard<OrtMutex> guard(thread_cache->mutex);
+      thread_cache->pending_frees.push_back(p);
+      if (thread_cache->pending_frees.size() < kThreadCacheFreeBatch) {
+        return;
+      }
+    }
+
+    auto lock = LockArena();
+    FlushThreadCacheLocked(*thread_cache, false);
+    return;
+  }
+
+  auto lock = LockArena();
+  FreeLocked(p);
+}
+
+void BFCArena::FreeLocked(void* p) {
   auto it = reserved_chunks_.find(p);
   if (it != reserved_chunks_.end()) {
     device_allocator_->Free(it->first);
@@ -19,6 +19,7 @@ limitations under the License.
 #include <memory>
 #include <mutex>
 #include <sstream>
+#include <vector>
 
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
@@ -46,9 +47,21 @@ namespace onnxruntime {
 // coalescing.  One assumption we make is that the process using this
 // allocator owns pretty much all of the memory, and that nearly
 // all requests to allocate memory go through this interface.
+//
+// If enable_thread_cache is set, small chunks freed by a thread are kept in a
+// cache owned by that thread and handed back to its next allocations of the
+// same size without taking the arena lock. Frees are queued per thread and
+// returned to the arena in batches. The caches are drained back into the bins
+// before the arena is extended.
+//
+// By default each new region is twice the size of the previous one. With
+// ORT_ARENA_EXTEND_SAME_AS_REQUESTED a region is only as large as the request
+// that triggered it, which caps growth at the cost of more regions.
 class BFCArena : public IArenaAllocator {
  public:
-  BFCArena(std::unique_ptr<IDeviceAllocator> resource_allocator, size_t total_memory);
+  BFCArena(std::unique_ptr<IDeviceAllocator> resource_allocator, size_t total_memory,
+           bool enable_thread_cache = false,
+           OrtArenaExtendStrategy extend_strategy = ORT_ARENA_EXTEND_NEXT_POWER_OF_TWO);
 
   ~BFCArena() override;
 
@@ -79,16 +92,30 @@ class BFCArena : public IArenaAllocator {
     return device_allocator_->CreateFence(session_state);
   }
 
-  void GetStats(AllocatorStats* stats);
+  void GetStats(AllocatorStats* stats) override;
+
+  // Returns every region that has no chunk in use to the device allocator,
+  // after draining the thread caches.
+  Status Shrink() override;
 
+  // When the thread cache is enabled, the requested size of a chunk reused from a
+  // thread cache is the size of the allocation the chunk was first created for.
   size_t RequestedSize(const void* ptr);
 
   size_t AllocatedSize(const void* ptr);
 
  private:
-  void* AllocateRawInternal(size_t num_bytes, bool dump_log_on_failure);
+  struct ThreadCache;
+
+  void* AllocateRawInternal(size_t num_bytes, bool dump_log_on_failure, ThreadCache* thread_cache);
   void DeallocateRawInternal(void* ptr);
 
+  // Frees a chunk returned by Alloc or Reserve. Requires lock_.
+  void FreeLocked(void* p);
+
+  // Acquires lock_, recording contention in stats_.
+  std::unique_lock<OrtMutex> LockArena();
+
   // A ChunkHandle is an index into the chunks_ vector in BFCAllocator
   // kInvalidChunkHandle means an invalid chunk
   using ChunkHandle = size_t;
@@ -185,6 +212,53 @@ class BFCArena : public IArenaAllocator {
   static const size_t kMinAllocationBits = 8;
   static const size_t kMinAllocationSize = 1 << kMinAllocationBits;
 
+  // Chunks up to kMaxThreadCacheChunkSize are kept in thread caches, with one
+  // free list per multiple of kMinAllocationSize.
+  static const size_t kMaxThreadCacheChunkSize = 32 << 10;
+  static const size_t kNumThreadCacheClasses = kMaxThreadCacheChunkSize / kMinAllocationSize;
+  // Upper bound of the bytes held by a single thread cache.
+  static const size_t kMaxThreadCacheBytes = 4 << 20;
+  // Number of queued frees after which they are returned to the arena.
+  static const size_t kThreadCacheFreeBatch = 32;
+
+  // Per-thread front-end of the arena. Only the owning thread uses it, except
+  // when the arena drains all caches, so its mutex is practically never contended.
+  // Cached chunks stay marked in use in the arena. The cache is handed back to
+  // the arena when its thread exits.
+  struct ThreadCache {
+    OrtMutex mutex;
+    std::vector<void*> pending_frees;
+    std::array<std::vector<void*>, kNumThreadCacheClasses> free_chunks;
+    size_t cached_bytes = 0;
+    int64_t hits = 0;
+  };
+
+  static size_t ThreadCacheClass(size_t rounded_bytes) {
+    return rounded_bytes / kMinAllocationSize - 1;
+  }
+
+  class ThreadCacheMap;
+
+  // Returns the calling thread's cache, creating it on first use. The entries of
+  // destroyed arenas are dropped from the thread's map on the next lookup that
+  // misses the last used arena.
+  ThreadCache* GetThreadCache();
+
+  // Returns the chunks of 'thread_cache' to the bins and removes it from the arena.
+  // Called when the thread owning the cache exits.
+  void ReleaseThreadCache(ThreadCache* thread_cache);
+
+  // Pops a cached chunk of exactly 'rounded_bytes' bytes, or returns nullptr.
+  void* TakeFromThreadCache(ThreadCache& thread_cache, size_t rounded_bytes);
+
+  // Returns the queued frees of 'thread_cache' to the arena, keeping small chunks
+  // in the cache unless 'release_cached_chunks' is set, in which case every cached
+  // chunk is returned too. Requires lock_.
+  void FlushThreadCacheLocked(ThreadCache& thread_cache, bool release_cached_chunks);
+
+  // Returns every thread cache to the bins. Requires lock_.
+  void DrainThreadCachesLocked();
+
   // AllocationRegion maps pointers to ChunkHandles for a single
   // contiguous memory region.
   //
@@ -271,6 +345,13 @@ class BFCArena : public IArenaAllocator {
       regions_.insert(entry, AllocationRegion(ptr, memory_size));
     }
 
+    void RemoveAllocationRegion(void* ptr) {
+      auto entry =
+          std::upper_bound(regions_.begin(), regions_.end(), ptr, &Comparator);
+      ORT_ENFORCE(entry != regions_.end() && entry->ptr() == ptr, "Could not find Region for ", ptr);
+      regions_.erase(entry);
+    }
+
     ChunkHandle get_handle(const void* p) const {
       return RegionFor(p)->get_handle(p);
     }
@@ -441,6 +522,14 @@ class BFCArena : public IArenaAllocator {
 
   std::unordered_map<void*, size_t> reserved_chunks_;
 
+  const bool enable_thread_cache_;
+  const OrtArenaExtendStrategy extend_strategy_;
+  // Unique for the lifetime of the process, used to find this arena's cache in
+  // thread local storage. Ids are never reused so a destroyed arena's cache is
+  // never looked up again, and its entry is pruned from the thread local maps.
+  const uint64_t arena_id_;
+  std::vector<std::unique_ptr<ThreadCache>> thread_caches_;
+
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(BFCArena);
 };
 #ifdef __GNUC__
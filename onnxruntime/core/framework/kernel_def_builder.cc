@@ -2,6 +2,8 @@
 // Licensed under the MIT License.
 
 #include "core/framework/kernel_def_builder.h"
+#include <algorithm>
+#include <map>
 #include <unordered_set>
 #include <string>
 
@@ -22,8 +24,74 @@ inline bool AreVectorsOverlap(const std::vector<T>& v1, const std::vector<T>& v2
   }
   return false;
 }
+
+// 64-bit FNV-1a. std::hash is not guaranteed to give the same result in different processes.
+inline void HashCombine(uint64_t& hash, const void* data, size_t len) {
+  const auto* bytes = static_cast<const unsigned char*>(data);
+  for (size_t i = 0; i < len; ++i) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ULL;
+  }
+}
+
+inline void HashCombine(uint64_t& hash, const std::string& str) {
+  HashCombine(hash, str.data(), str.size() + 1);
+}
+
+inline void HashCombine(uint64_t& hash, int64_t value) {
+  HashCombine(hash, &value, sizeof(value));
+}
 }  // namespace
 
+uint64_t KernelDef::GetHash() const {
+  uint64_t hash = 14695981039346656037ULL;
+  HashCombine(hash, op_name_);
+  HashCombine(hash, op_domain_);
+  HashCombine(hash, provider_type_);
+  HashCombine(hash, op_since_version_start_);
+  HashCombine(hash, op_since_version_end_);
+
+  // type_constraints_ is unordered
+  std::map<std::string, std::vector<std::string>> type_constraints;
+  for (const auto& constraint : type_constraints_) {
+    auto& types = type_constraints[constraint.first];
+    for (MLDataType type : constraint.second) {
+      types.push_back(DataTypeImpl::ToString(type));
+    }
+    std::sort(types.begin(), types.end());
+  }
+  for (const auto& constraint : type_constraints) {
+    HashCombine(hash, constraint.first);
+    for (const auto& type : constraint.second) {
+      HashCombine(hash, type);
+    }
+  }
+
+  for (const auto& inplace : inplace_map_) {
+    HashCombine(hash, inplace.first);
+    HashCombine(hash, inplace.second);
+  }
+  HashCombine(hash, -1);
+  for (const auto& alias : alias_map_) {
+    HashCombine(hash, alias.first);
+    HashCombine(hash, alias.second);
+  }
+  HashCombine(hash, -1);
+  for (const auto& mem_type : input_memory_type_args_) {
+    HashCombine(hash, static_cast<int64_t>(mem_type.first));
+    HashCombine(hash, mem_type.second);
+  }
+  HashCombine(hash, -1);
+  for (const auto& mem_type : output_memory_type_args_) {
+    HashCombine(hash, static_cast<int64_t>(mem_type.first));
+    HashCombine(hash, mem_type.second);
+  }
+  HashCombine(hash, exec_queue_id_);
+  HashCombine(hash, default_inputs_mem_type_);
+  HashCombine(hash, default_outputs_mem_type_);
+  return hash;
+}
+
 //TODO: Tell user why it has conflicts
 bool KernelDef::IsConflict(const KernelDef& other) const {
   if (op_name_ != other.OpName() || provider_type_ != other.Provider())
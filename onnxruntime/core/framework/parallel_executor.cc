@@ -3,6 +3,7 @@
 
 #include "core/framework/parallel_executor.h"
 
+#include <algorithm>
 #include <chrono>
 #include <memory>
 #include <thread>
@@ -19,12 +20,16 @@
 namespace onnxruntime {
 
 ParallelExecutor::ParallelExecutor(const SessionState& session_state, const bool& terminate_flag)
-    : out_standings_(0), terminate_flag_(terminate_flag), executor_pool_(session_state.GetInterOpThreadPool()) {
+    : terminate_flag_(terminate_flag), executor_pool_(session_state.GetInterOpThreadPool()) {
   auto graph_viewer = session_state.GetGraphViewer();
-  node_refs_.resize(graph_viewer->MaxNodeIndex());
+  node_refs_ = onnxruntime::make_unique<std::atomic<int>[]>(graph_viewer->MaxNodeIndex());
   for (auto& node : graph_viewer->Nodes()) {
-    node_refs_[node.Index()] = node.GetInputEdgesCount();
+    node_refs_[node.Index()].store(static_cast<int>(node.GetInputEdgesCount()), std::memory_order_relaxed);
   }
+
+  max_workers_ = std::max(executor_pool_->NumThreads(), 1);
+  num_ready_queues_ = max_workers_ + 1;
+  ready_queues_ = onnxruntime::make_unique<ReadyQueue[]>(num_ready_queues_);
 }
 
 Status ParallelExecutor::Execute(const SessionState& session_state, const std::vector<int>& feed_mlvalue_idxs,
@@ -40,20 +45,27 @@ Status ParallelExecutor::Execute(const SessionState& session_state, const std::v
 
   root_frame_ = onnxruntime::make_unique<ExecutionFrame>(feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetches,
                                                  fetch_allocators, session_state);
-  //std::cout << "start nodes:" << std::endl;
+  const SequentialExecutionPlan& exec_plan = *session_state.GetExecutionPlan();
+  std::vector<size_t> root_nodes;
   for (auto node_index : session_state.GetGraphViewer()->GetRootNodes()) {
     auto p_op_kernel = session_state.GetKernel(node_index);
     if (!p_op_kernel)
       continue;
 
-    //std::cout << "\t" << p_op_kernel->Node().Name() << std::endl;
-    EnqueueNode(node_index, session_state, logger);
+    root_nodes.push_back(node_index);
   }
 
-  // Wait for finish.
+  // Ready queues are popped from the back, so put the nodes on the longest path last.
+  std::stable_sort(root_nodes.begin(), root_nodes.end(), [&exec_plan](size_t lhs, size_t rhs) {
+    return exec_plan.NodePriority(lhs) < exec_plan.NodePriority(rhs);
+  });
+  EnqueueNodes(root_nodes, session_state, logger);
+
+  // Wait for finish. Workers only exit once no ready node is left, so all of them having exited means
+  // every node that could run has run.
   {
     std::unique_lock<OrtMutex> lock(complete_mutex_);
-    while (out_standings_ > 0) complete_cv_.wait(lock);
+    while (active_workers_ > 0) complete_cv_.wait(lock);
   }
 
   Status status = Status::OK();
@@ -96,7 +108,8 @@ Status ParallelExecutor::Execute(const SessionState& session_state, const std::v
     if (all_tensors) {
       auto mem_patterns = onnxruntime::make_unique<MemoryPatternGroup>();
       ORT_RETURN_IF_ERROR(root_frame_->GeneratePatterns(mem_patterns.get()));
-      ORT_RETURN_IF_ERROR(session_state.UpdateMemoryPatternGroupCache(input_shapes, std::move(mem_patterns)));
+      ORT_RETURN_IF_ERROR(session_state.UpdateMemoryPatternGroupCache(input_shapes, feed_mlvalue_idxs,
+                                                                       std::move(mem_patterns)));
     }
   }
 
@@ -121,6 +134,7 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
   TimePoint kernel_begin_time;
   const bool f_profiler_enabled = session_state.Profiler().IsEnabled();
   const SequentialExecutionPlan& exec_plan = *session_state.GetExecutionPlan();
+  std::vector<size_t> ready_nodes;
 
   // Avoid context switching if possible.
   while (keep_running) {
@@ -250,45 +264,121 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
     keep_running = false;
 
     // Checking which output nodes ready for running.
-    {
-      auto begin = node.OutputEdgesBegin();
-      auto end = node.OutputEdgesEnd();
-
-      std::lock_guard<OrtMutex> lock(ref_mutex_);
-      for (auto it = begin; it != end; it++) {
-        auto idx = (*it).GetNode().Index();
-        if ((--node_refs_[idx]) == 0) {
-          if (!keep_running) {
-            node_index = idx;
-            keep_running = true;
-          } else {
-            EnqueueNode(idx, session_state, logger);
-          }
-        }
-
-        // std::cout << "handle output, current name: " << node.Name() << ", current index: "
-        // << p_node_index << ", output name: " << (*it)->GetNode().Name() << ", output index: "
-        // << (*it)->GetNode().Index() << ", after -- output ref: " << node_refs_[idx] << std::endl;
+    // The successor on the longest path keeps running on this thread, the others are queued.
+    ready_nodes.clear();
+    for (auto it = node.OutputEdgesBegin(), end = node.OutputEdgesEnd(); it != end; ++it) {
+      auto idx = (*it).GetNode().Index();
+      if (node_refs_[idx].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        ready_nodes.push_back(idx);
       }
     }
+
+    if (!ready_nodes.empty() && !has_errors_) {
+      std::stable_sort(ready_nodes.begin(), ready_nodes.end(), [&exec_plan](size_t lhs, size_t rhs) {
+        return exec_plan.NodePriority(lhs) < exec_plan.NodePriority(rhs);
+      });
+      node_index = ready_nodes.back();
+      keep_running = true;
+      ready_nodes.pop_back();
+      EnqueueNodes(ready_nodes, session_state, logger);
+    }
   }
 
   return status;
 }
 
-void ParallelExecutor::EnqueueNode(size_t p_node_index, const SessionState& session_state, const logging::Logger& logger) {
+ParallelExecutor::ReadyQueue& ParallelExecutor::CurrentReadyQueue() {
+  int thread_id = executor_pool_->CurrentThreadId();
+  return (thread_id >= 0 && thread_id < max_workers_) ? ready_queues_[thread_id] : ready_queues_[max_workers_];
+}
+
+bool ParallelExecutor::TryPopNode(size_t& node_index) {
+  if (ready_nodes_.load(std::memory_order_acquire) == 0)
+    return false;
+
+  int thread_id = executor_pool_->CurrentThreadId();
+  int own = (thread_id >= 0 && thread_id < max_workers_) ? thread_id : max_workers_;
+
+  // The own queue and the shared queue are popped from the back, the queues of the other workers from the front.
+  for (int i = 0; i < num_ready_queues_; ++i) {
+    int queue_index = (own + i) % num_ready_queues_;
+    ReadyQueue& queue = ready_queues_[queue_index];
+    std::lock_guard<OrtMutex> lock(queue.mutex);
+    if (queue.nodes.empty())
+      continue;
+
+    if (queue_index == own || queue_index == max_workers_) {
+      node_index = queue.nodes.back();
+      queue.nodes.pop_back();
+    } else {
+      node_index = queue.nodes.front();
+      queue.nodes.pop_front();
+    }
+    ready_nodes_.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+  }
+
+  return false;
+}
+
+void ParallelExecutor::EnqueueNodes(const std::vector<size_t>& node_indices, const SessionState& session_state,
+                                    const logging::Logger& logger) {
+  if (node_indices.empty())
+    return;
+
+  // if there are errors there's no point queuing more work
+  if (has_errors_)
+    return;
+
+  const int count = static_cast<int>(node_indices.size());
+  ready_nodes_.fetch_add(count, std::memory_order_acq_rel);
   {
-    std::unique_lock<OrtMutex> lock(complete_mutex_);
-    // if there are errors there's no point queuing more work
-    if (!errors_.empty())
-      return;
+    ReadyQueue& queue = CurrentReadyQueue();
+    std::lock_guard<OrtMutex> lock(queue.mutex);
+    queue.nodes.insert(queue.nodes.end(), node_indices.begin(), node_indices.end());
+  }
+
+  // The current worker, if any, will get to one of these nodes itself.
+  int idle_workers = max_workers_ - active_workers_.load(std::memory_order_acquire);
+  StartWorkers(std::min(idle_workers, count), session_state, logger);
+}
 
-    out_standings_++;
+void ParallelExecutor::StartWorkers(int count, const SessionState& session_state, const logging::Logger& logger) {
+  for (int i = 0; i < count; ++i) {
+    // reserve a worker slot, giving up if all workers are already running
+    int active = active_workers_.load(std::memory_order_acquire);
+    do {
+      if (active >= max_workers_)
+        return;
+    } while (!active_workers_.compare_exchange_weak(active, active + 1, std::memory_order_acq_rel));
+
+    executor_pool_->Schedule([this, &session_state, &logger]() {
+      RunWorker(session_state, logger);
+    });
   }
+}
+
+void ParallelExecutor::RunWorker(const SessionState& session_state, const logging::Logger& logger) {
+  // number of extra attempts to find a ready node before the worker returns its thread to the pool
+  constexpr int kStealAttempts = 16;
+
+  size_t node_index = 0;
+  for (;;) {
+    bool found = TryPopNode(node_index);
+    for (int attempt = 0; !found && attempt < kStealAttempts; ++attempt) {
+      std::this_thread::yield();
+      found = TryPopNode(node_index);
+    }
+
+    if (!found)
+      break;
+
+    // drain the queues without running anything once a node has failed
+    if (has_errors_)
+      continue;
 
-  executor_pool_->Schedule([this, p_node_index, &session_state, &logger]() {
-    auto create_exception_message = [p_node_index, &session_state](const std::exception* ex) {
-      const auto* node = session_state.GetGraphViewer()->GetNode(p_node_index);
+    auto create_exception_message = [node_index, &session_state](const std::exception* ex) {
+      const auto* node = session_state.GetGraphViewer()->GetNode(node_index);
 
       return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exception running nodes starting at ", node->OpType(),
                              " node '", node->Name(), "'. ",
@@ -297,7 +387,7 @@ void ParallelExecutor::EnqueueNode(size_t p_node_index, const SessionState& sess
 
     Status status;
     try {
-      status = ParallelExecutor::RunNodeAsync(p_node_index, std::cref(session_state), std::cref(logger));
+      status = ParallelExecutor::RunNodeAsync(node_index, std::cref(session_state), std::cref(logger));
     } catch (const std::exception& ex) {
       status = create_exception_message(&ex);
     } catch (...) {
@@ -306,6 +396,17 @@ void ParallelExecutor::EnqueueNode(size_t p_node_index, const SessionState& sess
     }
 
     FinishNodeRun(status);
-  });
+  }
+
+  bool finished = false;
+  {
+    //Because we have a mutex here, it's not possible another thread is doing the test("while (active_workers_ > 0)"
+    std::lock_guard<OrtMutex> lock(complete_mutex_);
+    finished = active_workers_.fetch_sub(1, std::memory_order_acq_rel) == 1;
+  }
+
+  if (finished) {
+    complete_cv_.notify_all();
+  }
 }
 }  // namespace onnxruntime
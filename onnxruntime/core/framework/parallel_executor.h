@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <deque>
 #include <vector>
 #include "core/common/common.h"
 #include "core/common/status.h"
@@ -31,32 +33,51 @@ class ParallelExecutor : public IExecutor {
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ParallelExecutor);
 
+  // Ready nodes owned by one worker. The owner pushes and pops at the back, so it keeps running the
+  // successors of the node it just finished while their inputs are cache hot. Idle workers steal from the front.
+  struct ReadyQueue {
+    OrtMutex mutex;
+    std::deque<size_t> nodes;
+  };
+
   Status RunNodeAsync(size_t p_node_index, const SessionState& session_state, const logging::Logger& logger);
 
-  void EnqueueNode(size_t p_node_index, const SessionState& session_state, const logging::Logger& logger);
+  // Worker loop: runs nodes from the queue of the current pool thread, stealing from the other queues
+  // when it is empty, and returns once no ready node is left anywhere.
+  void RunWorker(const SessionState& session_state, const logging::Logger& logger);
 
-  void FinishNodeRun(const Status& status) {
-    bool finished = false;
-    {
-      //Because we have a mutex here, it's not possible another thread is doing the test("while (out_standings_ > 0)"
-      std::lock_guard<OrtMutex> lock(complete_mutex_);
-      finished = --out_standings_ == 0;
-      if (!status.IsOK())
-        errors_.push_back(status);
-    }
+  // Makes ready nodes available to other workers, starting more workers if some are idle.
+  void EnqueueNodes(const std::vector<size_t>& node_indices, const SessionState& session_state,
+                    const logging::Logger& logger);
+
+  void StartWorkers(int count, const SessionState& session_state, const logging::Logger& logger);
+
+  bool TryPopNode(size_t& node_index);
 
-    if (finished) {
-      //std::cout << "all out standing nodes are completed." << std::endl;
-      complete_cv_.notify_all();
+  ReadyQueue& CurrentReadyQueue();
+
+  void FinishNodeRun(const Status& status) {
+    if (!status.IsOK()) {
+      std::lock_guard<OrtMutex> lock(error_mutex_);
+      errors_.push_back(status);
+      has_errors_ = true;
     }
   }
 
   std::unique_ptr<ExecutionFrame> root_frame_;
-  std::vector<size_t> node_refs_;
-  OrtMutex ref_mutex_;
-  int out_standings_;  //protected by complete_mutex_
+  std::unique_ptr<std::atomic<int>[]> node_refs_;
+
+  // One queue per inter-op pool thread plus a shared one for nodes made ready outside of the pool.
+  std::unique_ptr<ReadyQueue[]> ready_queues_;
+  int num_ready_queues_;
+  int max_workers_;
+  std::atomic<int> ready_nodes_{0};     // number of nodes sitting in the ready queues
+  std::atomic<int> active_workers_{0};  // decremented to zero under complete_mutex_
   OrtMutex complete_mutex_;
   OrtCondVar complete_cv_;
+
+  OrtMutex error_mutex_;
+  std::atomic<bool> has_errors_{false};
   std::vector<Status> errors_;
 
   const bool& terminate_flag_;
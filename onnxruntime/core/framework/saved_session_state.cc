@@ -0,0 +1,633 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/saved_session_state.h"
+
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+
+#include "core/framework/endian.h"
+#include "core/framework/execution_providers.h"
+#include "core/framework/mem_pattern.h"
+#include "core/framework/mldata_type_utils.h"
+#include "core/framework/op_kernel.h"
+#include "core/framework/ort_value_name_idx_map.h"
+#include "core/framework/sequential_execution_plan.h"
+#include "core/framework/session_state.h"
+#include "core/graph/graph_viewer.h"
+#include "core/platform/env.h"
+
+namespace onnxruntime {
+
+// "ORTSTATE" followed by the format version.
+static constexpr char kMagic[8] = {'O', 'R', 'T', 'S', 'T', 'A', 'T', 'E'};
+static constexpr uint32_t kFormatVersion = 1;
+
+// Values are written in the native byte order, which must be little endian.
+class SavedSessionState::Writer {
+ public:
+  template <typename T>
+  void Write(T value) {
+    static_assert(std::is_arithmetic<T>::value, "Only arithmetic types can be written directly");
+    buffer_.append(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  void Write(const std::string& str) {
+    Write<uint64_t>(str.size());
+    buffer_.append(str);
+  }
+
+  void Write(const std::vector<int64_t>& values) {
+    Write<uint64_t>(values.size());
+    for (auto value : values) {
+      Write(value);
+    }
+  }
+
+  void WriteRaw(const char* data, size_t len) { buffer_.append(data, len); }
+
+  const std::string& Buffer() const { return buffer_; }
+
+ private:
+  std::string buffer_;
+};
+
+// All reads fail once the end of the buffer has been reached.
+class SavedSessionState::Reader {
+ public:
+  Reader(const char* data, size_t len) : data_(data), len_(len) {}
+
+  template <typename T>
+  bool Read(T& value) {
+    static_assert(std::is_arithmetic<T>::value, "Only arithmetic types can be read directly");
+    if (len_ - pos_ < sizeof(T)) {
+      return false;
+    }
+    memcpy(&value, data_ + pos_, sizeof(T));
+    pos_ += sizeof(T);
+    return true;
+  }
+
+  bool Read(bool& value) {
+    uint8_t byte = 0;
+    if (!Read(byte)) {
+      return false;
+    }
+    value = byte != 0;
+    return true;
+  }
+
+  bool Read(std::string& str) {
+    uint64_t size = 0;
+    if (!Read(size) || len_ - pos_ < size) {
+      return false;
+    }
+    str.assign(data_ + pos_, static_cast<size_t>(size));
+    pos_ += static_cast<size_t>(size);
+    return true;
+  }
+
+  bool Read(std::vector<int64_t>& values) {
+    uint64_t size = 0;
+    if (!ReadCount(size, sizeof(int64_t))) {
+      return false;
+    }
+    values.resize(static_cast<size_t>(size));
+    for (auto& value : values) {
+      if (!Read(value)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Reads the number of elements of a sequence, rejecting counts that can't fit in the rest of the buffer
+  // so that a corrupted file can't trigger a huge allocation.
+  bool ReadCount(uint64_t& count, size_t min_element_size) {
+    return Read(count) && count <= (len_ - pos_) / min_element_size;
+  }
+
+  bool ReadRaw(char* data, size_t len) {
+    if (len_ - pos_ < len) {
+      return false;
+    }
+    memcpy(data, data_ + pos_, len);
+    pos_ += len;
+    return true;
+  }
+
+  bool AtEnd() const { return pos_ == len_; }
+
+ private:
+  const char* data_;
+  size_t len_;
+  size_t pos_ = 0;
+};
+
+template <>
+void SavedSessionState::Writer::Write<bool>(bool value) {
+  Write<uint8_t>(value ? 1 : 0);
+}
+
+static common::Status InvalidFile(const PathString& path) {
+  return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The saved session state in ", ToMBString(path),
+                         " is truncated or corrupted.");
+}
+
+bool SavedSessionState::IsSavedSessionStateFile(const PathString& path) {
+  const Env& env = Env::Default();
+  size_t length = 0;
+  if (!env.GetFileLength(path.c_str(), length).IsOK() || length < sizeof(kMagic)) {
+    return false;
+  }
+
+  char magic[sizeof(kMagic)];
+  if (!env.ReadFileIntoBuffer(path.c_str(), 0, sizeof(magic), gsl::make_span(magic, sizeof(magic))).IsOK()) {
+    return false;
+  }
+
+  return memcmp(magic, kMagic, sizeof(kMagic)) == 0;
+}
+
+SavedSessionState::Location SavedSessionState::ToLocation(const OrtMemoryInfo& info) {
+  Location location;
+  location.name = info.name;
+  location.id = info.id;
+  location.mem_type = static_cast<int32_t>(info.mem_type);
+  location.alloc_type = static_cast<int32_t>(info.alloc_type);
+  location.device_type = info.device.Type();
+  location.device_mem_type = info.device.MemType();
+  location.device_id = info.device.Id();
+  return location;
+}
+
+// OrtMemoryInfo only points to its name, so the name is taken from the allocators of the execution providers.
+common::Status SavedSessionState::FromLocation(const Location& location, const ExecutionProviders& providers,
+                                               OrtMemoryInfo& info) {
+  const char* name = nullptr;
+  for (const auto& provider : providers) {
+    for (const auto& allocator : provider->GetAllocators()) {
+      if (location.name == allocator->Info().name) {
+        name = allocator->Info().name;
+        break;
+      }
+    }
+    if (name != nullptr) {
+      break;
+    }
+  }
+
+  if (name == nullptr && location.name == CPU) {
+    name = CPU;
+  }
+
+  if (name == nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "No allocator named ", location.name,
+                           " is registered for the saved session state.");
+  }
+
+  info = OrtMemoryInfo(name, static_cast<OrtAllocatorType>(location.alloc_type),
+                       OrtDevice(static_cast<OrtDevice::DeviceType>(location.device_type),
+                                 static_cast<OrtDevice::MemoryType>(location.device_mem_type),
+                                 static_cast<OrtDevice::DeviceId>(location.device_id)),
+                       location.id, static_cast<OrtMemType>(location.mem_type));
+  return Status::OK();
+}
+
+void SavedSessionState::Write(Writer& writer, const Location& location) {
+  writer.Write(location.name);
+  writer.Write(location.id);
+  writer.Write(location.mem_type);
+  writer.Write(location.alloc_type);
+  writer.Write(location.device_type);
+  writer.Write(location.device_mem_type);
+  writer.Write(location.device_id);
+}
+
+bool SavedSessionState::Read(Reader& reader, Location& location) {
+  return reader.Read(location.name) &&
+         reader.Read(location.id) &&
+         reader.Read(location.mem_type) &&
+         reader.Read(location.alloc_type) &&
+         reader.Read(location.device_type) &&
+         reader.Read(location.device_mem_type) &&
+         reader.Read(location.device_id);
+}
+
+common::Status SavedSessionState::Save(const PathString& path, const ONNX_NAMESPACE::ModelProto& optimized_model,
+                                       const SessionState& session_state) {
+  if (endian::native != endian::little) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Saving the session state requires a little endian host.");
+  }
+
+  const GraphViewer* graph_viewer = session_state.GetGraphViewer();
+  const SequentialExecutionPlan* plan = session_state.GetExecutionPlan();
+  ORT_RETURN_IF_NOT(graph_viewer != nullptr && plan != nullptr, "The session state has not been initialized.");
+
+  // When the model is loaded again each node gets its position in the saved model as index. The nodes are matched
+  // to those positions by their outputs, as output names are unique within a graph.
+  const auto& model_nodes = optimized_model.graph().node();
+  std::unordered_map<std::string, size_t> output_positions;
+  for (int i = 0; i < model_nodes.size(); ++i) {
+    for (const auto& output : model_nodes.Get(i).output()) {
+      if (!output.empty()) {
+        output_positions[output] = static_cast<size_t>(i);
+      }
+    }
+  }
+
+  const auto& order = graph_viewer->GetNodesInTopologicalOrder();
+  if (static_cast<size_t>(model_nodes.size()) != order.size()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "The optimized model doesn't match the session state.");
+  }
+
+  std::vector<uint64_t> position(graph_viewer->MaxNodeIndex(), 0);
+  std::vector<bool> assigned(order.size(), false);
+  SavedSessionState state;
+  state.nodes_.resize(order.size());
+  for (auto node_index : order) {
+    const Node* node = graph_viewer->GetNode(node_index);
+    if (node->ContainsSubgraph() || node->NodeType() == Node::Type::Fused) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Node ", node->Name(), " (", node->OpType(),
+                             ") contains a subgraph or was compiled by an execution provider. "
+                             "Saving the session state of such graphs is not supported.");
+    }
+
+    auto entry = output_positions.end();
+    for (const auto* output : node->OutputDefs()) {
+      if (output->Exists()) {
+        entry = output_positions.find(output->Name());
+        break;
+      }
+    }
+
+    if (entry == output_positions.end() || assigned[entry->second] ||
+        node->OpType() != model_nodes.Get(static_cast<int>(entry->second)).op_type()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "The optimized model doesn't match the session state for node ",
+                             node->Name(), " (", node->OpType(), ").");
+    }
+
+    const OpKernel* kernel = session_state.GetKernel(node_index);
+    ORT_RETURN_IF_NOT(kernel != nullptr, "No kernel was created for node ", node->Name());
+
+    auto& info = state.nodes_[entry->second];
+    info.op_type = node->OpType();
+    info.provider = node->GetExecutionProviderType();
+    info.kernel_def_hash = kernel->KernelDef().GetHash();
+    info.has_fence = plan->NodeHasFence(node_index);
+    info.priority = plan->NodePriority(node_index);
+    position[node_index] = entry->second;
+    assigned[entry->second] = true;
+  }
+
+  const auto& ort_value_name_idx_map = session_state.GetOrtValueNameIdxMap();
+  std::vector<std::string> value_names(plan->allocation_plan.size());
+  for (const auto& entry : ort_value_name_idx_map) {
+    if (static_cast<size_t>(entry.second) < value_names.size()) {
+      value_names[entry.second] = entry.first;
+    }
+  }
+
+  state.values_.reserve(plan->allocation_plan.size());
+  for (size_t idx = 0; idx < plan->allocation_plan.size(); ++idx) {
+    const auto& value_plan = plan->allocation_plan[idx];
+    ValuePlan value;
+    value.name = value_names[idx];
+    value.alloc_kind = static_cast<int32_t>(value_plan.alloc_kind);
+    value.has_value_type = value_plan.value_type != nullptr;
+    value.location = ToLocation(value_plan.location);
+    if (value_plan.alloc_kind == AllocKind::kReuse || value_plan.alloc_kind == AllocKind::kShare) {
+      value.reused_buffer = value_names[value_plan.reused_buffer];
+    }
+    value.create_fence_if_async = value_plan.create_fence_if_async;
+    state.values_.push_back(std::move(value));
+  }
+
+  state.steps_.reserve(plan->execution_plan.size());
+  for (const auto& node_plan : plan->execution_plan) {
+    Step step;
+    step.node = position[node_plan.node_index];
+    for (int i = node_plan.free_from_index; i <= node_plan.free_to_index; ++i) {
+      step.values_to_free.push_back(value_names[plan->to_be_freed[i]]);
+    }
+    state.steps_.push_back(std::move(step));
+  }
+
+  for (const auto& entry : session_state.GetMemoryPatternCacheEntries()) {
+    PatternGroup group;
+    group.key = entry.key;
+    group.input_dims = entry.input_dims;
+    for (size_t i = 0; i < entry.patterns->locations.size(); ++i) {
+      const MemoryPattern& pattern = entry.patterns->patterns[i];
+      group.locations.push_back(ToLocation(entry.patterns->locations[i]));
+      group.peak_sizes.push_back(pattern.peak_size_);
+      std::vector<Block> blocks;
+      for (const auto& block : pattern.patterns_) {
+        blocks.push_back({value_names[block.first], block.second.offset_, block.second.size_});
+      }
+      group.blocks.push_back(std::move(blocks));
+    }
+    state.pattern_groups_.push_back(std::move(group));
+  }
+
+  Writer writer;
+  writer.WriteRaw(kMagic, sizeof(kMagic));
+  writer.Write(kFormatVersion);
+  writer.Write(optimized_model.SerializeAsString());
+
+  writer.Write<uint64_t>(state.nodes_.size());
+  for (const auto& node : state.nodes_) {
+    writer.Write(node.op_type);
+    writer.Write(node.provider);
+    writer.Write(node.kernel_def_hash);
+    writer.Write(node.has_fence);
+    writer.Write(node.priority);
+  }
+
+  writer.Write<uint64_t>(state.values_.size());
+  for (const auto& value : state.values_) {
+    writer.Write(value.name);
+    writer.Write(value.alloc_kind);
+    writer.Write(value.has_value_type);
+    Write(writer, value.location);
+    writer.Write(value.reused_buffer);
+    writer.Write(value.create_fence_if_async);
+  }
+
+  writer.Write<uint64_t>(state.steps_.size());
+  for (const auto& step : state.steps_) {
+    writer.Write(step.node);
+    writer.Write<uint64_t>(step.values_to_free.size());
+    for (const auto& name : step.values_to_free) {
+      writer.Write(name);
+    }
+  }
+
+  writer.Write<uint64_t>(state.pattern_groups_.size());
+  for (const auto& group : state.pattern_groups_) {
+    writer.Write(group.key);
+    writer.Write(group.input_dims);
+    writer.Write<uint64_t>(group.locations.size());
+    for (size_t i = 0; i < group.locations.size(); ++i) {
+      Write(writer, group.locations[i]);
+      writer.Write(group.peak_sizes[i]);
+      writer.Write<uint64_t>(group.blocks[i].size());
+      for (const auto& block : group.blocks[i]) {
+        writer.Write(block.value);
+        writer.Write(block.offset);
+        writer.Write(block.size);
+      }
+    }
+  }
+
+  std::ofstream out(path, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!out) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to open ", ToMBString(path), " for writing.");
+  }
+
+  const auto& buffer = writer.Buffer();
+  out.write(buffer.data(), buffer.size());
+  out.close();
+  if (!out) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to write the session state to ", ToMBString(path));
+  }
+
+  return Status::OK();
+}
+
+common::Status SavedSessionState::Load(const PathString& path, ONNX_NAMESPACE::ModelProto& optimized_model,
+                                       std::unique_ptr<SavedSessionState>& saved_state) {
+  if (endian::native != endian::little) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Loading a session state requires a little endian host.");
+  }
+
+  const Env& env = Env::Default();
+  size_t length = 0;
+  ORT_RETURN_IF_ERROR(env.GetFileLength(path.c_str(), length));
+  std::unique_ptr<char[]> buffer(new char[length]);
+  ORT_RETURN_IF_ERROR(env.ReadFileIntoBuffer(path.c_str(), 0, length, gsl::make_span(buffer.get(), length)));
+
+  Reader reader(buffer.get(), length);
+  char magic[sizeof(kMagic)];
+  uint32_t version = 0;
+  if (!reader.ReadRaw(magic, sizeof(magic)) || memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+      !reader.Read(version)) {
+    return InvalidFile(path);
+  }
+
+  if (version != kFormatVersion) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The saved session state in ", ToMBString(path),
+                           " has format version ", version, ". Version ", kFormatVersion, " is supported.");
+  }
+
+  std::string model_bytes;
+  if (!reader.Read(model_bytes)) {
+    return InvalidFile(path);
+  }
+
+  if (!optimized_model.ParseFromString(model_bytes)) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_PROTOBUF, "Failed to parse the model of the saved session state in ",
+                           ToMBString(path));
+  }
+
+  auto state = onnxruntime::make_unique<SavedSessionState>();
+  uint64_t count = 0;
+  if (!reader.ReadCount(count, 1)) {
+    return InvalidFile(path);
+  }
+  state->nodes_.resize(static_cast<size_t>(count));
+  for (auto& node : state->nodes_) {
+    if (!reader.Read(node.op_type) || !reader.Read(node.provider) || !reader.Read(node.kernel_def_hash) ||
+        !reader.Read(node.has_fence) || !reader.Read(node.priority)) {
+      return InvalidFile(path);
+    }
+  }
+
+  if (!reader.ReadCount(count, 1)) {
+    return InvalidFile(path);
+  }
+  state->values_.resize(static_cast<size_t>(count));
+  for (auto& value : state->values_) {
+    if (!reader.Read(value.name) || !reader.Read(value.alloc_kind) || !reader.Read(value.has_value_type) ||
+        !Read(reader, value.location) || !reader.Read(value.reused_buffer) ||
+        !reader.Read(value.create_fence_if_async)) {
+      return InvalidFile(path);
+    }
+  }
+
+  if (!reader.ReadCount(count, 1)) {
+    return InvalidFile(path);
+  }
+  state->steps_.resize(static_cast<size_t>(count));
+  for (auto& step : state->steps_) {
+    uint64_t num_values = 0;
+    if (!reader.Read(step.node) || !reader.ReadCount(num_values, 1)) {
+      return InvalidFile(path);
+    }
+    step.values_to_free.resize(static_cast<size_t>(num_values));
+    for (auto& name : step.values_to_free) {
+      if (!reader.Read(name)) {
+        return InvalidFile(path);
+      }
+    }
+  }
+
+  if (!reader.ReadCount(count, 1)) {
+    return InvalidFile(path);
+  }
+  state->pattern_groups_.resize(static_cast<size_t>(count));
+  for (auto& group : state->pattern_groups_) {
+    uint64_t num_locations = 0;
+    if (!reader.Read(group.key) || !reader.Read(group.input_dims) || !reader.ReadCount(num_locations, 1)) {
+      return InvalidFile(path);
+    }
+    group.locations.resize(static_cast<size_t>(num_locations));
+    group.peak_sizes.resize(static_cast<size_t>(num_locations));
+    group.blocks.resize(static_cast<size_t>(num_locations));
+    for (size_t i = 0; i < group.locations.size(); ++i) {
+      uint64_t num_blocks = 0;
+      if (!Read(reader, group.locations[i]) || !reader.Read(group.peak_sizes[i]) ||
+          !reader.ReadCount(num_blocks, 1)) {
+        return InvalidFile(path);
+      }
+      group.blocks[i].resize(static_cast<size_t>(num_blocks));
+      for (auto& block : group.blocks[i]) {
+        if (!reader.Read(block.value) || !reader.Read(block.offset) || !reader.Read(block.size)) {
+          return InvalidFile(path);
+        }
+      }
+    }
+  }
+
+  if (!reader.AtEnd()) {
+    return InvalidFile(path);
+  }
+
+  saved_state = std::move(state);
+  return Status::OK();
+}
+
+common::Status SavedSessionState::AssignNodes(Graph& graph, const ExecutionProviders& providers) const {
+  if (static_cast<size_t>(graph.NumberOfNodes()) != nodes_.size() ||
+      static_cast<size_t>(graph.MaxNodeIndex()) != nodes_.size()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "The graph doesn't match the saved session state.");
+  }
+
+  for (size_t i = 0; i < nodes_.size(); ++i) {
+    const Node* node = graph.GetNode(i);
+    if (node == nullptr || node->OpType() != nodes_[i].op_type) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "The graph doesn't match the saved session state.");
+    }
+
+    if (providers.Get(nodes_[i].provider) == nullptr) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "The session state was saved with execution provider ",
+                             nodes_[i].provider, " which is not registered.");
+    }
+  }
+
+  for (size_t i = 0; i < nodes_.size(); ++i) {
+    graph.GetNode(i)->SetExecutionProviderType(nodes_[i].provider);
+  }
+
+  return Status::OK();
+}
+
+common::Status SavedSessionState::RestoreExecutionPlan(const GraphViewer& graph_viewer,
+                                                       const OrtValueNameIdxMap& ort_value_name_idx_map,
+                                                       const ExecutionProviders& providers,
+                                                       std::unique_ptr<SequentialExecutionPlan>& plan) const {
+  auto restored = onnxruntime::make_unique<SequentialExecutionPlan>();
+  restored->allocation_plan.resize(ort_value_name_idx_map.MaxIdx() + 1);
+  if (restored->allocation_plan.size() != values_.size()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "The values of the graph don't match the saved session state.");
+  }
+
+  for (const auto& value : values_) {
+    int idx = 0;
+    ORT_RETURN_IF_ERROR(ort_value_name_idx_map.GetIdx(value.name, idx));
+    auto& value_plan = restored->allocation_plan[idx];
+    value_plan.alloc_kind = static_cast<AllocKind>(value.alloc_kind);
+    if (value.has_value_type) {
+      const NodeArg* node_arg = graph_viewer.GetNodeArg(value.name);
+      ORT_RETURN_IF_NOT(node_arg != nullptr, "No NodeArg found for saved value ", value.name);
+      value_plan.value_type = utils::GetMLDataType(*node_arg);
+    }
+    ORT_RETURN_IF_ERROR(FromLocation(value.location, providers, value_plan.location));
+    if (!value.reused_buffer.empty()) {
+      ORT_RETURN_IF_ERROR(ort_value_name_idx_map.GetIdx(value.reused_buffer, value_plan.reused_buffer));
+    }
+    value_plan.create_fence_if_async = value.create_fence_if_async;
+  }
+
+  restored->node_has_fence.resize(graph_viewer.MaxNodeIndex());
+  restored->node_priority.resize(graph_viewer.MaxNodeIndex());
+  if (restored->node_has_fence.size() != nodes_.size()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "The graph doesn't match the saved session state.");
+  }
+
+  for (size_t i = 0; i < nodes_.size(); ++i) {
+    restored->node_has_fence[i] = nodes_[i].has_fence;
+    restored->node_priority[i] = nodes_[i].priority;
+  }
+
+  restored->execution_plan.reserve(steps_.size());
+  for (const auto& step : steps_) {
+    ORT_RETURN_IF_NOT(step.node < nodes_.size(), "The saved execution plan refers to an unknown node.");
+    restored->execution_plan.emplace_back(static_cast<NodeIndex>(step.node));
+    auto& node_plan = restored->execution_plan.back();
+    node_plan.free_from_index = static_cast<int>(restored->to_be_freed.size());
+    for (const auto& name : step.values_to_free) {
+      int idx = 0;
+      ORT_RETURN_IF_ERROR(ort_value_name_idx_map.GetIdx(name, idx));
+      restored->to_be_freed.push_back(idx);
+    }
+    node_plan.free_to_index = static_cast<int>(restored->to_be_freed.size()) - 1;
+  }
+
+  plan = std::move(restored);
+  return Status::OK();
+}
+
+common::Status SavedSessionState::VerifyKernels(const SessionState& session_state) const {
+  for (size_t i = 0; i < nodes_.size(); ++i) {
+    const OpKernel* kernel = session_state.GetKernel(i);
+    ORT_RETURN_IF_NOT(kernel != nullptr, "No kernel was created for node ", i);
+    if (kernel->KernelDef().GetHash() != nodes_[i].kernel_def_hash) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "The kernel for node ", kernel->Node().Name(), " (",
+                             nodes_[i].op_type, ") differs from the one the session state was saved with. "
+                             "Save the session state again with this build.");
+    }
+  }
+
+  return Status::OK();
+}
+
+common::Status SavedSessionState::RestoreMemoryPatterns(const SessionState& session_state) const {
+  const auto& ort_value_name_idx_map = session_state.GetOrtValueNameIdxMap();
+  const auto& providers = session_state.GetExecutionProviders();
+  for (const auto& group : pattern_groups_) {
+    auto patterns = onnxruntime::make_unique<MemoryPatternGroup>();
+    for (size_t i = 0; i < group.locations.size(); ++i) {
+      OrtMemoryInfo location;
+      ORT_RETURN_IF_ERROR(FromLocation(group.locations[i], providers, location));
+
+      MemoryPattern pattern;
+      pattern.peak_size_ = static_cast<size_t>(group.peak_sizes[i]);
+      for (const auto& block : group.blocks[i]) {
+        int idx = 0;
+        ORT_RETURN_IF_ERROR(ort_value_name_idx_map.GetIdx(block.value, idx));
+        pattern.patterns_[idx] = MemoryBlock(static_cast<size_t>(block.offset), static_cast<size_t>(block.size));
+      }
+
+      patterns->locations.push_back(location);
+      patterns->patterns.push_back(std::move(pattern));
+    }
+
+    session_state.RestoreMemoryPatternCacheEntry({group.key, group.input_dims, std::move(patterns)});
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
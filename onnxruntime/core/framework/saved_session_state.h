@@ -0,0 +1,132 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/path_string.h"
+#include "core/framework/allocator.h"
+#include "core/graph/onnx_protobuf.h"
+
+namespace onnxruntime {
+class ExecutionProviders;
+class Graph;
+class GraphViewer;
+class OrtValueNameIdxMap;
+class SessionState;
+struct SequentialExecutionPlan;
+
+/**
+ * The state of an initialized session saved ahead of time, so that a session for the same model can skip graph
+ * transformation, partitioning and planning.
+ *
+ * The file holds the optimized model (including initializers rewritten by the transformers, e.g. the NCHWc
+ * reordered weights), the execution provider and kernel definition hash of every node, the execution and
+ * allocation plans and the memory patterns cached so far. Kernels are still created, and pre-pack their weights,
+ * when the session is initialized. Initializers stored in external files are referenced, not copied, so relative
+ * paths are resolved against the directory of the saved session state. InferenceSession::SaveSessionState fails if
+ * a model with external initializers is saved to another directory than the one of the original model.
+ *
+ * The model is saved after the changes applied when it was loaded, e.g. the columnar ZipMap outputs of
+ * SessionOptions::use_columnar_zipmap_output, which must then be set when the state is loaded.
+ * Graphs with subgraphs or with nodes compiled by an execution provider are not supported.
+ * The file is only valid for the build of onnxruntime and the execution providers it was created with. With
+ * ORT_ENABLE_ALL it may also hold weights reordered for the NCHWc layout of the CPU it was saved on, so it is
+ * specific to that hardware too.
+ */
+class SavedSessionState {
+ public:
+  // Returns true if the file at 'path' starts with the header of a saved session state.
+  static bool IsSavedSessionStateFile(const PathString& path);
+
+  // Saves 'session_state'. 'optimized_model' must be the model of the session after graph transformation,
+  // taken before the initializers were moved into the session state.
+  static common::Status Save(const PathString& path, const ONNX_NAMESPACE::ModelProto& optimized_model,
+                             const SessionState& session_state);
+
+  static common::Status Load(const PathString& path, ONNX_NAMESPACE::ModelProto& optimized_model,
+                             std::unique_ptr<SavedSessionState>& saved_state);
+
+  // Assigns each node of 'graph', which must have been loaded from the saved model, to the execution
+  // provider it was assigned to when the state was saved. Fails without modifying the graph if a node
+  // doesn't match or an execution provider isn't registered.
+  common::Status AssignNodes(Graph& graph, const ExecutionProviders& providers) const;
+
+  common::Status RestoreExecutionPlan(const GraphViewer& graph_viewer,
+                                      const OrtValueNameIdxMap& ort_value_name_idx_map,
+                                      const ExecutionProviders& providers,
+                                      std::unique_ptr<SequentialExecutionPlan>& plan) const;
+
+  // Checks that the kernels created for the session are the ones the state was saved with.
+  common::Status VerifyKernels(const SessionState& session_state) const;
+
+  // Adds the saved memory patterns to the memory pattern cache of 'session_state'.
+  common::Status RestoreMemoryPatterns(const SessionState& session_state) const;
+
+ private:
+  struct Location {
+    std::string name;
+    int32_t id = 0;
+    int32_t mem_type = 0;
+    int32_t alloc_type = 0;
+    int32_t device_type = 0;
+    int32_t device_mem_type = 0;
+    int32_t device_id = 0;
+  };
+
+  struct NodeInfo {
+    std::string op_type;
+    std::string provider;
+    uint64_t kernel_def_hash = 0;
+    bool has_fence = false;
+    int32_t priority = 0;
+  };
+
+  struct ValuePlan {
+    std::string name;
+    int32_t alloc_kind = 0;
+    bool has_value_type = false;
+    Location location;
+    std::string reused_buffer;  // empty unless alloc_kind is kReuse or kShare
+    bool create_fence_if_async = false;
+  };
+
+  struct Step {
+    uint64_t node = 0;  // position of the node in the saved model
+    std::vector<std::string> values_to_free;
+  };
+
+  struct Block {
+    std::string value;
+    uint64_t offset = 0;
+    uint64_t size = 0;
+  };
+
+  struct PatternGroup {
+    std::vector<int64_t> key;
+    std::vector<int64_t> input_dims;
+    std::vector<Location> locations;
+    std::vector<uint64_t> peak_sizes;
+    std::vector<std::vector<Block>> blocks;
+  };
+
+  class Writer;
+  class Reader;
+
+  static Location ToLocation(const OrtMemoryInfo& info);
+  static common::Status FromLocation(const Location& location, const ExecutionProviders& providers,
+                                     OrtMemoryInfo& info);
+  static void Write(Writer& writer, const Location& location);
+  static bool Read(Reader& reader, Location& location);
+
+  // nodes in the order of the saved model, which is their index once the model is loaded again
+  std::vector<NodeInfo> nodes_;
+  std::vector<ValuePlan> values_;
+  std::vector<Step> steps_;
+  std::vector<PatternGroup> pattern_groups_;
+};
+}  // namespace onnxruntime
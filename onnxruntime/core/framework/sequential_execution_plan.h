@@ -69,6 +69,10 @@ struct SequentialExecutionPlan : public ExecutionPlanBase {
   // Records whether a given node has fence on its input or output, key is node index.
   std::vector<bool> node_has_fence;
 
+  // Length of the longest path from a node to any graph output, counted in nodes; key is node index.
+  // Used as a scheduling priority hint so that nodes on the critical path are run first.
+  std::vector<int> node_priority;
+
   // to_be_freed: vector elements represent indices of ml-values to be freed (as described above)
   std::vector<OrtValueIndex> to_be_freed;
 
@@ -92,6 +96,10 @@ struct SequentialExecutionPlan : public ExecutionPlanBase {
   bool NodeHasFence(onnxruntime::NodeIndex node_index) const {
     return node_has_fence[node_index];
   }
+
+  int NodePriority(onnxruntime::NodeIndex node_index) const {
+    return node_priority[node_index];
+  }
 };
 
 // Output details of an execution plan:
@@ -15,6 +15,24 @@ struct FreeDimensionOverride {
   int64_t dimension_override;
 };
 
+/**
+  * Controls how the memory patterns generated for a set of input shapes are cached and reused.
+  */
+struct MemoryPatternCachePolicy {
+  // maximum number of memory patterns cached for a graph. the least recently used pattern is evicted
+  // when a new one would exceed it. 0 means unlimited.
+  size_t max_num_entries = 0;
+
+  // round input dimensions up to the next power of two when looking up a pattern, so that inputs with
+  // similar shapes (e.g. varying sequence lengths) share a pattern. the pattern generated for the largest
+  // inputs seen in a bucket is reused for smaller inputs in the same bucket.
+  bool enable_shape_bucketing = false;
+
+  // names of the symbolic dimensions (dim_param) of the graph inputs to bucket. if empty, every input dimension
+  // without a fixed value in the model is bucketed.
+  std::vector<std::string> bucketed_dim_params;
+};
+
 /**
   * Configuration information for a session.
   */
@@ -27,6 +45,10 @@ struct SessionOptions {
   // non empty filepath enables serialization of the transformed optimized model to the specified filepath.
   std::basic_string<ORTCHAR_T> optimized_model_filepath;
 
+  // non empty filepath enables saving the initialized session state to the specified filepath.
+  // A session created from that file skips graph optimization, partitioning and planning.
+  std::basic_string<ORTCHAR_T> optimized_session_state_filepath;
+
   // enable the memory pattern optimization.
   // The idea is if the input shapes are the same, we could trace the internal memory allocation
   // and generate a memory pattern for future request. So next time we could just do one allocation
@@ -34,11 +56,36 @@ struct SessionOptions {
   // See class 'OrtValuePatternPlanner'.
   bool enable_mem_pattern = true;
 
+  // how the memory patterns are cached when enable_mem_pattern is true.
+  MemoryPatternCachePolicy mem_pattern_cache_policy;
+
   // enable the memory arena on CPU
   // Arena may pre-allocate memory for future usage.
   // set this option to false if you don't want it.
   bool enable_cpu_mem_arena = true;
 
+  // how the CPU memory arena grows when it runs out of memory.
+  OrtArenaExtendStrategy cpu_arena_extend_strategy = ORT_ARENA_EXTEND_NEXT_POWER_OF_TWO;
+
+  // give each thread allocating from the CPU memory arena a cache of small freed chunks, so concurrent Run() calls
+  // on a shared session don't serialize on the arena lock. Each cache holds up to 4MB until its thread exits.
+  bool enable_cpu_arena_thread_cache = false;
+
+  // at the end of each Run(), shrink the memory arenas that hold more than this many bytes.
+  // 0 disables the check. See also OrtRunOptions::shrink_memory_arenas.
+  size_t arena_shrink_high_watermark = 0;
+
+  // load a model from a file by memory-mapping it. Large initializers are used directly from the mapping instead
+  // of being copied, so sessions in different processes that load the same model file share its pages.
+  // The model file must not be modified while the session is alive.
+  bool use_mmap_for_model_loading = false;
+
+  // return the output of ZipMap nodes as a dense float tensor with the probabilities, plus a tensor with the class
+  // labels in an additional output named '<output name>_labels', instead of as a sequence of maps.
+  // The optimized model and the session state saved by such a session keep the columnar outputs and can only be
+  // loaded with this option set. See ConvertZipMapOutputsToColumnar.
+  bool use_columnar_zipmap_output = false;
+
   // the prefix of the profile file. The current time will be appended to the file name.
   std::basic_string<ORTCHAR_T> profile_file_prefix = ORT_TSTR("onnxruntime_profile_");
 
@@ -3,11 +3,14 @@
 
 #include "core/framework/session_state.h"
 
+#include <algorithm>
+#include <iterator>
 #include <sstream>
 
 #include "core/common/logging/logging.h"
 #include "core/framework/node_index_info.h"
 #include "core/framework/op_kernel.h"
+#include "core/framework/tensorprotoutils.h"
 #include "core/framework/utils.h"
 
 using namespace ::onnxruntime::common;
@@ -65,6 +68,32 @@ Status SessionState::SetGraph(const Graph& graph) {
   }
 
   LOGS(logger, INFO) << "Done saving OrtValue mappings.";
+
+  if (mem_pattern_cache_policy_.enable_shape_bucketing) {
+    const auto& dim_params = mem_pattern_cache_policy_.bucketed_dim_params;
+    for (const auto* input_def : graph_viewer_->GetInputs()) {
+      const auto* shape = input_def->Shape();
+      if (shape == nullptr) {
+        continue;
+      }
+
+      std::vector<bool> bucketed_dims;
+      bucketed_dims.reserve(shape->dim_size());
+      for (const auto& dim : shape->dim()) {
+        bucketed_dims.push_back(
+            dim_params.empty()
+                ? !utils::HasDimValue(dim)
+                : utils::HasDimParam(dim) &&
+                      std::find(dim_params.cbegin(), dim_params.cend(), dim.dim_param()) != dim_params.cend());
+      }
+
+      if (std::find(bucketed_dims.cbegin(), bucketed_dims.cend(), true) != bucketed_dims.cend()) {
+        ORT_RETURN_IF_ERROR(ort_value_name_idx_map_.GetIdx(input_def->Name(), idx));
+        mem_pattern_bucketed_dims_[idx] = std::move(bucketed_dims);
+      }
+    }
+  }
+
   return Status::OK();
 }
 
@@ -103,6 +132,74 @@ Status SessionState::CreateKernels(const KernelRegistryManager& custom_registry_
   return Status::OK();
 }
 
+Status SessionState::PrepackConstantInitializedTensors() {
+  ORT_ENFORCE(graph_viewer_, "SetGraph must be called prior to PrepackConstantInitializedTensors.");
+
+  // count the usages of each constant initializer. usages that can't be packed (implicit inputs that are consumed
+  // by a subgraph, and graph outputs) are counted so the initializer is never released if they exist.
+  std::unordered_map<int, size_t> constant_initializer_use_count;
+  auto count_use = [this, &constant_initializer_use_count](const NodeArg& node_arg) {
+    int ort_value_idx;
+    if (node_arg.Exists() && ort_value_name_idx_map_.GetIdx(node_arg.Name(), ort_value_idx).IsOK() &&
+        constant_initialized_tensors_.find(ort_value_idx) != constant_initialized_tensors_.cend()) {
+      ++constant_initializer_use_count[ort_value_idx];
+    }
+  };
+
+  for (const auto& node : graph_viewer_->Nodes()) {
+    for (const auto* input_def : node.InputDefs()) {
+      count_use(*input_def);
+    }
+
+    for (const auto* input_def : node.ImplicitInputDefs()) {
+      count_use(*input_def);
+    }
+  }
+
+  for (const auto* output_def : graph_viewer_->GetOutputs()) {
+    count_use(*output_def);
+  }
+
+  for (const auto& node : graph_viewer_->Nodes()) {
+    OpKernel* kernel = GetMutableKernel(node.Index());
+    if (kernel == nullptr) {
+      continue;
+    }
+
+    int input_idx = 0;
+    for (const auto* input_def : node.InputDefs()) {
+      int ort_value_idx;
+      if (input_def->Exists() && ort_value_name_idx_map_.GetIdx(input_def->Name(), ort_value_idx).IsOK()) {
+        auto entry = constant_initialized_tensors_.find(ort_value_idx);
+        if (entry != constant_initialized_tensors_.cend() && entry->second.IsTensor()) {
+          bool is_packed = false;
+          ORT_RETURN_IF_ERROR(kernel->PrePack(entry->second.Get<Tensor>(), input_idx, is_packed));
+
+          // the memory is freed by the deleter when the initializer has its own allocation, which
+          // SaveInitializedTensors gives to the B input of CPU MatMul/Gemm. any other initializer lives in the
+          // shared weights buffer, so releasing it only drops the reference and the buffer stays allocated.
+          if (is_packed && --constant_initializer_use_count[ort_value_idx] == 0) {
+            VLOGS(Logger(), 1) << "Releasing constant initializer " << input_def->Name()
+                               << " as all consumers have pre-packed it.";
+            constant_initialized_tensors_.erase(entry);
+            initialized_tensors_.erase(ort_value_idx);
+
+            auto deleter = deleter_for_initialized_tensors_.find(ort_value_idx);
+            if (deleter != deleter_for_initialized_tensors_.cend()) {
+              deleter->second.f(deleter->second.param);
+              deleter_for_initialized_tensors_.erase(deleter);
+            }
+          }
+        }
+      }
+
+      ++input_idx;
+    }
+  }
+
+  return Status::OK();
+}
+
 void SessionState::SetExecutionPlan(std::unique_ptr<SequentialExecutionPlan> p_seq_exec_plan) {
   p_seq_exec_plan_ = std::move(p_seq_exec_plan);
 }
@@ -148,39 +245,146 @@ void SessionState::SetProfiler(profiling::Profiler& profiler) { profiler_ = &pro
 
 ::onnxruntime::profiling::Profiler& SessionState::Profiler() const { return *profiler_; }
 
-static int64_t CalculateMemoryPatternsKey(const std::vector<std::reference_wrapper<const TensorShape>>& shapes) {
-  int64_t key = 0;
-  for (auto shape : shapes) {
-    for (auto dim : shape.get().GetDims()) key ^= dim;
+static int64_t RoundUpToPowerOfTwo(int64_t dim) {
+  int64_t bucket = 1;
+  while (bucket < dim) {
+    bucket <<= 1;
+  }
+  return dim > 0 ? bucket : dim;
+}
+
+// true if every input dim in 'dims' is no larger than the matching one in 'pattern_dims'.
+// both have the layout of a MemoryPatternCacheKey with the same ranks.
+static bool InputDimsFitPattern(const std::vector<int64_t>& dims, const std::vector<int64_t>& pattern_dims) {
+  if (dims.size() != pattern_dims.size()) {
+    return false;
   }
-  return key;
+
+  for (size_t i = 0, end = dims.size(); i < end; ++i) {
+    if (dims[i] > pattern_dims[i]) {
+      return false;
+    }
+  }
+
+  return true;
 }
 
-const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(
-    const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes) const {
-  int64_t key = CalculateMemoryPatternsKey(input_shapes);
+void SessionState::CalculateMemoryPatternsKey(
+    const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes,
+    const std::vector<int>& feed_mlvalue_idxs, MemoryPatternCacheKey& key, std::vector<int64_t>& input_dims) const {
+  for (size_t i = 0, end = input_shapes.size(); i < end; ++i) {
+    const auto& dims = input_shapes[i].get().GetDims();
+    key.push_back(static_cast<int64_t>(dims.size()));
+    input_dims.push_back(static_cast<int64_t>(dims.size()));
+
+    const std::vector<bool>* bucketed_dims = nullptr;
+    if (!mem_pattern_bucketed_dims_.empty() && i < feed_mlvalue_idxs.size()) {
+      auto entry = mem_pattern_bucketed_dims_.find(feed_mlvalue_idxs[i]);
+      if (entry != mem_pattern_bucketed_dims_.cend() && entry->second.size() == dims.size()) {
+        bucketed_dims = &entry->second;
+      }
+    }
+
+    for (size_t d = 0, rank = dims.size(); d < rank; ++d) {
+      key.push_back(bucketed_dims && (*bucketed_dims)[d] ? RoundUpToPowerOfTwo(dims[d]) : dims[d]);
+      input_dims.push_back(dims[d]);
+    }
+  }
+}
+
+std::shared_ptr<const MemoryPatternGroup> SessionState::GetMemoryPatternGroup(
+    const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes,
+    const std::vector<int>& feed_mlvalue_idxs) const {
+  MemoryPatternCacheKey key;
+  std::vector<int64_t> input_dims;
+  CalculateMemoryPatternsKey(input_shapes, feed_mlvalue_idxs, key, input_dims);
 
   std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
   auto it = mem_patterns_.find(key);
-  if (it == mem_patterns_.end()) return nullptr;
+  // a pattern generated for larger inputs in the same bucket has a large enough block for every value
+  if (it == mem_patterns_.end() || !InputDimsFitPattern(input_dims, it->second.input_dims)) {
+    ++mem_patterns_stats_.misses;
+    return nullptr;
+  }
 
-  return it->second.get();
+  ++mem_patterns_stats_.hits;
+  mem_patterns_lru_.splice(mem_patterns_lru_.begin(), mem_patterns_lru_, it->second.lru_position);
+  return it->second.patterns;
 }
 
 Status SessionState::UpdateMemoryPatternGroupCache(
     const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes,
+    const std::vector<int>& feed_mlvalue_idxs,
     std::unique_ptr<MemoryPatternGroup> mem_patterns) const {
-  int64_t key = CalculateMemoryPatternsKey(input_shapes);
+  MemoryPatternCacheKey key;
+  std::vector<int64_t> input_dims;
+  CalculateMemoryPatternsKey(input_shapes, feed_mlvalue_idxs, key, input_dims);
 
   std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
   auto it = mem_patterns_.find(key);
-  if (it == mem_patterns_.end()) {
-    mem_patterns_[key] = std::move(mem_patterns);
+  if (it != mem_patterns_.end()) {
+    // keep the existing pattern if it covers these inputs, e.g. another Run added it concurrently.
+    // otherwise replace it so the bucket grows towards the largest inputs seen.
+    if (!InputDimsFitPattern(input_dims, it->second.input_dims)) {
+      it->second.patterns = std::move(mem_patterns);
+      it->second.input_dims = std::move(input_dims);
+    }
+
+    mem_patterns_lru_.splice(mem_patterns_lru_.begin(), mem_patterns_lru_, it->second.lru_position);
+    return Status::OK();
   }
 
+  const size_t max_num_entries = mem_pattern_cache_policy_.max_num_entries;
+  while (max_num_entries > 0 && mem_patterns_.size() >= max_num_entries) {
+    // executors that are using the evicted patterns keep them alive until they finish
+    mem_patterns_.erase(mem_patterns_lru_.back());
+    mem_patterns_lru_.pop_back();
+    ++mem_patterns_stats_.evictions;
+  }
+
+  mem_patterns_lru_.push_front(key);
+  MemoryPatternCacheEntry& entry = mem_patterns_[std::move(key)];
+  entry.patterns = std::move(mem_patterns);
+  entry.input_dims = std::move(input_dims);
+  entry.lru_position = mem_patterns_lru_.begin();
+
   return Status::OK();
 }
 
+MemoryPatternCacheStats SessionState::GetMemoryPatternCacheStats() const {
+  std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
+  MemoryPatternCacheStats stats = mem_patterns_stats_;
+  stats.num_entries = mem_patterns_.size();
+  return stats;
+}
+
+std::vector<SessionState::MemoryPatternCacheEntryInfo> SessionState::GetMemoryPatternCacheEntries() const {
+  std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
+  std::vector<MemoryPatternCacheEntryInfo> entries;
+  entries.reserve(mem_patterns_.size());
+  for (const auto& key : mem_patterns_lru_) {
+    const auto& entry = mem_patterns_.at(key);
+    entries.push_back({key, entry.input_dims, entry.patterns});
+  }
+
+  return entries;
+}
+
+void SessionState::RestoreMemoryPatternCacheEntry(MemoryPatternCacheEntryInfo entry) const {
+  std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
+  const size_t max_num_entries = mem_pattern_cache_policy_.max_num_entries;
+  if ((max_num_entries > 0 && mem_patterns_.size() >= max_num_entries) ||
+      mem_patterns_.find(entry.key) != mem_patterns_.end()) {
+    return;
+  }
+
+  mem_patterns_lru_.push_back(entry.key);
+  MemoryPatternCacheEntry& cache_entry = mem_patterns_[std::move(entry.key)];
+  cache_entry.patterns = std::move(entry.patterns);
+  cache_entry.input_dims = std::move(entry.input_dims);
+  cache_entry.lru_position = std::prev(mem_patterns_lru_.end());
+}
+
 bool SessionState::GetEnableMemoryPattern() const { return enable_mem_pattern_; }
 
 common::Status SessionState::AddInputNameToNodeInfoMapping(const std::string& input_name, const NodeInfo& node_info) {
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <list>
 #include <memory>
 #include <map>
 #include <unordered_map>
@@ -22,6 +23,7 @@
 #include "core/framework/callback.h"
 #include "core/framework/ort_value_name_idx_map.h"
 #include "core/framework/node_index_info.h"
+#include "core/framework/session_options.h"
 #include "core/graph/graph_viewer.h"
 #include "core/framework/fuse_nodes_funcs.h"
 #include "core/platform/threadpool.h"
@@ -36,6 +38,13 @@ class NodeIndexInfo;
 struct SequentialExecutionPlan;
 struct MemoryPatternGroup;
 
+struct MemoryPatternCacheStats {
+  size_t num_entries = 0;
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  uint64_t evictions = 0;
+};
+
 /**
  * SessionState should be modified by the inference session class only.
  * It is supposed to be passed by const-ref only to all the executors.
@@ -97,6 +106,13 @@ class SessionState {
 
   Status SetGraph(const Graph& graph);
   Status CreateKernels(const KernelRegistryManager& custom_registry_manager);
+
+  /**
+   * Gives each kernel the opportunity to pre-pack the constant initializers it consumes.
+   * Must be called after CreateKernels. An initializer that every consuming kernel has packed is removed from
+   * the initialized tensors as nothing will read it at runtime.
+   */
+  Status PrepackConstantInitializedTensors();
   Status SetGraphAndCreateKernels(const Graph& graph, const KernelRegistryManager& custom_registry_manager) {
     ORT_RETURN_IF_ERROR(SetGraph(graph));
     return CreateKernels(custom_registry_manager);
@@ -142,18 +158,50 @@ class SessionState {
   profiling::Profiler& Profiler() const;
 
   /**
-  Get cached memory pattern based on input shapes
+  Set the policy for caching memory patterns. Must be called before SetGraph.
   */
-  const MemoryPatternGroup* GetMemoryPatternGroup(
-      const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes) const;
+  void SetMemoryPatternCachePolicy(const MemoryPatternCachePolicy& policy) { mem_pattern_cache_policy_ = policy; }
+
+  const MemoryPatternCachePolicy& GetMemoryPatternCachePolicy() const { return mem_pattern_cache_policy_; }
+
+  /**
+  Get cached memory pattern based on input shapes.
+  'feed_mlvalue_idxs' are the OrtValue indexes of the inputs the shapes are for.
+  The returned pattern may have been generated for larger inputs if shape bucketing is enabled.
+  */
+  std::shared_ptr<const MemoryPatternGroup> GetMemoryPatternGroup(
+      const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes,
+      const std::vector<int>& feed_mlvalue_idxs) const;
 
   /**
   Set generated memory pattern with a given input shapes.
   Const as it's an internal cache update only.
   */
   Status UpdateMemoryPatternGroupCache(const std::vector<std::reference_wrapper<const TensorShape>>& input_shape,
+                                       const std::vector<int>& feed_mlvalue_idxs,
                                        std::unique_ptr<MemoryPatternGroup> mem_patterns) const;
 
+  MemoryPatternCacheStats GetMemoryPatternCacheStats() const;
+
+  struct MemoryPatternCacheEntryInfo {
+    // the key the patterns are cached under. the rank and the (possibly bucketed) dims of each input.
+    std::vector<int64_t> key;
+    // the rank and dims of each input the patterns were generated for
+    std::vector<int64_t> input_dims;
+    std::shared_ptr<const MemoryPatternGroup> patterns;
+  };
+
+  /**
+  Get the entries of the memory pattern cache, most recently used first.
+  */
+  std::vector<MemoryPatternCacheEntryInfo> GetMemoryPatternCacheEntries() const;
+
+  /**
+  Add an entry previously returned by GetMemoryPatternCacheEntries, e.g. by another session for the same graph.
+  The entry is added as the least recently used one. Existing entries are not replaced.
+  */
+  void RestoreMemoryPatternCacheEntry(MemoryPatternCacheEntryInfo entry) const;
+
   /**
   Get enable memory pattern flag
   */
@@ -244,10 +292,31 @@ class SessionState {
 
   // switch for enable memory pattern optimization or not.
   const bool enable_mem_pattern_;
+  MemoryPatternCachePolicy mem_pattern_cache_policy_;
+  // for each graph input, by OrtValue index, which dims are rounded up when shape bucketing is enabled
+  std::unordered_map<int, std::vector<bool>> mem_pattern_bucketed_dims_;
+
+  // key of the mem_patterns_ cache. the rank and the (possibly bucketed) dims of each input.
+  using MemoryPatternCacheKey = std::vector<int64_t>;
+  struct MemoryPatternCacheEntry {
+    std::shared_ptr<const MemoryPatternGroup> patterns;
+    // rank and dims of each input the patterns were generated for
+    std::vector<int64_t> input_dims;
+    // position in mem_patterns_lru_
+    std::list<MemoryPatternCacheKey>::iterator lru_position;
+  };
+
+  void CalculateMemoryPatternsKey(const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes,
+                                  const std::vector<int>& feed_mlvalue_idxs, MemoryPatternCacheKey& key,
+                                  std::vector<int64_t>& input_dims) const;
+
   // lock for the mem_patterns_
   mutable OrtMutex mem_patterns_lock_;
   // cache for the generated mem_patterns. key is calculated based on input shapes.
-  mutable std::map<int64_t, std::unique_ptr<MemoryPatternGroup>> mem_patterns_;
+  mutable std::map<MemoryPatternCacheKey, MemoryPatternCacheEntry> mem_patterns_;
+  // keys of mem_patterns_, most recently used first
+  mutable std::list<MemoryPatternCacheKey> mem_patterns_lru_;
+  mutable MemoryPatternCacheStats mem_patterns_stats_;
 
   NameNodeInfoMapType input_names_to_nodeinfo_mapping_;
   NameNodeInfoMapType output_names_to_nodeinfo_mapping_;
@@ -6,6 +6,8 @@
 
 #include <functional>
 #include <limits>
+#include <string>
+#include <unordered_set>
 #include <core/common/status.h>
 
 #include "core/common/common.h"
@@ -13,11 +15,13 @@
 
 #include "core/graph/graph_viewer.h"
 #include "core/framework/data_transfer_manager.h"
+#include "core/framework/endian.h"
 #include "core/graph/graph_utils.h"
 #include "core/framework/graph_partitioner.h"
 #include "core/framework/ml_value.h"
 #include "core/framework/ort_value_pattern_planner.h"
 #include "core/framework/ort_value_name_idx_map.h"
+#include "core/framework/saved_session_state.h"
 #include "core/framework/sequential_execution_plan.h"
 #include "core/framework/session_state.h"
 #include "core/framework/tensorprotoutils.h"
@@ -32,9 +36,11 @@ template <typename T>
 static common::Status SaveInitializedTensors(const Env& env, const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
                                              const onnxruntime::Graph& graph, const ExecutionProviders& exec_providers,
                                              const OrtValueNameIdxMap& ort_value_name_idx_map,
+                                             const ExecutionPlanBase& exec_plan,
                                              ITensorAllocator* planner, const T& save_tensor_func,
                                              const logging::Logger& logger,
-                                             const DataTransferManager& data_transfer_mgr);
+                                             const DataTransferManager& data_transfer_mgr,
+                                             bool use_mmap_for_model_loading);
 
 static common::Status SaveInputOutputNamesToNodeMapping(
     const onnxruntime::Graph& graph,
@@ -46,19 +52,22 @@ SessionStateInitializer::SessionStateInitializer(bool enable_mem_pattern,
                                                  const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
                                                  onnxruntime::Graph& graph, SessionState& session_state,
                                                  const ExecutionProviders& providers,
-                                                 KernelRegistryManager& kernel_registry_manager)
+                                                 KernelRegistryManager& kernel_registry_manager,
+                                                 bool use_mmap_for_model_loading)
     : graph_loc_(graph_loc),
       graph_(graph),
       session_state_(session_state),
       execution_providers_(providers),
       kernel_registry_manager_(kernel_registry_manager),
       logger_(session_state.Logger()),
-      enable_mem_pattern_(enable_mem_pattern) {}
+      enable_mem_pattern_(enable_mem_pattern),
+      use_mmap_for_model_loading_(use_mmap_for_model_loading) {}
 
 common::Status SessionStateInitializer::CreatePlan(
     const Node* parent_node,
     const ConstPointerContainer<std::vector<NodeArg*>>* outer_scope_node_args,
-    ExecutionMode execution_mode) {
+    ExecutionMode execution_mode,
+    const SavedSessionState* saved_state) {
   session_state_.SetGraph(graph_);
   const GraphViewer* graph_viewer = session_state_.GetGraphViewer();
 
@@ -78,10 +87,15 @@ common::Status SessionStateInitializer::CreatePlan(
   }
 
   std::unique_ptr<SequentialExecutionPlan> exec_plan;
-  SequentialPlannerContext context(execution_mode);
-  ORT_RETURN_IF_ERROR(SequentialPlanner::CreatePlan(parent_node, *graph_viewer, valid_outer_scope_node_args,
-                                                    execution_providers_, kernel_registry_manager_,
-                                                    ort_value_name_idx_map, context, exec_plan));
+  if (saved_state != nullptr) {
+    ORT_RETURN_IF_ERROR(saved_state->RestoreExecutionPlan(*graph_viewer, ort_value_name_idx_map, execution_providers_,
+                                                          exec_plan));
+  } else {
+    SequentialPlannerContext context(execution_mode);
+    ORT_RETURN_IF_ERROR(SequentialPlanner::CreatePlan(parent_node, *graph_viewer, valid_outer_scope_node_args,
+                                                      execution_providers_, kernel_registry_manager_,
+                                                      ort_value_name_idx_map, context, exec_plan));
+  }
   session_state_.SetExecutionPlan(std::move(exec_plan));
 
   const auto* exec_plan_ptr = session_state_.GetExecutionPlan();
@@ -93,17 +107,21 @@ common::Status SessionStateInitializer::CreatePlan(
   // lambda to save initialized tensors into SessionState directly
   const Env& env = Env::Default();
   ORT_RETURN_IF_ERROR(SaveInitializedTensors(
-      env, graph_loc_, graph_, execution_providers_, ort_value_name_idx_map, tensor_allocator_.get(),
+      env, graph_loc_, graph_, execution_providers_, ort_value_name_idx_map, *exec_plan_ptr, tensor_allocator_.get(),
       [this](int idx, const OrtValue& value, const OrtCallback& d, bool constant) -> Status {
         return session_state_.AddInitializedTensor(idx, value, &d, constant);
       },
-      logger_, session_state_.GetDataTransferMgr()));
+      logger_, session_state_.GetDataTransferMgr(), use_mmap_for_model_loading_));
   // remove weights from the graph now to save memory but in many cases it won't save memory, if the tensor was
   // preallocated with the some other tensors in a single 'allocate' call, which is very common.
   // TODO: make it better
   graph_.CleanAllInitializedTensors();
 
   ORT_RETURN_IF_ERROR(session_state_.CreateKernels(kernel_registry_manager_));
+  ORT_RETURN_IF_ERROR(session_state_.PrepackConstantInitializedTensors());
+  if (saved_state != nullptr) {
+    ORT_RETURN_IF_ERROR(saved_state->VerifyKernels(session_state_));
+  }
   ORT_RETURN_IF_ERROR(
       SaveInputOutputNamesToNodeMapping(graph_, kernel_registry_manager_, session_state_, outer_scope_node_args));
   return Status::OK();
@@ -170,12 +188,97 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
   return common::Status::OK();
 }
 
+// When the model is loaded with use_mmap_for_model_loading, an initializer stored in an external file that is
+// deserialized to a CPU tensor doesn't need a preallocated buffer. TensorProtoToMLValue maps the file content (or
+// reads it into its own buffer if mapping is not available) and the tensor uses that memory directly, so the pages
+// of a memory-mapped model are shared instead of copied. Without the option, external data is copied into the
+// weights buffer as before, and the file is not kept mapped for the lifetime of the session.
+static bool IsZeroCopyExternalInitializer(const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                          const OrtMemoryInfo& location) {
+  if (endian::native != endian::little ||
+      tensor_proto.data_location() != ONNX_NAMESPACE::TensorProto_DataLocation_EXTERNAL ||
+      tensor_proto.data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
+    return false;
+  }
+
+  if (strcmp(location.name, CPU) != 0 && location.mem_type != OrtMemTypeCPUOutput) {
+    return false;
+  }
+
+  // empty tensors go through the regular path as there is nothing to map
+  size_t len = 0;
+  return utils::GetSizeInBytesFromTensorProto<0>(tensor_proto, &len).IsOK() && len > 0;
+}
+
+// A constant float initializer that is only consumed as input B of CPU MatMul/Gemm nodes is expected to be released
+// by SessionState::PrepackConstantInitializedTensors once the kernels have packed it. Such an initializer gets its
+// own allocation instead of a slice of the shared weights buffer so that releasing it actually frees the memory.
+// Keep this in sync with the kernels that override OpKernel::PrePack.
+static std::unordered_set<std::string> GetPrePackCandidateInitializers(const Graph& graph) {
+  std::unordered_set<std::string> candidates;
+  std::unordered_set<std::string> excluded;
+  for (const auto* output_def : graph.GetOutputs()) {
+    excluded.insert(output_def->Name());
+  }
+
+  for (const auto& node : graph.Nodes()) {
+    const bool is_packing_node = node.GetExecutionProviderType() == kCpuExecutionProvider &&
+                                 (node.Domain().empty() || node.Domain() == kOnnxDomain) &&
+                                 (node.OpType() == "MatMul" || node.OpType() == "Gemm");
+    int input_idx = 0;
+    for (const auto* input_def : node.InputDefs()) {
+      if (input_def->Exists()) {
+        if (is_packing_node && input_idx == 1) {
+          candidates.insert(input_def->Name());
+        } else {
+          excluded.insert(input_def->Name());
+        }
+      }
+      ++input_idx;
+    }
+
+    for (const auto* input_def : node.ImplicitInputDefs()) {
+      excluded.insert(input_def->Name());
+    }
+  }
+
+  for (auto it = candidates.begin(); it != candidates.end();) {
+    const ONNX_NAMESPACE::TensorProto* tensor_proto = nullptr;
+    if (excluded.count(*it) != 0 ||
+        !graph_utils::IsConstantInitializer(graph, *it, /* check_outer_scope */ false) ||
+        !graph.GetInitializedTensor(*it, tensor_proto) ||
+        tensor_proto->data_type() != ONNX_NAMESPACE::TensorProto_DataType_FLOAT ||
+        tensor_proto->data_location() == ONNX_NAMESPACE::TensorProto_DataLocation_EXTERNAL ||
+        tensor_proto->dims_size() != 2) {
+      it = candidates.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  return candidates;
+}
+
+namespace {
+struct InitializerBuffer {
+  AllocatorPtr allocator;
+  void* buffer;
+};
+}  // namespace
+
+static void FreeInitializerBuffer(void* param) {
+  auto* p = static_cast<InitializerBuffer*>(param);
+  p->allocator->Free(p->buffer);
+  delete p;
+}
+
 template <typename T>
 common::Status SaveInitializedTensors(const Env& env, const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
                                       const Graph& graph, const ExecutionProviders& exec_providers,
-                                      const OrtValueNameIdxMap& ort_value_name_idx_map, ITensorAllocator* planner,
+                                      const OrtValueNameIdxMap& ort_value_name_idx_map,
+                                      const ExecutionPlanBase& exec_plan, ITensorAllocator* planner,
                                       const T& save_tensor_func, const logging::Logger& logger,
-                                      const DataTransferManager& data_transfer_mgr) {
+                                      const DataTransferManager& data_transfer_mgr, bool use_mmap_for_model_loading) {
   LOGS(logger, INFO) << "Saving initialized tensors.";
   ORT_ENFORCE(ort_value_name_idx_map.MaxIdx() > -1, "OrtValue indexes should have been populated.");
 
@@ -187,7 +290,19 @@ common::Status SaveInitializedTensors(const Env& env, const std::basic_string<PA
     ORT_RETURN_IF_ERROR(ort_value_name_idx_map.GetIdx(entry.first, ort_value_index));
     id_to_initialized_tensor[ort_value_index] = entry.second;
   }
+  const std::unordered_set<std::string> prepack_candidates = GetPrePackCandidateInitializers(graph);
+  std::unordered_set<int> zero_copy_initializers;
+  std::unordered_set<int> separately_allocated_initializers;
   for (const auto& entry : id_to_initialized_tensor) {
+    const OrtMemoryInfo& location = exec_plan.GetLocation(entry.first);
+    if (use_mmap_for_model_loading && IsZeroCopyExternalInitializer(*entry.second, location)) {
+      zero_copy_initializers.insert(entry.first);
+      continue;
+    }
+    if (strcmp(location.name, CPU) == 0 && prepack_candidates.count(entry.second->name()) != 0) {
+      separately_allocated_initializers.insert(entry.first);
+      continue;
+    }
     ORT_RETURN_IF_ERROR(planner->Trace(entry.first, entry.second));
   }
 
@@ -201,8 +316,29 @@ common::Status SaveInitializedTensors(const Env& env, const std::basic_string<PA
     const ONNX_NAMESPACE::TensorProto& tensor_proto = *(entry.second);
 
     std::unique_ptr<MemBuffer> m;
-    // TODO: if the tensor need be copied, does it have enough room?
-    ORT_RETURN_IF_ERROR(planner->GetPreallocatedBuffer(ort_value_index, name, m));
+    AllocatorPtr separate_alloc;
+    BufferUniquePtr separate_buffer;
+    if (zero_copy_initializers.find(ort_value_index) != zero_copy_initializers.cend()) {
+      m = onnxruntime::make_unique<MemBuffer>(nullptr, 0, exec_plan.GetLocation(ort_value_index));
+    } else if (separately_allocated_initializers.find(ort_value_index) !=
+               separately_allocated_initializers.cend()) {
+      const OrtMemoryInfo& location = exec_plan.GetLocation(ort_value_index);
+      size_t len = 0;
+      ORT_RETURN_IF_ERROR(utils::GetSizeInBytesFromTensorProto<0>(tensor_proto, &len));
+      void* buffer = nullptr;
+      if (len > 0) {
+        separate_alloc = planner->GetAllocator(location);
+        if (!separate_alloc)
+          return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to get allocator for initializer '", name,
+                                 "', location: ", location.ToString());
+        buffer = separate_alloc->Alloc(len);
+        separate_buffer = BufferUniquePtr(buffer, BufferDeleter(separate_alloc));
+      }
+      m = onnxruntime::make_unique<MemBuffer>(buffer, len, location);
+    } else {
+      // TODO: if the tensor need be copied, does it have enough room?
+      ORT_RETURN_IF_ERROR(planner->GetPreallocatedBuffer(ort_value_index, name, m));
+    }
 #ifndef NDEBUG
     ORT_ENFORCE(m != nullptr);
     ORT_ENFORCE(m->GetBuffer() != nullptr || m->GetLen() == 0);
@@ -215,6 +351,14 @@ common::Status SaveInitializedTensors(const Env& env, const std::basic_string<PA
       return Status(st.Category(), st.Code(), oss.str());
     }
 
+    if (separate_buffer) {
+      // the tensor doesn't own its buffer, so the session state frees it with this deleter when the initializer
+      // is released or the session state is destroyed.
+      ORT_ENFORCE(deleter.f == nullptr, "Unexpected deleter for separately allocated initializer ", name);
+      deleter.f = FreeInitializerBuffer;
+      deleter.param = new InitializerBuffer{separate_alloc, separate_buffer.release()};
+    }
+
     bool constant = graph_utils::IsConstantInitializer(graph, name, /* check_outer_scope */ false);
     ORT_RETURN_IF_ERROR(save_tensor_func(ort_value_index, ort_value, deleter, constant));
 
@@ -19,6 +19,7 @@ class InsertCastTransformer;
 class KernelRegistryManager;
 class Node;
 class NodeArg;
+class SavedSessionState;
 class SessionState;
 
 namespace logging {
@@ -31,16 +32,20 @@ class SessionStateInitializer {
   /**
    *
    * \param graph_loc The file path of where the graph was loaded. e.g. /tmp/test_squeezenet/model.onnx
+   * \param use_mmap_for_model_loading If true, CPU initializers with external data use the mapped file content
+   *        directly instead of being copied into the weights buffer. See SessionOptions::use_mmap_for_model_loading.
    */
   SessionStateInitializer(bool enable_mem_pattern, const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
                           onnxruntime::Graph& graph, SessionState& session_state, const ExecutionProviders& providers,
-                          KernelRegistryManager& kernel_registry_manager);
+                          KernelRegistryManager& kernel_registry_manager, bool use_mmap_for_model_loading = false);
 
   // First perform any transformations and create the execution plan
   // Then initialize tensors, and save. save kernels and input/output node mappings
+  // If saved_state is provided the execution plan is restored from it instead of being created.
   common::Status CreatePlan(_In_opt_ const Node* parent_node,
                             _In_opt_ const ConstPointerContainer<std::vector<NodeArg*>>* outer_scope_node_args,
-                            ExecutionMode execution_mode);
+                            ExecutionMode execution_mode,
+                            _In_opt_ const SavedSessionState* saved_state = nullptr);
 
  private:
   const std::basic_string<PATH_CHAR_TYPE>& graph_loc_;
@@ -51,5 +56,6 @@ class SessionStateInitializer {
   KernelRegistryManager& kernel_registry_manager_;
   const logging::Logger& logger_;
   const bool enable_mem_pattern_;
+  const bool use_mmap_for_model_loading_;
 };
 }  // namespace onnxruntime
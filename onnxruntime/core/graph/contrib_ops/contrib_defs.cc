@@ -289,21 +289,107 @@ const char* contrib_ops_auto_pad_doc =
     "In case of odd number add the extra padding at the end for SAME_UPPER and at the "
     "beginning for SAME_LOWER. VALID mean no padding.";
 
+// Shape inference of EmbedLayerNormalization and QEmbedLayerNormalization. The element type of the output is the
+// type of the input at 'output_type_input_index'.
+void EmbedLayerNormalizationShapeInference(ONNX_NAMESPACE::InferenceContext& ctx, size_t output_type_input_index) {
+  propagateElemTypeFromInputToOutput(ctx, output_type_input_index, 0);
+  propagateElemTypeFromInputToOutput(ctx, 0, 1);
+  if (!hasInputShape(ctx, 0))
+    return;
+
+  auto& input_ids_shape = getInputShape(ctx, 0);
+  auto& input_ids_dims = input_ids_shape.dim();
+
+  // Note that both batch size and sequence length could be symbolic.
+  // So we only check dimension size here.
+  if (input_ids_dims.size() != 2) {
+    fail_shape_inference("Inputs 0 shall be 2 dimensions");
+  }
+
+  // get hidden_size from the last dimension of embedding
+  auto& word_embedding_shape = getInputShape(ctx, 3);
+  auto& word_embedding_dims = word_embedding_shape.dim();
+  if (word_embedding_dims.size() != 2 ||
+      !word_embedding_dims[1].has_dim_value() ||
+      word_embedding_shape.dim(1).dim_value() <= 0) {
+    fail_shape_inference("word_embedding should have 2 dimensions and dimension size is known.");
+  }
+  int64_t hidden_size = word_embedding_shape.dim(1).dim_value();
+
+  // input shape is (batch_size, sequence_length), output shape is (batch_size, sequence_length, hidden_size)
+  ONNX_NAMESPACE::TensorShapeProto output_shape;
+  for (auto& dim : input_ids_dims) {
+    *output_shape.add_dim() = dim;
+  }
+  output_shape.add_dim();
+  output_shape.mutable_dim(2)->set_dim_value(hidden_size);
+
+  updateOutputShape(ctx, 0, output_shape);
+
+  // mask_index shape is (batch_size)
+  ONNX_NAMESPACE::TensorShapeProto mask_index_shape;
+  *mask_index_shape.add_dim() = input_ids_dims[0];
+  updateOutputShape(ctx, 1, mask_index_shape);
+}
+
 void RegisterBertSchemas() {
+  static const char* Attention_ver1_doc = R"DOC(
+Multi-Head Self Attention that can be either unidirectional (like GPT-2) or bidirectional (like BERT).
+The optional past input holds the key and value of previously processed tokens, and the optional present
+output holds the concatenation of past and current key and value. Feeding present back as past of the next
+call lets incremental decoding only project and attend the new tokens.
+mask_index is either the number of valid positions of each batch, or a mask of 1 for the positions to attend and
+0 for padding. When past is given, positions count past and current tokens combined.)DOC";
+
   ONNX_CONTRIB_OPERATOR_SCHEMA(Attention)
       .SetDomain(kMSDomain)
       .SinceVersion(1)
       .SetSupportLevel(OpSchema::SupportType::EXPERIMENTAL)
-      .SetDoc("Multi-Head Self Attention")
+      .SetDoc(Attention_ver1_doc)
       .Attr("num_heads", "Number of attention heads", AttributeProto::INT)
+      .Attr("unidirectional",
+            "Whether every token can only attend to previous tokens. Default value is 0.",
+            AttributeProto::INT,
+            static_cast<int64_t>(0))
       .Input(0, "input", "3D input tensor with shape (batch_size, sequence_length, hidden_size), hidden_size = num_heads * head_size", "T")
       .Input(1, "weight", "2D input tensor with shape (hidden_size, 3 * hidden_size)", "T")
       .Input(2, "bias", "1D input tensor with shape (3 * hidden_size)", "T")
-      .Input(3, "mask_index", "Attention mask index with shape (batch_size)", "M")
+      .Input(3, "mask_index", "Attention mask index with shape (batch_size), or attention mask with shape (batch_size, past_sequence_length + sequence_length)", "M")
+      .Input(4, "past", "past state for key and value with shape (2, batch_size, num_heads, past_sequence_length, head_size).", "T", OpSchema::Optional)
       .Output(0, "output", "3D output tensor with shape (batch_size, sequence_length, hidden_size)", "T")
+      .Output(1, "present", "present state for key and value with shape (2, batch_size, num_heads, past_sequence_length + sequence_length, head_size)", "T", OpSchema::Optional)
       .TypeConstraint("T", {"tensor(float)", "tensor(float16)"}, "Constrain input and output types to float tensors.")
       .TypeConstraint("M", {"tensor(int32)"}, "Constrain mask index to integer types")
-      .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput);
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        if (ctx.getNumOutputs() > 1) {
+          propagateElemTypeFromInputToOutput(ctx, 0, 1);
+        }
+
+        if (!hasInputShape(ctx, 0))
+          return;
+
+        propagateShapeFromInputToOutput(ctx, 0, 0);
+
+        if (ctx.getNumOutputs() > 1 && hasInputShape(ctx, 4)) {
+          auto& past_shape = getInputShape(ctx, 4);
+          auto& past_dims = past_shape.dim();
+          if (past_dims.size() != 5) {
+            fail_shape_inference("Inputs 4 shall be 5 dimensions");
+          }
+
+          // present shape is past shape with sequence_length added to dimension 3
+          auto& input_shape = getInputShape(ctx, 0);
+          if (past_dims[3].has_dim_value() && input_shape.dim(1).has_dim_value()) {
+            ONNX_NAMESPACE::TensorShapeProto present_shape;
+            for (auto& dim : past_dims) {
+              *present_shape.add_dim() = dim;
+            }
+            present_shape.mutable_dim(3)->set_dim_value(past_dims[3].dim_value() + input_shape.dim(1).dim_value());
+            updateOutputShape(ctx, 1, present_shape);
+          }
+        }
+      });
 
   static const char* EmbedLayerNormalization_ver1_doc = R"DOC(
 EmbedLayerNormalization is the fusion of embedding layer in BERT model, with optional mask processing.
@@ -330,44 +416,73 @@ will be calculated.)DOC";
       .TypeConstraint("T1", {"tensor(int32)"}, "Constrain input and output integer tensors types")
       .TypeConstraint("T", {"tensor(float)", "tensor(float16)"}, "Constrain input and output float tensors types.")
       .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
-        propagateElemTypeFromInputToOutput(ctx, 2, 0);
-        propagateElemTypeFromInputToOutput(ctx, 0, 1);
-        if (!hasInputShape(ctx, 0))
-          return;
+        EmbedLayerNormalizationShapeInference(ctx, 2);
+      });
 
-        auto& input_ids_shape = getInputShape(ctx, 0);
-        auto& input_ids_dims = input_ids_shape.dim();
+  static const char* QAttention_ver1_doc = R"DOC(
+Quantization of Multi-Head Self Attention. The input and weight are quantized, and the projection of the input
+to query, key and value is computed by an integer matrix multiplication. The weight can be quantized per tensor,
+or per column with a weight_scale of shape (3 * hidden_size). The result is dequantized with the scales and the
+bias is added before the attention is computed in float.)DOC";
 
-        // Note that both batch size and sequence length could be symbolic.
-        // So we only check dimension size here.
-        if (input_ids_dims.size() != 2) {
-          fail_shape_inference("Inputs 0 shall be 2 dimensions");
-        }
-
-        // get hidden_size from the last dimension of embedding
-        auto& word_embedding_shape = getInputShape(ctx, 3);
-        auto& word_embedding_dims = word_embedding_shape.dim();
-        if (word_embedding_dims.size() != 2 ||
-            !word_embedding_dims[1].has_dim_value() ||
-            word_embedding_shape.dim(1).dim_value() <= 0) {
-          fail_shape_inference("word_embedding should have 2 dimensions and dimension size is known.");
-        }
-        int64_t hidden_size = word_embedding_shape.dim(1).dim_value();
+  ONNX_CONTRIB_OPERATOR_SCHEMA(QAttention)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetSupportLevel(OpSchema::SupportType::EXPERIMENTAL)
+      .SetDoc(QAttention_ver1_doc)
+      .Attr("num_heads", "Number of attention heads", AttributeProto::INT)
+      .Attr("unidirectional",
+            "Whether every token can only attend to previous tokens. Default value is 0.",
+            AttributeProto::INT,
+            static_cast<int64_t>(0))
+      .Input(0, "input", "3D input tensor with shape (batch_size, sequence_length, hidden_size), hidden_size = num_heads * head_size", "T1")
+      .Input(1, "weight", "2D input tensor with shape (hidden_size, 3 * hidden_size)", "T2")
+      .Input(2, "bias", "1D input tensor with shape (3 * hidden_size)", "T3")
+      .Input(3, "input_scale", "scale of quantized input tensor. It's a scalar, which means a per-tensor/layer quantization.", "T3")
+      .Input(4, "weight_scale", "scale of quantized weight tensor. It's a scalar for a per-tensor quantization, or a 1D tensor with shape (3 * hidden_size) for a per-column quantization.", "T3")
+      .Input(5, "mask_index", "Attention mask index with shape (batch_size), or attention mask with shape (batch_size, sequence_length)", "T4", OpSchema::Optional)
+      .Input(6, "input_zero_point", "zero point of quantized input tensor. It's a scalar, which means a per-tensor/layer quantization.", "T1", OpSchema::Optional)
+      .Input(7, "weight_zero_point", "zero point of quantized weight tensor. It's a scalar, which means a per-tensor/layer quantization.", "T2", OpSchema::Optional)
+      .Output(0, "output", "3D output tensor with shape (batch_size, sequence_length, hidden_size)", "T3")
+      .TypeConstraint("T1", {"tensor(uint8)"}, "Constrain input types to uint8 tensors.")
+      .TypeConstraint("T2", {"tensor(int8)", "tensor(uint8)"}, "Constrain weight types to int8 or uint8 tensors.")
+      .TypeConstraint("T3", {"tensor(float)"}, "Constrain bias, scales and output types to float tensors.")
+      .TypeConstraint("T4", {"tensor(int32)"}, "Constrain mask index to integer types")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 2, 0);
 
-        // input shape is (batch_size, sequence_length), output shape is (batch_size, sequence_length, hidden_size)
-        ONNX_NAMESPACE::TensorShapeProto output_shape;
-        for (auto& dim : input_ids_dims) {
-          *output_shape.add_dim() = dim;
-        }
-        output_shape.add_dim();
-        output_shape.mutable_dim(2)->set_dim_value(hidden_size);
+        if (!hasInputShape(ctx, 0))
+          return;
 
-        updateOutputShape(ctx, 0, output_shape);
+        propagateShapeFromInputToOutput(ctx, 0, 0);
+      });
 
-        // mask_index shape is (batch_size)
-        ONNX_NAMESPACE::TensorShapeProto mask_index_shape;
-        *mask_index_shape.add_dim() = input_ids_dims[0];
-        updateOutputShape(ctx, 1, mask_index_shape);
+  ONNX_CONTRIB_OPERATOR_SCHEMA(QEmbedLayerNormalization)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetSupportLevel(OpSchema::SupportType::EXPERIMENTAL)
+      .SetDoc("QEmbedLayerNormalization is EmbedLayerNormalization with quantized embedding tables.")
+      .Input(0, "input_ids", "2D words IDs with shape (batch_size, sequence_length)", "T1")
+      .Input(1, "segment_ids", "2D segment IDs with shape (batch_size, sequence_length)", "T1")
+      .Input(2, "word_embedding_quant", "2D with shape (,hidden_size)", "T2")
+      .Input(3, "position_embedding_quant", "2D with shape (, hidden_size)", "T2")
+      .Input(4, "segment_embedding_quant", "2D with shape (, hidden_size)", "T2")
+      .Input(5, "gamma", "1D gamma tensor for layer normalization with shape (hidden_size)", "T")
+      .Input(6, "beta", "1D beta tensor for layer normalization  with shape (hidden_size)", "T")
+      .Input(7, "mask", "2D attention mask with shape (batch_size, sequence_length)", "T1", OpSchema::Optional)
+      .Input(8, "word_embedding_scale", "Scale of the quantized word embedding. It's a scalar.", "T")
+      .Input(9, "position_embedding_scale", "Scale of the quantized position embedding. It's a scalar.", "T")
+      .Input(10, "segment_embedding_scale", "Scale of the quantized segment embedding. It's a scalar.", "T")
+      .Input(11, "word_embedding_zero_point", "Zero point of the quantized word embedding. It's a scalar.", "T2")
+      .Input(12, "position_embedding_zero_point", "Zero point of the quantized position embedding. It's a scalar.", "T2")
+      .Input(13, "segment_embedding_zero_point", "Zero point of the quantized segment embedding. It's a scalar.", "T2")
+      .Output(0, "output", "3D output tensor with shape (batch_size, sequence_length, hidden_size)", "T")
+      .Output(1, "mask_index", "1D mask_index tensor with shape (batch_size)", "T1")
+      .TypeConstraint("T1", {"tensor(int32)"}, "Constrain input and output integer tensors types")
+      .TypeConstraint("T2", {"tensor(uint8)"}, "Constrain quantized embedding tensors types.")
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output float tensors types.")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        EmbedLayerNormalizationShapeInference(ctx, 5);
       });
 
   static const char* FastGelu_ver1_doc = R"DOC(
@@ -2324,6 +2439,29 @@ It's an extension of Gelu. It takes the sum of input A and bias input B as the i
           "Constrain input and output types to float tensors.")
       .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput);
 
+  static const char* FusedElementwise_ver1_doc = R"DOC(
+Evaluates a chain of element-wise operators in a single pass over the input.
+The chain starts from input X. Each entry of 'ops' is applied in order to the running value.
+Binary entries take their other operand from the next unused input in 'operands', which must either have
+the same shape as X or hold a single element. 'operand_positions' tells whether that operand is the left (0) or
+right (1) side of the binary operator, and is -1 for unary entries.
+Supported ops: Add, Sub, Mul, Div, Relu, Sigmoid, Tanh, Erf, Neg, Abs, Exp, Log, Sqrt, Reciprocal.)DOC";
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(FusedElementwise)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetSupportLevel(OpSchema::SupportType::EXPERIMENTAL)
+      .SetDoc(FusedElementwise_ver1_doc)
+      .Attr("ops", "Element-wise operators to apply, in order.", AttributeProto::STRINGS)
+      .Attr("operand_positions",
+            "Position of the extra operand for each entry of 'ops': 0 for left, 1 for right, -1 for unary ops.",
+            AttributeProto::INTS)
+      .Input(0, "X", "The input that starts the chain.", "T")
+      .Input(1, "operands", "Extra operands of the binary ops, in chain order.", "T", OpSchema::Variadic, true, 0)
+      .Output(0, "Y", "The output, with the same shape as X.", "T")
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+      .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput);
+
   RegisterBertSchemas();
 
 }
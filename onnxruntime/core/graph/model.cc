@@ -3,6 +3,7 @@
 
 #include "core/framework/tensorprotoutils.h"
 #include "core/graph/model.h"
+#include <limits>
 #include <memory>
 #include "core/common/logging/logging.h"
 
@@ -12,6 +13,7 @@
 #pragma warning(disable : 4800)
 #endif
 #include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite.h>
 #ifdef _MSC_VER
 #pragma warning(pop)
 #endif
@@ -20,6 +22,7 @@
 #include "gsl/gsl"
 
 #include "core/platform/env.h"
+#include "core/platform/path_lib.h"
 #include "core/graph/schema_registry.h"
 using namespace ONNX_NAMESPACE;
 using namespace onnxruntime;
@@ -433,6 +436,155 @@ Status Model::LoadFromBytes(int count, void* p_bytes, const PathString& model_pa
 using ::google::protobuf::io::CodedInputStream;
 using ::google::protobuf::io::FileInputStream;
 using ::google::protobuf::io::ZeroCopyInputStream;
+using ::google::protobuf::internal::WireFormatLite;
+
+// initializers smaller than this are kept in the ModelProto. small tensors are commonly read directly from the
+// TensorProto (e.g. shapes consumed by shape inference), and mapping them saves nothing.
+static constexpr int kMinMappedInitializerBytes = 4096;
+
+// field numbers from onnx.proto
+static constexpr int kModelProtoGraphFieldNumber = 7;
+static constexpr int kGraphProtoInitializerFieldNumber = 5;
+static constexpr int kTensorProtoRawDataFieldNumber = 9;
+
+static bool IsLengthDelimitedField(uint32_t tag, int field_number) {
+  return WireFormatLite::GetTagFieldNumber(tag) == field_number &&
+         WireFormatLite::GetTagWireType(tag) == WireFormatLite::WIRETYPE_LENGTH_DELIMITED;
+}
+
+// Walks the serialized ModelProto in 'data' and returns the offset and length of the raw_data of each initializer
+// of the main graph, in the order the initializers are stored. The offset is -1 if an initializer has no raw_data.
+// Returns false if the message is malformed or has a layout that protobuf would merge (e.g. a repeated graph field)
+// as the offsets would not match the parsed ModelProto.
+static bool FindInitializerRawData(const char* data, int length, std::vector<std::pair<int, int>>& raw_data) {
+  CodedInputStream cis(reinterpret_cast<const uint8_t*>(data), length);
+  bool has_graph = false;
+
+  for (uint32_t tag = cis.ReadTag(); tag != 0; tag = cis.ReadTag()) {
+    if (!IsLengthDelimitedField(tag, kModelProtoGraphFieldNumber)) {
+      if (!WireFormatLite::SkipField(&cis, tag)) return false;
+      continue;
+    }
+
+    uint32_t graph_length;
+    if (has_graph || !cis.ReadVarint32(&graph_length)) return false;
+    has_graph = true;
+
+    const auto graph_limit = cis.PushLimit(static_cast<int>(graph_length));
+    for (uint32_t graph_tag = cis.ReadTag(); graph_tag != 0; graph_tag = cis.ReadTag()) {
+      if (!IsLengthDelimitedField(graph_tag, kGraphProtoInitializerFieldNumber)) {
+        if (!WireFormatLite::SkipField(&cis, graph_tag)) return false;
+        continue;
+      }
+
+      uint32_t tensor_length;
+      if (!cis.ReadVarint32(&tensor_length)) return false;
+
+      std::pair<int, int> tensor_raw_data{-1, 0};
+      const auto tensor_limit = cis.PushLimit(static_cast<int>(tensor_length));
+      for (uint32_t tensor_tag = cis.ReadTag(); tensor_tag != 0; tensor_tag = cis.ReadTag()) {
+        if (!IsLengthDelimitedField(tensor_tag, kTensorProtoRawDataFieldNumber)) {
+          if (!WireFormatLite::SkipField(&cis, tensor_tag)) return false;
+          continue;
+        }
+
+        // the last occurrence wins when parsing, which is also what we record here
+        uint32_t raw_data_length;
+        if (!cis.ReadVarint32(&raw_data_length)) return false;
+        tensor_raw_data = {cis.CurrentPosition(), static_cast<int>(raw_data_length)};
+        if (!cis.Skip(static_cast<int>(raw_data_length))) return false;
+      }
+
+      if (!cis.ConsumedEntireMessage()) return false;
+      cis.PopLimit(tensor_limit);
+      raw_data.push_back(tensor_raw_data);
+    }
+
+    if (!cis.ConsumedEntireMessage()) return false;
+    cis.PopLimit(graph_limit);
+  }
+
+  return cis.ConsumedEntireMessage();
+}
+
+// the alignment the data of a tensor needs so that it can be used in place, or 0 if the type is not supported.
+static int GetMappedTensorAlignment(int32_t data_type) {
+  switch (data_type) {
+    case TensorProto_DataType_BOOL:
+    case TensorProto_DataType_INT8:
+    case TensorProto_DataType_UINT8:
+      return 1;
+    case TensorProto_DataType_INT16:
+    case TensorProto_DataType_UINT16:
+    case TensorProto_DataType_FLOAT16:
+    case TensorProto_DataType_BFLOAT16:
+      return 2;
+    case TensorProto_DataType_FLOAT:
+    case TensorProto_DataType_INT32:
+    case TensorProto_DataType_UINT32:
+      return 4;
+    case TensorProto_DataType_DOUBLE:
+    case TensorProto_DataType_INT64:
+    case TensorProto_DataType_UINT64:
+      return 8;
+    default:
+      return 0;
+  }
+}
+
+static void AddExternalDataEntry(TensorProto& tensor_proto, const std::string& key, const std::string& value) {
+  auto* entry = tensor_proto.add_external_data();
+  entry->set_key(key);
+  entry->set_value(value);
+}
+
+Status Model::LoadMapped(const PathString& file_path, ModelProto& model_proto) {
+  const Env& env = Env::Default();
+  size_t length = 0;
+  Env::MappedMemoryPtr mapped_model;
+  if (!env.GetFileLength(file_path.c_str(), length).IsOK() || length == 0 ||
+      length > static_cast<size_t>(std::numeric_limits<int>::max()) ||
+      !env.MapFileIntoMemory(file_path.c_str(), 0, length, mapped_model).IsOK()) {
+    // mapping is an optimization only
+    return Load(file_path, model_proto);
+  }
+
+  const int model_length = static_cast<int>(length);
+  if (!model_proto.ParseFromArray(mapped_model.get(), model_length)) {
+    return Status(ONNXRUNTIME, INVALID_PROTOBUF, "Protobuf parsing failed.");
+  }
+
+  std::vector<std::pair<int, int>> raw_data;
+  if (!utils::HasGraph(model_proto) || !FindInitializerRawData(mapped_model.get(), model_length, raw_data) ||
+      static_cast<int>(raw_data.size()) != model_proto.graph().initializer_size()) {
+    // the model is loaded, the initializers just keep their copy of the data
+    return Status::OK();
+  }
+
+  // external data locations are relative to the directory of the model
+  const std::string location = ToMBString(GetLastComponent(file_path));
+
+  for (int i = 0, end = model_proto.graph().initializer_size(); i < end; ++i) {
+    const int offset = raw_data[i].first;
+    const int raw_data_length = raw_data[i].second;
+    TensorProto& tensor_proto = *model_proto.mutable_graph()->mutable_initializer(i);
+    const int alignment = GetMappedTensorAlignment(tensor_proto.data_type());
+
+    if (offset < 0 || raw_data_length < kMinMappedInitializerBytes || alignment == 0 || offset % alignment != 0 ||
+        !utils::HasRawData(tensor_proto) || tensor_proto.raw_data().size() != static_cast<size_t>(raw_data_length)) {
+      continue;
+    }
+
+    tensor_proto.clear_raw_data();
+    tensor_proto.clear_external_data();
+    tensor_proto.set_data_location(TensorProto_DataLocation_EXTERNAL);
+    AddExternalDataEntry(tensor_proto, "location", location);
+    AddExternalDataEntry(tensor_proto, "offset", std::to_string(offset));
+    AddExternalDataEntry(tensor_proto, "length", std::to_string(raw_data_length));
+  }
+
+  return Status::OK();
+}
 
 Status Model::Load(int fd, ONNX_NAMESPACE::ModelProto& model_proto) {
   if (fd < 0) {
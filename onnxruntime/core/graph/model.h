@@ -129,6 +129,14 @@ class Model {
   static common::Status Load(const PathString& file_path,
                              /*out*/ ONNX_NAMESPACE::ModelProto& model_proto);
 
+  // Loads the model from a memory mapping of 'file_path'. The raw data of large initializers of the main graph is
+  // not copied into 'model_proto'. Those initializers are changed to reference their bytes within the model file
+  // as external data, so that they can be mapped into tensors without a copy when the session is initialized.
+  // The file must therefore not be modified while the model is in use.
+  // Falls back to Load if the file can't be mapped.
+  static common::Status LoadMapped(const PathString& file_path,
+                                   /*out*/ ONNX_NAMESPACE::ModelProto& model_proto);
+
   // TODO(Task:132) Use of shared_ptr<X>* in Load/Save methods is confusing.
   static common::Status Load(const PathString& file_path,
                              /*out*/ std::shared_ptr<Model>& p_model,
@@ -147,6 +147,48 @@ MlasGemm(
     MLAS_THREADPOOL* ThreadPool
     );
 
+//
+// Matrix/matrix multiply routines for a prepacked matrix B.
+//
+// The packed buffer is opaque to the caller and is only valid for the MLAS
+// build and processor that packed it.
+//
+
+size_t
+MLASCALL
+MlasGemmPackBSize(
+    size_t N,
+    size_t K
+    );
+
+void
+MLASCALL
+MlasGemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    );
+
+void
+MLASCALL
+MlasGemm(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const void* PackedB,
+    float beta,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 void
 MLASCALL
 MlasGemm(
@@ -306,11 +348,29 @@ MlasComputeErf(
     size_t N
     );
 
+void
+MLASCALL
+MlasComputeExp(
+    const float* Input,
+    float* Output,
+    size_t N
+    );
+
+void
+MLASCALL
+MlasComputeSoftmax(
+    const float* Input,
+    float* Output,
+    size_t N,
+    size_t D,
+    bool LogSoftmax,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 //
 // Half-precision floating-point routines.
 //
 
-extern "C"
 void
 MLASCALL
 MlasConvertHalfToFloatBuffer(
@@ -319,6 +379,14 @@ MlasConvertHalfToFloatBuffer(
     size_t Count
     );
 
+void
+MLASCALL
+MlasConvertFloatToHalfBuffer(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    );
+
 //
 // Buffer reordering routines.
 //
@@ -363,6 +431,57 @@ MlasReorderFilterOIHWBo(
     float* D
     );
 
+//
+// Transpose routines.
+//
+// The source matrix has M rows and N columns, and the destination matrix has
+// N rows and M columns.
+//
+
+void
+MLASCALL
+MlasTranspose(
+    size_t M,
+    size_t N,
+    const uint8_t* Input,
+    size_t lda,
+    uint8_t* Output,
+    size_t ldb
+    );
+
+void
+MLASCALL
+MlasTranspose(
+    size_t M,
+    size_t N,
+    const uint16_t* Input,
+    size_t lda,
+    uint16_t* Output,
+    size_t ldb
+    );
+
+void
+MLASCALL
+MlasTranspose(
+    size_t M,
+    size_t N,
+    const uint32_t* Input,
+    size_t lda,
+    uint32_t* Output,
+    size_t ldb
+    );
+
+void
+MLASCALL
+MlasTranspose(
+    size_t M,
+    size_t N,
+    const uint64_t* Input,
+    size_t lda,
+    uint64_t* Output,
+    size_t ldb
+    );
+
 //
 // Single precision NCHWc routines.
 //
@@ -451,3 +570,39 @@ MlasRequantizeOutput(
     float Scale,
     uint8_t ZeroPoint
     );
+
+//
+// Element-wise binary routines for linearly quantized buffers.
+//
+
+void
+MLASCALL
+MlasQLinearAdd(
+    const uint8_t* InputA,
+    float ScaleA,
+    uint8_t ZeroPointA,
+    const uint8_t* InputB,
+    float ScaleB,
+    uint8_t ZeroPointB,
+    float ScaleC,
+    uint8_t ZeroPointC,
+    uint8_t* OutputC,
+    size_t N,
+    bool IsScalarB
+    );
+
+void
+MLASCALL
+MlasQLinearMul(
+    const uint8_t* InputA,
+    float ScaleA,
+    uint8_t ZeroPointA,
+    const uint8_t* InputB,
+    float ScaleB,
+    uint8_t ZeroPointB,
+    float ScaleC,
+    uint8_t ZeroPointC,
+    uint8_t* OutputC,
+    size_t N,
+    bool IsScalarB
+    );
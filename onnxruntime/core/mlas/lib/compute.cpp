@@ -0,0 +1,762 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    compute.cpp
+
+Abstract:
+
+    This module implements miscellaneous computation routines.
+
+    The exponential function is computed by reducing the input to the range
+    [-ln2/2, ln2/2] and evaluating a polynomial approximation:
+
+        exp(x) = 2^m * exp(r), where m = round(x / ln2) and r = x - m * ln2
+
+    The reduction uses a high and a low part of ln2 so that r is computed
+    without losing precision. This uses the same polynomial coefficients as
+    the exponential used by the error function.
+
+    The softmax routines are built from the exponential: the maximum of each
+    row is subtracted from every element before computing the exponential
+    so that the sum of the row cannot overflow.
+
+--*/
+
+#include "mlasi.h"
+
+#include <cmath>
+#include <limits>
+
+//
+// Bundles the floating point constants for use by kernels written in assembly.
+//
+
+MLAS_INTERNAL_DATA const struct {
+    float LowerRange;
+    float UpperRange;
+    float RoundingBias;
+    float Log2Reciprocal;
+    float Log2High;
+    float Log2Low;
+    float poly_0;
+    float poly_1;
+    float poly_2;
+    float poly_3;
+    float poly_4;
+    float poly_56;
+    float MinimumExponent;
+    float MaximumExponent;
+} MlasExpConstants = {
+    -103.9720840454f,
+    88.7762626647950f,
+    12582912.0f,
+    1.44269504088896341f,
+    -6.93145752e-1f,
+    -1.42860677e-6f,
+    1.38319808e-3f,
+    8.37550033e-3f,
+    4.16689515e-2f,
+    1.66664466e-1f,
+    4.99999851e-1f,
+    1.00000000e+0f,
+    -126.0f,
+    127.0f,
+};
+
+//
+// Stores the parameters of a softmax operation split across threads.
+//
+
+struct MLAS_SOFTMAX_WORK_BLOCK {
+    int32_t ThreadCountN;
+    bool LogSoftmax;
+    const float* Input;
+    float* Output;
+    size_t N;
+    size_t D;
+};
+
+MLAS_FORCEINLINE
+MLAS_FLOAT32X4
+MlasComputeExpVector(
+    MLAS_FLOAT32X4 Vector
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the exponential function for a vector of values
+    that are already clamped to the range supported by the approximation.
+
+Arguments:
+
+    Vector - Supplies the input values.
+
+Return Value:
+
+    Returns the exponential of each value.
+
+--*/
+{
+    //
+    // Compute m = round(x / ln2) by adding and subtracting a bias that moves
+    // the fractional bits out of the mantissa.
+    //
+
+    const MLAS_FLOAT32X4 RoundingBias = MlasBroadcastFloat32x4(MlasExpConstants.RoundingBias);
+
+    MLAS_FLOAT32X4 m = MlasMultiplyAddFloat32x4(Vector,
+        MlasBroadcastFloat32x4(MlasExpConstants.Log2Reciprocal), RoundingBias);
+    m = MlasSubtractFloat32x4(m, RoundingBias);
+
+    MLAS_FLOAT32X4 r = MlasMultiplyAddFloat32x4(m, MlasBroadcastFloat32x4(MlasExpConstants.Log2High), Vector);
+    r = MlasMultiplyAddFloat32x4(m, MlasBroadcastFloat32x4(MlasExpConstants.Log2Low), r);
+
+    MLAS_FLOAT32X4 p = MlasBroadcastFloat32x4(MlasExpConstants.poly_0);
+    p = MlasMultiplyAddFloat32x4(p, r, MlasBroadcastFloat32x4(MlasExpConstants.poly_1));
+    p = MlasMultiplyAddFloat32x4(p, r, MlasBroadcastFloat32x4(MlasExpConstants.poly_2));
+    p = MlasMultiplyAddFloat32x4(p, r, MlasBroadcastFloat32x4(MlasExpConstants.poly_3));
+    p = MlasMultiplyAddFloat32x4(p, r, MlasBroadcastFloat32x4(MlasExpConstants.poly_4));
+    p = MlasMultiplyAddFloat32x4(p, r, MlasBroadcastFloat32x4(MlasExpConstants.poly_56));
+    p = MlasMultiplyAddFloat32x4(p, r, MlasBroadcastFloat32x4(MlasExpConstants.poly_56));
+
+    //
+    // Scale by 2^m in two steps so that results in the denormal range and
+    // results that overflow are produced without building an invalid
+    // exponent.
+    //
+
+    MLAS_FLOAT32X4 NormalExponent = MlasMaximumFloat32x4(m, MlasBroadcastFloat32x4(MlasExpConstants.MinimumExponent));
+    NormalExponent = MlasMinimumFloat32x4(NormalExponent, MlasBroadcastFloat32x4(MlasExpConstants.MaximumExponent));
+    MLAS_FLOAT32X4 OverflowExponent = MlasSubtractFloat32x4(m, NormalExponent);
+
+    p = MlasMultiplyFloat32x4(p, MlasPowerOf2Float32x4(NormalExponent));
+    p = MlasMultiplyFloat32x4(p, MlasPowerOf2Float32x4(OverflowExponent));
+
+    return p;
+}
+
+MLAS_FORCEINLINE
+float
+MlasComputeExpValue(
+    float Value
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the exponential function for a single value that
+    is already clamped to the range supported by the approximation.
+
+Arguments:
+
+    Value - Supplies the input value.
+
+Return Value:
+
+    Returns the exponential of the value.
+
+--*/
+{
+    float m = Value * MlasExpConstants.Log2Reciprocal + MlasExpConstants.RoundingBias;
+    m -= MlasExpConstants.RoundingBias;
+
+    float r = m * MlasExpConstants.Log2High + Value;
+    r = m * MlasExpConstants.Log2Low + r;
+
+    float p = MlasExpConstants.poly_0;
+    p = p * r + MlasExpConstants.poly_1;
+    p = p * r + MlasExpConstants.poly_2;
+    p = p * r + MlasExpConstants.poly_3;
+    p = p * r + MlasExpConstants.poly_4;
+    p = p * r + MlasExpConstants.poly_56;
+    p = p * r + MlasExpConstants.poly_56;
+
+    return ldexpf(p, int32_t(m));
+}
+
+void
+MLASCALL
+MlasExpKernel(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel for the exponential function.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_FLOAT32X4 LowerRange = MlasBroadcastFloat32x4(MlasExpConstants.LowerRange);
+    const MLAS_FLOAT32X4 UpperRange = MlasBroadcastFloat32x4(MlasExpConstants.UpperRange);
+
+    while (N >= 4) {
+
+        MLAS_FLOAT32X4 Vector = MlasLoadFloat32x4(Input);
+
+        Vector = MlasMaximumFloat32x4(LowerRange, Vector);
+        Vector = MlasMinimumFloat32x4(UpperRange, Vector);
+
+        MlasStoreFloat32x4(Output, MlasComputeExpVector(Vector));
+
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        float Value = *Input++;
+
+        Value = (std::min)(MlasExpConstants.UpperRange, (std::max)(MlasExpConstants.LowerRange, Value));
+
+        *Output++ = MlasComputeExpValue(Value);
+
+        N -= 1;
+    }
+}
+
+void
+MLASCALL
+MlasComputeExp(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the exponential function.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasExpKernel(Input, Output, N);
+}
+
+float
+MLASCALL
+MlasReduceMaximumKernel(
+    const float* Input,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel to find the maximum value of
+    the supplied buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    Returns the maximum value of the supplied buffer.
+
+--*/
+{
+    float Maximum = std::numeric_limits<float>::lowest();
+
+    if (N >= 4) {
+
+        MLAS_FLOAT32X4 MaximumVector0 = MlasBroadcastFloat32x4(Maximum);
+
+        if (N >= 16) {
+
+            MLAS_FLOAT32X4 MaximumVector1 = MaximumVector0;
+            MLAS_FLOAT32X4 MaximumVector2 = MaximumVector0;
+            MLAS_FLOAT32X4 MaximumVector3 = MaximumVector0;
+
+            while (N >= 16) {
+
+                MaximumVector0 = MlasMaximumFloat32x4(MaximumVector0, MlasLoadFloat32x4(Input));
+                MaximumVector1 = MlasMaximumFloat32x4(MaximumVector1, MlasLoadFloat32x4(Input + 4));
+                MaximumVector2 = MlasMaximumFloat32x4(MaximumVector2, MlasLoadFloat32x4(Input + 8));
+                MaximumVector3 = MlasMaximumFloat32x4(MaximumVector3, MlasLoadFloat32x4(Input + 12));
+
+                Input += 16;
+                N -= 16;
+            }
+
+            MaximumVector0 = MlasMaximumFloat32x4(MaximumVector0, MaximumVector1);
+            MaximumVector2 = MlasMaximumFloat32x4(MaximumVector2, MaximumVector3);
+            MaximumVector0 = MlasMaximumFloat32x4(MaximumVector0, MaximumVector2);
+        }
+
+        while (N >= 4) {
+
+            MaximumVector0 = MlasMaximumFloat32x4(MaximumVector0, MlasLoadFloat32x4(Input));
+
+            Input += 4;
+            N -= 4;
+        }
+
+        Maximum = (std::max)(Maximum, MlasExtractLaneFloat32x4<0>(MaximumVector0));
+        Maximum = (std::max)(Maximum, MlasExtractLaneFloat32x4<1>(MaximumVector0));
+        Maximum = (std::max)(Maximum, MlasExtractLaneFloat32x4<2>(MaximumVector0));
+        Maximum = (std::max)(Maximum, MlasExtractLaneFloat32x4<3>(MaximumVector0));
+    }
+
+    while (N > 0) {
+
+        Maximum = (std::max)(Maximum, *Input);
+
+        Input += 1;
+        N -= 1;
+    }
+
+    return Maximum;
+}
+
+float
+MLASCALL
+MlasComputeSumExpKernel(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float NegativeMaximum
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel to compute the exponential of
+    the supplied buffer offset by the negative maximum value and to sum the
+    results.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Optionally supplies the output buffer. When used by the softmax
+        routine, the intermediate exponential values are stored here.
+
+    N - Supplies the number of elements to process.
+
+    NegativeMaximum - Supplies the negated maximum value of the input buffer.
+
+Return Value:
+
+    Returns the sum of the exponential values.
+
+--*/
+{
+    const MLAS_FLOAT32X4 LowerRange = MlasBroadcastFloat32x4(MlasExpConstants.LowerRange);
+    const MLAS_FLOAT32X4 NegativeMaximumVector = MlasBroadcastFloat32x4(NegativeMaximum);
+
+    float Accumulator = 0.0f;
+
+    if (N >= 4) {
+
+        MLAS_FLOAT32X4 AccumulatorVector0 = MlasZeroFloat32x4();
+
+        if (N >= 8) {
+
+            MLAS_FLOAT32X4 AccumulatorVector1 = MlasZeroFloat32x4();
+
+            while (N >= 8) {
+
+                MLAS_FLOAT32X4 Vector0 = MlasAddFloat32x4(MlasLoadFloat32x4(Input), NegativeMaximumVector);
+                MLAS_FLOAT32X4 Vector1 = MlasAddFloat32x4(MlasLoadFloat32x4(Input + 4), NegativeMaximumVector);
+
+                Vector0 = MlasComputeExpVector(MlasMaximumFloat32x4(LowerRange, Vector0));
+                Vector1 = MlasComputeExpVector(MlasMaximumFloat32x4(LowerRange, Vector1));
+
+                if (Output != nullptr) {
+                    MlasStoreFloat32x4(Output, Vector0);
+                    MlasStoreFloat32x4(Output + 4, Vector1);
+                    Output += 8;
+                }
+
+                AccumulatorVector0 = MlasAddFloat32x4(AccumulatorVector0, Vector0);
+                AccumulatorVector1 = MlasAddFloat32x4(AccumulatorVector1, Vector1);
+
+                Input += 8;
+                N -= 8;
+            }
+
+            AccumulatorVector0 = MlasAddFloat32x4(AccumulatorVector0, AccumulatorVector1);
+        }
+
+        while (N >= 4) {
+
+            MLAS_FLOAT32X4 Vector = MlasAddFloat32x4(MlasLoadFloat32x4(Input), NegativeMaximumVector);
+
+            Vector = MlasComputeExpVector(MlasMaximumFloat32x4(LowerRange, Vector));
+
+            if (Output != nullptr) {
+                MlasStoreFloat32x4(Output, Vector);
+                Output += 4;
+            }
+
+            AccumulatorVector0 = MlasAddFloat32x4(AccumulatorVector0, Vector);
+
+            Input += 4;
+            N -= 4;
+        }
+
+        Accumulator = MlasExtractLaneFloat32x4<0>(AccumulatorVector0) +
+            MlasExtractLaneFloat32x4<1>(AccumulatorVector0) +
+            MlasExtractLaneFloat32x4<2>(AccumulatorVector0) +
+            MlasExtractLaneFloat32x4<3>(AccumulatorVector0);
+    }
+
+    while (N > 0) {
+
+        float Value = (std::max)(MlasExpConstants.LowerRange, *Input + NegativeMaximum);
+
+        Value = MlasComputeExpValue(Value);
+
+        if (Output != nullptr) {
+            *Output++ = Value;
+        }
+
+        Accumulator += Value;
+
+        Input += 1;
+        N -= 1;
+    }
+
+    return Accumulator;
+}
+
+void
+MLASCALL
+MlasComputeSoftmaxOutputKernel(
+    float* Output,
+    size_t N,
+    float Scale
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel to scale the exponential
+    values of a softmax row by the reciprocal of their sum.
+
+Arguments:
+
+    Output - Supplies the output buffer, which holds the exponential values.
+
+    N - Supplies the number of elements to process.
+
+    Scale - Supplies the reciprocal of the sum of the exponential values.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_FLOAT32X4 ScaleVector = MlasBroadcastFloat32x4(Scale);
+
+    while (N >= 16) {
+
+        MLAS_FLOAT32X4 Vector0 = MlasMultiplyFloat32x4(ScaleVector, MlasLoadFloat32x4(Output));
+        MLAS_FLOAT32X4 Vector1 = MlasMultiplyFloat32x4(ScaleVector, MlasLoadFloat32x4(Output + 4));
+        MLAS_FLOAT32X4 Vector2 = MlasMultiplyFloat32x4(ScaleVector, MlasLoadFloat32x4(Output + 8));
+        MLAS_FLOAT32X4 Vector3 = MlasMultiplyFloat32x4(ScaleVector, MlasLoadFloat32x4(Output + 12));
+
+        MlasStoreFloat32x4(Output, Vector0);
+        MlasStoreFloat32x4(Output + 4, Vector1);
+        MlasStoreFloat32x4(Output + 8, Vector2);
+        MlasStoreFloat32x4(Output + 12, Vector3);
+
+        Output += 16;
+        N -= 16;
+    }
+
+    while (N >= 4) {
+
+        MlasStoreFloat32x4(Output, MlasMultiplyFloat32x4(ScaleVector, MlasLoadFloat32x4(Output)));
+
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        *Output *= Scale;
+
+        Output += 1;
+        N -= 1;
+    }
+}
+
+void
+MLASCALL
+MlasComputeLogSoftmaxOutputKernel(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float Offset
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel to compute the log softmax
+    values of a row from the input values.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+    Offset - Supplies the negated sum of the row maximum and the logarithm of
+        the sum of the exponential values.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_FLOAT32X4 OffsetVector = MlasBroadcastFloat32x4(Offset);
+
+    while (N >= 16) {
+
+        MLAS_FLOAT32X4 Vector0 = MlasAddFloat32x4(OffsetVector, MlasLoadFloat32x4(Input));
+        MLAS_FLOAT32X4 Vector1 = MlasAddFloat32x4(OffsetVector, MlasLoadFloat32x4(Input + 4));
+        MLAS_FLOAT32X4 Vector2 = MlasAddFloat32x4(OffsetVector, MlasLoadFloat32x4(Input + 8));
+        MLAS_FLOAT32X4 Vector3 = MlasAddFloat32x4(OffsetVector, MlasLoadFloat32x4(Input + 12));
+
+        MlasStoreFloat32x4(Output, Vector0);
+        MlasStoreFloat32x4(Output + 4, Vector1);
+        MlasStoreFloat32x4(Output + 8, Vector2);
+        MlasStoreFloat32x4(Output + 12, Vector3);
+
+        Input += 16;
+        Output += 16;
+        N -= 16;
+    }
+
+    while (N >= 4) {
+
+        MlasStoreFloat32x4(Output, MlasAddFloat32x4(OffsetVector, MlasLoadFloat32x4(Input)));
+
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        *Output = *Input + Offset;
+
+        Input += 1;
+        Output += 1;
+        N -= 1;
+    }
+}
+
+void
+MlasComputeSoftmaxThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    softmax or log softmax operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_SOFTMAX_WORK_BLOCK*)Context;
+
+    //
+    // Partition the operation along the N dimension.
+    //
+
+    size_t n;
+    size_t CountN;
+
+    MlasPartitionWork(Index, WorkBlock->ThreadCountN, WorkBlock->N, &n, &CountN);
+
+    //
+    // Compute the softmax or log softmax function.
+    //
+
+    const size_t D = WorkBlock->D;
+    const bool LogSoftmax = WorkBlock->LogSoftmax;
+
+    const float* Input = WorkBlock->Input + n * D;
+    float* Output = WorkBlock->Output + n * D;
+
+    while (CountN > 0) {
+
+        //
+        // Find the maximum value for the row.
+        //
+
+        float Maximum = MlasReduceMaximumKernel(Input, D);
+        float NegativeMaximum = -Maximum;
+
+        if (LogSoftmax) {
+
+            //
+            // Compute the sum of the exponential functions for the row.
+            //
+
+            float Accumulation = MlasComputeSumExpKernel(Input, nullptr, D, NegativeMaximum);
+
+            //
+            // Compute the log softmax output.
+            //
+
+            float Offset = NegativeMaximum - std::log(Accumulation);
+
+            MlasComputeLogSoftmaxOutputKernel(Input, Output, D, Offset);
+
+        } else {
+
+            //
+            // Compute the exponential function for each element of the row
+            // and compute the sum of these exponential functions.
+            //
+
+            float Accumulation = MlasComputeSumExpKernel(Input, Output, D, NegativeMaximum);
+
+            //
+            // Normalize the softmax output.
+            //
+
+            float Parameter = 1.0f / Accumulation;
+
+            MlasComputeSoftmaxOutputKernel(Output, D, Parameter);
+        }
+
+        Input += D;
+        Output += D;
+        CountN--;
+    }
+}
+
+void
+MLASCALL
+MlasComputeSoftmax(
+    const float* Input,
+    float* Output,
+    size_t N,
+    size_t D,
+    bool LogSoftmax,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the softmax or log softmax function.
+
+    N.B. This implementation supports in place updates of the output buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of rows to process.
+
+    D - Supplies the number of columns per row to process.
+
+    LogSoftmax - Supplies true if this is a log softmax operation, else false
+        if this is a softmax operation.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_SOFTMAX_WORK_BLOCK WorkBlock;
+
+    //
+    // Capture the softmax parameters to the work block.
+    //
+
+    WorkBlock.LogSoftmax = LogSoftmax;
+    WorkBlock.Input = Input;
+    WorkBlock.Output = Output;
+    WorkBlock.N = N;
+    WorkBlock.D = D;
+
+    //
+    // Compute the number of target threads given the complexity of the softmax
+    // operation. Limit the number of threads to the number of rows and try to
+    // keep each thread processing a minimum number of elements before using
+    // another thread.
+    //
+
+    int32_t ThreadCountN = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (size_t(ThreadCountN) > N) {
+        ThreadCountN = int32_t(N);
+    }
+
+    constexpr size_t MinimumElementsPerThread = 16384;
+
+    size_t BlockCount = ((N * D) / MinimumElementsPerThread) + 1;
+
+    if (size_t(ThreadCountN) > BlockCount) {
+        ThreadCountN = int32_t(BlockCount);
+    }
+
+    WorkBlock.ThreadCountN = ThreadCountN;
+
+    MlasExecuteThreaded(MlasComputeSoftmaxThreaded, &WorkBlock, ThreadCountN, ThreadPool);
+}
@@ -0,0 +1,249 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    cvtfp16.cpp
+
+Abstract:
+
+    This module implements routines to convert between FP16 and FP32 formats.
+
+    The implementation below targets the base instruction set and handles
+    denormals, infinities and NaNs the same way as the F16C instructions, so
+    the result does not depend on which kernel the platform selects.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Helpers to reinterpret the bits of a single precision float.
+//
+
+MLAS_FORCEINLINE
+uint32_t
+MlasBitsOfFloat32(
+    float Value
+    )
+{
+    uint32_t Bits;
+    memcpy(&Bits, &Value, sizeof(Bits));
+    return Bits;
+}
+
+MLAS_FORCEINLINE
+float
+MlasFloat32FromBits(
+    uint32_t Bits
+    )
+{
+    float Value;
+    memcpy(&Value, &Bits, sizeof(Value));
+    return Value;
+}
+
+void
+MLASCALL
+MlasConvertHalfToFloatKernel(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts the source buffer of half-precision floats to the
+    destination buffer of single-precision floats.
+
+    The exponent/mantissa bits are shifted into place and rebiased. Denormals
+    are normalized by subtracting a magic value in the floating point domain
+    and signaling NaNs become quiet NaNs.
+
+Arguments:
+
+    Source - Supplies the address of the source buffer of half-precision
+        floats.
+
+    Destination - Supplies the address of the destination buffer of
+        single-precision floats.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float MagicDenormal = MlasFloat32FromBits(0x38800000);
+
+    for (size_t n = 0; n < Count; n++) {
+
+        uint32_t Half = Source[n];
+        uint32_t Sign = (Half & 0x8000) << 16;
+        uint32_t ExponentMantissa = (Half & 0x7FFF) << 13;
+        uint32_t Bits;
+
+        if (ExponentMantissa < (0x0400 << 13)) {
+            Bits = MlasBitsOfFloat32(MlasFloat32FromBits(ExponentMantissa + 0x38800000) - MagicDenormal);
+        } else if (ExponentMantissa > (0x7C00 << 13)) {
+            Bits = (ExponentMantissa + 0x70000000) | 0x00400000;
+        } else if (ExponentMantissa == (0x7C00 << 13)) {
+            Bits = 0x7F800000;
+        } else {
+            Bits = ExponentMantissa + 0x38000000;
+        }
+
+        Destination[n] = MlasFloat32FromBits(Sign | Bits);
+    }
+}
+
+void
+MLASCALL
+MlasConvertFloatToHalfKernel(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts the source buffer of single-precision floats to the
+    destination buffer of half-precision floats.
+
+    Values are rounded to nearest even. Values too large for the half-precision
+    format become infinities and NaNs become quiet NaNs.
+
+Arguments:
+
+    Source - Supplies the address of the source buffer of single-precision
+        floats.
+
+    Destination - Supplies the address of the destination buffer of
+        half-precision floats.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float DenormalMagic = MlasFloat32FromBits(0x3F000000);
+
+    for (size_t n = 0; n < Count; n++) {
+
+        uint32_t Bits = MlasBitsOfFloat32(Source[n]);
+        uint32_t Sign = Bits & 0x80000000;
+        uint32_t Half;
+
+        Bits ^= Sign;
+
+        if (Bits >= 0x47800000) {
+
+            //
+            // Overflow to infinity or propagate a quiet NaN.
+            //
+
+            Half = (Bits > 0x7F800000) ? (0x7E00 | ((Bits >> 13) & 0x3FF)) : 0x7C00;
+
+        } else if (Bits < 0x38800000) {
+
+            //
+            // Let the floating point addition round the denormal result.
+            //
+
+            Half = MlasBitsOfFloat32(MlasFloat32FromBits(Bits) + DenormalMagic) - 0x3F000000;
+
+        } else {
+
+            uint32_t MantissaOdd = (Bits >> 13) & 1;
+
+            Bits += 0xC8000FFF + MantissaOdd;
+            Half = Bits >> 13;
+        }
+
+        Destination[n] = (unsigned short)(Half | (Sign >> 16));
+    }
+}
+
+void
+MLASCALL
+MlasConvertHalfToFloatBuffer(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts the source buffer of half-precision floats to the
+    destination buffer of single-precision floats.
+
+Arguments:
+
+    Source - Supplies the address of the source buffer of half-precision
+        floats.
+
+    Destination - Supplies the address of the destination buffer of
+        single-precision floats.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+    MlasPlatform.ConvertHalfToFloatKernelRoutine(Source, Destination, Count);
+#else
+    MlasConvertHalfToFloatKernel(Source, Destination, Count);
+#endif
+}
+
+void
+MLASCALL
+MlasConvertFloatToHalfBuffer(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts the source buffer of single-precision floats to the
+    destination buffer of half-precision floats.
+
+Arguments:
+
+    Source - Supplies the address of the source buffer of single-precision
+        floats.
+
+    Destination - Supplies the address of the destination buffer of
+        half-precision floats.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+    MlasPlatform.ConvertFloatToHalfKernelRoutine(Source, Destination, Count);
+#else
+    MlasConvertFloatToHalfKernel(Source, Destination, Count);
+#endif
+}
@@ -0,0 +1,149 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    cvtfp16f16c.cpp
+
+Abstract:
+
+    This module implements routines to convert between FP16 and FP32 formats.
+
+    This implementation uses F16C instructions.
+
+--*/
+
+#include "mlasi.h"
+
+void
+MLASCALL
+MlasConvertHalfToFloatKernelF16C(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts the source buffer of half-precision floats to the
+    destination buffer of single-precision floats.
+
+Arguments:
+
+    Source - Supplies the address of the source buffer of half-precision
+        floats.
+
+    Destination - Supplies the address of the destination buffer of
+        single-precision floats.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (Count >= 16) {
+
+        __m128i HalfVector0 = _mm_loadu_si128((const __m128i*)Source);
+        __m128i HalfVector1 = _mm_loadu_si128((const __m128i*)(Source + 8));
+
+        _mm256_storeu_ps(Destination, _mm256_cvtph_ps(HalfVector0));
+        _mm256_storeu_ps(Destination + 8, _mm256_cvtph_ps(HalfVector1));
+
+        Source += 16;
+        Destination += 16;
+        Count -= 16;
+    }
+
+    if (Count >= 8) {
+
+        __m128i HalfVector = _mm_loadu_si128((const __m128i*)Source);
+
+        _mm256_storeu_ps(Destination, _mm256_cvtph_ps(HalfVector));
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+    if (Count > 0) {
+
+        MLAS_DECLSPEC_ALIGN(unsigned short HalfBuffer[8], 16) = { 0 };
+        MLAS_DECLSPEC_ALIGN(float FloatBuffer[8], 32);
+
+        memcpy(HalfBuffer, Source, Count * sizeof(unsigned short));
+        _mm256_store_ps(FloatBuffer, _mm256_cvtph_ps(_mm_load_si128((const __m128i*)HalfBuffer)));
+        memcpy(Destination, FloatBuffer, Count * sizeof(float));
+    }
+}
+
+void
+MLASCALL
+MlasConvertFloatToHalfKernelF16C(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts the source buffer of single-precision floats to the
+    destination buffer of half-precision floats using round to nearest even.
+
+Arguments:
+
+    Source - Supplies the address of the source buffer of single-precision
+        floats.
+
+    Destination - Supplies the address of the destination buffer of
+        half-precision floats.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (Count >= 16) {
+
+        __m256 FloatVector0 = _mm256_loadu_ps(Source);
+        __m256 FloatVector1 = _mm256_loadu_ps(Source + 8);
+
+        _mm_storeu_si128((__m128i*)Destination, _mm256_cvtps_ph(FloatVector0, 0));
+        _mm_storeu_si128((__m128i*)(Destination + 8), _mm256_cvtps_ph(FloatVector1, 0));
+
+        Source += 16;
+        Destination += 16;
+        Count -= 16;
+    }
+
+    if (Count >= 8) {
+
+        __m256 FloatVector = _mm256_loadu_ps(Source);
+
+        _mm_storeu_si128((__m128i*)Destination, _mm256_cvtps_ph(FloatVector, 0));
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+    if (Count > 0) {
+
+        MLAS_DECLSPEC_ALIGN(float FloatBuffer[8], 32) = { 0 };
+        MLAS_DECLSPEC_ALIGN(unsigned short HalfBuffer[8], 16);
+
+        memcpy(FloatBuffer, Source, Count * sizeof(float));
+        _mm_store_si128((__m128i*)HalfBuffer, _mm256_cvtps_ph(_mm256_load_ps(FloatBuffer), 0));
+        memcpy(Destination, HalfBuffer, Count * sizeof(unsigned short));
+    }
+}
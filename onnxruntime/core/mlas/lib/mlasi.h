@@ -120,6 +120,15 @@ Abstract:
 #define MLAS_DGEMM_STRIDEN                          64
 #define MLAS_DGEMM_STRIDEK                          128
 
+//
+// Define the strides to step through slices of a prepacked matrix B. The K
+// stride is part of the packed buffer format and must not change between the
+// routines that pack and consume the buffer.
+//
+
+#define MLAS_SGEMM_PACKED_STRIDEN                   128
+#define MLAS_SGEMM_PACKED_STRIDEK                   256
+
 //
 // Define the alignment for segmenting a GEMM operation across multiple
 // threads.
@@ -133,6 +142,13 @@ Abstract:
 #define MLAS_DGEMM_STRIDEN_THREAD_ALIGN             8
 #define MLAS_QGEMM_STRIDEN_THREAD_ALIGN             16
 
+//
+// Define the alignment of the N dimension of a prepacked matrix B. The SGEMM
+// kernels consume matrix B in panels of 16 columns.
+//
+
+#define MLAS_SGEMM_PACKED_N_ALIGN                   16
+
 //
 // Define the prototypes of the platform optimized routines.
 //
@@ -451,6 +467,59 @@ void
 
 typedef MLAS_ELEMENTWISE_KERNEL_ROUTINE* PMLAS_ELEMENTWISE_KERNEL_ROUTINE;
 
+typedef
+void
+(MLASCALL MLAS_CONVERT_HALF_TO_FLOAT_KERNEL)(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    );
+
+typedef MLAS_CONVERT_HALF_TO_FLOAT_KERNEL* PMLAS_CONVERT_HALF_TO_FLOAT_KERNEL;
+
+typedef
+void
+(MLASCALL MLAS_CONVERT_FLOAT_TO_HALF_KERNEL)(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    );
+
+typedef MLAS_CONVERT_FLOAT_TO_HALF_KERNEL* PMLAS_CONVERT_FLOAT_TO_HALF_KERNEL;
+
+typedef
+float
+(MLASCALL MLAS_REDUCE_MAXIMUM_FLOAT_KERNEL)(
+    const float* Input,
+    size_t N
+    );
+
+typedef
+float
+(MLASCALL MLAS_COMPUTE_SUMEXP_FLOAT_KERNEL)(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float NegativeMaximum
+    );
+
+typedef
+void
+(MLASCALL MLAS_COMPUTE_SOFTMAX_OUTPUT_FLOAT_KERNEL)(
+    float* Output,
+    size_t N,
+    float Scale
+    );
+
+typedef
+void
+(MLASCALL MLAS_COMPUTE_LOGSOFTMAX_OUTPUT_FLOAT_KERNEL)(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float Offset
+    );
+
 extern "C" {
 
 #if defined(MLAS_TARGET_AMD64_IX86)
@@ -544,10 +613,19 @@ extern "C" {
     MLAS_ELEMENTWISE_KERNEL_ROUTINE MlasLogisticKernel;
     MLAS_ELEMENTWISE_KERNEL_ROUTINE MlasTanhKernel;
     MLAS_ELEMENTWISE_KERNEL_ROUTINE MlasErfKernel;
+    MLAS_ELEMENTWISE_KERNEL_ROUTINE MlasExpKernel;
+    MLAS_REDUCE_MAXIMUM_FLOAT_KERNEL MlasReduceMaximumKernel;
+    MLAS_COMPUTE_SUMEXP_FLOAT_KERNEL MlasComputeSumExpKernel;
+    MLAS_COMPUTE_SOFTMAX_OUTPUT_FLOAT_KERNEL MlasComputeSoftmaxOutputKernel;
+    MLAS_COMPUTE_LOGSOFTMAX_OUTPUT_FLOAT_KERNEL MlasComputeLogSoftmaxOutputKernel;
+    MLAS_CONVERT_HALF_TO_FLOAT_KERNEL MlasConvertHalfToFloatKernel;
+    MLAS_CONVERT_FLOAT_TO_HALF_KERNEL MlasConvertFloatToHalfKernel;
 #if defined(MLAS_TARGET_AMD64)
     MLAS_ELEMENTWISE_KERNEL_ROUTINE MlasLogisticKernelFma3;
     MLAS_ELEMENTWISE_KERNEL_ROUTINE MlasTanhKernelFma3;
     MLAS_ELEMENTWISE_KERNEL_ROUTINE MlasErfKernelFma3;
+    MLAS_CONVERT_HALF_TO_FLOAT_KERNEL MlasConvertHalfToFloatKernelF16C;
+    MLAS_CONVERT_FLOAT_TO_HALF_KERNEL MlasConvertFloatToHalfKernelF16C;
 #endif
 
 }
@@ -631,6 +709,8 @@ struct MLAS_PLATFORM {
     PMLAS_ELEMENTWISE_KERNEL_ROUTINE LogisticKernelRoutine;
     PMLAS_ELEMENTWISE_KERNEL_ROUTINE TanhKernelRoutine;
     PMLAS_ELEMENTWISE_KERNEL_ROUTINE ErfKernelRoutine;
+    PMLAS_CONVERT_HALF_TO_FLOAT_KERNEL ConvertHalfToFloatKernelRoutine;
+    PMLAS_CONVERT_FLOAT_TO_HALF_KERNEL ConvertFloatToHalfKernelRoutine;
     uint32_t NchwcBlockSize;
     uint32_t PreferredBufferAlignment;
 #endif
@@ -118,6 +118,8 @@ Return Value:
     this->LogisticKernelRoutine = MlasLogisticKernel;
     this->TanhKernelRoutine = MlasTanhKernel;
     this->ErfKernelRoutine = MlasErfKernel;
+    this->ConvertHalfToFloatKernelRoutine = MlasConvertHalfToFloatKernel;
+    this->ConvertFloatToHalfKernelRoutine = MlasConvertFloatToHalfKernel;
     this->NchwcBlockSize = 8;
     this->PreferredBufferAlignment = MLAS_DEFAULT_PREFERRED_BUFFER_ALIGNMENT;
 
@@ -160,6 +162,16 @@ Return Value:
             this->PoolFloatKernel[MlasAveragePoolingExcludePad] = MlasPoolAverageExcludePadFloatKernelAvx;
             this->PoolFloatKernel[MlasAveragePoolingIncludePad] = MlasPoolAverageIncludePadFloatKernelAvx;
 
+            //
+            // Check if the processor supports the F16C feature.
+            //
+
+            if ((Cpuid1[2] & 0x20000000) != 0) {
+
+                this->ConvertHalfToFloatKernelRoutine = MlasConvertHalfToFloatKernelF16C;
+                this->ConvertFloatToHalfKernelRoutine = MlasConvertFloatToHalfKernelF16C;
+            }
+
             //
             // Check if the processor supports AVX2/FMA3 features.
             //
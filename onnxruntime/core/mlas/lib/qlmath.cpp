@@ -0,0 +1,392 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qlmath.cpp
+
+Abstract:
+
+    This module implements routines to compute element-wise binary operations
+    on linearly quantized buffers.
+
+    The addition is computed in fixed point arithmetic:
+
+        C = ZeroPointC + ((MultiplierA * (A - ZeroPointA) +
+                           MultiplierB * (B - ZeroPointB) + Round) >> Shift)
+
+    where MultiplierX = RoundToEven((ScaleX / ScaleC) << Shift) is a 16-bit
+    value and Shift is chosen to keep the larger multiplier as precise as
+    possible.
+
+    The multiplication computes the exact integer product and scales it:
+
+        C = ZeroPointC + RoundToEven((A - ZeroPointA) * (B - ZeroPointB) *
+                                     (ScaleA * ScaleB / ScaleC))
+
+--*/
+
+#include "mlasi.h"
+
+#include <cmath>
+
+//
+// Stores the fixed point parameters of a quantized addition.
+//
+
+struct MLAS_QLINEAR_ADD_PARAMETERS {
+    int32_t MultiplierA;
+    int32_t MultiplierB;
+    int32_t Round;
+    int32_t Shift;
+};
+
+inline
+void
+MlasQLinearAddPrepare(
+    float ScaleA,
+    float ScaleB,
+    float ScaleC,
+    MLAS_QLINEAR_ADD_PARAMETERS* Parameters
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the fixed point multipliers and shift for a
+    quantized addition.
+
+Arguments:
+
+    ScaleA - Supplies the quantization scale of the first input.
+
+    ScaleB - Supplies the quantization scale of the second input.
+
+    ScaleC - Supplies the quantization scale of the output.
+
+    Parameters - Returns the fixed point parameters.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float RatioA = ScaleA / ScaleC;
+    const float RatioB = ScaleB / ScaleC;
+    const float MaximumRatio = std::max(std::fabs(RatioA), std::fabs(RatioB));
+
+    //
+    // Use the largest shift that keeps both multipliers in 16 bits. The
+    // shift is limited so that the accumulator can't overflow.
+    //
+
+    int32_t Shift = 0;
+
+    while (Shift < 30 && MaximumRatio * float(int32_t(1) << (Shift + 1)) < 32767.0f) {
+        Shift++;
+    }
+
+    const float Factor = float(int32_t(1) << Shift);
+
+    auto ToMultiplier = [Factor](float Ratio) {
+        float Multiplier = std::nearbyintf(Ratio * Factor);
+        Multiplier = std::max(Multiplier, -32767.0f);
+        Multiplier = std::min(Multiplier, 32767.0f);
+        return int32_t(Multiplier);
+    };
+
+    Parameters->MultiplierA = ToMultiplier(RatioA);
+    Parameters->MultiplierB = ToMultiplier(RatioB);
+    Parameters->Round = (Shift > 0) ? (int32_t(1) << (Shift - 1)) : 0;
+    Parameters->Shift = Shift;
+}
+
+MLAS_FORCEINLINE
+uint8_t
+MlasQLinearAddValue(
+    int32_t ValueA,
+    int32_t ValueB,
+    int32_t ZeroPointA,
+    int32_t ZeroPointB,
+    int32_t ZeroPointC,
+    const MLAS_QLINEAR_ADD_PARAMETERS& Parameters
+    )
+{
+    int32_t Accumulator = Parameters.MultiplierA * (ValueA - ZeroPointA) +
+        Parameters.MultiplierB * (ValueB - ZeroPointB) + Parameters.Round;
+
+    // N.B. Relies on an arithmetic right shift of negative values, matching
+    // the vector implementation.
+    int32_t Value = (Accumulator >> Parameters.Shift) + ZeroPointC;
+
+    Value = std::max(Value, int32_t(0));
+    Value = std::min(Value, int32_t(255));
+
+    return uint8_t(Value);
+}
+
+MLAS_FORCEINLINE
+uint8_t
+MlasQLinearMulValue(
+    int32_t ValueA,
+    int32_t ValueB,
+    int32_t ZeroPointA,
+    int32_t ZeroPointB,
+    int32_t ZeroPointC,
+    float Scale
+    )
+{
+    float FloatValue = float((ValueA - ZeroPointA) * (ValueB - ZeroPointB)) * Scale;
+
+    FloatValue = std::max(FloatValue, float(0 - ZeroPointC));
+    FloatValue = std::min(FloatValue, float(255 - ZeroPointC));
+
+    return uint8_t(int32_t(std::nearbyintf(FloatValue)) + ZeroPointC);
+}
+
+void
+MLASCALL
+MlasQLinearAdd(
+    const uint8_t* InputA,
+    float ScaleA,
+    uint8_t ZeroPointA,
+    const uint8_t* InputB,
+    float ScaleB,
+    uint8_t ZeroPointB,
+    float ScaleC,
+    uint8_t ZeroPointC,
+    uint8_t* OutputC,
+    size_t N,
+    bool IsScalarB
+    )
+/*++
+
+Routine Description:
+
+    This routine adds two quantized buffers and requantizes the sum to the
+    output quantization parameters.
+
+Arguments:
+
+    InputA - Supplies the first input buffer.
+
+    ScaleA - Supplies the quantization scale of the first input.
+
+    ZeroPointA - Supplies the quantization zero point of the first input.
+
+    InputB - Supplies the second input buffer.
+
+    ScaleB - Supplies the quantization scale of the second input.
+
+    ZeroPointB - Supplies the quantization zero point of the second input.
+
+    ScaleC - Supplies the quantization scale of the output.
+
+    ZeroPointC - Supplies the quantization zero point of the output.
+
+    OutputC - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+    IsScalarB - Supplies true if InputB points to a single value that is
+        broadcast to all elements of InputA.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_QLINEAR_ADD_PARAMETERS Parameters;
+
+    MlasQLinearAddPrepare(ScaleA, ScaleB, ScaleC, &Parameters);
+
+#if defined(MLAS_SSE2_INTRINSICS)
+
+    const __m128i ZeroVector = _mm_setzero_si128();
+    const __m128i ZeroPointAVector = _mm_set1_epi16(ZeroPointA);
+    const __m128i ZeroPointBVector = _mm_set1_epi16(ZeroPointB);
+    const __m128i ZeroPointCVector = _mm_set1_epi16(ZeroPointC);
+    const __m128i RoundVector = _mm_set1_epi32(Parameters.Round);
+    const __m128i ShiftVector = _mm_cvtsi32_si128(Parameters.Shift);
+
+    //
+    // Interleave the multipliers so that PMADDWD computes both products of
+    // each element pair and their sum.
+    //
+
+    const __m128i MultiplierVector = _mm_set1_epi32(
+        int32_t((uint32_t(Parameters.MultiplierB) << 16) | (uint32_t(Parameters.MultiplierA) & 0xFFFF)));
+
+    __m128i ScalarBVector = _mm_setzero_si128();
+
+    if (IsScalarB) {
+        ScalarBVector = _mm_sub_epi16(_mm_set1_epi16(*InputB), ZeroPointBVector);
+    }
+
+    while (N >= 8) {
+
+        __m128i VectorA = _mm_loadl_epi64((const __m128i*)InputA);
+        VectorA = _mm_sub_epi16(_mm_unpacklo_epi8(VectorA, ZeroVector), ZeroPointAVector);
+
+        __m128i VectorB = ScalarBVector;
+
+        if (!IsScalarB) {
+            VectorB = _mm_loadl_epi64((const __m128i*)InputB);
+            VectorB = _mm_sub_epi16(_mm_unpacklo_epi8(VectorB, ZeroVector), ZeroPointBVector);
+            InputB += 8;
+        }
+
+        __m128i Accumulator0 = _mm_madd_epi16(_mm_unpacklo_epi16(VectorA, VectorB), MultiplierVector);
+        __m128i Accumulator1 = _mm_madd_epi16(_mm_unpackhi_epi16(VectorA, VectorB), MultiplierVector);
+
+        Accumulator0 = _mm_sra_epi32(_mm_add_epi32(Accumulator0, RoundVector), ShiftVector);
+        Accumulator1 = _mm_sra_epi32(_mm_add_epi32(Accumulator1, RoundVector), ShiftVector);
+
+        __m128i VectorC = _mm_adds_epi16(_mm_packs_epi32(Accumulator0, Accumulator1), ZeroPointCVector);
+        VectorC = _mm_packus_epi16(VectorC, VectorC);
+
+        _mm_storel_epi64((__m128i*)OutputC, VectorC);
+
+        InputA += 8;
+        OutputC += 8;
+        N -= 8;
+    }
+
+#endif
+
+    const int32_t ValueB = IsScalarB ? int32_t(*InputB) : 0;
+
+    for (size_t n = 0; n < N; n++) {
+        OutputC[n] = MlasQLinearAddValue(InputA[n], IsScalarB ? ValueB : int32_t(InputB[n]),
+            ZeroPointA, ZeroPointB, ZeroPointC, Parameters);
+    }
+}
+
+void
+MLASCALL
+MlasQLinearMul(
+    const uint8_t* InputA,
+    float ScaleA,
+    uint8_t ZeroPointA,
+    const uint8_t* InputB,
+    float ScaleB,
+    uint8_t ZeroPointB,
+    float ScaleC,
+    uint8_t ZeroPointC,
+    uint8_t* OutputC,
+    size_t N,
+    bool IsScalarB
+    )
+/*++
+
+Routine Description:
+
+    This routine multiplies two quantized buffers and requantizes the product
+    to the output quantization parameters.
+
+Arguments:
+
+    InputA - Supplies the first input buffer.
+
+    ScaleA - Supplies the quantization scale of the first input.
+
+    ZeroPointA - Supplies the quantization zero point of the first input.
+
+    InputB - Supplies the second input buffer.
+
+    ScaleB - Supplies the quantization scale of the second input.
+
+    ZeroPointB - Supplies the quantization zero point of the second input.
+
+    ScaleC - Supplies the quantization scale of the output.
+
+    ZeroPointC - Supplies the quantization zero point of the output.
+
+    OutputC - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+    IsScalarB - Supplies true if InputB points to a single value that is
+        broadcast to all elements of InputA.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float Scale = ScaleA * ScaleB / ScaleC;
+
+#if defined(MLAS_SSE2_INTRINSICS)
+
+    const __m128i ZeroVector = _mm_setzero_si128();
+    const __m128i ZeroPointAVector = _mm_set1_epi16(ZeroPointA);
+    const __m128i ZeroPointBVector = _mm_set1_epi16(ZeroPointB);
+    const __m128i ZeroPointCVector = _mm_set1_epi16(ZeroPointC);
+    const MLAS_FLOAT32X4 ScaleVector = MlasBroadcastFloat32x4(Scale);
+    const MLAS_FLOAT32X4 MinimumValueVector = MlasBroadcastFloat32x4(float(0 - ZeroPointC));
+    const MLAS_FLOAT32X4 MaximumValueVector = MlasBroadcastFloat32x4(float(255 - ZeroPointC));
+
+    __m128i ScalarBVector = _mm_setzero_si128();
+
+    if (IsScalarB) {
+        ScalarBVector = _mm_sub_epi16(_mm_set1_epi16(*InputB), ZeroPointBVector);
+    }
+
+    while (N >= 8) {
+
+        __m128i VectorA = _mm_loadl_epi64((const __m128i*)InputA);
+        VectorA = _mm_sub_epi16(_mm_unpacklo_epi8(VectorA, ZeroVector), ZeroPointAVector);
+
+        __m128i VectorB = ScalarBVector;
+
+        if (!IsScalarB) {
+            VectorB = _mm_loadl_epi64((const __m128i*)InputB);
+            VectorB = _mm_sub_epi16(_mm_unpacklo_epi8(VectorB, ZeroVector), ZeroPointBVector);
+            InputB += 8;
+        }
+
+        //
+        // Form the exact 32-bit products from the low and high halves of the
+        // 16-bit products.
+        //
+
+        __m128i ProductLow = _mm_mullo_epi16(VectorA, VectorB);
+        __m128i ProductHigh = _mm_mulhi_epi16(VectorA, VectorB);
+
+        MLAS_FLOAT32X4 FloatVector0 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(ProductLow, ProductHigh));
+        MLAS_FLOAT32X4 FloatVector1 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(ProductLow, ProductHigh));
+
+        FloatVector0 = MlasMultiplyFloat32x4(FloatVector0, ScaleVector);
+        FloatVector1 = MlasMultiplyFloat32x4(FloatVector1, ScaleVector);
+
+        FloatVector0 = _mm_min_ps(_mm_max_ps(FloatVector0, MinimumValueVector), MaximumValueVector);
+        FloatVector1 = _mm_min_ps(_mm_max_ps(FloatVector1, MinimumValueVector), MaximumValueVector);
+
+        // N.B. Assumes MXCSR has been configured with the default rounding
+        // mode of "round to nearest even".
+        __m128i VectorC = _mm_packs_epi32(_mm_cvtps_epi32(FloatVector0), _mm_cvtps_epi32(FloatVector1));
+        VectorC = _mm_adds_epi16(VectorC, ZeroPointCVector);
+        VectorC = _mm_packus_epi16(VectorC, VectorC);
+
+        _mm_storel_epi64((__m128i*)OutputC, VectorC);
+
+        InputA += 8;
+        OutputC += 8;
+        N -= 8;
+    }
+
+#endif
+
+    const int32_t ValueB = IsScalarB ? int32_t(*InputB) : 0;
+
+    for (size_t n = 0; n < N; n++) {
+        OutputC[n] = MlasQLinearMulValue(InputA[n], IsScalarB ? ValueB : int32_t(InputB[n]),
+            ZeroPointA, ZeroPointB, ZeroPointC, Scale);
+    }
+}
@@ -0,0 +1,354 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    transpose.cpp
+
+Abstract:
+
+    This module implements the matrix transpose routines.
+
+    The matrix is walked in strips of columns. Each strip is transposed with
+    a square in-register kernel, so that a cache line read from a source row
+    and a cache line written to a destination row are both fully used.
+
+--*/
+
+#include "mlasi.h"
+
+template<typename ElementType, size_t BlockSize>
+MLAS_FORCEINLINE
+void
+MlasTransposeBlockGeneric(
+    const ElementType* Input,
+    size_t lda,
+    ElementType* Output,
+    size_t ldb
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes a square block of elements one element at a time.
+
+Arguments:
+
+    Input - Supplies the address of the source block.
+
+    lda - Supplies the number of elements per row of the source matrix.
+
+    Output - Supplies the address of the destination block.
+
+    ldb - Supplies the number of elements per row of the destination matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t n = 0; n < BlockSize; n++) {
+        for (size_t m = 0; m < BlockSize; m++) {
+            Output[n * ldb + m] = Input[m * lda + n];
+        }
+    }
+}
+
+template<typename ElementType>
+struct MLAS_TRANSPOSE_KERNEL
+{
+    static constexpr size_t BlockSize = 4;
+
+    static
+    void
+    TransposeBlock(
+        const ElementType* Input,
+        size_t lda,
+        ElementType* Output,
+        size_t ldb
+        )
+    {
+        MlasTransposeBlockGeneric<ElementType, BlockSize>(Input, lda, Output, ldb);
+    }
+};
+
+template<>
+struct MLAS_TRANSPOSE_KERNEL<uint32_t>
+{
+    static constexpr size_t BlockSize = 4;
+
+    static
+    void
+    TransposeBlock(
+        const uint32_t* Input,
+        size_t lda,
+        uint32_t* Output,
+        size_t ldb
+        )
+    {
+#if defined(MLAS_SSE2_INTRINSICS)
+        __m128i a0 = _mm_loadu_si128((const __m128i*)&Input[lda * 0]);
+        __m128i a1 = _mm_loadu_si128((const __m128i*)&Input[lda * 1]);
+        __m128i a2 = _mm_loadu_si128((const __m128i*)&Input[lda * 2]);
+        __m128i a3 = _mm_loadu_si128((const __m128i*)&Input[lda * 3]);
+
+        __m128i b0 = _mm_unpacklo_epi32(a0, a1);
+        __m128i b1 = _mm_unpackhi_epi32(a0, a1);
+        __m128i b2 = _mm_unpacklo_epi32(a2, a3);
+        __m128i b3 = _mm_unpackhi_epi32(a2, a3);
+
+        _mm_storeu_si128((__m128i*)&Output[ldb * 0], _mm_unpacklo_epi64(b0, b2));
+        _mm_storeu_si128((__m128i*)&Output[ldb * 1], _mm_unpackhi_epi64(b0, b2));
+        _mm_storeu_si128((__m128i*)&Output[ldb * 2], _mm_unpacklo_epi64(b1, b3));
+        _mm_storeu_si128((__m128i*)&Output[ldb * 3], _mm_unpackhi_epi64(b1, b3));
+#elif defined(MLAS_NEON_INTRINSICS)
+        uint32x4_t a0 = vld1q_u32(&Input[lda * 0]);
+        uint32x4_t a1 = vld1q_u32(&Input[lda * 1]);
+        uint32x4_t a2 = vld1q_u32(&Input[lda * 2]);
+        uint32x4_t a3 = vld1q_u32(&Input[lda * 3]);
+
+        uint32x4x2_t b01 = vtrnq_u32(a0, a1);
+        uint32x4x2_t b23 = vtrnq_u32(a2, a3);
+
+        vst1q_u32(&Output[ldb * 0], vcombine_u32(vget_low_u32(b01.val[0]), vget_low_u32(b23.val[0])));
+        vst1q_u32(&Output[ldb * 1], vcombine_u32(vget_low_u32(b01.val[1]), vget_low_u32(b23.val[1])));
+        vst1q_u32(&Output[ldb * 2], vcombine_u32(vget_high_u32(b01.val[0]), vget_high_u32(b23.val[0])));
+        vst1q_u32(&Output[ldb * 3], vcombine_u32(vget_high_u32(b01.val[1]), vget_high_u32(b23.val[1])));
+#else
+        MlasTransposeBlockGeneric<uint32_t, BlockSize>(Input, lda, Output, ldb);
+#endif
+    }
+};
+
+template<>
+struct MLAS_TRANSPOSE_KERNEL<uint8_t>
+{
+    static constexpr size_t BlockSize = 8;
+
+    static
+    void
+    TransposeBlock(
+        const uint8_t* Input,
+        size_t lda,
+        uint8_t* Output,
+        size_t ldb
+        )
+    {
+#if defined(MLAS_SSE2_INTRINSICS)
+        __m128i a0 = _mm_loadl_epi64((const __m128i*)&Input[lda * 0]);
+        __m128i a1 = _mm_loadl_epi64((const __m128i*)&Input[lda * 1]);
+        __m128i b0 = _mm_unpacklo_epi8(a0, a1);
+
+        __m128i a2 = _mm_loadl_epi64((const __m128i*)&Input[lda * 2]);
+        __m128i a3 = _mm_loadl_epi64((const __m128i*)&Input[lda * 3]);
+        __m128i b1 = _mm_unpacklo_epi8(a2, a3);
+
+        __m128i a4 = _mm_loadl_epi64((const __m128i*)&Input[lda * 4]);
+        __m128i a5 = _mm_loadl_epi64((const __m128i*)&Input[lda * 5]);
+        __m128i b2 = _mm_unpacklo_epi8(a4, a5);
+
+        __m128i a6 = _mm_loadl_epi64((const __m128i*)&Input[lda * 6]);
+        __m128i a7 = _mm_loadl_epi64((const __m128i*)&Input[lda * 7]);
+        __m128i b3 = _mm_unpacklo_epi8(a6, a7);
+
+        //
+        // Each 32-bit element of c0/c1 holds a column of rows 0-3 and each
+        // 32-bit element of c2/c3 holds a column of rows 4-7.
+        //
+
+        __m128i c0 = _mm_unpacklo_epi16(b0, b1);
+        __m128i c1 = _mm_unpackhi_epi16(b0, b1);
+        __m128i c2 = _mm_unpacklo_epi16(b2, b3);
+        __m128i c3 = _mm_unpackhi_epi16(b2, b3);
+
+        __m128i d0 = _mm_unpacklo_epi32(c0, c2);
+        _mm_storel_epi64((__m128i*)&Output[ldb * 0], d0);
+        _mm_storel_epi64((__m128i*)&Output[ldb * 1], _mm_unpackhi_epi64(d0, d0));
+
+        __m128i d1 = _mm_unpackhi_epi32(c0, c2);
+        _mm_storel_epi64((__m128i*)&Output[ldb * 2], d1);
+        _mm_storel_epi64((__m128i*)&Output[ldb * 3], _mm_unpackhi_epi64(d1, d1));
+
+        __m128i d2 = _mm_unpacklo_epi32(c1, c3);
+        _mm_storel_epi64((__m128i*)&Output[ldb * 4], d2);
+        _mm_storel_epi64((__m128i*)&Output[ldb * 5], _mm_unpackhi_epi64(d2, d2));
+
+        __m128i d3 = _mm_unpackhi_epi32(c1, c3);
+        _mm_storel_epi64((__m128i*)&Output[ldb * 6], d3);
+        _mm_storel_epi64((__m128i*)&Output[ldb * 7], _mm_unpackhi_epi64(d3, d3));
+#elif defined(MLAS_NEON_INTRINSICS)
+        uint8x8x2_t b0 = vtrn_u8(vld1_u8(&Input[lda * 0]), vld1_u8(&Input[lda * 1]));
+        uint8x8x2_t b1 = vtrn_u8(vld1_u8(&Input[lda * 2]), vld1_u8(&Input[lda * 3]));
+        uint8x8x2_t b2 = vtrn_u8(vld1_u8(&Input[lda * 4]), vld1_u8(&Input[lda * 5]));
+        uint8x8x2_t b3 = vtrn_u8(vld1_u8(&Input[lda * 6]), vld1_u8(&Input[lda * 7]));
+
+        uint16x4x2_t c0 = vtrn_u16(vreinterpret_u16_u8(b0.val[0]), vreinterpret_u16_u8(b1.val[0]));
+        uint16x4x2_t c1 = vtrn_u16(vreinterpret_u16_u8(b0.val[1]), vreinterpret_u16_u8(b1.val[1]));
+        uint16x4x2_t c2 = vtrn_u16(vreinterpret_u16_u8(b2.val[0]), vreinterpret_u16_u8(b3.val[0]));
+        uint16x4x2_t c3 = vtrn_u16(vreinterpret_u16_u8(b2.val[1]), vreinterpret_u16_u8(b3.val[1]));
+
+        uint32x2x2_t d0 = vtrn_u32(vreinterpret_u32_u16(c0.val[0]), vreinterpret_u32_u16(c2.val[0]));
+        uint32x2x2_t d1 = vtrn_u32(vreinterpret_u32_u16(c1.val[0]), vreinterpret_u32_u16(c3.val[0]));
+        uint32x2x2_t d2 = vtrn_u32(vreinterpret_u32_u16(c0.val[1]), vreinterpret_u32_u16(c2.val[1]));
+        uint32x2x2_t d3 = vtrn_u32(vreinterpret_u32_u16(c1.val[1]), vreinterpret_u32_u16(c3.val[1]));
+
+        vst1_u8(&Output[ldb * 0], vreinterpret_u8_u32(d0.val[0]));
+        vst1_u8(&Output[ldb * 1], vreinterpret_u8_u32(d1.val[0]));
+        vst1_u8(&Output[ldb * 2], vreinterpret_u8_u32(d2.val[0]));
+        vst1_u8(&Output[ldb * 3], vreinterpret_u8_u32(d3.val[0]));
+        vst1_u8(&Output[ldb * 4], vreinterpret_u8_u32(d0.val[1]));
+        vst1_u8(&Output[ldb * 5], vreinterpret_u8_u32(d1.val[1]));
+        vst1_u8(&Output[ldb * 6], vreinterpret_u8_u32(d2.val[1]));
+        vst1_u8(&Output[ldb * 7], vreinterpret_u8_u32(d3.val[1]));
+#else
+        MlasTransposeBlockGeneric<uint8_t, BlockSize>(Input, lda, Output, ldb);
+#endif
+    }
+};
+
+template<typename ElementType>
+void
+MlasTransposeMatrix(
+    size_t M,
+    size_t N,
+    const ElementType* Input,
+    size_t lda,
+    ElementType* Output,
+    size_t ldb
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes the source matrix to the destination matrix.
+
+Arguments:
+
+    M - Supplies the number of rows of the source matrix and the number of
+        columns of the destination matrix.
+
+    N - Supplies the number of columns of the source matrix and the number of
+        rows of the destination matrix.
+
+    Input - Supplies the address of the source matrix.
+
+    lda - Supplies the number of elements per row of the source matrix.
+
+    Output - Supplies the address of the destination matrix.
+
+    ldb - Supplies the number of elements per row of the destination matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t BlockSize = MLAS_TRANSPOSE_KERNEL<ElementType>::BlockSize;
+
+    size_t n = 0;
+
+    //
+    // Transpose a strip of BlockSize columns at a time.
+    //
+
+    for (; n + BlockSize <= N; n += BlockSize) {
+
+        const ElementType* s = Input + n;
+        ElementType* d = Output + n * ldb;
+
+        size_t m = 0;
+
+        for (; m + BlockSize <= M; m += BlockSize) {
+
+            MLAS_TRANSPOSE_KERNEL<ElementType>::TransposeBlock(s, lda, d, ldb);
+
+            s += BlockSize * lda;
+            d += BlockSize;
+        }
+
+        for (; m < M; m++) {
+
+            for (size_t i = 0; i < BlockSize; i++) {
+                d[i * ldb] = s[i];
+            }
+
+            s += lda;
+            d += 1;
+        }
+    }
+
+    //
+    // Transpose the remaining columns.
+    //
+
+    for (; n < N; n++) {
+
+        const ElementType* s = Input + n;
+        ElementType* d = Output + n * ldb;
+
+        for (size_t m = 0; m < M; m++) {
+            d[m] = s[m * lda];
+        }
+    }
+}
+
+void
+MLASCALL
+MlasTranspose(
+    size_t M,
+    size_t N,
+    const uint8_t* Input,
+    size_t lda,
+    uint8_t* Output,
+    size_t ldb
+    )
+{
+    MlasTransposeMatrix(M, N, Input, lda, Output, ldb);
+}
+
+void
+MLASCALL
+MlasTranspose(
+    size_t M,
+    size_t N,
+    const uint16_t* Input,
+    size_t lda,
+    uint16_t* Output,
+    size_t ldb
+    )
+{
+    MlasTransposeMatrix(M, N, Input, lda, Output, ldb);
+}
+
+void
+MLASCALL
+MlasTranspose(
+    size_t M,
+    size_t N,
+    const uint32_t* Input,
+    size_t lda,
+    uint32_t* Output,
+    size_t ldb
+    )
+{
+    MlasTransposeMatrix(M, N, Input, lda, Output, ldb);
+}
+
+void
+MLASCALL
+MlasTranspose(
+    size_t M,
+    size_t N,
+    const uint64_t* Input,
+    size_t lda,
+    uint64_t* Output,
+    size_t ldb
+    )
+{
+    MlasTransposeMatrix(M, N, Input, lda, Output, ldb);
+}
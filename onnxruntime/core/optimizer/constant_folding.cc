@@ -53,7 +53,7 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
     }
 
     // Create execution frame for executing constant nodes.
-    OptimizerExecutionFrame::Info info({node}, constant_inputs);
+    OptimizerExecutionFrame::Info info({node}, constant_inputs, graph.ModelPath());
 
     // undo the EP change in case something fails prior to node removal
     if (!cpu_ep) {
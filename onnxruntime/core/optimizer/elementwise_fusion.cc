@@ -0,0 +1,217 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/elementwise_fusion.h"
+#include "core/optimizer/utils.h"
+#include "core/graph/graph_utils.h"
+#include "core/framework/tensorprotoutils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+bool IsFusableBinaryOp(const Node& node) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "Add", {7}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sub", {7}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Mul", {7}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Div", {7});
+}
+
+bool IsFusableUnaryOp(const Node& node) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "Relu", {6}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sigmoid", {6}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Tanh", {6}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Erf", {9}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Neg", {6}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Abs", {6}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Exp", {6}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Log", {6}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sqrt", {6}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Reciprocal", {6});
+}
+
+bool HasFloatInputs(const Node& node) {
+  for (const auto* input : node.InputDefs()) {
+    const auto* type = input->TypeAsProto();
+    if (type == nullptr || !type->has_tensor_type() ||
+        type->tensor_type().elem_type() != TensorProto_DataType_FLOAT) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool IsSameDim(const TensorShapeProto_Dimension& a, const TensorShapeProto_Dimension& b) {
+  if (utils::HasDimValue(a) && utils::HasDimValue(b)) {
+    return a.dim_value() == b.dim_value();
+  }
+  return utils::HasDimParam(a) && utils::HasDimParam(b) && a.dim_param() == b.dim_param();
+}
+
+// The operand of a binary node can be fused if it does not change the shape of the chain: it either has exactly the
+// shape of the chain input, or it holds a single element and its rank does not exceed the rank of the chain input.
+bool IsCompatibleOperand(const NodeArg& operand, const TensorShapeProto& chain_shape) {
+  const TensorShapeProto* operand_shape = operand.Shape();
+  if (operand_shape == nullptr || operand_shape->dim_size() > chain_shape.dim_size()) {
+    return false;
+  }
+
+  bool is_scalar = true;
+  for (const auto& dim : operand_shape->dim()) {
+    if (!utils::HasDimValue(dim) || dim.dim_value() != 1) {
+      is_scalar = false;
+      break;
+    }
+  }
+  if (is_scalar) {
+    return true;
+  }
+
+  if (operand_shape->dim_size() != chain_shape.dim_size()) {
+    return false;
+  }
+  for (int i = 0; i < chain_shape.dim_size(); ++i) {
+    if (!IsSameDim(operand_shape->dim(i), chain_shape.dim(i))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+struct InputEdge {
+  NodeIndex src_node;
+  int src_arg_index;
+  int dst_arg_index;
+};
+
+// Collects the nodes, inputs and attributes of a FusedElementwise node.
+struct ElementwiseChain {
+  std::vector<std::reference_wrapper<Node>> nodes;
+  std::vector<NodeArg*> inputs;
+  std::vector<std::string> ops;
+  std::vector<int64_t> operand_positions;
+  std::vector<InputEdge> input_edges;
+
+  void AddInput(const Node& node, int arg_index) {
+    const Node::EdgeEnd* edge = graph_utils::GetInputEdge(node, arg_index);
+    if (edge != nullptr) {
+      input_edges.push_back({edge->GetNode().Index(), edge->GetSrcArgIndex(), static_cast<int>(inputs.size())});
+    }
+    inputs.push_back(const_cast<NodeArg*>(node.InputDefs()[arg_index]));
+  }
+
+  void AddNode(Node& node, int operand_index) {
+    nodes.push_back(node);
+    ops.push_back(node.OpType());
+    operand_positions.push_back(operand_index);
+    if (operand_index >= 0) {
+      AddInput(node, operand_index);
+    }
+  }
+};
+
+}  // namespace
+
+Status ElementwiseFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+  const auto is_fusable = [this](const Node& node) {
+    return (IsFusableBinaryOp(node) || IsFusableUnaryOp(node)) &&
+           graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders()) &&
+           HasFloatInputs(node);
+  };
+
+  for (auto index : order) {
+    auto* node_ptr = graph.GetNode(index);
+    if (!node_ptr)
+      continue;  // node was removed
+
+    auto& node = *node_ptr;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!is_fusable(node)) {
+      continue;
+    }
+
+    // Pick the input that carries the shape of the whole chain. For a binary head the other input must be compatible
+    // with it, so a node that broadcasts its inputs into a bigger output never starts a chain.
+    int chain_input_index = -1;
+    const bool head_is_binary = IsFusableBinaryOp(node);
+    for (int i = 0; i < (head_is_binary ? 2 : 1); ++i) {
+      const NodeArg* chain_input = node.InputDefs()[i];
+      if (chain_input->Shape() != nullptr &&
+          (!head_is_binary || IsCompatibleOperand(*node.InputDefs()[1 - i], *chain_input->Shape()))) {
+        chain_input_index = i;
+        break;
+      }
+    }
+    if (chain_input_index < 0) {
+      continue;
+    }
+
+    const TensorShapeProto& chain_shape = *node.InputDefs()[chain_input_index]->Shape();
+    ElementwiseChain chain;
+    chain.AddInput(node, chain_input_index);
+    chain.AddNode(node, head_is_binary ? 1 - chain_input_index : -1);
+
+    // Grow the chain while the running value has a single consumer that can be fused as well.
+    Node* current = &node;
+    while (current->GetOutputEdgesCount() == 1 && graph.GetNodeOutputsInGraphOutputs(*current).empty()) {
+      Node& next = *graph.GetNode(current->OutputNodesBegin()->Index());
+      if (!is_fusable(next) || next.GetExecutionProviderType() != node.GetExecutionProviderType()) {
+        break;
+      }
+
+      int operand_index = -1;
+      if (IsFusableBinaryOp(next)) {
+        operand_index = 1 - optimizer_utils::IndexOfNodeInput(next, *current->OutputDefs()[0]);
+        if (!IsCompatibleOperand(*next.InputDefs()[operand_index], chain_shape)) {
+          break;
+        }
+      }
+
+      chain.AddNode(next, operand_index);
+      current = &next;
+    }
+
+    if (chain.nodes.size() < 2) {
+      continue;
+    }
+
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName("FusedElementwise"),
+                                     "FusedElementwise",
+                                     "fused element-wise chain",
+                                     chain.inputs,
+                                     {},
+                                     {},
+                                     kMSDomain);
+    fused_node.AddAttribute("ops", chain.ops);
+    fused_node.AddAttribute("operand_positions", chain.operand_positions);
+
+    // Assign provider to this new node. Provider should be same as the provider for old node.
+    fused_node.SetExecutionProviderType(node.GetExecutionProviderType());
+
+    // The inputs of the fused node come from several nodes of the chain, so connect them here and drop the input
+    // edges of the head node, which FinalizeNodeFusion would otherwise move over with their original indices.
+    std::vector<InputEdge> head_input_edges;
+    for (auto it = node.InputEdgesBegin(), end = node.InputEdgesEnd(); it != end; ++it) {
+      head_input_edges.push_back({it->GetNode().Index(), it->GetSrcArgIndex(), it->GetDstArgIndex()});
+    }
+    for (const auto& edge : head_input_edges) {
+      graph.RemoveEdge(edge.src_node, node.Index(), edge.src_arg_index, edge.dst_arg_index);
+    }
+    for (const auto& edge : chain.input_edges) {
+      graph.AddEdge(edge.src_node, fused_node.Index(), edge.src_arg_index, edge.dst_arg_index);
+    }
+
+    graph_utils::FinalizeNodeFusion(graph, chain.nodes, fused_node);
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
@@ -27,6 +27,7 @@
 #include "core/optimizer/embed_layer_norm_fusion.h"
 #include "core/optimizer/reshape_fusion.h"
 #include "core/optimizer/attention_fusion.h"
+#include "core/optimizer/elementwise_fusion.h"
 #include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
@@ -145,6 +146,11 @@ std::vector<std::unique_ptr<GraphTransformer>> GenerateTransformers(TransformerL
       if (MlasNchwcGetBlockSize() > 1) {
         transformers.emplace_back(onnxruntime::make_unique<NchwcTransformer>());
       }
+
+      // Registered last so that the Level2 fusions and the NCHWc transformer, which fold Add and activation nodes
+      // into Conv, claim their nodes first. Only the element-wise chains left behind are fused here.
+      std::unordered_set<std::string> cpu_execution_providers = {onnxruntime::kCpuExecutionProvider};
+      transformers.emplace_back(onnxruntime::make_unique<ElementwiseFusion>(cpu_execution_providers));
 #endif
     } break;
 
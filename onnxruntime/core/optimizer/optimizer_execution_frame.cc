@@ -18,7 +18,8 @@
 namespace onnxruntime {
 
 OptimizerExecutionFrame::Info::Info(const std::vector<const Node*>& nodes,
-                                    const InitializedTensorSet& initialized_tensor_set) {
+                                    const InitializedTensorSet& initialized_tensor_set,
+                                    const Path& model_path) {
   // Create CPU execution provider
   // For now, CPU execution provider will be created every time when initializing Info.
   // Later, it will be changed to pass by Info ctor.
@@ -28,8 +29,12 @@ OptimizerExecutionFrame::Info::Info(const std::vector<const Node*>& nodes,
 
   data_transfer_mgr_.RegisterDataTransfer(onnxruntime::make_unique<CPUDataTransfer>());
 
+  const PathString model_path_str = model_path.ToPathString();
+  const ORTCHAR_T* tensor_proto_path = model_path_str.empty() ? nullptr : model_path_str.c_str();
+
   // Create MLValues related maps
-  auto initialize_maps = [this, &initialized_tensor_set](const NodeArg& arg, size_t /*index*/) -> Status {
+  auto initialize_maps = [this, &initialized_tensor_set, tensor_proto_path](const NodeArg& arg,
+                                                                             size_t /*index*/) -> Status {
     int idx = ort_value_name_idx_map_.Add(arg.Name());
     ort_value_idx_nodearg_map_[idx] = &arg;
 
@@ -44,7 +49,7 @@ OptimizerExecutionFrame::Info::Info(const std::vector<const Node*>& nodes,
       std::unique_ptr<char[]> data(new char[cpu_tensor_length]);
       std::unique_ptr<Tensor> p_tensor;
       OrtCallback d;
-      ORT_RETURN_IF_ERROR(utils::TensorProtoToMLValue(Env::Default(), nullptr, tensor_proto,
+      ORT_RETURN_IF_ERROR(utils::TensorProtoToMLValue(Env::Default(), tensor_proto_path, tensor_proto,
                                                       MemBuffer(data.get(), cpu_tensor_length, info), ort_value, d));
 
       initializers_[idx] = ort_value;
@@ -20,7 +20,9 @@ class OptimizerExecutionFrame final : public IExecutionFrame {
  public:
   class Info {
    public:
-    Info(const std::vector<const Node*>& nodes, const InitializedTensorSet& initialized_tensor_set);
+    // 'model_path' is used to locate the external data of initializers, if any.
+    Info(const std::vector<const Node*>& nodes, const InitializedTensorSet& initialized_tensor_set,
+         const Path& model_path);
     ~Info() {
       for (auto& kvp : deleter_for_initialized_tensors_) {
         kvp.second.f(kvp.second.param);
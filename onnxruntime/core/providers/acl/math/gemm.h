@@ -52,6 +52,12 @@ class Gemm : public onnxruntime::Gemm<T> {
     ORT_ENFORCE(info.GetAttr<float>("beta", &beta_).IsOK());
   }
 
+  // the ACL kernel reads the W input directly so it must not be packed by the CPU implementation
+  Status PrePack(const Tensor& /*tensor*/, int /*input_idx*/, bool& is_packed) override {
+    is_packed = false;
+    return Status::OK();
+  }
+
   Status Compute(OpKernelContext* context) const override {
     const auto X = context->Input<Tensor>(0);
     const auto W = context->Input<Tensor>(1);
@@ -17,6 +17,12 @@ class MatMul final : public onnxruntime::MatMul<T> {
       : onnxruntime::MatMul<T>(info) {
   }
 
+  // the ACL kernel reads the B input directly so it must not be packed by the CPU implementation
+  Status PrePack(const Tensor& /*tensor*/, int /*input_idx*/, bool& is_packed) override {
+    is_packed = false;
+    return Status::OK();
+  }
+
   Status Compute(OpKernelContext* ctx) const override {
     const Tensor* left_X = ctx->Input<Tensor>(0);
     const Tensor* right_X = ctx->Input<Tensor>(1);
@@ -21,6 +21,9 @@
 #include "core/providers/cpu/tensor/utils.h"
 #include "core/framework/session_options.h"
 
+#include <algorithm>
+#include <unordered_set>
+
 #include "gsl/gsl"
 
 #ifdef _MSC_VER
@@ -144,6 +147,10 @@ struct Loop::Info {
 
   std::vector<std::string> subgraph_input_names;
   std::vector<std::string> subgraph_output_names;
+
+  // whether each Loop output is fetched from the subgraph into CPU memory, where LoopImpl can provide the buffers
+  // for it. set by SetupSubgraphExecutionInfo once the fetch locations are known.
+  std::vector<bool> output_on_cpu;
 };
 
 class LoopImpl {
@@ -161,11 +168,46 @@ class LoopImpl {
   Status Execute(const FeedsFetchesManager& cached_ffm);
 
  private:
+  // Loop carried variables on CPU are produced in one of two buffers owned by the Loop, alternating between them
+  // so the subgraph never writes to the buffer it is reading from. A variable with a fixed shape is therefore
+  // allocated at most twice for the whole Loop instead of once per iteration.
+  struct LoopCarriedBuffers {
+    bool enabled = false;
+    OrtValue values[2];
+  };
+
+  // Scan outputs on CPU are written by the subgraph straight into a buffer holding the output of every iteration.
+  // The buffer grows geometrically as the number of iterations is not known up front, so producing the Loop output
+  // is a single copy instead of a concatenation of all the per-iteration values.
+  struct ScanOutputBuffer {
+    bool enabled = false;
+    MLDataType element_type = nullptr;
+    TensorShape per_iteration_shape;
+    size_t bytes_per_iteration = 0;
+    int64_t capacity = 0;
+    BufferUniquePtr buffer;
+  };
+
   void CreateInitialFeeds(std::vector<OrtValue>& feeds);
-  void SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outputs, std::vector<OrtValue>& next_inputs);
+  Status SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outputs, std::vector<OrtValue>& next_inputs,
+                                   int64_t iteration);
+
+  // custom allocators for the subgraph fetches
+  Status AllocateLoopCarriedVar(int index, const std::vector<OrtValue>& feeds,
+                                const TensorShape& shape, const OrtMemoryInfo& location,
+                                OrtValue& ort_value, bool& allocated);
+  Status AllocateScanOutput(ScanOutputBuffer& output, int64_t iteration,
+                            const TensorShape& shape, const OrtMemoryInfo& location,
+                            OrtValue& ort_value, bool& allocated);
+
+  Status InitializeScanOutputBuffer(ScanOutputBuffer& output, const Tensor& first_output);
+  Status ReserveScanOutputBuffer(ScanOutputBuffer& output, int64_t capacity);
+  Status CopyToScanOutputBuffer(ScanOutputBuffer& output, const Tensor& iteration_output, int64_t iteration);
+  void* ScanOutputSlot(ScanOutputBuffer& output, int64_t iteration) const;
 
   // create the single Loop output from a collection of per-iteration outputs
   Status ConcatenateLoopOutput(std::vector<OrtValue>& per_iteration_output, int output_index);
+  Status CopyScanOutputBufferToOutput(ScanOutputBuffer& output, int64_t num_iterations, int output_index);
 
   OpKernelContextInternal& context_;
   const SessionState& session_state_;
@@ -176,11 +218,16 @@ class LoopImpl {
 
   const std::vector<const OrtValue*>& implicit_inputs_;
 
+  AllocatorPtr cpu_allocator_;
+
   OrtValue iter_num_mlvalue_;
   OrtValue condition_mlvalue_;
 
-  // collection of OrtValue outputs from each loop iteration for the loop outputs.
-  // the order from the subgraph matches the order from the loop output
+  std::vector<LoopCarriedBuffers> loop_carried_buffers_;
+  std::vector<ScanOutputBuffer> scan_output_buffers_;
+
+  // collection of OrtValue outputs from each loop iteration for the loop outputs that are not written to a
+  // ScanOutputBuffer. the order from the subgraph matches the order from the loop output
   std::vector<std::vector<OrtValue>> loop_output_tensors_;
 
   const Loop::ConcatOutput& concat_output_func_;
@@ -305,6 +352,19 @@ common::Status Loop::SetupSubgraphExecutionInfo(const SessionState& session_stat
     fetch_locations.push_back(&alloc_info);
   }
 
+  // LoopImpl can only provide the buffers for the outputs if each subgraph output is a distinct value,
+  // otherwise several fetches would be written to the same buffer.
+  std::unordered_set<std::string> unique_output_names(info_->subgraph_output_names.cbegin(),
+                                                      info_->subgraph_output_names.cend());
+  bool outputs_are_unique = unique_output_names.size() == info_->subgraph_output_names.size();
+
+  info_->output_on_cpu.reserve(info_->num_outputs);
+  for (int i = 0; i < info_->num_outputs; ++i) {
+    // +1 to skip 'cond'
+    info_->output_on_cpu.push_back(outputs_are_unique &&
+                                   fetch_locations[i + 1]->device == cpu_allocator_info.device);
+  }
+
   utils::FinalizeFeedFetchCopyInfo(subgraph_session_state, *ffm, feed_locations, fetch_locations);
 
   feeds_fetches_manager_ = std::move(ffm);
@@ -344,6 +404,12 @@ LoopImpl::LoopImpl(OpKernelContextInternal& context,
   condition_ = cond_tensor ? *cond_tensor->Data<bool>() : true;
 }
 
+static OrtValue MakeTensorMLValue(std::unique_ptr<Tensor> p_tensor) {
+  auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+  return OrtValue{p_tensor.release(), ml_tensor,
+                  ml_tensor->GetDeleteFunc()};
+}
+
 template <typename T>
 static OrtValue MakeScalarMLValue(const AllocatorPtr& allocator, T value, bool is_1d) {
   auto* data_type = DataTypeImpl::GetType<T>();
@@ -384,13 +450,31 @@ Status LoopImpl::Initialize() {
   auto condition_rank = subgraph_inputs[1]->Shape()->dim_size();
 
   // these need to be on CPU
-  auto cpu_allocator = session_state_.GetExecutionProviders()
-                           .Get(onnxruntime::kCpuExecutionProvider)
-                           ->GetAllocator(0, OrtMemTypeDefault);
-  iter_num_mlvalue_ = MakeScalarMLValue<int64_t>(cpu_allocator, 0, iter_num_rank);
-  condition_mlvalue_ = MakeScalarMLValue<bool>(cpu_allocator, condition_, condition_rank);
+  cpu_allocator_ = session_state_.GetExecutionProviders()
+                       .Get(onnxruntime::kCpuExecutionProvider)
+                       ->GetAllocator(0, OrtMemTypeDefault);
+  iter_num_mlvalue_ = MakeScalarMLValue<int64_t>(cpu_allocator_, 0, iter_num_rank);
+  condition_mlvalue_ = MakeScalarMLValue<bool>(cpu_allocator_, condition_, condition_rank);
+
+  const int num_scan_outputs = info_.num_outputs - info_.num_loop_carried_vars;
+  scan_output_buffers_.resize(num_scan_outputs);
+  loop_output_tensors_.resize(num_scan_outputs);
+
+  bool all_scan_outputs_on_cpu = true;
+  for (int i = 0; i < num_scan_outputs; ++i) {
+    scan_output_buffers_[i].enabled = info_.output_on_cpu[info_.num_loop_carried_vars + i];
+    all_scan_outputs_on_cpu = all_scan_outputs_on_cpu && scan_output_buffers_[i].enabled;
+  }
 
-  loop_output_tensors_.resize(info_.num_outputs - info_.num_loop_carried_vars);
+  // a scan output that is not copied into a ScanOutputBuffer holds on to the value produced by the subgraph until
+  // the end of the Loop. that value may be a loop carried variable passed through the subgraph, so only recycle the
+  // loop carried variable buffers if no scan output does that.
+  loop_carried_buffers_.resize(info_.num_loop_carried_vars);
+  for (int i = 0; i < info_.num_loop_carried_vars; ++i) {
+    const auto* input = context_.GetInputMLValue(i + 2);  // skip 'M' and 'cond'
+    loop_carried_buffers_[i].enabled = all_scan_outputs_on_cpu && info_.output_on_cpu[i] &&
+                                       input->IsTensor() && !input->Get<Tensor>().IsDataTypeString();
+  }
 
   return status;
 }
@@ -413,8 +497,9 @@ void LoopImpl::CreateInitialFeeds(std::vector<OrtValue>& feeds) {
   }
 }
 
-void LoopImpl::SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outputs,
-                                         std::vector<OrtValue>& next_inputs) {
+Status LoopImpl::SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outputs,
+                                           std::vector<OrtValue>& next_inputs,
+                                           int64_t iteration) {
   // last_output: cond, loop vars..., loop output...
   // next_input: iter_num, cond, loop_vars. iter_num is re-used
 
@@ -425,8 +510,141 @@ void LoopImpl::SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outpu
 
   // save loop outputs as we have to concatenate at the end
   for (int j = info_.num_loop_carried_vars; j < info_.num_outputs; ++j) {
-    loop_output_tensors_[j - info_.num_loop_carried_vars].push_back(last_outputs[j + 1]);  // skip 'cond' in output
+    const OrtValue& ort_value = last_outputs[j + 1];  // skip 'cond' in output
+    auto& output = scan_output_buffers_[j - info_.num_loop_carried_vars];
+
+    if (output.enabled && iteration == 0) {
+      ORT_RETURN_IF_ERROR(InitializeScanOutputBuffer(output, ort_value.Get<Tensor>()));
+    }
+
+    if (output.enabled) {
+      ORT_RETURN_IF_ERROR(CopyToScanOutputBuffer(output, ort_value.Get<Tensor>(), iteration));
+    } else {
+      loop_output_tensors_[j - info_.num_loop_carried_vars].push_back(ort_value);
+    }
+  }
+
+  return Status::OK();
+}
+
+// check if the buffer of 'ort_value' is currently being read by the subgraph
+static bool IsUsedByFeeds(const OrtValue& ort_value, const std::vector<OrtValue>& feeds) {
+  const void* data = ort_value.Get<Tensor>().DataRaw();
+  return std::any_of(feeds.cbegin(), feeds.cend(), [data](const OrtValue& feed) {
+    return feed.IsTensor() && feed.Get<Tensor>().DataRaw() == data;
+  });
+}
+
+Status LoopImpl::AllocateLoopCarriedVar(int index, const std::vector<OrtValue>& feeds,
+                                        const TensorShape& shape, const OrtMemoryInfo& location,
+                                        OrtValue& ort_value, bool& allocated) {
+  // if the subgraph produces the value on another device we let the execution frame allocate it there
+  if (location.device != cpu_allocator_->Info().device) {
+    return Status::OK();
+  }
+
+  // the element type is fixed across iterations so take it from the current value of the variable
+  const auto* element_type = feeds[index + 2].Get<Tensor>().DataType();  // skip iter_num and cond
+
+  // a subgraph output may pass through any of its inputs, so the buffer being read could be used by any of
+  // the feeds and not just the one for this variable.
+  for (auto& buffer : loop_carried_buffers_[index].values) {
+    if (buffer.IsAllocated() && IsUsedByFeeds(buffer, feeds)) {
+      continue;
+    }
+
+    if (!buffer.IsAllocated() || buffer.Get<Tensor>().Shape() != shape) {
+      buffer = MakeTensorMLValue(onnxruntime::make_unique<Tensor>(element_type, shape, cpu_allocator_));
+    }
+
+    ort_value = buffer;
+    allocated = true;
+    break;
+  }
+
+  return Status::OK();
+}
+
+Status LoopImpl::AllocateScanOutput(ScanOutputBuffer& output, int64_t iteration,
+                                    const TensorShape& shape, const OrtMemoryInfo& location,
+                                    OrtValue& ort_value, bool& allocated) {
+  if (shape != output.per_iteration_shape) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Inconsistent shape in loop output for output. ",
+                           " Expected:", output.per_iteration_shape, " Got:", shape);
+  }
+
+  // if the subgraph produces the value on another device we let the execution frame allocate it there,
+  // and copy it into the buffer once it has been fetched to CPU.
+  if (location.device != cpu_allocator_->Info().device) {
+    return Status::OK();
+  }
+
+  ort_value = MakeTensorMLValue(onnxruntime::make_unique<Tensor>(output.element_type, shape,
+                                                                 ScanOutputSlot(output, iteration),
+                                                                 cpu_allocator_->Info()));
+  allocated = true;
+
+  return Status::OK();
+}
+
+Status LoopImpl::InitializeScanOutputBuffer(ScanOutputBuffer& output, const Tensor& first_output) {
+  // strings can't be copied as raw bytes, and there's nothing to gain for an empty output,
+  // so those are saved per iteration and concatenated at the end.
+  if (first_output.IsDataTypeString() || first_output.SizeInBytes() == 0) {
+    output.enabled = false;
+    return Status::OK();
+  }
+
+  output.element_type = first_output.DataType();
+  output.per_iteration_shape = first_output.Shape();
+  output.bytes_per_iteration = first_output.SizeInBytes();
+
+  constexpr int64_t initial_capacity = 16;
+  return ReserveScanOutputBuffer(output, std::min(max_trip_count_, initial_capacity));
+}
+
+Status LoopImpl::ReserveScanOutputBuffer(ScanOutputBuffer& output, int64_t capacity) {
+  size_t size_in_bytes = 0;
+  if (!IAllocator::CalcMemSizeForArray(gsl::narrow<size_t>(capacity), output.bytes_per_iteration, &size_in_bytes)) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Size overflow allocating buffer for ", capacity,
+                           " iterations of loop output with shape ", output.per_iteration_shape);
+  }
+
+  BufferUniquePtr buffer(cpu_allocator_->Alloc(size_in_bytes), BufferDeleter(cpu_allocator_));
+
+  // nothing refers to the old buffer between iterations, so the existing values can simply be moved over
+  if (output.buffer) {
+    memcpy(buffer.get(), output.buffer.get(), static_cast<size_t>(output.capacity) * output.bytes_per_iteration);
   }
+
+  output.buffer = std::move(buffer);
+  output.capacity = capacity;
+
+  return Status::OK();
+}
+
+Status LoopImpl::CopyToScanOutputBuffer(ScanOutputBuffer& output, const Tensor& iteration_output,
+                                        int64_t iteration) {
+  void* slot = ScanOutputSlot(output, iteration);
+
+  // nothing to do if the subgraph wrote the value into the slot provided by AllocateScanOutput.
+  // otherwise the value is an initializer, an outer scope value or a subgraph input passed through,
+  // or was produced on another device.
+  if (iteration_output.DataRaw() != slot) {
+    // sanity check
+    if (iteration_output.Shape() != output.per_iteration_shape) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Inconsistent shape in loop output for output. ",
+                             " Expected:", output.per_iteration_shape, " Got:", iteration_output.Shape());
+    }
+
+    memcpy(slot, iteration_output.DataRaw(), output.bytes_per_iteration);
+  }
+
+  return Status::OK();
+}
+
+void* LoopImpl::ScanOutputSlot(ScanOutputBuffer& output, int64_t iteration) const {
+  return static_cast<uint8_t*>(output.buffer.get()) + static_cast<size_t>(iteration) * output.bytes_per_iteration;
 }
 
 Status LoopImpl::ConcatenateLoopOutput(std::vector<OrtValue>& per_iteration_output, int output_index) {
@@ -448,29 +666,76 @@ Status LoopImpl::ConcatenateLoopOutput(std::vector<OrtValue>& per_iteration_outp
   return Status::OK();
 }
 
+Status LoopImpl::CopyScanOutputBufferToOutput(ScanOutputBuffer& output, int64_t num_iterations,
+                                              int output_index) {
+  const auto& per_iteration_dims = output.per_iteration_shape.GetDims();
+
+  std::vector<int64_t> dims;
+  dims.reserve(1 + per_iteration_dims.size());
+
+  // first dimension is number of iterations
+  dims.push_back(num_iterations);
+  std::copy(per_iteration_dims.cbegin(), per_iteration_dims.cend(), std::back_inserter(dims));
+
+  Tensor* output_tensor = context_.Output(output_index, TensorShape(dims));
+  memcpy(output_tensor->MutableDataRaw(), output.buffer.get(), output_tensor->SizeInBytes());
+
+  return Status::OK();
+}
+
 Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
   auto status = Status::OK();
 
   std::vector<OrtValue> feeds;
   std::vector<OrtValue> fetches;
+  std::unordered_map<size_t, IExecutor::CustomAllocator> fetch_allocators;
 
   CreateInitialFeeds(feeds);
 
   auto& iter_num_value = *iter_num_mlvalue_.GetMutable<Tensor>()->MutableData<int64_t>();
 
+  for (int i = 0; i < info_.num_loop_carried_vars; ++i) {
+    if (loop_carried_buffers_[i].enabled) {
+      // +1 to skip 'cond' in the fetches
+      fetch_allocators[i + 1] = [this, i, &feeds](const TensorShape& shape, const OrtMemoryInfo& location,
+                                                  OrtValue& ort_value, bool& allocated) {
+        return AllocateLoopCarriedVar(i, feeds, shape, location, ort_value, allocated);
+      };
+    }
+  }
+
   while (iter_num_value < max_trip_count_ && *condition_mlvalue_.GetMutable<Tensor>()->MutableData<bool>()) {
-    if (iter_num_value != 0) {
-      SaveOutputsAndUpdateFeeds(fetches, feeds);
-      fetches.clear();
+    fetches.clear();
+
+    for (auto& output : scan_output_buffers_) {
+      if (output.enabled && iter_num_value == output.capacity) {
+        ORT_RETURN_IF_ERROR(ReserveScanOutputBuffer(output, std::min(max_trip_count_, output.capacity * 2)));
+      }
     }
 
-    status = utils::ExecuteSubgraph(session_state_, ffm, feeds, fetches, {},
+    status = utils::ExecuteSubgraph(session_state_, ffm, feeds, fetches, fetch_allocators,
                                     ExecutionMode::ORT_SEQUENTIAL, context_.GetTerminateFlag(), context_.Logger());
 
     ORT_RETURN_IF_ERROR(status);
 
     condition_mlvalue_ = fetches[0];
 
+    ORT_RETURN_IF_ERROR(SaveOutputsAndUpdateFeeds(fetches, feeds, iter_num_value));
+
+    if (iter_num_value == 0) {
+      // the shape of each scan output is known now, so the remaining iterations can write to the buffers directly
+      for (int j = info_.num_loop_carried_vars; j < info_.num_outputs; ++j) {
+        auto& output = scan_output_buffers_[j - info_.num_loop_carried_vars];
+        if (output.enabled) {
+          fetch_allocators[j + 1] = [this, &output, &iter_num_value](const TensorShape& shape,
+                                                                     const OrtMemoryInfo& location,
+                                                                     OrtValue& ort_value, bool& allocated) {
+            return AllocateScanOutput(output, iter_num_value, shape, location, ort_value, allocated);
+          };
+        }
+      }
+    }
+
     ++iter_num_value;
   }
 
@@ -482,27 +747,23 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
     session_state_.GetDataTransferMgr().CopyTensor(input.Get<Tensor>(), *output);
   };
 
+  // the feeds hold the latest value of the loop carried vars, which is the input value if there were no iterations
+  for (int i = 0; i < info_.num_loop_carried_vars; ++i) {
+    copy_tensor_from_mlvalue_to_output(feeds[i + 2], i);  // skip iter# and cond
+  }
+
   // copy to Loop output
   if (iter_num_value != 0) {
-    for (int i = 0; i < info_.num_loop_carried_vars; ++i) {
-      // need to allocate Loop output and copy OrtValue from fetches
-      copy_tensor_from_mlvalue_to_output(fetches[i + 1], i);  // skip cond
-    }
-
     for (int i = info_.num_loop_carried_vars; i < info_.num_outputs; ++i) {
-      // add last output
-      auto& per_iteration_outputs = loop_output_tensors_[i - info_.num_loop_carried_vars];
-      per_iteration_outputs.push_back(fetches[i + 1]);  // skip cond
-
-      ORT_RETURN_IF_ERROR(ConcatenateLoopOutput(per_iteration_outputs, i));
+      auto& output = scan_output_buffers_[i - info_.num_loop_carried_vars];
+      if (output.enabled) {
+        ORT_RETURN_IF_ERROR(CopyScanOutputBufferToOutput(output, iter_num_value, i));
+      } else {
+        ORT_RETURN_IF_ERROR(ConcatenateLoopOutput(loop_output_tensors_[i - info_.num_loop_carried_vars], i));
+      }
     }
   } else {
     // no iterations.
-    // copy input loop carried vars to output.
-    for (int i = 0; i < info_.num_loop_carried_vars; ++i) {
-      copy_tensor_from_mlvalue_to_output(feeds[i + 2], i);  // skip iter# and cond
-    }
-
     // create empty outputs for loop outputs using the subgraph output shapes for the rank
     auto& graph_outputs = info_.subgraph.GetOutputs();
 
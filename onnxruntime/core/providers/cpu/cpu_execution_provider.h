@@ -12,6 +12,8 @@ namespace onnxruntime {
 // Information needed to construct CPU execution providers.
 struct CPUExecutionProviderInfo {
   bool create_arena{true};
+  OrtArenaExtendStrategy arena_extend_strategy{ORT_ARENA_EXTEND_NEXT_POWER_OF_TWO};
+  bool arena_use_thread_cache{false};
 
   explicit CPUExecutionProviderInfo(bool use_arena)
       : create_arena(use_arena) {}
@@ -30,6 +32,8 @@ class CPUExecutionProvider : public IExecutionProvider {
     DeviceAllocatorRegistrationInfo device_info{OrtMemTypeDefault,
                                                 [](int) { return onnxruntime::make_unique<TAllocator>(); },
                                                 std::numeric_limits<size_t>::max()};
+    device_info.use_thread_cache = info.arena_use_thread_cache;
+    device_info.arena_extend_strategy = info.arena_extend_strategy;
 
 #ifdef USE_JEMALLOC
 #if defined(USE_MIMALLOC_ARENA_ALLOCATOR) || defined(USE_MIMALLOC_STL_ALLOCATOR)
@@ -5,6 +5,7 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
 #include "core/util/math_cpuonly.h"
 
 namespace onnxruntime {
@@ -330,6 +331,20 @@ struct BroadcastIterator {
     return index;
   }
 
+  // Positions the iterator at output element 'offset', as if AdvanceBy had been called for all the elements before it.
+  // Each time a counter wraps around, the delta of the next counter is added to the index.
+  void Seek(size_t offset) {
+    auto index = deltas_[0] * static_cast<ptrdiff_t>(offset);
+    counters_[0] = static_cast<int64_t>(offset) % counts_[0];
+    auto wraps = static_cast<int64_t>(offset) / counts_[0];
+    for (size_t counterIndex = 1; counterIndex < counters_.size(); counterIndex++) {
+      index += deltas_[counterIndex] * static_cast<ptrdiff_t>(wraps);
+      counters_[counterIndex] = wraps % counts_[counterIndex];
+      wraps /= counts_[counterIndex];
+    }
+    index_ = static_cast<size_t>(index);
+  }
+
   void Reserve(int64_t max_dims) {
     deltas_.reserve(static_cast<size_t>(max_dims));
     counts_.reserve(static_cast<size_t>(max_dims));
@@ -509,9 +524,24 @@ struct TBroadcaster {
   ConstEigenVectorMap<T0> NextEigen0() { return ConstEigenVectorMap<T0>(Next0(), span_size_); }
   ConstEigenVectorMap<T1> NextEigen1() { return ConstEigenVectorMap<T1>(Next1(), span_size_); }
 
+  // Positions both inputs at output element 'offset', so that a copy of the broadcaster can process a range of the output.
+  // The next 'count' elements are then read with the functions below, where 'count' must not cross a span boundary.
+  void Seek(size_t offset) {
+    broadcaster_.iterator1_.Seek(offset);
+    broadcaster_.iterator2_.Seek(offset);
+  }
+
+  const T0& NextScalar0(size_t count) { return *Next0(count); }
+  const T1& NextScalar1(size_t count) { return *Next1(count); }
+
+  ConstEigenVectorMap<T0> NextEigen0(size_t count) { return ConstEigenVectorMap<T0>(Next0(count), count); }
+  ConstEigenVectorMap<T1> NextEigen1(size_t count) { return ConstEigenVectorMap<T1>(Next1(count), count); }
+
  private:
-  const T0* Next0() { return input0_ + broadcaster_.iterator1_.AdvanceBy(span_size_); }
-  const T1* Next1() { return input1_ + broadcaster_.iterator2_.AdvanceBy(span_size_); }
+  const T0* Next0(size_t count) { return input0_ + broadcaster_.iterator1_.AdvanceBy(count); }
+  const T1* Next1(size_t count) { return input1_ + broadcaster_.iterator2_.AdvanceBy(count); }
+  const T0* Next0() { return Next0(span_size_); }
+  const T1* Next1() { return Next1(span_size_); }
 
   const Tensor& input_tensor0_;
   const Tensor& input_tensor1_;
@@ -610,11 +640,48 @@ void BroadcastLoopSpan(TBroadcaster& bc, Output& output, Input0Scalar input0scal
   }
 }
 
+// Parallel version of BroadcastLoop, with functions of the same form. The output is split into ranges that are
+// processed by the thread pool, each with its own copy of the broadcaster positioned at the start of the range.
+// The functions are called for pieces of a range that do not cross a span boundary, so a single large span (when both
+// inputs have the same shape or one of them is a scalar) is split across the threads as well.
+template <typename TOutput, typename T0, typename T1, typename Input0Scalar, typename Input1Scalar, typename General>
+void ParallelBroadcastLoop(const TBroadcaster<T0, T1>& bc, Tensor& output_tensor, concurrency::ThreadPool* tp,
+                           Input0Scalar input0scalar, Input1Scalar input1scalar, General general) {
+  TOutput* output = output_tensor.template MutableData<TOutput>();
+  const auto output_size = static_cast<std::ptrdiff_t>(output_tensor.Shape().Size());
+  const auto span_size = static_cast<std::ptrdiff_t>(bc.GetSpanSize());
+  const bool input0_scalar = bc.IsInput0Scalar();
+  const bool input1_scalar = bc.IsInput1Scalar();
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, output_size,
+      TensorOpCost{static_cast<double>(sizeof(T0) + sizeof(T1)), static_cast<double>(sizeof(TOutput)), 1.0},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        if (first >= last)
+          return;
+
+        TBroadcaster<T0, T1> range_bc(bc);
+        range_bc.Seek(static_cast<size_t>(first));
+
+        for (std::ptrdiff_t offset = first; offset < last;) {
+          const auto count = static_cast<size_t>(std::min(last, (offset / span_size + 1) * span_size) - offset);
+          EigenVectorMap<TOutput> range_output(output + offset, count);
+          if (input0_scalar)
+            input0scalar(range_output, range_bc.NextScalar0(count), range_bc.NextEigen1(count));
+          else if (input1_scalar)
+            input1scalar(range_output, range_bc.NextEigen0(count), range_bc.NextScalar1(count));
+          else
+            general(range_output, range_bc.NextEigen0(count), range_bc.NextEigen1(count));
+          offset += static_cast<std::ptrdiff_t>(count);
+        }
+      });
+}
+
 template <typename TInput, typename TOutput, typename Input0Scalar, typename Input1Scalar, typename General>
 Status BroadcastTwo(OpKernelContext& context, Input0Scalar input0scalar, Input1Scalar input1scalar, General general) {
   TBroadcaster<TInput, TInput> bc(*context.Input<Tensor>(0), *context.Input<Tensor>(1));
-  TBroadcastOutput<TOutput> output(bc.GetSpanSize(), *context.Output(0, bc.GetOutputShape()));
-  BroadcastLoop(bc, output, input0scalar, input1scalar, general);
+  Tensor& output = *context.Output(0, bc.GetOutputShape());
+  ParallelBroadcastLoop<TOutput>(bc, output, context.GetOperatorThreadPool(), input0scalar, input1scalar, general);
 
   return Status::OK();
 }
@@ -651,9 +718,7 @@ Status BroadcastVariadic(const Node& node, OpKernelContext& context, Input0Scala
       p_output = tempOutput.get();
     }
 
-    TBroadcastOutput<TOutput> output(bc.GetSpanSize(), *p_output);
-
-    BroadcastLoop(bc, output, input0scalar, input1scalar, general);
+    ParallelBroadcastLoop<TOutput>(bc, *p_output, context.GetOperatorThreadPool(), input0scalar, input1scalar, general);
 
     tempInput = std::move(tempOutput);
   }
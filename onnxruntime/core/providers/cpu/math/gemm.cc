@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/math/gemm.h"
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 
@@ -26,4 +27,94 @@ ONNX_CPU_OPERATOR_KERNEL(
     11,
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Gemm<float>);
+
+template <>
+Status Gemm<float>::PrePack(const Tensor& tensor, int input_idx, bool& is_packed) {
+  is_packed = false;
+
+  // only pack matrix B
+  if (input_idx != 1) {
+    return Status::OK();
+  }
+
+  b_shape_ = tensor.Shape();
+  if (b_shape_.NumDimensions() != 2 || b_shape_[0] == 0 || b_shape_[1] == 0) {
+    return Status::OK();
+  }
+
+  const size_t K = trans_B_ == CblasTrans ? static_cast<size_t>(b_shape_[1]) : static_cast<size_t>(b_shape_[0]);
+  const size_t N = trans_B_ == CblasTrans ? static_cast<size_t>(b_shape_[0]) : static_cast<size_t>(b_shape_[1]);
+
+  const size_t packed_b_size = MlasGemmPackBSize(N, K);
+  if (packed_b_size == 0) {
+    return Status::OK();
+  }
+
+  auto alloc = Info().GetAllocator(0, OrtMemTypeDefault);
+  auto* packed_b_data = alloc->Alloc(packed_b_size);
+  packed_b_ = BufferUniquePtr(packed_b_data, BufferDeleter(alloc));
+
+  MlasGemmPackB(trans_B_, N, K, tensor.Data<float>(), static_cast<size_t>(b_shape_[1]), packed_b_data);
+
+  is_packed = true;
+  return Status::OK();
+}
+
+template <>
+Status Gemm<float>::Compute(OpKernelContext* context) const {
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+
+  const auto* X = context->Input<Tensor>(0);
+  // the W input is not read if it was packed as it may have been released by the session
+  const auto* W = packed_b_ ? nullptr : context->Input<Tensor>(1);
+  const auto* B = context->Input<Tensor>(2);
+  // Bias could be missing. Treat as scalar 0 if that is the case.
+  GemmHelper helper(X->Shape(), trans_A_ != CblasNoTrans, packed_b_ ? b_shape_ : W->Shape(),
+                    trans_B_ != CblasNoTrans, B != nullptr ? B->Shape() : TensorShape({}));
+
+  if (!helper.State().IsOK())
+    return helper.State();
+
+  int64_t M = helper.M();
+  int64_t N = helper.N();
+  int64_t K = helper.K();
+
+  auto Y = context->Output(0, {M, N});
+
+  // if input is empty tensor, return as nothing need to be calculated and we've set the shape for the output
+  if (M == 0 || N == 0)
+    return Status::OK();
+
+  const float* b_data = B != nullptr ? B->Data<float>() : nullptr;
+  const TensorShape* b_shape = B != nullptr ? &B->Shape() : nullptr;
+
+  float* y_data = Y->MutableData<float>();
+
+  if (packed_b_) {
+    GemmBroadcastBias(M, N, beta_, b_data, b_shape, y_data);
+
+    MlasGemm(trans_A_,
+             static_cast<size_t>(M), static_cast<size_t>(N), static_cast<size_t>(K),
+             alpha_,
+             X->Data<float>(),
+             trans_A_ == CblasNoTrans ? static_cast<size_t>(K) : static_cast<size_t>(M),
+             packed_b_.get(),
+             // ideally we need to set the output buffer contents to 0 if bias is missing,
+             // but passing 0 for beta is cheaper and it will ignore any junk in the output buffer
+             b_data != nullptr ? beta_ : 0,
+             y_data,
+             static_cast<size_t>(N),
+             thread_pool);
+  } else {
+    ComputeGemm(trans_A_, trans_B_, M, N, K, alpha_, X->Data<float>(), W->Data<float>(), beta_,
+                b_data, b_shape,
+                y_data,
+                thread_pool);
+  }
+
+  FuseActivation<float>(activation_, y_data, M * N, leaky_relu_alpha_);
+
+  return Status::OK();
+}
+
 }  // namespace onnxruntime
@@ -26,19 +26,10 @@ class Gemm : public OpKernel {
     ORT_ENFORCE(info.GetAttr<float>("beta", &beta_).IsOK());
   }
 
-  static void ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
-                          int64_t M, int64_t N, int64_t K,
-                          float alpha,
-                          const T* a_data, const T* b_data,
-                          float beta,
-                          const T* c_data, const TensorShape* c_shape,
-                          T* y_data,
-                          concurrency::ThreadPool* thread_pool) {
-    // if input is empty tensor, return directly as nothing need to be calculated.
-    if (M == 0 || N == 0)
-      return;
-
-    // Broadcast the bias as needed if bias is given
+  // Broadcast the bias into the output as needed if bias is given, so the GEMM can accumulate into it.
+  static void GemmBroadcastBias(int64_t M, int64_t N, float beta,
+                                const T* c_data, const TensorShape* c_shape,
+                                T* y_data) {
     if (beta != 0 && c_data != nullptr) {
       ORT_ENFORCE(c_shape != nullptr, "c_shape is required if c_data is provided");
       auto output_mat = EigenMatrixMapRowMajor<T>(y_data, M, N);
@@ -56,6 +47,21 @@ class Gemm : public OpKernel {
         output_mat = ConstEigenMatrixMapRowMajor<T>(c_data, M, N);
       }
     }
+  }
+
+  static void ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
+                          int64_t M, int64_t N, int64_t K,
+                          float alpha,
+                          const T* a_data, const T* b_data,
+                          float beta,
+                          const T* c_data, const TensorShape* c_shape,
+                          T* y_data,
+                          concurrency::ThreadPool* thread_pool) {
+    // if input is empty tensor, return directly as nothing need to be calculated.
+    if (M == 0 || N == 0)
+      return;
+
+    GemmBroadcastBias(M, N, beta, c_data, c_shape, y_data);
 
     math::Gemm<T>(trans_a, trans_b,
                   M, N, K,
@@ -69,6 +75,11 @@ class Gemm : public OpKernel {
                   thread_pool);
   }
 
+  Status PrePack(const Tensor& /*tensor*/, int /*input_idx*/, bool& is_packed) override {
+    is_packed = false;
+    return Status::OK();
+  }
+
   Status Compute(OpKernelContext* context) const override {
     concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
 
@@ -113,10 +124,20 @@ class Gemm : public OpKernel {
   float alpha_;
   float beta_;
 
+  // Constant B matrix packed by MlasGemmPackB during session initialization. Only used for float.
+  TensorShape b_shape_;
+  BufferUniquePtr packed_b_;
+
  protected:
   // For fused gemm + activation
   std::string activation_;
   float leaky_relu_alpha_;
 };
 
+template <>
+Status Gemm<float>::PrePack(const Tensor& tensor, int input_idx, bool& is_packed);
+
+template <>
+Status Gemm<float>::Compute(OpKernelContext* context) const;
+
 }  // namespace onnxruntime
@@ -4,6 +4,7 @@
 #include "core/providers/cpu/math/matmul.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
+#include "core/mlas/inc/mlas.h"
 #include "matmul_helper.h"
 
 namespace onnxruntime {
@@ -65,6 +66,12 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<uint64_t>()),
     MatMul<uint64_t>);
 
+template <typename T>
+Status MatMul<T>::PrePack(const Tensor& /*tensor*/, int /*input_idx*/, bool& is_packed) {
+  is_packed = false;
+  return Status::OK();
+}
+
 template <typename T>
 Status MatMul<T>::Compute(OpKernelContext* ctx) const {
   concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
@@ -92,4 +99,90 @@ Status MatMul<T>::Compute(OpKernelContext* ctx) const {
   return Status::OK();
 }
 
+template <>
+Status MatMul<float>::PrePack(const Tensor& tensor, int input_idx, bool& is_packed) {
+  is_packed = false;
+
+  // only pack matrix B
+  if (input_idx != 1) {
+    return Status::OK();
+  }
+
+  // the packed kernel handles a 2D B, which covers the common case of a weight that is shared by
+  // every matrix in a batched A.
+  b_shape_ = tensor.Shape();
+  if (b_shape_.NumDimensions() != 2 || b_shape_[0] == 0 || b_shape_[1] == 0) {
+    return Status::OK();
+  }
+
+  const size_t K = static_cast<size_t>(b_shape_[0]);
+  const size_t N = static_cast<size_t>(b_shape_[1]);
+
+  const size_t packed_b_size = MlasGemmPackBSize(N, K);
+  if (packed_b_size == 0) {
+    return Status::OK();
+  }
+
+  auto alloc = Info().GetAllocator(0, OrtMemTypeDefault);
+  auto* packed_b_data = alloc->Alloc(packed_b_size);
+  packed_b_ = BufferUniquePtr(packed_b_data, BufferDeleter(alloc));
+
+  MlasGemmPackB(CblasNoTrans, N, K, tensor.Data<float>(), N, packed_b_data);
+
+  is_packed = true;
+  return Status::OK();
+}
+
+template <>
+Status MatMul<float>::Compute(OpKernelContext* ctx) const {
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+
+  const auto* left_X = ctx->Input<Tensor>(0);
+  // the B input is not read if it was packed as it may have been released by the session
+  const auto* right_X = packed_b_ ? nullptr : ctx->Input<Tensor>(1);
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(left_X->Shape(), packed_b_ ? b_shape_ : right_X->Shape()));
+
+  Tensor* Y = ctx->Output(0, helper.OutputShape());
+
+  // Bail out early if the output is going to be empty
+  if (Y->Shape().Size() == 0)
+    return Status::OK();
+
+  const size_t max_len = helper.OutputOffsets().size();
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+
+  const float* a_data = left_X->Data<float>();
+  float* y_data = Y->MutableData<float>();
+
+  if (packed_b_) {
+    for (size_t i = 0; i < max_len; i++) {
+      MlasGemm(CblasNoTrans, M, N, K, 1.0f,
+               a_data + helper.LeftOffsets()[i], K,
+               packed_b_.get(), 0.0f,
+               y_data + helper.OutputOffsets()[i], N,
+               thread_pool);
+    }
+
+    return Status::OK();
+  }
+
+  const float* b_data = right_X->Data<float>();
+
+  for (size_t i = 0; i < max_len; i++) {
+    math::MatMul<float>(
+        static_cast<int>(M),
+        static_cast<int>(N),
+        static_cast<int>(K),
+        a_data + helper.LeftOffsets()[i],
+        b_data + helper.RightOffsets()[i],
+        y_data + helper.OutputOffsets()[i], thread_pool);
+  }
+
+  return Status::OK();
+}
+
 }  // namespace onnxruntime
@@ -15,7 +15,20 @@ class MatMul final : public OpKernel {
       : OpKernel(info) {
   }
 
+  Status PrePack(const Tensor& tensor, int input_idx, bool& is_packed) override;
+
   Status Compute(OpKernelContext* context) const override;
+
+ private:
+  // Constant B matrix packed by MlasGemmPackB during session initialization. Only used for float.
+  TensorShape b_shape_;
+  BufferUniquePtr packed_b_;
 };
 
+template <>
+Status MatMul<float>::PrePack(const Tensor& tensor, int input_idx, bool& is_packed);
+
+template <>
+Status MatMul<float>::Compute(OpKernelContext* context) const;
+
 }  // namespace onnxruntime
@@ -14,10 +14,74 @@
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/providers/common.h"
 #include "core/util/math.h"
-#include "core/util/eigen_common_wrapper.h"
+#include "core/util/math_cpuonly.h"
+#include "core/util/softmax.h"
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 
+template <typename T>
+static void ComputeSoftmaxRows(const T* X, T* Y, size_t N, size_t D, bool log_softmax,
+                               concurrency::ThreadPool* tp) {
+  Eigen::TensorMap<Eigen::Tensor<const T, 2, Eigen::RowMajor, Eigen::DenseIndex>, Eigen::Aligned> X_tensor(
+      X, N, D);
+  Eigen::TensorMap<Eigen::Tensor<T, 2, Eigen::RowMajor, Eigen::DenseIndex>, Eigen::Aligned> Y_tensor(
+      Y, N, D);
+
+  const int batch_size = static_cast<int>(N);
+  const int num_classes = static_cast<int>(D);
+
+#ifndef _OPENMP
+  if (tp != nullptr) {
+    if (log_softmax)
+      ComputeSoftMax<true>(tp->Device(), X_tensor, Y_tensor, batch_size, num_classes);
+    else
+      ComputeSoftMax<false>(tp->Device(), X_tensor, Y_tensor, batch_size, num_classes);
+    return;
+  }
+#else
+  ORT_UNUSED_PARAMETER(tp);
+#endif
+
+  if (log_softmax)
+    ComputeSoftMax<true>(Eigen::DefaultDevice(), X_tensor, Y_tensor, batch_size, num_classes);
+  else
+    ComputeSoftMax<false>(Eigen::DefaultDevice(), X_tensor, Y_tensor, batch_size, num_classes);
+}
+
+// MLAS computes the rows with vectorized max/exp/sum/scale kernels and shards them across the thread pool.
+template <>
+void ComputeSoftmaxRows<float>(const float* X, float* Y, size_t N, size_t D, bool log_softmax,
+                               concurrency::ThreadPool* tp) {
+  MlasComputeSoftmax(X, Y, N, D, log_softmax, tp);
+}
+
+template <typename T, bool use_log>
+Status Softmax<T, use_log>::Compute(OpKernelContext* ctx) const {
+  const auto* tensor_pointer = ctx->Input<Tensor>(0);
+  if (tensor_pointer == nullptr)
+    return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
+  const Tensor& X = *tensor_pointer;
+  const TensorShape& input_shape = X.Shape();
+
+  VLOGS(ctx->Logger(), 2) << "Input tensor shape: " << input_shape;
+
+  Tensor* Y = ctx->Output(0, input_shape);
+
+  // edge case. one or more dims with value of 0. nothing to do
+  if (input_shape.Size() == 0)
+    return Status::OK();
+
+  const int64_t axis = HandleNegativeAxis(axis_, input_shape.NumDimensions());
+
+  const size_t N = gsl::narrow<size_t>(input_shape.SizeToDimension(axis));
+  const size_t D = gsl::narrow<size_t>(input_shape.SizeFromDimension(axis));
+
+  ComputeSoftmaxRows<T>(X.Data<T>(), Y->MutableData<T>(), N, D, use_log, ctx->GetOperatorThreadPool());
+
+  return Status::OK();
+}
+
 ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(Softmax, 1, 10, float,
                                          KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
                                          Softmax<float, false>);
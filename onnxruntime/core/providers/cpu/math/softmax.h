@@ -20,8 +20,6 @@ limitations under the License.
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/op_kernel_context_internal.h"
-#include "core/util/math_cpuonly.h"
-#include "core/util/softmax.h"
 #include "core/providers/common.h"
 
 namespace onnxruntime {
@@ -38,43 +36,7 @@ class Softmax final : public OpKernel {
     }
   }
 
-  Status Compute(OpKernelContext* ctx) const override {
-#ifndef _OPENMP
-    concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
-#endif
-    const auto* tensor_pointer = ctx->Input<Tensor>(0);
-    if (tensor_pointer == nullptr)
-      return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
-    const Tensor& X = *tensor_pointer;
-    const TensorShape& input_shape = X.Shape();
-
-    VLOGS(ctx->Logger(), 2) << "Input tensor shape: " << input_shape;
-
-    Tensor* Y = ctx->Output(0, input_shape);
-
-    // edge case. one or more dims with value of 0. nothing to do
-    if (input_shape.Size() == 0)
-      return Status::OK();
-
-    const int64_t axis = HandleNegativeAxis(axis_, input_shape.NumDimensions());
-
-    int N = static_cast<int>(input_shape.SizeToDimension(axis));
-    int D = static_cast<int>(input_shape.SizeFromDimension(axis));
-
-    Eigen::TensorMap<Eigen::Tensor<const T, 2, Eigen::RowMajor, Eigen::DenseIndex>, Eigen::Aligned> X_tensor(
-        X.Data<T>(), N, D);
-    Eigen::TensorMap<Eigen::Tensor<T, 2, Eigen::RowMajor, Eigen::DenseIndex>, Eigen::Aligned> Y_tensor(
-        Y->MutableData<T>(), N, D);
-#ifndef _OPENMP
-    if (tp == nullptr)
-#endif
-      ComputeSoftMax<use_log>(Eigen::DefaultDevice(), X_tensor, Y_tensor, N, D);
-#ifndef _OPENMP
-    else
-      ComputeSoftMax<use_log>(tp->Device(), X_tensor, Y_tensor, N, D);
-#endif
-    return Status::OK();
-  }
+  Status Compute(OpKernelContext* ctx) const override;
 
  private:
   int axis_;
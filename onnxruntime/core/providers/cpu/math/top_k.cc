@@ -20,10 +20,11 @@
 #include "core/common/exceptions.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/tensor.h"
+#include "core/platform/threadpool.h"
 #include "core/util/math_cpuonly.h"
-#include <queue>
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 
 using namespace std;
 namespace onnxruntime {
@@ -52,29 +53,187 @@ struct LesserValueCmp {
 
 // Static helpers that implement the core logic for each of the 'TopK' operator flavor
 
-// Selects the top k elements (largest or smallest based on template parameter)
+// The threshold filter is used when the axis holds at least this many elements per selected element.
+static constexpr int64_t kTopKFilterRatio = 16;
+
+// Number of contiguous elements that are tested against the threshold at once by the threshold filter.
+static constexpr int64_t kTopKFilterBlockSize = 32;
+
+// Axis size from which larger k values are selected with a radix select instead of nth_element.
+static constexpr int64_t kTopKRadixSelectMinSize = 1024;
+
+// Maps a value to an unsigned key that orders the same way as the value, so that a radix select
+// can narrow down the k-th key one byte at a time.
+template <typename T>
+struct RadixSelectKey;
+
+template <>
+struct RadixSelectKey<float> {
+  using KeyType = uint32_t;
+  static KeyType Get(float value) {
+    // -0.0f and 0.0f compare equal, so give them the same key
+    if (value == 0.0f) {
+      value = 0.0f;
+    }
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x80000000u) != 0 ? ~bits : (bits | 0x80000000u);
+  }
+};
+
+template <>
+struct RadixSelectKey<int64_t> {
+  using KeyType = uint64_t;
+  static KeyType Get(int64_t value) {
+    return static_cast<uint64_t>(value) ^ (uint64_t{1} << 63);
+  }
+};
+
+// Selects the top k elements (largest or smallest based on template parameter) with nth_element
 template <class Comparator>
-static vector<pair<typename Comparator::DataType, int64_t>> select_top_k(
-    const ConstEigenMatrixMapRowMajor<typename Comparator::DataType>& raw_data, int64_t row_num, int64_t num_blocks,
-    int64_t block_slice, int64_t inter_block_offset, const unsigned k,
-    bool sort_top_k) {
-  // create a data holder and insert elements
-  vector<pair<typename Comparator::DataType, int64_t>> data_holder;
-  data_holder.reserve(num_blocks);
+static void select_top_k(const typename Comparator::DataType* input, int64_t num_blocks, int64_t block_slice,
+                         const unsigned k, vector<pair<typename Comparator::DataType, int64_t>>& data_holder) {
+  // insert elements in the data holder
+  data_holder.clear();
   for (int64_t l = 0; l < num_blocks; ++l) {
-    data_holder.push_back({raw_data(row_num, l * block_slice + inter_block_offset), l});
+    data_holder.push_back({input[l * block_slice], l});
   }
 
   // find the top k (largest or smallest) elements in the data holder - O(n)
   nth_element(data_holder.begin(), data_holder.begin() + (k - 1), data_holder.end(), Comparator());
+}
+
+// Selects the top k elements when k is small compared to the number of elements. The best k
+// elements seen so far define a threshold, and only the elements that beat the threshold are
+// added to the candidates. When the candidates outgrow their capacity, they are reduced back to
+// the best k, which tightens the threshold. Contiguous elements are compared against the threshold
+// a block at a time with a vectorized min/max, so most of the input is skipped without branching.
+template <bool largest, class Comparator>
+static void filter_top_k(const typename Comparator::DataType* input, int64_t num_blocks, int64_t block_slice,
+                         const unsigned k, vector<pair<typename Comparator::DataType, int64_t>>& data_holder) {
+  using T = typename Comparator::DataType;
+
+  const size_t capacity = 2 * static_cast<size_t>(k) + kTopKFilterBlockSize;
+  data_holder.clear();
+  data_holder.reserve(capacity);
+  for (int64_t l = 0; l < k; ++l) {
+    data_holder.push_back({input[l * block_slice], l});
+  }
+
+  // Reduces the candidates to the best k and returns the k-th best value. An element equal to this
+  // value can not be selected anymore, as it comes after the k-th best element in the input.
+  auto shrink = [&data_holder, k]() {
+    nth_element(data_holder.begin(), data_holder.begin() + (k - 1), data_holder.end(), Comparator());
+    data_holder.resize(k);
+    return data_holder[k - 1].first;
+  };
+
+  T threshold = shrink();
+
+  auto consider = [&](int64_t l) {
+    const T value = input[l * block_slice];
+    if (largest ? value > threshold : value < threshold) {
+      data_holder.push_back({value, l});
+      if (data_holder.size() >= capacity) {
+        threshold = shrink();
+      }
+    }
+  };
+
+  int64_t l = k;
+  if (block_slice == 1) {
+    for (; l + kTopKFilterBlockSize <= num_blocks; l += kTopKFilterBlockSize) {
+      ConstEigenVectorArrayMap<T> block(input + l, kTopKFilterBlockSize);
+      const T extreme = largest ? block.maxCoeff() : block.minCoeff();
+      if (largest ? extreme > threshold : extreme < threshold) {
+        for (int64_t b = 0; b < kTopKFilterBlockSize; ++b) {
+          consider(l + b);
+        }
+      }
+    }
+  }
+  for (; l < num_blocks; ++l) {
+    consider(l);
+  }
+
+  if (data_holder.size() > k) {
+    shrink();
+  }
+}
+
+// Selects the top k elements with a most significant byte first radix select. The keys of the
+// elements are copied once, and each byte of the k-th key is found with a histogram over the keys
+// that share the bytes found so far. The elements are then gathered in index order, so that ties
+// on the k-th key keep the elements with the lowest indices.
+template <bool largest, class Comparator>
+static void radix_select_top_k(const typename Comparator::DataType* input, int64_t num_blocks, int64_t block_slice,
+                               const unsigned k, vector<pair<typename Comparator::DataType, int64_t>>& data_holder,
+                               vector<typename RadixSelectKey<typename Comparator::DataType>::KeyType>& keys) {
+  using T = typename Comparator::DataType;
+  using KeyType = typename RadixSelectKey<T>::KeyType;
+
+  // the keys are flipped when selecting the smallest elements, so the largest keys are always selected
+  keys.resize(static_cast<size_t>(num_blocks));
+  for (int64_t l = 0; l < num_blocks; ++l) {
+    const KeyType key = RadixSelectKey<T>::Get(input[l * block_slice]);
+    keys[l] = largest ? key : static_cast<KeyType>(~key);
+  }
+
+  KeyType prefix = 0;
+  KeyType prefix_mask = 0;
+  size_t remaining = k;
+  for (int shift = static_cast<int>(sizeof(KeyType) * 8) - 8; shift >= 0; shift -= 8) {
+    size_t histogram[256] = {};
+    for (const KeyType key : keys) {
+      if ((key & prefix_mask) == prefix) {
+        ++histogram[(key >> shift) & 0xff];
+      }
+    }
+    // walk down from the largest digit until the bucket holding the k-th key is found
+    size_t digit = 255;
+    while (histogram[digit] < remaining) {
+      remaining -= histogram[digit];
+      --digit;
+    }
+    prefix |= static_cast<KeyType>(digit) << shift;
+    prefix_mask |= static_cast<KeyType>(0xff) << shift;
+  }
+
+  // 'prefix' is now the k-th key, and 'remaining' elements equal to it are part of the top k
+  data_holder.clear();
+  for (int64_t l = 0; l < num_blocks; ++l) {
+    const KeyType key = keys[l];
+    if (key > prefix || (key == prefix && remaining > 0)) {
+      if (key == prefix) {
+        --remaining;
+      }
+      data_holder.push_back({input[l * block_slice], l});
+    }
+  }
+}
+
+// Selects the top k elements of a single (strided) slice along the axis into the first k entries of
+// 'data_holder', picking the selection algorithm based on the ratio of k to the axis size
+template <bool largest, bool sorted, class Comparator>
+static void find_top_k(const typename Comparator::DataType* input, int64_t num_blocks, int64_t block_slice,
+                       const unsigned k, vector<pair<typename Comparator::DataType, int64_t>>& data_holder,
+                       vector<typename RadixSelectKey<typename Comparator::DataType>::KeyType>& keys) {
+  if (num_blocks >= kTopKFilterRatio * k) {
+    // Average - O(n) with few comparisons against the threshold for each element
+    filter_top_k<largest, Comparator>(input, num_blocks, block_slice, k, data_holder);
+  } else if (num_blocks >= kTopKRadixSelectMinSize) {
+    // O(n * sizeof(T)) regardless of the value distribution
+    radix_select_top_k<largest, Comparator>(input, num_blocks, block_slice, k, data_holder, keys);
+  } else {
+    // Average - O(n). Worst - O(n * ln(n)) or O(n^2) depending on the implementation
+    select_top_k<Comparator>(input, num_blocks, block_slice, k, data_holder);
+  }
 
   // sort the top k elements if needed - O (k log k)
-  if (sort_top_k) {
+  // The optimizer will clean-up the redundant condition based on the template parameter 'sorted'
+  if (sorted) {
     std::sort(data_holder.begin(), data_holder.begin() + k, Comparator());
   }
-
-  // the data_holder now contains the top k elements in the first k indices
-  return data_holder;
 }
 
 // Given an input tensor 'input' and metadata values - 'k' and 'axis_parsed',
@@ -83,94 +242,50 @@ static vector<pair<typename Comparator::DataType, int64_t>> select_top_k(
 template <bool largest, bool sorted, class Comparator>
 static void extract_top_k_elements(const Tensor* input, const TensorShape& input_shape, Tensor* values,
                                    Tensor* indices, const TensorShape& output_shape, const unsigned k,
-                                   const unsigned axis_parsed) {
+                                   const unsigned axis_parsed, concurrency::ThreadPool* tp) {
+  using T = typename Comparator::DataType;
+
   // Cache some values that will be used in the implementation below
   const int64_t rows = input_shape.SizeToDimension(static_cast<size_t>(axis_parsed));
   const int64_t cols = input->Shape().Size() / rows;
-  auto input_map =
-      ConstEigenMatrixMapRowMajor<typename Comparator::DataType>(
-          static_cast<const typename Comparator::DataType*>(input->template Data<typename Comparator::DataType>()), rows, cols);
-
-  // Use Eigen maps to allow indexing into the 2d tensors like Values_map(i,j)
   const int64_t reduced_cols = output_shape.SizeFromDimension(static_cast<size_t>(axis_parsed));
-  auto values_map = EigenMatrixMapRowMajor<typename Comparator::DataType>(
-      values->template MutableData<typename Comparator::DataType>(), rows, reduced_cols);
-  auto indices_map = EigenMatrixMapRowMajor<int64_t>(indices->template MutableData<int64_t>(), rows, reduced_cols);
+
+  const T* input_data = input->template Data<T>();
+  T* values_data = values->template MutableData<T>();
+  int64_t* indices_data = indices->template MutableData<int64_t>();
 
   // This is basically the number of elements within each of the "k" rows
   const int64_t block_slice = reduced_cols / k;
   const int64_t num_blocks = input_shape[axis_parsed];
 
-  for (int64_t i = 0; i < rows; ++i) {
-    for (int64_t j = 0; j < block_slice; ++j) {
-      // Since sorted == true, we will use a Heap to hold the top K values in sorted fashion
-      if (sorted) {  // The optimizer will clean-up the redundant condition based on the template parameter 'sorted'
-        auto n_casted = static_cast<double>(num_blocks);
-        auto k_casted = static_cast<double>(k);
-        if ((n_casted + k_casted * log(k_casted)) < (n_casted * log(k_casted))) {
-          // Select first  - O(n), then sort O(k * ln(k))
-          // Overall complexity =  O (n + k * ln(k))
-          const auto& data_holder = select_top_k<Comparator>(input_map, i, num_blocks, block_slice, j, k, true);
+  // Every (row, offset within a block) pair is an independent selection over 'num_blocks' elements
+  const double selection_cost = static_cast<double>(num_blocks) + k * std::log2(static_cast<double>(k) + 1);
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(rows * block_slice),
+      TensorOpCost{static_cast<double>(num_blocks * sizeof(T)), static_cast<double>(k * (sizeof(T) + sizeof(int64_t))),
+                   selection_cost},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        // scratch buffers shared by the selections of this range
+        vector<pair<T, int64_t>> data_holder;
+        vector<typename RadixSelectKey<T>::KeyType> keys;
+
+        for (std::ptrdiff_t selection = first; selection < last; ++selection) {
+          const int64_t i = selection / block_slice;
+          const int64_t j = selection % block_slice;
+
+          find_top_k<largest, sorted, Comparator>(input_data + i * cols + j, num_blocks, block_slice, k,
+                                                  data_holder, keys);
+
+          // Insert the top 'k' (largest or smallest) elements into the final output buffers
+          T* values_row = values_data + i * reduced_cols + j;
+          int64_t* indices_row = indices_data + i * reduced_cols + j;
           for (int64_t l = 0; l < k; ++l) {
             const auto& elem = data_holder[l];
-            auto col_index = l * block_slice + j;
-            values_map(i, col_index) = elem.first;
-            indices_map(i, col_index) = elem.second;
-          }
-        } else {
-          // Perform sorted selection by passing 'n' elements over a heap of size 'k'
-          // overall complexity =  O (n * ln(k))
-
-          // Build a min-heap/max-heap, the heap element is pair of (value, idx)
-          // The top of the heap is the smallest/largest value depending on whether it is a min-heap/max-heap
-          // This is a min-heap if largest == true, this is a max-heap if largest == false
-          priority_queue<pair<typename Comparator::DataType, int64_t>, vector<pair<typename Comparator::DataType, int64_t>>, Comparator> heap;
-
-          // Maintain the size of heap to be less or equal to k, so the
-          // heap will hold the k largest/smallest values
-          for (int64_t l = 0; l < num_blocks; ++l) {
-            const auto value = input_map(i, l * block_slice + j);
-            // largest == true: insert into the min-heap if the size is < k or if the new
-            // element is greater than the min element in the min-heap
-
-            // largest == false: insert into the min-heap if the size is < k or if the new
-            // element is lesser than the max element in the max-heap
-            if ((heap.size() < k) || (largest && value > heap.top().first) ||
-                (!largest && value < heap.top().first)) {  // the optimizer will clean-up the redundant condition based
-                                                           // on the template parameter 'largest'
-              heap.push({value, l});
-            }
-            if (heap.size() > k) {
-              heap.pop();
-            }
-          }
-          // Extract these k elements and place them in the results placeholder
-          for (int64_t l = 0; l < k; ++l) {
-            const auto& elem = heap.top();
-            auto col_index = (k - l - 1) * block_slice + j;
-            values_map(i, col_index) = elem.first;
-            indices_map(i, col_index) = elem.second;
-            heap.pop();
+            values_row[l * block_slice] = elem.first;
+            indices_row[l * block_slice] = elem.second;
           }
         }
-      } else {  // sorted == false
-        // The optimizer will clean-up the redundant condition based on the template parameter 'sorted'
-
-        // If the top K values are not required to be sorted, we use a more optimal selection algorithm
-        // Average - O(n). Worst - O(n * ln(n)) or O(n^2) depending on the implementation, where 'n' is the number of input
-
-        const auto& data_holder = select_top_k<Comparator>(input_map, i, num_blocks, block_slice, j, k, false);
-
-        // Insert the top 'k' (largest or smallest) elements into the final output buffers
-        for (int64_t l = 0; l < k; ++l) {
-          const auto& elem = data_holder[l];
-          auto col_index = l * block_slice + j;
-          values_map(i, col_index) = elem.first;
-          indices_map(i, col_index) = elem.second;
-        }
-      }
-    }
-  }
+      });
 }
 
 // Wrapper over core TopK implementation
@@ -204,22 +319,24 @@ static Status TopKImpl(OpKernelContext* p_op_kernel_context, const Tensor* input
     return Status::OK();
   }
 
+  concurrency::ThreadPool* tp = p_op_kernel_context->GetOperatorThreadPool();
+
   if (sorted && largest) {
     // extract sorted largest TopK elements
     extract_top_k_elements<true, true, GreaterValueCmp<T>>(input, input_shape, values, indices, output_shape, k,
-                                                           gsl::narrow_cast<unsigned>(axis_parsed));
+                                                           gsl::narrow_cast<unsigned>(axis_parsed), tp);
   } else if (sorted && !largest) {
     // extract sorted smallest TopK elements
     extract_top_k_elements<false, true, LesserValueCmp<T>>(input, input_shape, values, indices, output_shape, k,
-                                                           gsl::narrow_cast<unsigned>(axis_parsed));
+                                                           gsl::narrow_cast<unsigned>(axis_parsed), tp);
   } else if (largest) {
     // extract unsorted (order undefined) largest TopK elements
     extract_top_k_elements<true, false, GreaterValueCmp<T>>(input, input_shape, values, indices, output_shape, k,
-                                                            gsl::narrow_cast<unsigned>(axis_parsed));
+                                                            gsl::narrow_cast<unsigned>(axis_parsed), tp);
   } else {
     // extract unsorted (order undefined) smallest TopK elements
     extract_top_k_elements<false, false, LesserValueCmp<T>>(input, input_shape, values, indices, output_shape, k,
-                                                            gsl::narrow_cast<unsigned>(axis_parsed));
+                                                            gsl::narrow_cast<unsigned>(axis_parsed), tp);
   }
 
   return Status::OK();
@@ -3,6 +3,7 @@
 
 #pragma once
 #include "tree_ensemble_aggregator.h"
+#include <unordered_map>
 
 namespace onnxruntime {
 namespace ml {
@@ -28,6 +29,18 @@ class TreeEnsembleCommon {
   int parallel_tree_;  // starts parallelizing the computing if n_tree >= parallel_tree_ and n_rows == 1
   int parallel_N_;     // starts parallelizing the computing if n_rows >= parallel_N_
 
+  // Split nodes compiled into contiguous structure-of-arrays tables. Each tree is laid out in
+  // depth-first order with the true branch first, so the most likely next node is usually adjacent.
+  // flat_children_[2 * i] and flat_children_[2 * i + 1] are the true and false children of split node i.
+  // A negative index -(k + 1) designates the leaf nodes_[k], which carries the weights.
+  std::vector<int32_t> flat_feature_ids_;
+  std::vector<OTYPE> flat_values_;
+  std::vector<int32_t> flat_children_;
+  std::vector<NODE_MODE> flat_modes_;
+  std::vector<unsigned char> flat_missing_tracks_true_;
+  std::vector<int32_t> flat_roots_;
+  NODE_MODE flat_same_mode_;
+
  public:
   TreeEnsembleCommon(int parallel_tree,
                      int parallel_N,
@@ -52,13 +65,34 @@ class TreeEnsembleCommon {
   void compute(const Tensor* X, Tensor* Z, Tensor* label) const;
 
  protected:
-  TreeNodeElement<OTYPE>* ProcessTreeNodeLeave(
-      TreeNodeElement<OTYPE>* root, const ITYPE* x_data) const;
+  void FlattenTrees();
+
+  const TreeNodeElement<OTYPE>* ProcessTreeNodeLeave(
+      size_t tree_index, const ITYPE* x_data) const;
+
+  void ProcessTreeNodeLeaves(size_t tree_index, const ITYPE* x_data, int64_t stride, int64_t n_rows,
+                             const TreeNodeElement<OTYPE>** leaves) const;
+
+  template <typename CMP, bool has_missing_tracks>
+  void TraverseTree(int32_t root, const ITYPE* x_data, int64_t stride, int64_t n_rows, int32_t* indices) const;
 
   template <typename AGG>
   void compute_agg(const Tensor* X, Tensor* Z, Tensor* label, const AGG& agg) const;
+
+  template <typename AGG>
+  void compute_agg_block1(const ITYPE* x_data, int64_t stride, int64_t n_rows,
+                          OTYPE* z_data, int64_t* label_data, const AGG& agg) const;
+
+  template <typename AGG>
+  void compute_agg_block(const ITYPE* x_data, int64_t stride, int64_t n_rows,
+                         OTYPE* z_data, int64_t* label_data,
+                         std::vector<std::vector<ScoreValue<OTYPE>>>& scores, const AGG& agg) const;
 };
 
+// Number of rows walked in lockstep through a tree. Interleaving independent rows hides the latency
+// of the dependent loads along each path.
+constexpr int64_t kTreeEnsembleRowBlockSize = 8;
+
 template <typename ITYPE, typename OTYPE>
 TreeEnsembleCommon<ITYPE, OTYPE>::TreeEnsembleCommon(int parallel_tree, int parallel_N,
                                                      const std::string& aggregate_function,
@@ -210,6 +244,67 @@ TreeEnsembleCommon<ITYPE, OTYPE>::TreeEnsembleCommon(int parallel_tree, int para
       break;
     }
   }
+
+  FlattenTrees();
+}
+
+template <typename ITYPE, typename OTYPE>
+void TreeEnsembleCommon<ITYPE, OTYPE>::FlattenTrees() {
+  flat_feature_ids_.clear();
+  flat_values_.clear();
+  flat_children_.clear();
+  flat_modes_.clear();
+  flat_missing_tracks_true_.clear();
+  flat_roots_.clear();
+  flat_roots_.reserve(roots_.size());
+
+  // First pass numbers the split nodes of every tree in depth-first order, true branch first.
+  std::unordered_map<const TreeNodeElement<OTYPE>*, int32_t> flat_index;
+  std::vector<const TreeNodeElement<OTYPE>*> ordered;
+  std::vector<const TreeNodeElement<OTYPE>*> stack;
+  ordered.reserve(nodes_.size());
+  for (const auto* root : roots_) {
+    stack.push_back(root);
+    while (!stack.empty()) {
+      const auto* node = stack.back();
+      stack.pop_back();
+      if (!node->is_not_leaf || flat_index.find(node) != flat_index.end())
+        continue;
+      if (node->truenode == nullptr || node->falsenode == nullptr) {
+        ORT_THROW("Node ", node->id.node_id, " in tree ", node->id.tree_id, " is missing a child node.");
+      }
+      flat_index.insert({node, static_cast<int32_t>(ordered.size())});
+      ordered.push_back(node);
+      stack.push_back(node->falsenode);
+      stack.push_back(node->truenode);
+    }
+  }
+
+  auto get_index = [&](const TreeNodeElement<OTYPE>* node) -> int32_t {
+    return node->is_not_leaf
+               ? flat_index[node]
+               : -static_cast<int32_t>(node - nodes_.data()) - 1;
+  };
+
+  // Second pass fills the tables.
+  flat_feature_ids_.reserve(ordered.size());
+  flat_values_.reserve(ordered.size());
+  flat_children_.reserve(2 * ordered.size());
+  flat_modes_.reserve(ordered.size());
+  flat_missing_tracks_true_.reserve(ordered.size());
+  for (const auto* node : ordered) {
+    flat_feature_ids_.push_back(node->feature_id);
+    flat_values_.push_back(node->value);
+    flat_children_.push_back(get_index(node->truenode));
+    flat_children_.push_back(get_index(node->falsenode));
+    flat_modes_.push_back(node->mode);
+    flat_missing_tracks_true_.push_back(node->is_missing_track_true ? 1 : 0);
+  }
+  for (const auto* root : roots_) {
+    flat_roots_.push_back(get_index(root));
+  }
+
+  flat_same_mode_ = flat_modes_.empty() ? NODE_MODE::LEAF : flat_modes_[0];
 }
 
 template <typename ITYPE, typename OTYPE>
@@ -258,19 +353,21 @@ void TreeEnsembleCommon<ITYPE, OTYPE>::compute_agg(const Tensor* X, Tensor* Z, T
   OTYPE* z_data = Z->template MutableData<OTYPE>();
   int64_t* label_data = label == NULL ? NULL : label->template MutableData<int64_t>();
 
+  const int64_t n_blocks = (N + kTreeEnsembleRowBlockSize - 1) / kTreeEnsembleRowBlockSize;
+
   if (n_targets_or_classes_ == 1) {
     if (N == 1) {
       ScoreValue<OTYPE> score = {0, 0};
       if (n_trees_ <= parallel_tree_) {
         for (int64_t j = 0; j < n_trees_; ++j)
-          agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(roots_[j], x_data));
+          agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(j, x_data));
       } else {
         std::vector<ScoreValue<OTYPE>> scores_t(n_trees_, {0, 0});
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
         for (int64_t j = 0; j < n_trees_; ++j) {
-          agg.ProcessTreeNodePrediction1(scores_t[j], *ProcessTreeNodeLeave(roots_[j], x_data));
+          agg.ProcessTreeNodePrediction1(scores_t[j], *ProcessTreeNodeLeave(j, x_data));
         }
         for (auto it = scores_t.cbegin(); it != scores_t.cend(); ++it)
           agg.MergePrediction1(score, *it);
@@ -279,26 +376,21 @@ void TreeEnsembleCommon<ITYPE, OTYPE>::compute_agg(const Tensor* X, Tensor* Z, T
       agg.FinalizeScores1(z_data, score, label_data);
     } else {
       if (N <= parallel_N_) {
-        ScoreValue<OTYPE> score;
-        size_t j;
-
-        for (int64_t i = 0; i < N; ++i) {
-          score = {0, 0};
-          for (j = 0; j < static_cast<size_t>(n_trees_); ++j)
-            agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
-          agg.FinalizeScores1(z_data + i * n_targets_or_classes_, score,
-                              label_data == NULL ? NULL : (label_data + i));
+        for (int64_t b = 0; b < n_blocks; ++b) {
+          int64_t i = b * kTreeEnsembleRowBlockSize;
+          compute_agg_block1(x_data + i * stride, stride, std::min(kTreeEnsembleRowBlockSize, N - i),
+                             z_data + i * n_targets_or_classes_,
+                             label_data == NULL ? NULL : (label_data + i), agg);
         }
       } else {
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-        for (int64_t i = 0; i < N; ++i) {
-          ScoreValue<OTYPE> score = {0, 0};
-          for (size_t j = 0; j < static_cast<size_t>(n_trees_); ++j)
-            agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
-          agg.FinalizeScores1(z_data + i * n_targets_or_classes_, score,
-                              label_data == NULL ? NULL : (label_data + i));
+        for (int64_t b = 0; b < n_blocks; ++b) {
+          int64_t i = b * kTreeEnsembleRowBlockSize;
+          compute_agg_block1(x_data + i * stride, stride, std::min(kTreeEnsembleRowBlockSize, N - i),
+                             z_data + i * n_targets_or_classes_,
+                             label_data == NULL ? NULL : (label_data + i), agg);
         }
       }
     }
@@ -308,7 +400,7 @@ void TreeEnsembleCommon<ITYPE, OTYPE>::compute_agg(const Tensor* X, Tensor* Z, T
 
       if (n_trees_ <= parallel_tree_) {
         for (int64_t j = 0; j < n_trees_; ++j)
-          agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(roots_[j], x_data));
+          agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(j, x_data));
         agg.FinalizeScores(scores, z_data, -1, label_data);
       } else {
 #ifdef _OPENMP
@@ -320,7 +412,7 @@ void TreeEnsembleCommon<ITYPE, OTYPE>::compute_agg(const Tensor* X, Tensor* Z, T
 #pragma omp for
 #endif
           for (int64_t j = 0; j < n_trees_; ++j) {
-            agg.ProcessTreeNodePrediction(private_scores, *ProcessTreeNodeLeave(roots_[j], x_data));
+            agg.ProcessTreeNodePrediction(private_scores, *ProcessTreeNodeLeave(j, x_data));
           }
 
 #ifdef _OPENMP
@@ -333,36 +425,31 @@ void TreeEnsembleCommon<ITYPE, OTYPE>::compute_agg(const Tensor* X, Tensor* Z, T
       }
     } else {
       if (N <= parallel_N_) {
-        std::vector<ScoreValue<OTYPE>> scores(n_targets_or_classes_);
-        size_t j;
-
-        for (int64_t i = 0; i < N; ++i) {
-          std::fill(scores.begin(), scores.end(), ScoreValue<OTYPE>({0, 0}));
-          for (j = 0; j < roots_.size(); ++j)
-            agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
-          agg.FinalizeScores(scores,
-                             z_data + i * n_targets_or_classes_, -1,
-                             label_data == NULL ? NULL : (label_data + i));
-          ORT_ENFORCE((int64_t)scores.size() == n_targets_or_classes_);
+        std::vector<std::vector<ScoreValue<OTYPE>>> scores(
+            kTreeEnsembleRowBlockSize, std::vector<ScoreValue<OTYPE>>(n_targets_or_classes_));
+
+        for (int64_t b = 0; b < n_blocks; ++b) {
+          int64_t i = b * kTreeEnsembleRowBlockSize;
+          compute_agg_block(x_data + i * stride, stride, std::min(kTreeEnsembleRowBlockSize, N - i),
+                            z_data + i * n_targets_or_classes_,
+                            label_data == NULL ? NULL : (label_data + i), scores, agg);
         }
       } else {
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
         {
-          std::vector<ScoreValue<OTYPE>> scores(n_targets_or_classes_);
-          size_t j;
+          std::vector<std::vector<ScoreValue<OTYPE>>> scores(
+              kTreeEnsembleRowBlockSize, std::vector<ScoreValue<OTYPE>>(n_targets_or_classes_));
 
 #ifdef _OPENMP
 #pragma omp for
 #endif
-          for (int64_t i = 0; i < N; ++i) {
-            std::fill(scores.begin(), scores.end(), ScoreValue<OTYPE>({0, 0}));
-            for (j = 0; j < roots_.size(); ++j)
-              agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
-            agg.FinalizeScores(scores,
-                               z_data + i * n_targets_or_classes_, -1,
-                               label_data == NULL ? NULL : (label_data + i));
+          for (int64_t b = 0; b < n_blocks; ++b) {
+            int64_t i = b * kTreeEnsembleRowBlockSize;
+            compute_agg_block(x_data + i * stride, stride, std::min(kTreeEnsembleRowBlockSize, N - i),
+                              z_data + i * n_targets_or_classes_,
+                              label_data == NULL ? NULL : (label_data + i), scores, agg);
           }
         }
       }
@@ -370,110 +457,184 @@ void TreeEnsembleCommon<ITYPE, OTYPE>::compute_agg(const Tensor* X, Tensor* Z, T
   }
 }
 
-#define TREE_FIND_VALUE(CMP)                                         \
-  if (has_missing_tracks_) {                                         \
-    while (root->is_not_leaf) {                                      \
-      val = x_data[root->feature_id];                                \
-      root = (val CMP root->value ||                                 \
-              (root->is_missing_track_true && _isnan_(val)))         \
-                 ? root->truenode                                    \
-                 : root->falsenode;                                  \
-    }                                                                \
-  } else {                                                           \
-    while (root->is_not_leaf) {                                      \
-      val = x_data[root->feature_id];                                \
-      root = val CMP root->value ? root->truenode : root->falsenode; \
-    }                                                                \
+template <typename ITYPE, typename OTYPE>
+template <typename AGG>
+void TreeEnsembleCommon<ITYPE, OTYPE>::compute_agg_block1(const ITYPE* x_data, int64_t stride, int64_t n_rows,
+                                                          OTYPE* z_data, int64_t* label_data,
+                                                          const AGG& agg) const {
+  ScoreValue<OTYPE> scores[kTreeEnsembleRowBlockSize];
+  const TreeNodeElement<OTYPE>* leaves[kTreeEnsembleRowBlockSize];
+  for (int64_t r = 0; r < n_rows; ++r)
+    scores[r] = {0, 0};
+
+  for (size_t j = 0; j < static_cast<size_t>(n_trees_); ++j) {
+    ProcessTreeNodeLeaves(j, x_data, stride, n_rows, leaves);
+    for (int64_t r = 0; r < n_rows; ++r)
+      agg.ProcessTreeNodePrediction1(scores[r], *leaves[r]);
+  }
+
+  for (int64_t r = 0; r < n_rows; ++r)
+    agg.FinalizeScores1(z_data + r * n_targets_or_classes_, scores[r],
+                        label_data == NULL ? NULL : (label_data + r));
+}
+
+template <typename ITYPE, typename OTYPE>
+template <typename AGG>
+void TreeEnsembleCommon<ITYPE, OTYPE>::compute_agg_block(const ITYPE* x_data, int64_t stride, int64_t n_rows,
+                                                         OTYPE* z_data, int64_t* label_data,
+                                                         std::vector<std::vector<ScoreValue<OTYPE>>>& scores,
+                                                         const AGG& agg) const {
+  const TreeNodeElement<OTYPE>* leaves[kTreeEnsembleRowBlockSize];
+  for (int64_t r = 0; r < n_rows; ++r)
+    std::fill(scores[r].begin(), scores[r].end(), ScoreValue<OTYPE>({0, 0}));
+
+  for (size_t j = 0; j < static_cast<size_t>(n_trees_); ++j) {
+    ProcessTreeNodeLeaves(j, x_data, stride, n_rows, leaves);
+    for (int64_t r = 0; r < n_rows; ++r)
+      agg.ProcessTreeNodePrediction(scores[r], *leaves[r]);
+  }
+
+  for (int64_t r = 0; r < n_rows; ++r) {
+    agg.FinalizeScores(scores[r],
+                       z_data + r * n_targets_or_classes_, -1,
+                       label_data == NULL ? NULL : (label_data + r));
   }
+}
 
 inline bool _isnan_(float x) { return std::isnan(x); }
 inline bool _isnan_(double x) { return std::isnan(x); }
 inline bool _isnan_(int64_t) { return false; }
 inline bool _isnan_(int32_t) { return false; }
 
+#define TREE_NODE_COMPARE(NAME, CMP)                                            \
+  struct NAME {                                                                 \
+    template <typename ITYPE, typename OTYPE>                                   \
+    bool operator()(ITYPE val, OTYPE threshold, NODE_MODE /*mode*/) const {     \
+      return val CMP threshold;                                                 \
+    }                                                                           \
+  };
+
+TREE_NODE_COMPARE(TreeNodeCompareLEQ, <=)
+TREE_NODE_COMPARE(TreeNodeCompareLT, <)
+TREE_NODE_COMPARE(TreeNodeCompareGTE, >=)
+TREE_NODE_COMPARE(TreeNodeCompareGT, >)
+TREE_NODE_COMPARE(TreeNodeCompareEQ, ==)
+TREE_NODE_COMPARE(TreeNodeCompareNEQ, !=)
+
+#undef TREE_NODE_COMPARE
+
+// Used when the split nodes do not all share the same rule.
+struct TreeNodeCompareAny {
+  template <typename ITYPE, typename OTYPE>
+  bool operator()(ITYPE val, OTYPE threshold, NODE_MODE mode) const {
+    switch (mode) {
+      case NODE_MODE::BRANCH_LEQ:
+        return val <= threshold;
+      case NODE_MODE::BRANCH_LT:
+        return val < threshold;
+      case NODE_MODE::BRANCH_GTE:
+        return val >= threshold;
+      case NODE_MODE::BRANCH_GT:
+        return val > threshold;
+      case NODE_MODE::BRANCH_EQ:
+        return val == threshold;
+      case NODE_MODE::BRANCH_NEQ:
+        return val != threshold;
+      default:
+        return false;
+    }
+  }
+};
+
 template <typename ITYPE, typename OTYPE>
-TreeNodeElement<OTYPE>*
-TreeEnsembleCommon<ITYPE, OTYPE>::ProcessTreeNodeLeave(
-    TreeNodeElement<OTYPE>* root, const ITYPE* x_data) const {
-  ITYPE val;
+template <typename CMP, bool has_missing_tracks>
+void TreeEnsembleCommon<ITYPE, OTYPE>::TraverseTree(int32_t root, const ITYPE* x_data, int64_t stride,
+                                                    int64_t n_rows, int32_t* indices) const {
+  const CMP cmp;
+  const int32_t* feature_ids = flat_feature_ids_.data();
+  const OTYPE* values = flat_values_.data();
+  const int32_t* children = flat_children_.data();
+  const NODE_MODE* modes = flat_modes_.data();
+  const unsigned char* missing_tracks_true = flat_missing_tracks_true_.data();
+
+  for (int64_t r = 0; r < n_rows; ++r)
+    indices[r] = root;
+
+  // All rows of the block advance one level per iteration until every row has reached a leaf.
+  bool active = root >= 0;
+  while (active) {
+    active = false;
+    for (int64_t r = 0; r < n_rows; ++r) {
+      int32_t index = indices[r];
+      if (index < 0)
+        continue;
+      ITYPE val = x_data[r * stride + feature_ids[index]];
+      bool is_true = cmp(val, values[index], modes[index]);
+      if (has_missing_tracks)
+        is_true = is_true || (missing_tracks_true[index] && _isnan_(val));
+      index = children[2 * index + (is_true ? 0 : 1)];
+      indices[r] = index;
+      active = active || index >= 0;
+    }
+  }
+}
+
+#define TREE_TRAVERSE(CMP)                                                             \
+  if (has_missing_tracks_) {                                                           \
+    TraverseTree<CMP, true>(flat_roots_[tree_index], x_data, stride, n_rows, indices); \
+  } else {                                                                             \
+    TraverseTree<CMP, false>(flat_roots_[tree_index], x_data, stride, n_rows, indices); \
+  }
+
+template <typename ITYPE, typename OTYPE>
+void TreeEnsembleCommon<ITYPE, OTYPE>::ProcessTreeNodeLeaves(
+    size_t tree_index, const ITYPE* x_data, int64_t stride, int64_t n_rows,
+    const TreeNodeElement<OTYPE>** leaves) const {
+  int32_t indices[kTreeEnsembleRowBlockSize];
+
   if (same_mode_) {
-    switch (root->mode) {
+    switch (flat_same_mode_) {
       case NODE_MODE::BRANCH_LEQ:
-        if (has_missing_tracks_) {
-          while (root->is_not_leaf) {
-            val = x_data[root->feature_id];
-            root = (val <= root->value ||
-                    (root->is_missing_track_true && _isnan_(val)))
-                       ? root->truenode
-                       : root->falsenode;
-          }
-        } else {
-          while (root->is_not_leaf) {
-            val = x_data[root->feature_id];
-            root = val <= root->value ? root->truenode : root->falsenode;
-          }
-        }
+        TREE_TRAVERSE(TreeNodeCompareLEQ)
         break;
       case NODE_MODE::BRANCH_LT:
-        TREE_FIND_VALUE(<)
+        TREE_TRAVERSE(TreeNodeCompareLT)
         break;
       case NODE_MODE::BRANCH_GTE:
-        TREE_FIND_VALUE(>=)
+        TREE_TRAVERSE(TreeNodeCompareGTE)
         break;
       case NODE_MODE::BRANCH_GT:
-        TREE_FIND_VALUE(>)
+        TREE_TRAVERSE(TreeNodeCompareGT)
         break;
       case NODE_MODE::BRANCH_EQ:
-        TREE_FIND_VALUE(==)
+        TREE_TRAVERSE(TreeNodeCompareEQ)
         break;
       case NODE_MODE::BRANCH_NEQ:
-        TREE_FIND_VALUE(!=)
+        TREE_TRAVERSE(TreeNodeCompareNEQ)
         break;
       case NODE_MODE::LEAF:
+        // every tree is a single leaf
+        for (int64_t r = 0; r < n_rows; ++r)
+          indices[r] = flat_roots_[tree_index];
         break;
     }
   } else {  // Different rules to compare to node thresholds.
-    OTYPE threshold;
-    while (root->is_not_leaf) {
-      val = x_data[root->feature_id];
-      threshold = root->value;
-      switch (root->mode) {
-        case NODE_MODE::BRANCH_LEQ:
-          root = val <= threshold || (root->is_missing_track_true && _isnan_(val))
-                     ? root->truenode
-                     : root->falsenode;
-          break;
-        case NODE_MODE::BRANCH_LT:
-          root = val < threshold || (root->is_missing_track_true && _isnan_(val))
-                     ? root->truenode
-                     : root->falsenode;
-          break;
-        case NODE_MODE::BRANCH_GTE:
-          root = val >= threshold || (root->is_missing_track_true && _isnan_(val))
-                     ? root->truenode
-                     : root->falsenode;
-          break;
-        case NODE_MODE::BRANCH_GT:
-          root = val > threshold || (root->is_missing_track_true && _isnan_(val))
-                     ? root->truenode
-                     : root->falsenode;
-          break;
-        case NODE_MODE::BRANCH_EQ:
-          root = val == threshold || (root->is_missing_track_true && _isnan_(val))
-                     ? root->truenode
-                     : root->falsenode;
-          break;
-        case NODE_MODE::BRANCH_NEQ:
-          root = val != threshold || (root->is_missing_track_true && _isnan_(val))
-                     ? root->truenode
-                     : root->falsenode;
-          break;
-        case NODE_MODE::LEAF:
-          break;
-      }
-    }
+    TREE_TRAVERSE(TreeNodeCompareAny)
   }
-  return root;
+
+  for (int64_t r = 0; r < n_rows; ++r)
+    leaves[r] = &nodes_[-indices[r] - 1];
+}
+
+#undef TREE_TRAVERSE
+
+template <typename ITYPE, typename OTYPE>
+const TreeNodeElement<OTYPE>*
+TreeEnsembleCommon<ITYPE, OTYPE>::ProcessTreeNodeLeave(
+    size_t tree_index, const ITYPE* x_data) const {
+  const TreeNodeElement<OTYPE>* leaf;
+  ProcessTreeNodeLeaves(tree_index, x_data, 0, 1, &leaf);
+  return leaf;
 }
 
 template <typename ITYPE, typename OTYPE>
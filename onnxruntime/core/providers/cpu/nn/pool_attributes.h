@@ -8,6 +8,8 @@
 #include "core/framework/tensor_shape.h"
 #include "core/providers/cpu/nn/autopad_type.h"
 
+#include <cmath>
+
 namespace onnxruntime {
 
 // A helper struct holding attributes for Pool-family ops
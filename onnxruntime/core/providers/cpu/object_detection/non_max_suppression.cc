@@ -13,7 +13,9 @@ limitations under the License.
 
 #include "non_max_suppression.h"
 #include "non_max_suppression_helper.h"
-#include <queue>
+#include "core/platform/threadpool.h"
+#include <algorithm>
+#include <vector>
 
 namespace onnxruntime {
 
@@ -110,6 +112,137 @@ Status NonMaxSuppressionBase::GetThresholdsFromInputs(const PrepareContext& pc,
   return Status::OK();
 }
 
+namespace {
+
+// Corner coordinates and areas of a list of boxes, stored as separate arrays so that a box can be
+// compared against many boxes at once with a loop the compiler can vectorize.
+struct BoxesSoA {
+  std::vector<float> x_min;
+  std::vector<float> y_min;
+  std::vector<float> x_max;
+  std::vector<float> y_max;
+  std::vector<float> area;
+
+  void Clear() {
+    x_min.clear();
+    y_min.clear();
+    x_max.clear();
+    y_max.clear();
+    area.clear();
+  }
+
+  void Append(const BoxesSoA& boxes, size_t index) {
+    x_min.push_back(boxes.x_min[index]);
+    y_min.push_back(boxes.y_min[index]);
+    x_max.push_back(boxes.x_max[index]);
+    y_max.push_back(boxes.y_max[index]);
+    area.push_back(boxes.area[index]);
+  }
+
+  size_t Size() const {
+    return area.size();
+  }
+};
+
+// Converts the boxes of one batch to corner coordinates, in the same way as nms_helpers::SuppressByIOU
+void ConvertBoxes(const float* boxes_data, int64_t num_boxes, int64_t center_point_box, BoxesSoA& boxes) {
+  const auto size = static_cast<size_t>(num_boxes);
+  boxes.x_min.resize(size);
+  boxes.y_min.resize(size);
+  boxes.x_max.resize(size);
+  boxes.y_max.resize(size);
+  boxes.area.resize(size);
+
+  for (size_t i = 0; i < size; ++i) {
+    const float* box = boxes_data + 4 * i;
+    float x_min{};
+    float y_min{};
+    float x_max{};
+    float y_max{};
+    // center_point_box_ only support 0 or 1
+    if (0 == center_point_box) {
+      // boxes data format [y1, x1, y2, x2],
+      MaxMin(box[1], box[3], x_min, x_max);
+      MaxMin(box[0], box[2], y_min, y_max);
+    } else {
+      // 1 == center_point_box_ => boxes data format [x_center, y_center, width, height]
+      const float width_half = box[2] / 2;
+      const float height_half = box[3] / 2;
+      x_min = box[0] - width_half;
+      x_max = box[0] + width_half;
+      y_min = box[1] - height_half;
+      y_max = box[1] + height_half;
+    }
+    boxes.x_min[i] = x_min;
+    boxes.y_min[i] = y_min;
+    boxes.x_max[i] = x_max;
+    boxes.y_max[i] = y_max;
+    boxes.area[i] = (x_max - x_min) * (y_max - y_min);
+  }
+}
+
+// Number of selected boxes that are compared against a candidate before checking whether it was suppressed.
+constexpr size_t kSuppressBlockSize = 16;
+
+// Returns true if box 'index' of 'boxes' exceeds the IOU (Intersection Over Union) threshold with any of the
+// 'selected' boxes. The conditions of nms_helpers::SuppressByIOU are evaluated without branches, so each
+// block of selected boxes is processed with SIMD instructions.
+bool SuppressBySelectedBoxes(const BoxesSoA& boxes, size_t index, const BoxesSoA& selected, float iou_threshold) {
+  const float x_min = boxes.x_min[index];
+  const float y_min = boxes.y_min[index];
+  const float x_max = boxes.x_max[index];
+  const float y_max = boxes.y_max[index];
+  const float area = boxes.area[index];
+
+  // a box without area is never suppressed
+  if (area <= .0f) {
+    return false;
+  }
+
+  const float* selected_x_min = selected.x_min.data();
+  const float* selected_y_min = selected.y_min.data();
+  const float* selected_x_max = selected.x_max.data();
+  const float* selected_y_max = selected.y_max.data();
+  const float* selected_area = selected.area.data();
+  const size_t count = selected.Size();
+
+  for (size_t start = 0; start < count; start += kSuppressBlockSize) {
+    const size_t end = std::min(start + kSuppressBlockSize, count);
+    int suppressed = 0;
+    for (size_t i = start; i < end; ++i) {
+      const float intersection_x =
+          std::max(std::min(selected_x_max[i], x_max) - std::max(selected_x_min[i], x_min), .0f);
+      const float intersection_y =
+          std::max(std::min(selected_y_max[i], y_max) - std::max(selected_y_min[i], y_min), .0f);
+      const float intersection_area = intersection_x * intersection_y;
+      const float union_area = selected_area[i] + area - intersection_area;
+      suppressed |= static_cast<int>(intersection_area > .0f) & static_cast<int>(selected_area[i] > .0f) &
+                    static_cast<int>(union_area > .0f) &
+                    static_cast<int>(intersection_area / union_area > iou_threshold);
+    }
+    if (suppressed != 0) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+struct ScoreIndexPair {
+  float score_{};
+  int64_t index_{};
+
+  ScoreIndexPair() = default;
+  explicit ScoreIndexPair(float score, int64_t idx) : score_(score), index_(idx) {}
+
+  // orders a max-heap by descending score, with the lowest index first among equal scores
+  bool operator<(const ScoreIndexPair& rhs) const {
+    return score_ < rhs.score_ || (score_ == rhs.score_ && index_ > rhs.index_);
+  }
+};
+
+}  // namespace
+
 Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
   PrepareContext pc;
   auto ret = PrepareCompute(ctx, pc);
@@ -129,76 +262,89 @@ Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
 
   const auto* const boxes_data = pc.boxes_data_;
   const auto* const scores_data = pc.scores_data_;
-
-  struct ScoreIndexPair {
-    float score_{};
-    int64_t index_{};
-
-    ScoreIndexPair() = default;
-    explicit ScoreIndexPair(float score, int64_t idx) : score_(score), index_(idx) {}
-
-    bool operator<(const ScoreIndexPair& rhs) const {
-      return score_ < rhs.score_;
-    }
-  };
-
+  const bool has_score_threshold = pc.score_threshold_ != nullptr;
   const auto center_point_box = GetCenterPointBox();
-
-  std::vector<SelectedIndex> selected_indices;
-  for (int64_t batch_index = 0; batch_index < pc.num_batches_; ++batch_index) {
-    for (int64_t class_index = 0; class_index < pc.num_classes_; ++class_index) {
-      int64_t box_score_offset = (batch_index * pc.num_classes_ + class_index) * pc.num_boxes_;
-      int64_t box_offset = batch_index * pc.num_boxes_ * 4;
-      // Filter by score_threshold_
-      std::priority_queue<ScoreIndexPair, std::deque<ScoreIndexPair>> sorted_scores_with_index;
-      const auto* class_scores = scores_data + box_score_offset;
-      if (pc.score_threshold_ != nullptr) {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          if (*class_scores > score_threshold) {
-            sorted_scores_with_index.push(ScoreIndexPair(*class_scores, box_index));
-          }
+  const int64_t num_boxes = pc.num_boxes_;
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+
+  // The boxes of a batch are shared by all of its classes, so they are converted once
+  std::vector<BoxesSoA> batch_boxes(static_cast<size_t>(pc.num_batches_));
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(pc.num_batches_),
+      TensorOpCost{static_cast<double>(num_boxes * 4 * sizeof(float)),
+                   static_cast<double>(num_boxes * 5 * sizeof(float)),
+                   static_cast<double>(num_boxes * 8)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t batch_index = first; batch_index < last; ++batch_index) {
+          ConvertBoxes(boxes_data + batch_index * num_boxes * 4, num_boxes, center_point_box,
+                       batch_boxes[batch_index]);
         }
-      } else {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          sorted_scores_with_index.push(ScoreIndexPair(*class_scores, box_index));
-        }
-      }
-
-      ScoreIndexPair next_top_score;
-      std::vector<int64_t> selected_indices_inside_class;
-      // Get the next box with top score, filter by iou_threshold
-      while (!sorted_scores_with_index.empty()) {
-        next_top_score = sorted_scores_with_index.top();
-        sorted_scores_with_index.pop();
-
-        bool selected = true;
-        // Check with existing selected boxes for this class, suppress if exceed the IOU (Intersection Over Union) threshold
-        for (int64_t selected_index : selected_indices_inside_class) {
-          if (SuppressByIOU(boxes_data + box_offset, selected_index, next_top_score.index_,
-                            center_point_box, iou_threshold)) {
-            selected = false;
-            break;
+      });
+
+  // Every (batch, class) pair selects its boxes independently
+  const int64_t num_selections = pc.num_batches_ * pc.num_classes_;
+  std::vector<std::vector<int64_t>> selected_indices_per_class(static_cast<size_t>(num_selections));
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(num_selections),
+      TensorOpCost{static_cast<double>(num_boxes * sizeof(float)), 0.0, static_cast<double>(num_boxes * 16)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<ScoreIndexPair> candidates;
+        BoxesSoA selected_boxes;
+
+        for (std::ptrdiff_t selection = first; selection < last; ++selection) {
+          const BoxesSoA& boxes = batch_boxes[selection / pc.num_classes_];
+          const auto* class_scores = scores_data + selection * num_boxes;
+
+          // Filter by score_threshold_
+          candidates.clear();
+          for (int64_t box_index = 0; box_index < num_boxes; ++box_index) {
+            if (!has_score_threshold || class_scores[box_index] > score_threshold) {
+              candidates.emplace_back(class_scores[box_index], box_index);
+            }
           }
-        }
 
-        if (selected) {
-          if (max_output_boxes_per_class > 0 &&
-              static_cast<int64_t>(selected_indices_inside_class.size()) >= max_output_boxes_per_class) {
-            break;
+          // The candidates are popped from a heap in score order, so no time is spent ordering the candidates
+          // that are never reached once max_output_boxes_per_class boxes are selected
+          std::make_heap(candidates.begin(), candidates.end());
+
+          auto& selected_indices = selected_indices_per_class[selection];
+          selected_boxes.Clear();
+          // Get the next box with top score, filter by iou_threshold
+          while (!candidates.empty()) {
+            std::pop_heap(candidates.begin(), candidates.end());
+            const auto next_box_index = static_cast<size_t>(candidates.back().index_);
+            candidates.pop_back();
+
+            // Check with existing selected boxes for this class, suppress if exceed the IOU threshold
+            if (!SuppressBySelectedBoxes(boxes, next_box_index, selected_boxes, iou_threshold)) {
+              selected_indices.push_back(static_cast<int64_t>(next_box_index));
+              if (max_output_boxes_per_class > 0 &&
+                  static_cast<int64_t>(selected_indices.size()) >= max_output_boxes_per_class) {
+                break;
+              }
+              selected_boxes.Append(boxes, next_box_index);
+            }
           }
-          selected_indices_inside_class.push_back(next_top_score.index_);
-          selected_indices.emplace_back(batch_index, class_index, next_top_score.index_);
         }
-      }  //while
-    }    //for class_index
-  }      //for batch_index
+      });
+
+  size_t num_selected = 0;
+  for (const auto& selected_indices : selected_indices_per_class) {
+    num_selected += selected_indices.size();
+  }
 
   const auto last_dim = 3;
-  const auto num_selected = selected_indices.size();
   Tensor* output = ctx->Output(0, {static_cast<int64_t>(num_selected), last_dim});
   ORT_ENFORCE(output != nullptr);
   static_assert(last_dim * sizeof(int64_t) == sizeof(SelectedIndex), "Possible modification of SelectedIndex");
-  memcpy(output->MutableData<int64_t>(), selected_indices.data(), num_selected * sizeof(SelectedIndex));
+  auto* output_data = reinterpret_cast<SelectedIndex*>(output->MutableData<int64_t>());
+  for (int64_t selection = 0; selection < num_selections; ++selection) {
+    const int64_t batch_index = selection / pc.num_classes_;
+    const int64_t class_index = selection % pc.num_classes_;
+    for (const int64_t box_index : selected_indices_per_class[selection]) {
+      *output_data++ = SelectedIndex(batch_index, class_index, box_index);
+    }
+  }
 
   return Status::OK();
 }
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/reduction/reduction_ops.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 #include "core/util/math_cpuonly.h"
 #include "core/providers/cpu/containers.h"
@@ -147,6 +148,64 @@ REGISTER_UNARY_ELEMENTWISE_VERSIONED_KERNEL(ArgMin, 1, 10);
 REGISTER_UNARY_ELEMENTWISE_VERSIONED_KERNEL(ArgMin, 11, 11);
 REGISTER_UNARY_ELEMENTWISE_KERNEL(ArgMin, 12);
 
+// Normalizes the axes to reduce (all axes if 'axes_' is empty) into 'axes' in ascending order, sets whether each
+// dimension of the input is kept in 'keep_axis' and returns the dimensions of the output.
+static std::vector<int64_t> ComputeReducedDims(const TensorShape& input_shape,
+                                               const std::vector<int64_t>& axes_,
+                                               bool keepdims_,
+                                               std::vector<int64_t>& axes,
+                                               std::vector<bool>& keep_axis) {
+  const auto& in_dims = input_shape.GetDims();
+  size_t ndim = in_dims.size();
+
+  axes.clear();
+  axes.reserve(axes_.size());
+  for (int64_t axis : axes_) {
+    axes.push_back(HandleNegativeAxis(axis, static_cast<int64_t>(ndim)));
+  }
+
+  if (axes.empty()) {
+    // This is the default case for non-arg kind reductions. Reduce on all dimensions.
+    for (size_t i = 0; i < ndim; i++) {
+      axes.push_back(i);
+    }
+  }
+
+  std::sort(axes.begin(), axes.end());
+
+  keep_axis.assign(ndim, true);
+  for (auto i : axes) {
+    keep_axis[i] = false;
+  }
+
+  //set to-be-reduced axes to one. squeeze is keepdims_ is false
+  std::vector<int64_t> reduced_dims;
+  reduced_dims.reserve(in_dims.size());
+
+  for (size_t i = 0; i < in_dims.size(); i++) {
+    const auto in_dim = in_dims[i];
+    if (keep_axis[i]) {
+      reduced_dims.push_back(in_dim);
+    } else {
+      if (keepdims_) {
+        reduced_dims.push_back(in_dim == 0 ? 0 : 1);
+      } else {
+        // as we are reducing on this axis and not keeping a dim for it, we can't drop a dim value of 0.
+        // e.g. if input was {3, 0, 2} and we reduced on axis 1 without keeping it, the output shape would be
+        // {3, 2} which is invalid given the input was empty.
+        // note that if we do keep the dim the output shape will have a 0 in it,
+        // which is still valid for an empty tensor, so allow that.
+        ORT_ENFORCE(in_dim != 0,
+                    "Can't reduce on dim with value of 0 if 'keepdims' is false. "
+                    "Invalid output shape would be produced. input_shape:",
+                    input_shape);
+      }
+    }
+  }
+
+  return reduced_dims;
+}
+
 // When all reduce axises located at the tail of the dims, quite general cases, transpose and extra
 // copy could be skipped to improve performance. If required by check_no_transpose = true, then
 // the calling code will check if the data was transposed and act accordingly.
@@ -183,19 +242,8 @@ bool PrepareForReduce(OpKernelContext* ctx,
   }
 
   std::vector<int64_t> axes;
-  axes.reserve(axes_.size());
-  for (int64_t axis : axes_) {
-    axes.push_back(HandleNegativeAxis(axis, static_cast<int64_t>(ndim)));
-  }
-
-  if (axes.empty()) {
-    // This is the default case for non-arg kind reductions. Reduce on all dimensions.
-    for (size_t i = 0; i < ndim; i++) {
-      axes.push_back(i);
-    }
-  }
-
-  std::sort(axes.begin(), axes.end());
+  std::vector<bool> keep_axis;
+  std::vector<int64_t> reduced_dims = ComputeReducedDims(input.Shape(), axes_, keepdims_, axes, keep_axis);
 
   // If all reduced axes are located at the tail of the input shape, then copy could be skipped is required
   bool need_copy = true;
@@ -205,11 +253,6 @@ bool PrepareForReduce(OpKernelContext* ctx,
     need_copy = false;
   }
 
-  std::vector<bool> keep_axis(ndim, true);
-  for (auto i : axes) {
-    keep_axis[i] = false;
-  }
-
   //transpose the input so that all to-be-reduced axes are at the head
   std::vector<int64_t> transposed_axes(axes.begin(), axes.end());
   for (size_t i = 0; i < ndim; ++i) {
@@ -241,30 +284,10 @@ bool PrepareForReduce(OpKernelContext* ctx,
   const T* from_data = input.template Data<T>();
   size_t count = input.Shape().Size();
 
-  //set to-be-reduced axes to one. squeeze is keepdims_ is false
   int64_t first_dim = 1;
-  std::vector<int64_t> reduced_dims;
-  reduced_dims.reserve(in_dims.size());
-
-  for (size_t i = 0; i < in_dims.size(); i++) {
-    const auto in_dim = in_dims[i];
-    if (keep_axis[i]) {
-      reduced_dims.push_back(in_dim);
-    } else {
-      first_dim *= in_dim;
-      if (keepdims_) {
-        reduced_dims.push_back(in_dim == 0 ? 0 : 1);
-      } else {
-        // as we are reducing on this axis and not keeping a dim for it, we can't drop a dim value of 0.
-        // e.g. if input was {3, 0, 2} and we reduced on axis 1 without keeping it, the output shape would be
-        // {3, 2} which is invalid given the input was empty.
-        // note that if we do keep the dim the output shape will have a 0 in it,
-        // which is still valid for an empty tensor, so allow that.
-        ORT_ENFORCE(in_dim != 0,
-                    "Can't reduce on dim with value of 0 if 'keepdims' is false. "
-                    "Invalid output shape would be produced. input_shape:",
-                    input.Shape());
-      }
+  for (size_t i = 0; i < ndim; ++i) {
+    if (!keep_axis[i]) {
+      first_dim *= in_dims[i];
     }
   }
 
@@ -350,84 +373,257 @@ bool PrepareForReduce(OpKernelContext* ctx,
   return false;
 }
 
-template <typename T>
-Status ReduceL1<T>::Compute(OpKernelContext* ctx) const {
-  FastAllocVector<T> transposedInputData(GetAllocator<T>(*ctx));
-  int64_t block_size;
-  int64_t blocks;
-  Tensor* reduced;
+// The input of a reduction whose reduced axes are adjacent, once dimensions of size 1 are ignored, is viewed as
+// a row major tensor of shape [outer_size, reduce_size, inner_size] that is reduced on the middle axis. Three
+// cases are specialized:
+// - full reduction (outer_size == inner_size == 1): the input is split into fixed size chunks that are reduced
+//   in parallel and then combined, so the result doesn't depend on the number of threads.
+// - contiguous inner reduction (inner_size == 1): each output element reduces a contiguous row.
+// - strided outer reduction (inner_size > 1): blocks of output elements are accumulated from the rows of the
+//   reduced axis, which reads the input contiguously.
+struct ReduceLayout {
+  int64_t outer_size;
+  int64_t reduce_size;
+  int64_t inner_size;
+};
+
+// Returns false if the reduced axes aren't adjacent.
+static bool GetReduceLayout(const std::vector<int64_t>& input_dims, const std::vector<bool>& keep_axis,
+                            ReduceLayout& layout) {
+  layout = {1, 1, 1};
+  // 0: before the reduced axes, 1: in the reduced axes, 2: after the reduced axes
+  int state = 0;
+  for (size_t i = 0; i < input_dims.size(); ++i) {
+    if (input_dims[i] == 1) {
+      continue;
+    }
+    if (keep_axis[i]) {
+      if (state == 0) {
+        layout.outer_size *= input_dims[i];
+      } else {
+        state = 2;
+        layout.inner_size *= input_dims[i];
+      }
+    } else {
+      if (state == 2) {
+        return false;
+      }
+      state = 1;
+      layout.reduce_size *= input_dims[i];
+    }
+  }
+  return true;
+}
 
-  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_, true);
+// Aggregators define a reduction as a fold of the input values:
+// - Identity: the initial value of an accumulator.
+// - ReduceVector: folds a contiguous vector, starting from Identity.
+// - Accumulate: folds a vector of values into a vector of accumulators.
+// - Combine: folds two partial results.
+// - Finalize: computes the output from an accumulator and the number of reduced values.
+template <typename T>
+struct ReduceAggregatorBase {
+  static T Finalize(T accumulator, int64_t /*count*/) { return accumulator; }
+};
 
-  T* output_data = reduced->template MutableData<T>();
+template <typename T>
+struct ReduceAggregatorSum : ReduceAggregatorBase<T> {
+  static T Identity() { return 0; }
+  static T ReduceVector(const ConstEigenVectorMap<T>& v) { return v.sum(); }
+  static void Accumulate(EigenVectorMap<T>& acc, const ConstEigenVectorMap<T>& v) { acc += v; }
+  static T Combine(T a, T b) { return a + b; }
+};
 
-  if (no_transpose) {
-    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
+template <typename T>
+struct ReduceAggregatorMean : ReduceAggregatorSum<T> {
+  static T Finalize(T accumulator, int64_t count) { return accumulator / static_cast<T>(count); }
+};
 
-    for (int64_t i = 0; i < block_size; ++i) {
-      output_data[i] = ConstEigenVectorMap<T>(input_data + (i * blocks), blocks).cwiseAbs().sum();
-    }
-  } else {
-    EigenVectorMap<T> out_vec(output_data, block_size);
-    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).cwiseAbs().rowwise().sum();
-  }
+template <typename T>
+struct ReduceAggregatorLogSum : ReduceAggregatorSum<T> {
+  static T Finalize(T accumulator, int64_t /*count*/) { return static_cast<T>(std::log(accumulator)); }
+};
 
-  return Status::OK();
-}
+template <typename T>
+struct ReduceAggregatorL1 : ReduceAggregatorSum<T> {
+  static T ReduceVector(const ConstEigenVectorMap<T>& v) { return v.cwiseAbs().sum(); }
+  static void Accumulate(EigenVectorMap<T>& acc, const ConstEigenVectorMap<T>& v) { acc += v.cwiseAbs(); }
+};
 
 template <typename T>
-Status ReduceL2<T>::Compute(OpKernelContext* ctx) const {
-  FastAllocVector<T> transposedInputData(GetAllocator<T>(*ctx));
-  int64_t block_size;
-  int64_t blocks;
-  Tensor* reduced;
+struct ReduceAggregatorSumSquare : ReduceAggregatorSum<T> {
+  static T ReduceVector(const ConstEigenVectorMap<T>& v) { return v.squaredNorm(); }
+  static void Accumulate(EigenVectorMap<T>& acc, const ConstEigenVectorMap<T>& v) { acc += v.cwiseAbs2(); }
+};
 
-  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_, true);
+template <typename T>
+struct ReduceAggregatorL2 : ReduceAggregatorSumSquare<T> {
+  static T Finalize(T accumulator, int64_t /*count*/) { return static_cast<T>(std::sqrt(accumulator)); }
+};
 
-  T* output_data = reduced->template MutableData<T>();
+template <typename T>
+struct ReduceAggregatorProd : ReduceAggregatorBase<T> {
+  static T Identity() { return 1; }
+  static T ReduceVector(const ConstEigenVectorMap<T>& v) { return v.prod(); }
+  static void Accumulate(EigenVectorMap<T>& acc, const ConstEigenVectorMap<T>& v) { acc = acc.cwiseProduct(v); }
+  static T Combine(T a, T b) { return a * b; }
+};
 
-  if (no_transpose) {
-    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
+template <typename T>
+struct ReduceAggregatorMax : ReduceAggregatorBase<T> {
+  static T Identity() { return std::numeric_limits<T>::lowest(); }
+  static T ReduceVector(const ConstEigenVectorMap<T>& v) { return v.maxCoeff(); }
+  static void Accumulate(EigenVectorMap<T>& acc, const ConstEigenVectorMap<T>& v) { acc = acc.cwiseMax(v); }
+  static T Combine(T a, T b) { return std::max(a, b); }
+};
 
-    for (int64_t i = 0; i < block_size; ++i) {
-      output_data[i] = ConstEigenVectorMap<T>(input_data + (i * blocks), blocks).norm();
+template <typename T>
+struct ReduceAggregatorMin : ReduceAggregatorBase<T> {
+  static T Identity() { return std::numeric_limits<T>::max(); }
+  static T ReduceVector(const ConstEigenVectorMap<T>& v) { return v.minCoeff(); }
+  static void Accumulate(EigenVectorMap<T>& acc, const ConstEigenVectorMap<T>& v) { acc = acc.cwiseMin(v); }
+  static T Combine(T a, T b) { return std::min(a, b); }
+};
+
+// Number of input elements reduced by a single task of a full reduction.
+constexpr int64_t kReduceFullChunkSize = 16384;
+// Number of output elements accumulated by a single task of a strided reduction.
+constexpr int64_t kReduceStridedBlockSize = 512;
+
+template <typename T, typename TAggregator>
+static void ReduceWithLayout(concurrency::ThreadPool* tp, const T* input_data, const ReduceLayout& layout,
+                             T* output_data) {
+  const int64_t reduce_size = layout.reduce_size;
+  const double element_bytes = static_cast<double>(sizeof(T));
+
+  if (layout.inner_size == 1 && layout.outer_size == 1) {
+    const int64_t num_chunks = (reduce_size + kReduceFullChunkSize - 1) / kReduceFullChunkSize;
+    std::vector<T> partials(static_cast<size_t>(num_chunks));
+    concurrency::ThreadPool::TryParallelFor(
+        tp, static_cast<std::ptrdiff_t>(num_chunks),
+        TensorOpCost{kReduceFullChunkSize * element_bytes, element_bytes, static_cast<double>(kReduceFullChunkSize)},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t c = first; c < last; ++c) {
+            const int64_t start = c * kReduceFullChunkSize;
+            const int64_t length = std::min(kReduceFullChunkSize, reduce_size - start);
+            partials[c] = TAggregator::ReduceVector(ConstEigenVectorMap<T>(input_data + start, length));
+          }
+        });
+    T accumulator = partials[0];
+    for (size_t c = 1; c < partials.size(); ++c) {
+      accumulator = TAggregator::Combine(accumulator, partials[c]);
     }
-  } else {
-    EigenVectorMap<T> out_vec(output_data, block_size);
-    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().norm();
+    output_data[0] = TAggregator::Finalize(accumulator, reduce_size);
+    return;
   }
 
-  return Status::OK();
+  if (layout.inner_size == 1) {
+    concurrency::ThreadPool::TryParallelFor(
+        tp, static_cast<std::ptrdiff_t>(layout.outer_size),
+        TensorOpCost{reduce_size * element_bytes, element_bytes, static_cast<double>(reduce_size)},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t i = first; i < last; ++i) {
+            const T accumulator =
+                TAggregator::ReduceVector(ConstEigenVectorMap<T>(input_data + i * reduce_size, reduce_size));
+            output_data[i] = TAggregator::Finalize(accumulator, reduce_size);
+          }
+        });
+    return;
+  }
+
+  const int64_t inner_size = layout.inner_size;
+  const int64_t blocks_per_outer = (inner_size + kReduceStridedBlockSize - 1) / kReduceStridedBlockSize;
+  const int64_t block_size = std::min(inner_size, kReduceStridedBlockSize);
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(layout.outer_size * blocks_per_outer),
+      TensorOpCost{reduce_size * block_size * element_bytes, block_size * element_bytes,
+                   static_cast<double>(reduce_size * block_size)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t b = first; b < last; ++b) {
+          const int64_t outer = b / blocks_per_outer;
+          const int64_t start = (b % blocks_per_outer) * kReduceStridedBlockSize;
+          const int64_t length = std::min(kReduceStridedBlockSize, inner_size - start);
+          const T* input = input_data + outer * reduce_size * inner_size + start;
+          T* output = output_data + outer * inner_size + start;
+
+          EigenVectorMap<T> accumulators(output, length);
+          accumulators.setConstant(TAggregator::Identity());
+          for (int64_t r = 0; r < reduce_size; ++r) {
+            TAggregator::Accumulate(accumulators, ConstEigenVectorMap<T>(input + r * inner_size, length));
+          }
+          for (int64_t i = 0; i < length; ++i) {
+            output[i] = TAggregator::Finalize(output[i], reduce_size);
+          }
+        }
+      });
 }
 
-template <typename T>
-Status ReduceLogSum<T>::Compute(OpKernelContext* ctx) const {
+template <typename T, typename TAggregator>
+static Status CommonReduce(OpKernelContext* ctx, const std::vector<int64_t>& axes_, bool keepdims_) {
+  const Tensor& input = *ctx->Input<Tensor>(0);
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+
+  std::vector<int64_t> axes;
+  std::vector<bool> keep_axis;
+  std::vector<int64_t> output_dims = ComputeReducedDims(input.Shape(), axes_, keepdims_, axes, keep_axis);
+
+  ReduceLayout layout;
+  if (GetReduceLayout(input.Shape().GetDims(), keep_axis, layout)) {
+    Tensor* reduced = ctx->Output(0, output_dims);
+    if (input.Shape().Size() == 0) {
+      return Status::OK();
+    }
+    ReduceWithLayout<T, TAggregator>(tp, input.template Data<T>(), layout, reduced->template MutableData<T>());
+    return Status::OK();
+  }
+
+  // The reduced axes aren't adjacent, so transpose them to the front of the input.
   FastAllocVector<T> transposedInputData(GetAllocator<T>(*ctx));
   int64_t block_size;
   int64_t blocks;
   Tensor* reduced;
+  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
+  if (block_size == 0 || blocks == 0) {
+    return Status::OK();
+  }
 
-  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_, true);
-
-  T* output_data = reduced->template MutableData<T>();
+  ReduceWithLayout<T, TAggregator>(tp, transposedInputData.data(), {1, blocks, block_size},
+                                   reduced->template MutableData<T>());
+  return Status::OK();
+}
 
-  if (no_transpose) {
-    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
+template <typename T>
+Status ReduceL1<T>::Compute(OpKernelContext* ctx) const {
+  return CommonReduce<T, ReduceAggregatorL1<T>>(ctx, axes_, keepdims_);
+}
 
-    for (int64_t i = 0; i < block_size; ++i) {
-      output_data[i] = ConstEigenVectorMap<T>(input_data + (i * blocks), blocks).sum();
-    }
-  } else {
-    EigenVectorMap<T> out_vec(output_data, block_size);
-    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().sum();
-  }
+template <typename T>
+Status ReduceL2<T>::Compute(OpKernelContext* ctx) const {
+  return CommonReduce<T, ReduceAggregatorL2<T>>(ctx, axes_, keepdims_);
+}
 
-  for (int j = 0; j < block_size; ++j) {
-    *(output_data) = static_cast<T>(std::log(*(output_data)));
-    ++output_data;
-  }
+template <typename T>
+Status ReduceLogSum<T>::Compute(OpKernelContext* ctx) const {
+  return CommonReduce<T, ReduceAggregatorLogSum<T>>(ctx, axes_, keepdims_);
+}
 
-  return Status::OK();
+template <typename T>
+static void ReduceLogSumExpRows(concurrency::ThreadPool* tp, const T* input_data, int64_t rows, int64_t row_size,
+                                T* output_data) {
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(rows),
+      TensorOpCost{row_size * static_cast<double>(sizeof(T)), static_cast<double>(sizeof(T)), row_size * 20.0},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          const T* row = input_data + i * row_size;
+          const T max_value = ConstEigenVectorMap<T>(row, row_size).maxCoeff();
+          T scaled_exp_sum = 0;
+          for (int64_t j = 0; j < row_size; ++j) {
+            scaled_exp_sum += static_cast<T>(std::exp(row[j] - max_value));
+          }
+          output_data[i] = static_cast<T>(std::log(scaled_exp_sum) + max_value);
+        }
+      });
 }
 
 template <typename T>
@@ -436,10 +632,16 @@ Status ReduceLogSumExp<T>::Compute(OpKernelContext* ctx) const {
   int64_t block_size;
   int64_t blocks;
   Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
+  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_, true);
 
   T* output_data = reduced->template MutableData<T>();
 
+  if (no_transpose) {
+    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
+    ReduceLogSumExpRows(ctx->GetOperatorThreadPool(), input_data, block_size, blocks, output_data);
+    return Status::OK();
+  }
+
   for (int j = 0; j < block_size; ++j) {
     T max_value = std::numeric_limits<T>::lowest();
     for (int i = 0; i < blocks; ++i) {
@@ -456,154 +658,32 @@ Status ReduceLogSumExp<T>::Compute(OpKernelContext* ctx) const {
 
 template <typename T>
 Status ReduceMax<T>::Compute(OpKernelContext* ctx) const {
-  FastAllocVector<T> transposedInputData(GetAllocator<T>(*ctx));
-  int64_t block_size;
-  int64_t blocks;
-  Tensor* reduced;
-  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_, true);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  if (no_transpose) {
-    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
-
-    for (int64_t i = 0; i < block_size; ++i) {
-      output_data[i] = ConstEigenVectorMap<T>(input_data + (i * blocks), blocks).maxCoeff();
-    }
-  } else {
-    EigenVectorMap<T> out_vec(output_data, block_size);
-    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().maxCoeff();
-  }
-
-  return Status::OK();
+  return CommonReduce<T, ReduceAggregatorMax<T>>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
 Status ReduceMean<T>::Compute(OpKernelContext* ctx) const {
-  FastAllocVector<T> transposedInputData(GetAllocator<T>(*ctx));
-  int64_t block_size;
-  int64_t blocks;
-  Tensor* reduced;
-  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_, true);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  if (no_transpose) {
-    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
-
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-    for (int64_t i = 0; i < block_size; ++i) {
-      output_data[i] = ConstEigenVectorMap<T>(input_data + (i * blocks), blocks).mean();
-    }
-  } else {
-    EigenVectorMap<T> out_vec(output_data, block_size);
-    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().mean();
-  }
-
-  return Status::OK();
+  return CommonReduce<T, ReduceAggregatorMean<T>>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
 Status ReduceMin<T>::Compute(OpKernelContext* ctx) const {
-  FastAllocVector<T> transposedInputData(GetAllocator<T>(*ctx));
-  int64_t block_size;
-  int64_t blocks;
-  Tensor* reduced;
-  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_, true);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  if (no_transpose) {
-    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
-
-    for (int64_t i = 0; i < block_size; ++i) {
-      output_data[i] = ConstEigenVectorMap<T>(input_data + (i * blocks), blocks).minCoeff();
-    }
-  } else {
-    EigenVectorMap<T> out_vec(output_data, block_size);
-    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().minCoeff();
-  }
-
-  return Status::OK();
+  return CommonReduce<T, ReduceAggregatorMin<T>>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
 Status ReduceProd<T>::Compute(OpKernelContext* ctx) const {
-  FastAllocVector<T> transposedInputData(GetAllocator<T>(*ctx));
-  int64_t block_size;
-  int64_t blocks;
-  Tensor* reduced;
-
-  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_, true);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  if (no_transpose) {
-    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
-
-    for (int64_t i = 0; i < block_size; ++i) {
-      output_data[i] = ConstEigenVectorMap<T>(input_data + (i * blocks), blocks).prod();
-    }
-  } else {
-    EigenVectorMap<T> out_vec(output_data, block_size);
-    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().prod();
-  }
-
-  return Status::OK();
+  return CommonReduce<T, ReduceAggregatorProd<T>>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
 Status ReduceSum<T>::Compute(OpKernelContext* ctx) const {
-  FastAllocVector<T> transposedInputData(GetAllocator<T>(*ctx));
-  int64_t block_size;
-  int64_t blocks;
-  Tensor* reduced;
-  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_, true);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  if (no_transpose) {
-    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
-
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-    for (int64_t i = 0; i < block_size; ++i) {
-      output_data[i] = ConstEigenVectorMap<T>(input_data + (i * blocks), blocks).sum();
-    }
-  } else {
-    EigenVectorMap<T> out_vec(output_data, block_size);
-    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().sum();
-  }
-
-  return Status::OK();
+  return CommonReduce<T, ReduceAggregatorSum<T>>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
 Status ReduceSumSquare<T>::Compute(OpKernelContext* ctx) const {
-  FastAllocVector<T> transposedInputData(GetAllocator<T>(*ctx));
-  int64_t block_size;
-  int64_t blocks;
-  Tensor* reduced;
-
-  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_, true);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  if (no_transpose) {
-    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
-
-    for (int64_t i = 0; i < block_size; ++i) {
-      output_data[i] = ConstEigenVectorMap<T>(input_data + (i * blocks), blocks).squaredNorm();
-    }
-  } else {
-    EigenVectorMap<T> out_vec(output_data, block_size);
-    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().squaredNorm();
-  }
-
-  return Status::OK();
+  return CommonReduce<T, ReduceAggregatorSumSquare<T>>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
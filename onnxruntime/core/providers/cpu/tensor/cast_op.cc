@@ -1,81 +1,182 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cmath>
 #include <iomanip>
+#include <limits>
 #include <sstream>
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
-#include "Eigen/src/Core/arch/Default/Half.h"
-#include "core/common/common.h"
-
-#if defined(_M_AMD64)
-#include "core/mlas/inc/mlas.h"
-#endif
 
 using namespace ONNX_NAMESPACE;
 namespace onnxruntime {
 
-template <typename SrcType,
-          typename DstType>
-inline void CastData(const Tensor* in, Tensor* out, const TensorShape& shape) {
-  auto shape_size = shape.Size();
-  auto in_vector = ConstEigenVectorMap<SrcType>(in->template Data<SrcType>(), shape_size);
-  auto output_vector = EigenVectorMap<DstType>(out->template MutableData<DstType>(), shape_size);
-  output_vector = in_vector.template cast<DstType>();
-}
+namespace {
+
+// Number of elements converted through the intermediate float buffer at a time when casting to or from float16.
+constexpr std::ptrdiff_t kCastFloat16BufferSize = 256;
+
+// Casting a floating point value to an integer type that cannot represent it is undefined behavior, so these casts
+// saturate to the range of the destination type and map NaN to zero.
+template <typename SrcType, typename DstType>
+using IsSaturatingCast = std::integral_constant<bool, std::is_floating_point<SrcType>::value &&
+                                                          std::is_integral<DstType>::value &&
+                                                          !std::is_same<DstType, bool>::value>;
+
+template <typename SrcType, typename DstType, typename Enable = void>
+struct CastSpan {
+  static void Run(const SrcType* in, DstType* out, std::ptrdiff_t count) {
+    EigenVectorArrayMap<DstType>(out, count) = ConstEigenVectorArrayMap<SrcType>(in, count).template cast<DstType>();
+  }
+};
+
+template <typename SrcType, typename DstType>
+struct CastSpan<SrcType, DstType, typename std::enable_if<IsSaturatingCast<SrcType, DstType>::value>::type> {
+  static void Run(const SrcType* in, DstType* out, std::ptrdiff_t count) {
+    // The lower bound is zero or a power of two and is exact in SrcType. The upper bound may round up to the next
+    // power of two, so values at or above it are selected separately and everything below is clamped to the largest
+    // SrcType value under it, which always fits in DstType. The selects keep the loop branch free so it vectorizes.
+    const SrcType lower = static_cast<SrcType>(std::numeric_limits<DstType>::lowest());
+    const SrcType upper = static_cast<SrcType>(std::numeric_limits<DstType>::max());
+    const SrcType upper_in_range = std::nextafter(upper, SrcType(0));
+
+    ConstEigenVectorArrayMap<SrcType> x(in, count);
+    EigenVectorArrayMap<DstType> y(out, count);
+    y = (x >= upper).select(std::numeric_limits<DstType>::max(),
+                            (x == x).select(x, SrcType(0)).max(lower).min(upper_in_range).template cast<DstType>());
+  }
+};
+
+template <>
+struct CastSpan<float, MLFloat16> {
+  static void Run(const float* in, MLFloat16* out, std::ptrdiff_t count) {
+    MlasConvertFloatToHalfBuffer(in, &out[0].val, static_cast<size_t>(count));
+  }
+};
 
 template <>
-inline void CastData<float, MLFloat16>(const Tensor* in, Tensor* out, const TensorShape& shape) {
-  auto out_data = out->template MutableData<MLFloat16>();
-  auto shape_size = shape.Size();
-  auto in_vector = ConstEigenVectorMap<float>(in->template Data<float>(), shape_size);
-  auto output_vector = EigenVectorMap<Eigen::half>(static_cast<Eigen::half*>(static_cast<void*>(out_data)), shape_size);
-  output_vector = in_vector.template cast<Eigen::half>();
+struct CastSpan<MLFloat16, float> {
+  static void Run(const MLFloat16* in, float* out, std::ptrdiff_t count) {
+    MlasConvertHalfToFloatBuffer(&in[0].val, out, static_cast<size_t>(count));
+  }
+};
+
+// Other casts from or to float16 go through float, a small block at a time so the intermediate values stay in cache.
+template <typename DstType>
+struct CastSpan<MLFloat16, DstType> {
+  static void Run(const MLFloat16* in, DstType* out, std::ptrdiff_t count) {
+    float buffer[kCastFloat16BufferSize];
+    for (std::ptrdiff_t i = 0; i < count; i += kCastFloat16BufferSize) {
+      const std::ptrdiff_t block = std::min(kCastFloat16BufferSize, count - i);
+      CastSpan<MLFloat16, float>::Run(in + i, buffer, block);
+      CastSpan<float, DstType>::Run(buffer, out + i, block);
+    }
+  }
+};
+
+template <typename SrcType>
+struct CastSpan<SrcType, MLFloat16> {
+  static void Run(const SrcType* in, MLFloat16* out, std::ptrdiff_t count) {
+    float buffer[kCastFloat16BufferSize];
+    for (std::ptrdiff_t i = 0; i < count; i += kCastFloat16BufferSize) {
+      const std::ptrdiff_t block = std::min(kCastFloat16BufferSize, count - i);
+      CastSpan<SrcType, float>::Run(in + i, buffer, block);
+      CastSpan<float, MLFloat16>::Run(buffer, out + i, block);
+    }
+  }
+};
+
+// Parses strings of the form [+-]?[0-9]{1,18}, which always fit in an int64_t. Anything else, including leading
+// white space or trailing characters, is left to the std::sto* functions.
+bool TryParseDecimalInteger(const std::string& str, int64_t& value) {
+  size_t pos = 0;
+  bool negative = false;
+  if (!str.empty() && (str[0] == '+' || str[0] == '-')) {
+    negative = str[0] == '-';
+    pos = 1;
+  }
+
+  const size_t digits = str.size() - pos;
+  if (digits == 0 || digits > 18) {
+    return false;
+  }
+
+  int64_t result = 0;
+  for (; pos < str.size(); ++pos) {
+    const char c = str[pos];
+    if (c < '0' || c > '9') {
+      return false;
+    }
+    result = result * 10 + (c - '0');
+  }
+
+  value = negative ? -result : result;
+  return true;
 }
 
+template <typename T>
+T ParseIntegerSlow(const std::string& str);
+
+template <>
+int ParseIntegerSlow<int>(const std::string& str) { return std::stoi(str); }
+
+template <>
+long ParseIntegerSlow<long>(const std::string& str) { return std::stol(str); }
+
+template <>
+unsigned long ParseIntegerSlow<unsigned long>(const std::string& str) { return std::stoul(str); }
+
 template <>
-inline void CastData<MLFloat16, float>(const Tensor* in, Tensor* out, const TensorShape& shape) {
-  auto out_data = out->template MutableData<float>();
-  auto in_data = in->template Data<MLFloat16>();
-  auto shape_size = shape.Size();
-#if defined(_M_AMD64)
-  MlasConvertHalfToFloatBuffer(&in_data[0].val, out_data, shape_size);
-#else
-  auto in_vector = ConstEigenVectorMap<Eigen::half>(static_cast<const Eigen::half*>(static_cast<const void*>(in_data)), shape_size);
-  auto output_vector = EigenVectorMap<float>(out_data, shape_size);
-  output_vector = in_vector.template cast<float>();
-#endif
+long long ParseIntegerSlow<long long>(const std::string& str) { return std::stoll(str); }
+
+template <>
+unsigned long long ParseIntegerSlow<unsigned long long>(const std::string& str) { return std::stoull(str); }
+
+// Returns the same value as the std::sto* function for T. Values outside the range of T, and negative values for
+// unsigned T (which std::stoul wraps around), take the slow path so the results and exceptions are unchanged.
+template <typename T>
+T ParseInteger(const std::string& str) {
+  int64_t value;
+  if (TryParseDecimalInteger(str, value)) {
+    const bool in_range = value >= 0
+                              ? static_cast<uint64_t>(value) <= static_cast<uint64_t>(std::numeric_limits<T>::max())
+                              : std::is_signed<T>::value &&
+                                    value >= static_cast<int64_t>(std::numeric_limits<T>::lowest());
+    if (in_range && (std::is_signed<T>::value || str[0] != '-')) {
+      return static_cast<T>(value);
+    }
+  }
+  return ParseIntegerSlow<T>(str);
 }
 
+}  // namespace
+
 template <typename SrcType,
           typename DstType>
-inline void CastFloat16Data(const Tensor* in, Tensor* out, const TensorShape& shape, const AllocatorPtr& allocator) {
-  ORT_ENFORCE(allocator != nullptr);
-  const int64_t len = shape.Size();
-  ORT_ENFORCE(len > 0);
-  void* buffer = allocator->AllocArray(sizeof(float), len);
-  ORT_ENFORCE(buffer);
-  Tensor tmp_tensor(DataTypeImpl::GetType<float>(), shape, buffer, allocator->Info());
-  if (std::is_same<SrcType, MLFloat16>::value) {
-    CastData<MLFloat16, float>(in, &tmp_tensor, shape);  // first cast to float
-    CastData<float, DstType>(&tmp_tensor, out, shape);   // then cast to the destination type.
-  } else if (std::is_same<DstType, MLFloat16>::value) {
-    CastData<SrcType, float>(in, &tmp_tensor, shape);
-    CastData<float, MLFloat16>(&tmp_tensor, out, shape);
-  }
-  allocator->Free(buffer);
+inline void CastData(const Tensor* in, Tensor* out, const TensorShape& shape, concurrency::ThreadPool* tp) {
+  const auto* in_data = in->template Data<SrcType>();
+  auto* out_data = out->template MutableData<DstType>();
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(shape.Size()),
+      TensorOpCost{static_cast<double>(sizeof(SrcType)), static_cast<double>(sizeof(DstType)), 1.0},
+      [in_data, out_data](std::ptrdiff_t first, std::ptrdiff_t last) {
+        CastSpan<SrcType, DstType>::Run(in_data + first, out_data + first, last - first);
+      });
 }
 
 template <typename SrcType>
-inline void CastToStringData(const Tensor* in, Tensor* out, const TensorShape& shape) {
-  const int64_t len = shape.Size();
-  ORT_ENFORCE(len > 0);
-  auto input_data = in->DataAsSpan<SrcType>();
-  auto output_data = out->MutableDataAsSpan<std::string>();
+inline void CastToStringSpan(const SrcType* input_data, std::string* output_data, std::ptrdiff_t count) {
+  std::ostringstream convert;
+  if (std::is_floating_point<SrcType>::value) {
+    // match numpy default behavior
+    convert << std::setprecision(8);
+  }
 
-  for (int i = 0; i < len; ++i) {
+  for (std::ptrdiff_t i = 0; i < count; ++i) {
     if (std::is_floating_point<SrcType>::value && std::isnan(input_data[i])) {
       output_data[i] = "NaN";
     } else if (std::is_floating_point<SrcType>::value && std::isinf(input_data[i])) {
@@ -84,82 +185,99 @@ inline void CastToStringData(const Tensor* in, Tensor* out, const TensorShape& s
       } else {
         output_data[i] = "INF";
       }
+    } else if (std::is_integral<SrcType>::value && sizeof(SrcType) > 1) {
+      // bool and the 8-bit types are streamed as characters, everything else formats the same as std::to_string.
+      output_data[i] = std::to_string(input_data[i]);
     } else {
-      std::ostringstream convert;
-      if (std::is_floating_point<SrcType>::value) {
-        // match numpy default behavior
-        convert << std::setprecision(8);
-      }
-
+      // reuse the stream (and its locale) across elements
+      convert.str(std::string());
       convert << input_data[i];
       output_data[i] = convert.str();
     }
   }
 }
 
+template <typename SrcType>
+inline void CastToStringData(const Tensor* in, Tensor* out, const TensorShape& shape, concurrency::ThreadPool* tp) {
+  const int64_t len = shape.Size();
+  ORT_ENFORCE(len > 0);
+  const auto* input_data = in->Data<SrcType>();
+  auto* output_data = out->MutableData<std::string>();
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(len),
+      TensorOpCost{static_cast<double>(sizeof(SrcType)), static_cast<double>(sizeof(std::string)), 64.0},
+      [input_data, output_data](std::ptrdiff_t first, std::ptrdiff_t last) {
+        CastToStringSpan<SrcType>(input_data + first, output_data + first, last - first);
+      });
+}
+
+// Parsing stays on the calling thread: the std::sto* functions report malformed strings with exceptions, which must
+// not escape a thread pool worker.
 template <typename DstType>
 inline void CastFromStringData(const Tensor* in, Tensor* out, const TensorShape& shape) {
   if (std::is_same<DstType, std::string>::value) return;
   const int64_t len = shape.Size();
   ORT_ENFORCE(len > 0);
+  const auto* input_data = in->Data<std::string>();
   if (std::is_same<DstType, float>::value) {
     auto* mutable_data = out->MutableData<float>();
-    for (int i = 0; i < len; ++i) {
-      mutable_data[i] = std::stof(in->Data<std::string>()[i]);
+    for (int64_t i = 0; i < len; ++i) {
+      mutable_data[i] = std::stof(input_data[i]);
     }
   } else if (std::is_same<DstType, double>::value) {
     auto* mutable_data = out->MutableData<double>();
-    for (int i = 0; i < len; ++i) {
-      mutable_data[i] = std::stod(in->Data<std::string>()[i]);
+    for (int64_t i = 0; i < len; ++i) {
+      mutable_data[i] = std::stod(input_data[i]);
     }
   } else if (std::is_same<DstType, int8_t>::value) {
     auto* mutable_data = out->MutableData<int8_t>();
-    for (int i = 0; i < len; ++i) {
-      int temp_i = std::stoi(in->Data<std::string>()[i]);
+    for (int64_t i = 0; i < len; ++i) {
+      int temp_i = ParseInteger<int>(input_data[i]);
       mutable_data[i] = static_cast<int8_t>(temp_i);
     }
   } else if (std::is_same<DstType, uint8_t>::value) {
     auto* mutable_data = out->MutableData<uint8_t>();
-    for (int i = 0; i < len; ++i) {
-      unsigned long temp_ui = std::stoul(in->Data<std::string>()[i]);
+    for (int64_t i = 0; i < len; ++i) {
+      unsigned long temp_ui = ParseInteger<unsigned long>(input_data[i]);
       mutable_data[i] = static_cast<uint8_t>(temp_ui);
     }
   } else if (std::is_same<DstType, int16_t>::value) {
     auto* mutable_data = out->MutableData<int16_t>();
-    for (int i = 0; i < len; ++i) {
-      int temp_i = std::stoi(in->Data<std::string>()[i]);
+    for (int64_t i = 0; i < len; ++i) {
+      int temp_i = ParseInteger<int>(input_data[i]);
       mutable_data[i] = static_cast<int16_t>(temp_i);
     }
   } else if (std::is_same<DstType, uint16_t>::value) {
     auto* mutable_data = out->MutableData<uint16_t>();
-    for (int i = 0; i < len; ++i) {
-      unsigned long temp_ui = std::stoul(in->Data<std::string>()[i]);
+    for (int64_t i = 0; i < len; ++i) {
+      unsigned long temp_ui = ParseInteger<unsigned long>(input_data[i]);
       mutable_data[i] = static_cast<uint16_t>(temp_ui);
     }
   } else if (std::is_same<DstType, int32_t>::value) {
     auto* mutable_data = out->MutableData<int32_t>();
-    for (int i = 0; i < len; ++i) {
-      mutable_data[i] = std::stol(in->Data<std::string>()[i]);
+    for (int64_t i = 0; i < len; ++i) {
+      mutable_data[i] = static_cast<int32_t>(ParseInteger<long>(input_data[i]));
     }
   } else if (std::is_same<DstType, uint32_t>::value) {
     auto* mutable_data = out->MutableData<uint32_t>();
-    for (int i = 0; i < len; ++i) {
-      mutable_data[i] = std::stoul(in->Data<std::string>()[i]);
+    for (int64_t i = 0; i < len; ++i) {
+      mutable_data[i] = static_cast<uint32_t>(ParseInteger<unsigned long>(input_data[i]));
     }
   } else if (std::is_same<DstType, int64_t>::value) {
     auto* mutable_data = out->MutableData<int64_t>();
-    for (int i = 0; i < len; ++i) {
-      mutable_data[i] = std::stoll(in->Data<std::string>()[i]);
+    for (int64_t i = 0; i < len; ++i) {
+      mutable_data[i] = ParseInteger<long long>(input_data[i]);
     }
   } else if (std::is_same<DstType, uint64_t>::value) {
     auto* mutable_data = out->MutableData<uint64_t>();
-    for (int i = 0; i < len; ++i) {
-      mutable_data[i] = std::stoull(in->Data<std::string>()[i]);
+    for (int64_t i = 0; i < len; ++i) {
+      mutable_data[i] = ParseInteger<unsigned long long>(input_data[i]);
     }
   } else {
     ORT_THROW("Unsupported type in cast op: from String to ", typeid(DstType).name());
   }
-}  // namespace onnxruntime
+}
 
 template <typename T>
 class Cast final : public OpKernel {
@@ -176,22 +294,13 @@ class Cast final : public OpKernel {
  private:
   template <typename SrcType,
             typename DstType>
-  void CastData(const Tensor* in, Tensor* out, const TensorShape& shape) const {
-    ::onnxruntime::CastData<SrcType, DstType>(in, out, shape);
-  }
-
-  template <typename SrcType,
-            typename DstType>
-  Status CastFloat16Data(const Tensor* in, Tensor* out, const TensorShape& shape, OpKernelContext* context) const {
-    AllocatorPtr allocator;
-    ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
-    ::onnxruntime::CastFloat16Data<SrcType, DstType>(in, out, shape, allocator);
-    return Status::OK();
+  void CastData(const Tensor* in, Tensor* out, const TensorShape& shape, OpKernelContext* context) const {
+    ::onnxruntime::CastData<SrcType, DstType>(in, out, shape, context->GetOperatorThreadPool());
   }
 
   template <typename SrcType>
-  Status CastToStringData(const Tensor* in, Tensor* out, const TensorShape& shape) const {
-    ::onnxruntime::CastToStringData<SrcType>(in, out, shape);
+  Status CastToStringData(const Tensor* in, Tensor* out, const TensorShape& shape, OpKernelContext* context) const {
+    ::onnxruntime::CastToStringData<SrcType>(in, out, shape, context->GetOperatorThreadPool());
     return Status::OK();
   }
 
@@ -236,48 +345,43 @@ const std::vector<MLDataType> castOpTypeConstraints{
                                                                                                                                    \
     switch (to_) {                                                                                                                 \
       case TensorProto_DataType_BOOL:                                                                                              \
-        CastData<in_type, bool>(X, Y, shape);                                                                                      \
+        CastData<in_type, bool>(X, Y, shape, context);                                                                             \
         break;                                                                                                                     \
       case TensorProto_DataType_INT16:                                                                                             \
-        CastData<in_type, int16_t>(X, Y, shape);                                                                                   \
+        CastData<in_type, int16_t>(X, Y, shape, context);                                                                          \
         break;                                                                                                                     \
       case TensorProto_DataType_INT32:                                                                                             \
-        CastData<in_type, int32_t>(X, Y, shape);                                                                                   \
+        CastData<in_type, int32_t>(X, Y, shape, context);                                                                          \
         break;                                                                                                                     \
       case TensorProto_DataType_INT64:                                                                                             \
-        CastData<in_type, int64_t>(X, Y, shape);                                                                                   \
+        CastData<in_type, int64_t>(X, Y, shape, context);                                                                          \
         break;                                                                                                                     \
       case TensorProto_DataType_UINT8:                                                                                             \
-        CastData<in_type, uint8_t>(X, Y, shape);                                                                                   \
+        CastData<in_type, uint8_t>(X, Y, shape, context);                                                                          \
         break;                                                                                                                     \
       case TensorProto_DataType_UINT16:                                                                                            \
-        CastData<in_type, uint16_t>(X, Y, shape);                                                                                  \
+        CastData<in_type, uint16_t>(X, Y, shape, context);                                                                         \
         break;                                                                                                                     \
       case TensorProto_DataType_UINT32:                                                                                            \
-        CastData<in_type, uint32_t>(X, Y, shape);                                                                                  \
+        CastData<in_type, uint32_t>(X, Y, shape, context);                                                                         \
         break;                                                                                                                     \
       case TensorProto_DataType_UINT64:                                                                                            \
-        CastData<in_type, uint64_t>(X, Y, shape);                                                                                  \
+        CastData<in_type, uint64_t>(X, Y, shape, context);                                                                         \
         break;                                                                                                                     \
       case TensorProto_DataType_FLOAT:                                                                                             \
-        CastData<in_type, float>(X, Y, shape);                                                                                     \
+        CastData<in_type, float>(X, Y, shape, context);                                                                            \
         break;                                                                                                                     \
       case TensorProto_DataType_DOUBLE:                                                                                            \
-        CastData<in_type, double>(X, Y, shape);                                                                                    \
+        CastData<in_type, double>(X, Y, shape, context);                                                                           \
         break;                                                                                                                     \
       case TensorProto_DataType_INT8:                                                                                              \
-        CastData<in_type, int8_t>(X, Y, shape);                                                                                    \
+        CastData<in_type, int8_t>(X, Y, shape, context);                                                                           \
         break;                                                                                                                     \
       case TensorProto_DataType_FLOAT16:                                                                                           \
-        if (std::is_same<in_type, float>::value) {                                                                                 \
-          CastData<float, MLFloat16>(X, Y, shape);                                                                                 \
-        } else {                                                                                                                   \
-          auto st = CastFloat16Data<in_type, MLFloat16>(X, Y, shape, context);                                                     \
-          if (!st.IsOK()) return st;                                                                                               \
-        }                                                                                                                          \
+        CastData<in_type, MLFloat16>(X, Y, shape, context);                                                                        \
         break;                                                                                                                     \
       case TensorProto_DataType_STRING:                                                                                            \
-        CastToStringData<in_type>(X, Y, shape);                                                                                    \
+        CastToStringData<in_type>(X, Y, shape, context);                                                                           \
         break;                                                                                                                     \
       case TensorProto_DataType_UNDEFINED:                                                                                         \
         ORT_THROW("Cast op must have 'to' argument of type DataType"); /*break;*/                                                  \
@@ -315,31 +419,31 @@ Status Cast<MLFloat16>::Compute(OpKernelContext* context) const {
   Status st;
   switch (to_) {
     case TensorProto_DataType_BOOL:
-      st = CastFloat16Data<MLFloat16, bool>(X, Y, shape, context);
+      CastData<MLFloat16, bool>(X, Y, shape, context);
       break;
     case TensorProto_DataType_INT16:
-      st = CastFloat16Data<MLFloat16, int16_t>(X, Y, shape, context);
+      CastData<MLFloat16, int16_t>(X, Y, shape, context);
       break;
     case TensorProto_DataType_INT32:
-      st = CastFloat16Data<MLFloat16, int32_t>(X, Y, shape, context);
+      CastData<MLFloat16, int32_t>(X, Y, shape, context);
       break;
     case TensorProto_DataType_INT64:
-      st = CastFloat16Data<MLFloat16, int64_t>(X, Y, shape, context);
+      CastData<MLFloat16, int64_t>(X, Y, shape, context);
       break;
     case TensorProto_DataType_UINT8:
-      st = CastFloat16Data<MLFloat16, uint8_t>(X, Y, shape, context);
+      CastData<MLFloat16, uint8_t>(X, Y, shape, context);
       break;
     case TensorProto_DataType_UINT16:
-      st = CastFloat16Data<MLFloat16, uint16_t>(X, Y, shape, context);
+      CastData<MLFloat16, uint16_t>(X, Y, shape, context);
       break;
     case TensorProto_DataType_UINT32:
-      st = CastFloat16Data<MLFloat16, uint32_t>(X, Y, shape, context);
+      CastData<MLFloat16, uint32_t>(X, Y, shape, context);
       break;
     case TensorProto_DataType_UINT64:
-      st = CastFloat16Data<MLFloat16, uint64_t>(X, Y, shape, context);
+      CastData<MLFloat16, uint64_t>(X, Y, shape, context);
       break;
     case TensorProto_DataType_FLOAT:
-      CastData<MLFloat16, float>(X, Y, shape);
+      CastData<MLFloat16, float>(X, Y, shape, context);
       break;
     case TensorProto_DataType_FLOAT16: {
       auto X_type = X->DataType();
@@ -353,10 +457,10 @@ Status Cast<MLFloat16>::Compute(OpKernelContext* context) const {
       break;
     }
     case TensorProto_DataType_DOUBLE:
-      st = CastFloat16Data<MLFloat16, double>(X, Y, shape, context);
+      CastData<MLFloat16, double>(X, Y, shape, context);
       break;
     case TensorProto_DataType_INT8:
-      st = CastFloat16Data<MLFloat16, int8_t>(X, Y, shape, context);
+      CastData<MLFloat16, int8_t>(X, Y, shape, context);
       break;
     case TensorProto_DataType_STRING:
       ORT_THROW("Casting from 'float16' to 'string' is not supported yet."); /*break;*/
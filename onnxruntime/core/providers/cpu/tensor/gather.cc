@@ -4,6 +4,8 @@
 //https://github.com/onnx/onnx/blob/master/docs/Operators.md#Gather
 #include "core/providers/cpu/tensor/gather.h"
 #include "core/common/common.h"
+#include "core/platform/threadpool.h"
+#include "core/util/math_cpuonly.h"
 
 namespace onnxruntime {
 
@@ -53,15 +55,74 @@ Status GatherBase::PrepareForCompute(OpKernelContext* context, Prepare& p) const
   return Status::OK();
 }
 
+// Number of blocks ahead of the current block whose source is prefetched. The indices of an embedding lookup
+// are usually random, so the hardware prefetcher can't predict the rows that are read.
+constexpr int64_t kGatherPrefetchDistance = 8;
+
+// Copies a block of a size known at compile time. The copy is inlined into a few (vector) loads and stores.
+template <size_t block_bytes>
+struct GatherFixedSizeBlockCopy {
+  void operator()(uint8_t* dst, const uint8_t* src) const {
+    memcpy(dst, src, block_bytes);
+  }
+};
+
+struct GatherBlockCopy {
+  size_t block_bytes;
+
+  void operator()(uint8_t* dst, const uint8_t* src) const {
+    memcpy(dst, src, block_bytes);
+  }
+};
+
+struct GatherStringBlockCopy {
+  size_t block;
+
+  void operator()(uint8_t* dst, const uint8_t* src) const {
+    std::copy_n(reinterpret_cast<const std::string*>(src), block, reinterpret_cast<std::string*>(dst));
+  }
+};
+
+// Copies the blocks of the M x N gathered batches. The blocks are split across the thread pool.
+template <typename Tin, typename BlockCopy>
+static void GatherCopyBlocks(const Tin* indices_data, const uint8_t* src_base, uint8_t* dst_base,
+                             const int64_t block_size, const int64_t M, const int64_t N,
+                             const int64_t data_batch_bytes, const int64_t gathered_batch_bytes,
+                             const int64_t axis_dim_limit, const BlockCopy& copy_block,
+                             concurrency::ThreadPool* tp) {
+  auto src_block = [&](int64_t index) {
+    const int64_t batch = index / N;
+    const int64_t i = index % N;
+    Tin idx = indices_data[i];
+    idx = idx < 0 ? idx + static_cast<Tin>(axis_dim_limit) : idx;
+    return src_base + batch * data_batch_bytes + idx * block_size;
+  };
+
+  const auto block_bytes = static_cast<double>(block_size);
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(M * N), TensorOpCost{block_bytes, block_bytes, 1.0},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (int64_t index = first; index < last; ++index) {
+          if (index + kGatherPrefetchDistance < last) {
+            Eigen::internal::prefetch(src_block(index + kGatherPrefetchDistance));
+          }
+
+          const int64_t batch = index / N;
+          const int64_t i = index % N;
+          copy_block(dst_base + batch * gathered_batch_bytes + i * block_size, src_block(index));
+        }
+      });
+}
+
 template <typename Tin>
 Status GatherCopyData(const Tensor* indices_tensor, const uint8_t* src_base, uint8_t* dst_base, bool is_string_type,
                       const size_t element_bytes, const int64_t block_size, const int64_t M,
                       const int64_t N, const int64_t data_batch_bytes, const int64_t gathered_batch_bytes,
-                      const TensorShape& input_data_shape, const int64_t axis) {
+                      const TensorShape& input_data_shape, const int64_t axis, concurrency::ThreadPool* tp) {
   const Tin* indices_data = indices_tensor->template Data<Tin>();
 
   // Check the indices first in case there's a out of bound index.
-  // We can't merge this code in the omp loop below as omp does not allow return in the loop
+  // We can't merge this code in the parallel loop below as it can't return from the loop
   auto axis_dim_limit = input_data_shape[axis];
 
   for (int64_t i = 0; i < N; ++i) {
@@ -73,25 +134,44 @@ Status GatherCopyData(const Tensor* indices_tensor, const uint8_t* src_base, uin
     }
   }
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-  for (int64_t index = 0; index < M * N; ++index) {
-    int64_t batch = index / N;
-    int64_t i = index % N;
-
-    const int64_t src_offset_batch = batch * data_batch_bytes;
-    const int64_t dst_offset_batch = batch * gathered_batch_bytes;
-    Tin idx = indices_data[i];
-    idx = idx < 0 ? idx + static_cast<Tin>(axis_dim_limit) : idx;
-    const int64_t src_offset = src_offset_batch + idx * block_size;
-    const int64_t dst_offset = dst_offset_batch + i * block_size;
-
-    if (is_string_type) {
-      reinterpret_cast<std::string*>(dst_base)[dst_offset / element_bytes] =
-          reinterpret_cast<const std::string*>(src_base)[src_offset / element_bytes];
-    } else {
-      memcpy(dst_base + dst_offset, src_base + src_offset, block_size);
+  // Small blocks, such as the rows of an embedding table with a small embedding size, are copied with a fixed size.
+  if (is_string_type) {
+    GatherCopyBlocks(indices_data, src_base, dst_base, block_size, M, N, data_batch_bytes, gathered_batch_bytes,
+                     axis_dim_limit, GatherStringBlockCopy{static_cast<size_t>(block_size) / element_bytes}, tp);
+  } else {
+    switch (block_size) {
+      case 1:
+        GatherCopyBlocks(indices_data, src_base, dst_base, block_size, M, N, data_batch_bytes, gathered_batch_bytes,
+                         axis_dim_limit, GatherFixedSizeBlockCopy<1>(), tp);
+        break;
+      case 2:
+        GatherCopyBlocks(indices_data, src_base, dst_base, block_size, M, N, data_batch_bytes, gathered_batch_bytes,
+                         axis_dim_limit, GatherFixedSizeBlockCopy<2>(), tp);
+        break;
+      case 4:
+        GatherCopyBlocks(indices_data, src_base, dst_base, block_size, M, N, data_batch_bytes, gathered_batch_bytes,
+                         axis_dim_limit, GatherFixedSizeBlockCopy<4>(), tp);
+        break;
+      case 8:
+        GatherCopyBlocks(indices_data, src_base, dst_base, block_size, M, N, data_batch_bytes, gathered_batch_bytes,
+                         axis_dim_limit, GatherFixedSizeBlockCopy<8>(), tp);
+        break;
+      case 16:
+        GatherCopyBlocks(indices_data, src_base, dst_base, block_size, M, N, data_batch_bytes, gathered_batch_bytes,
+                         axis_dim_limit, GatherFixedSizeBlockCopy<16>(), tp);
+        break;
+      case 32:
+        GatherCopyBlocks(indices_data, src_base, dst_base, block_size, M, N, data_batch_bytes, gathered_batch_bytes,
+                         axis_dim_limit, GatherFixedSizeBlockCopy<32>(), tp);
+        break;
+      case 64:
+        GatherCopyBlocks(indices_data, src_base, dst_base, block_size, M, N, data_batch_bytes, gathered_batch_bytes,
+                         axis_dim_limit, GatherFixedSizeBlockCopy<64>(), tp);
+        break;
+      default:
+        GatherCopyBlocks(indices_data, src_base, dst_base, block_size, M, N, data_batch_bytes, gathered_batch_bytes,
+                         axis_dim_limit, GatherBlockCopy{static_cast<size_t>(block_size)}, tp);
+        break;
     }
   }
 
@@ -117,13 +197,17 @@ Status Gather::Compute(OpKernelContext* context) const {
   const auto* src_base = static_cast<const uint8_t*>(p.input_tensor->DataRaw());
   auto* dst_base = static_cast<uint8_t*>(p.output_tensor->MutableDataRaw());
 
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
+
   if (p.indices_tensor->IsDataType<int32_t>()) {
     return GatherCopyData<int32_t>(p.indices_tensor, src_base, dst_base, is_string_type, element_bytes,
-                                   block_size, M, N, data_batch_bytes, gathered_batch_bytes, input_data_shape, p.axis);
+                                   block_size, M, N, data_batch_bytes, gathered_batch_bytes, input_data_shape, p.axis,
+                                   tp);
   }
   if (p.indices_tensor->IsDataType<int64_t>()) {
     return GatherCopyData<int64_t>(p.indices_tensor, src_base, dst_base, is_string_type, element_bytes,
-                                   block_size, M, N, data_batch_bytes, gathered_batch_bytes, input_data_shape, p.axis);
+                                   block_size, M, N, data_batch_bytes, gathered_batch_bytes, input_data_shape, p.axis,
+                                   tp);
   }
 
   return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Type for Tind not supported yet in Gather.");
@@ -3,6 +3,10 @@
 
 #include "gather_nd.h"
 
+#include <atomic>
+
+#include "core/util/math_cpuonly.h"
+
 namespace onnxruntime {
 
 // Register a kernel for kMsDomain (contrib op) GatherND
@@ -56,14 +60,12 @@ Status GatherNDBase::PrepareForCompute(OpKernelContext* context, Prepare& p) con
   std::vector<int64_t> element_counts(last_indices_dimension,
                                       0LL);  // Number of elements for each input dimension
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
   for (int64_t i = 0; i < last_indices_dimension; ++i) {
     element_counts[i] = input_shape.SizeFromDimension(i + 1);
   }
 
-  int64_t err_index = 0;
+  // set from the thread pool workers; when several indices are invalid any one of them is reported
+  std::atomic<int64_t> err_index{0};
   p.element_bytes = input_tensor->DataType()->Size();
   p.element_to_copy = input_shape.SizeFromDimension(last_indices_dimension);
   p.bytes_to_copy = p.element_bytes * p.element_to_copy;
@@ -79,26 +81,31 @@ Status GatherNDBase::PrepareForCompute(OpKernelContext* context, Prepare& p) con
     p.output_base = static_cast<uint8_t*>(output_tensor->MutableDataRaw());
   }
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-  for (int64_t i = 0; i < offset_count; ++i) {
-    for (int64_t j = 0; j < last_indices_dimension; ++j) {
-      auto index = *(indices_data + i * last_indices_dimension + j);
-      auto upper_limit = input_shape[j];
-      auto lower_limit = -upper_limit;
-      if (index < lower_limit || index >= upper_limit) {
-        err_index = index;
-      }
-      if (index < 0) {
-        index += static_cast<Tind>(upper_limit);
-      }
-      p.element_offsets[i] += index * element_counts[j];
-    }
-  }
-
-  return err_index == 0 ? Status::OK()
-                        : ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "invalid index found, index = ", err_index);
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(offset_count),
+      TensorOpCost{static_cast<double>(last_indices_dimension * sizeof(Tind)), static_cast<double>(sizeof(uint64_t)),
+                   static_cast<double>(last_indices_dimension)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (int64_t i = first; i < last; ++i) {
+          for (int64_t j = 0; j < last_indices_dimension; ++j) {
+            auto index = *(indices_data + i * last_indices_dimension + j);
+            auto upper_limit = input_shape[j];
+            auto lower_limit = -upper_limit;
+            if (index < lower_limit || index >= upper_limit) {
+              err_index.store(static_cast<int64_t>(index), std::memory_order_relaxed);
+            }
+            if (index < 0) {
+              index += static_cast<Tind>(upper_limit);
+            }
+            p.element_offsets[i] += index * element_counts[j];
+          }
+        }
+      });
+
+  const int64_t invalid_index = err_index.load(std::memory_order_relaxed);
+  return invalid_index == 0 ? Status::OK()
+                            : ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "invalid index found, index = ",
+                                              invalid_index);
 }
 
 template Status GatherNDBase::PrepareForCompute<int32_t>(OpKernelContext*, Prepare&) const;
@@ -110,30 +117,43 @@ Status GatherND::Compute(OpKernelContext* context) const {
                           ? PrepareForCompute<int32_t>(context, p)
                           : PrepareForCompute<int64_t>(context, p));
 
-  return nullptr == p.input_str_base ? GatherNumber(p) : GatherString(p);
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
+  return nullptr == p.input_str_base ? GatherNumber(p, tp) : GatherString(p, tp);
 }
 
-Status GatherND::GatherNumber(const Prepare& p) const {
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-  for (int64_t i = 0; i < static_cast<int64_t>(p.element_offsets.size()); ++i) {
-    memcpy(p.output_base + i * p.bytes_to_copy, p.input_base + p.element_offsets[i] * p.element_bytes,
-           p.bytes_to_copy);
-  }
+// Number of slices ahead of the current slice whose source is prefetched.
+constexpr int64_t kGatherNDPrefetchDistance = 8;
+
+Status GatherND::GatherNumber(const Prepare& p, concurrency::ThreadPool* tp) const {
+  const auto bytes_to_copy = static_cast<double>(p.bytes_to_copy);
+  const auto offset_count = static_cast<int64_t>(p.element_offsets.size());
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(offset_count), TensorOpCost{bytes_to_copy, bytes_to_copy, 1.0},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (int64_t i = first; i < last; ++i) {
+          if (i + kGatherNDPrefetchDistance < last) {
+            const uint64_t prefetch_offset = p.element_offsets[i + kGatherNDPrefetchDistance];
+            Eigen::internal::prefetch(p.input_base + prefetch_offset * p.element_bytes);
+          }
+          memcpy(p.output_base + i * p.bytes_to_copy, p.input_base + p.element_offsets[i] * p.element_bytes,
+                 p.bytes_to_copy);
+        }
+      });
 
   return Status::OK();
 }
 
-Status GatherND::GatherString(const Prepare& p) const {
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-  for (int64_t i = 0; i < static_cast<int64_t>(p.element_offsets.size()); ++i) {
-    for (int64_t j = 0; j < static_cast<int64_t>(p.element_to_copy); ++j) {
-      p.output_str_base[i * p.element_to_copy + j] = p.input_str_base[p.element_offsets[i] + j];
-    }
-  }
+Status GatherND::GatherString(const Prepare& p, concurrency::ThreadPool* tp) const {
+  const auto bytes_to_copy = static_cast<double>(p.element_to_copy * sizeof(std::string));
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(p.element_offsets.size()), TensorOpCost{bytes_to_copy, bytes_to_copy, 1.0},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (int64_t i = first; i < last; ++i) {
+          for (int64_t j = 0; j < static_cast<int64_t>(p.element_to_copy); ++j) {
+            p.output_str_base[i * p.element_to_copy + j] = p.input_str_base[p.element_offsets[i] + j];
+          }
+        }
+      });
 
   return Status::OK();
 }
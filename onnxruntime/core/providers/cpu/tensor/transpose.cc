@@ -3,6 +3,8 @@
 
 #include "core/providers/cpu/tensor/transpose.h"
 #include "core/framework/utils.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
 namespace onnxruntime {
 
 /* A permutation [a,b,c,...] indicates that 
@@ -32,6 +34,16 @@ static inline void IncrementIndex(std::vector<int64_t>& index, const std::vector
   }
 }
 
+// InitializeIndex: set index to the position of the offset-th element (in lexicographic ordering)
+// of a tensor with the specified upper_bound.
+static inline void InitializeIndex(std::vector<int64_t>& index, const std::vector<int64_t>& upper_bound, int64_t num_axes,
+                                   size_t offset) {
+  for (int64_t k = num_axes - 1; k >= 0; --k) {
+    index[k] = static_cast<int64_t>(offset % upper_bound[k]);
+    offset /= upper_bound[k];
+  }
+}
+
 // DoTransposeSingleBlock: specialization of DoTranspose for the num_blocks=1 case.
 // copies source tensor to target, transposing elements.
 static inline void DoTransposeSingleBlock(size_t num_elts_in_block, const void* source, void* target,
@@ -48,46 +60,83 @@ static inline void DoTransposeSingleBlock(size_t num_elts_in_block, const std::s
 
 // DoTranspose: copies source tensor to target, transposing elements.
 // The stride vector indicates the transposition.
+// The blocks are split across the thread pool. Each thread starts from the target_index of its first block.
 static void DoTransposeImpl(int64_t num_axes, const std::vector<int64_t>& target_dims,
                             size_t num_blocks, size_t num_elts_in_block, const std::vector<size_t>& stride,
-                            const uint8_t* source, uint8_t* target, size_t element_size) {
+                            const uint8_t* source, uint8_t* target, size_t element_size,
+                            concurrency::ThreadPool* tp) {
   size_t blocksize = num_elts_in_block * element_size;
-  // index used to iterate over target iteration-space
-  std::vector<int64_t> target_index(num_axes, 0);
-  for (size_t i = 0; i < num_blocks; ++i) {
-    // convert target_index into an offset in source data
-    size_t source_offset = ComputeOffset(target_index, stride, num_axes);
-
-    // copy
-    memcpy(target, source + source_offset * element_size, blocksize);
-
-    // increment target_index:
-    IncrementIndex(target_index, target_dims, num_axes);
-    target += blocksize;
-  }
+  const auto block_bytes = static_cast<double>(blocksize);
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(num_blocks), TensorOpCost{block_bytes, block_bytes, static_cast<double>(num_axes)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        // index used to iterate over target iteration-space
+        std::vector<int64_t> target_index(num_axes, 0);
+        InitializeIndex(target_index, target_dims, num_axes, first);
+        uint8_t* target_block = target + first * blocksize;
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          // convert target_index into an offset in source data
+          size_t source_offset = ComputeOffset(target_index, stride, num_axes);
+
+          // copy
+          memcpy(target_block, source + source_offset * element_size, blocksize);
+
+          // increment target_index:
+          IncrementIndex(target_index, target_dims, num_axes);
+          target_block += blocksize;
+        }
+      });
 }
 
 static void DoTransposeImpl(int64_t num_axes, const std::vector<int64_t>& target_dims,
                             size_t num_blocks, size_t num_elts_in_block, const std::vector<size_t>& stride,
-                            const std::string* source, std::string* target) {
-  // index used to iterate over target iteration-space
-  std::vector<int64_t> target_index(num_axes, 0);
-  for (size_t i = 0; i < num_blocks; ++i) {
-    // convert target_index into an offset in source data
-    size_t source_offset = ComputeOffset(target_index, stride, num_axes);
-
-    // copy
-    DoTransposeSingleBlock(num_elts_in_block, source + source_offset, target);
-
-    // increment target_index:
-    IncrementIndex(target_index, target_dims, num_axes);
-    target += num_elts_in_block;
-  }
+                            const std::string* source, std::string* target, concurrency::ThreadPool* tp) {
+  const auto block_bytes = static_cast<double>(num_elts_in_block * sizeof(std::string));
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(num_blocks), TensorOpCost{block_bytes, block_bytes, static_cast<double>(num_axes)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        // index used to iterate over target iteration-space
+        std::vector<int64_t> target_index(num_axes, 0);
+        InitializeIndex(target_index, target_dims, num_axes, first);
+        std::string* target_block = target + first * num_elts_in_block;
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          // convert target_index into an offset in source data
+          size_t source_offset = ComputeOffset(target_index, stride, num_axes);
+
+          // copy
+          DoTransposeSingleBlock(num_elts_in_block, source + source_offset, target_block);
+
+          // increment target_index:
+          IncrementIndex(target_index, target_dims, num_axes);
+          target_block += num_elts_in_block;
+        }
+      });
 }
 
-template <class T>
-inline void CopyPrim(uint8_t* target, const uint8_t* source) {
-  *reinterpret_cast<T*>(target) = *reinterpret_cast<const T*>(source);
+// TypedDoTransposeEltWise: copies source tensor to target one element of type T at a time.
+// The elements are split across the thread pool like the blocks of DoTransposeImpl.
+template <typename T>
+static void TypedDoTransposeEltWise(int64_t num_axes, const std::vector<int64_t>& target_dims, size_t num_blocks,
+                                    const std::vector<size_t>& stride, const T* source, T* target,
+                                    concurrency::ThreadPool* tp) {
+  constexpr auto element_bytes = static_cast<double>(sizeof(T));
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(num_blocks), TensorOpCost{element_bytes, element_bytes, static_cast<double>(num_axes)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        // index used to iterate over target iteration-space
+        std::vector<int64_t> target_index(num_axes, 0);
+        InitializeIndex(target_index, target_dims, num_axes, first);
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          // convert target_index into an offset in source data
+          size_t source_offset = ComputeOffset(target_index, stride, num_axes);
+
+          // copy
+          target[i] = source[source_offset];
+
+          // increment target_index:
+          IncrementIndex(target_index, target_dims, num_axes);
+        }
+      });
 }
 
 // DoTransposeEltWise: specialization of DoTranspose for the num_elts_in_block=1 case.
@@ -95,62 +144,22 @@ inline void CopyPrim(uint8_t* target, const uint8_t* source) {
 // The stride vector indicates the transposition.
 static void DoTransposeEltWise(int64_t num_axes, const std::vector<int64_t>& target_dims, size_t num_blocks,
                                const std::vector<size_t>& stride, const uint8_t* source, uint8_t* target,
-                               size_t element_size) {
-  // index used to iterate over target iteration-space
-  std::vector<int64_t> target_index(num_axes, 0);
-
+                               size_t element_size, concurrency::ThreadPool* tp) {
   switch (element_size) {
     case sizeof(uint64_t):
-      for (size_t i = 0; i < num_blocks; ++i) {
-        // convert target_index into an offset in source data
-        size_t source_offset = ComputeOffset(target_index, stride, num_axes);
-
-        // copy
-        CopyPrim<uint64_t>(target, source + (source_offset * element_size));
-
-        // increment target_index:
-        IncrementIndex(target_index, target_dims, num_axes);
-        target += element_size;
-      }
+      TypedDoTransposeEltWise(num_axes, target_dims, num_blocks, stride, reinterpret_cast<const uint64_t*>(source),
+                              reinterpret_cast<uint64_t*>(target), tp);
       break;
     case sizeof(uint32_t):
-      for (size_t i = 0; i < num_blocks; ++i) {
-        // convert target_index into an offset in source data
-        size_t source_offset = ComputeOffset(target_index, stride, num_axes);
-
-        // copy
-        CopyPrim<uint32_t>(target, source + (source_offset * element_size));
-
-        // increment target_index:
-        IncrementIndex(target_index, target_dims, num_axes);
-        target += element_size;
-      }
+      TypedDoTransposeEltWise(num_axes, target_dims, num_blocks, stride, reinterpret_cast<const uint32_t*>(source),
+                              reinterpret_cast<uint32_t*>(target), tp);
       break;
     case sizeof(uint16_t):
-      for (size_t i = 0; i < num_blocks; ++i) {
-        // convert target_index into an offset in source data
-        size_t source_offset = ComputeOffset(target_index, stride, num_axes);
-
-        // copy
-        CopyPrim<uint16_t>(target, source + (source_offset * element_size));
-
-        // increment target_index:
-        IncrementIndex(target_index, target_dims, num_axes);
-        target += element_size;
-      }
+      TypedDoTransposeEltWise(num_axes, target_dims, num_blocks, stride, reinterpret_cast<const uint16_t*>(source),
+                              reinterpret_cast<uint16_t*>(target), tp);
       break;
     case sizeof(uint8_t):
-      for (size_t i = 0; i < num_blocks; ++i) {
-        // convert target_index into an offset in source data
-        size_t source_offset = ComputeOffset(target_index, stride, num_axes);
-
-        // copy
-        *target = *(source + (source_offset * element_size));
-
-        // increment target_index:
-        IncrementIndex(target_index, target_dims, num_axes);
-        target += element_size;
-      }
+      TypedDoTransposeEltWise(num_axes, target_dims, num_blocks, stride, source, target, tp);
       break;
     default:
       assert(false);
@@ -158,23 +167,13 @@ static void DoTransposeEltWise(int64_t num_axes, const std::vector<int64_t>& tar
 }
 
 static void DoTransposeEltWise(int64_t num_axes, const std::vector<int64_t>& target_dims, size_t num_blocks,
-                               const std::vector<size_t>& stride, const std::string* source, std::string* target) {
-  // index used to iterate over target iteration-space
-  std::vector<int64_t> target_index(num_axes, 0);
-  for (size_t i = 0; i < num_blocks; ++i) {
-    // convert target_index into an offset in source data
-    size_t source_offset = ComputeOffset(target_index, stride, num_axes);
-
-    // copy
-    *target = *(source + source_offset);
-
-    // increment target_index:
-    IncrementIndex(target_index, target_dims, num_axes);
-    target++;
-  }
+                               const std::vector<size_t>& stride, const std::string* source, std::string* target,
+                               concurrency::ThreadPool* tp) {
+  TypedDoTransposeEltWise(num_axes, target_dims, num_blocks, stride, source, target, tp);
 }
 
-static Status DoUntypedTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output) {
+static Status DoUntypedTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
+                                 concurrency::ThreadPool* tp) {
   const auto& input_shape = input.Shape();
   const auto& input_dims = input_shape.GetDims();
   auto rank = input_shape.NumDimensions();
@@ -216,10 +215,10 @@ static Status DoUntypedTranspose(const std::vector<size_t>& permutations, const
       DoTransposeSingleBlock(suffix_blocksize, input_data, output_data);
     } else if (1 == suffix_blocksize) {
       DoTransposeEltWise(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, stride,
-                         input_data, output_data);
+                         input_data, output_data, tp);
     } else {
       DoTransposeImpl(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, suffix_blocksize, stride,
-                      input_data, output_data);
+                      input_data, output_data, tp);
     }
   } else {
     const auto* input_data = reinterpret_cast<const uint8_t*>(input.DataRaw());
@@ -228,10 +227,10 @@ static Status DoUntypedTranspose(const std::vector<size_t>& permutations, const
       DoTransposeSingleBlock(suffix_blocksize, input_data, output_data, element_size);
     } else if (1 == suffix_blocksize) {
       DoTransposeEltWise(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, stride,
-                         input_data, output_data, element_size);
+                         input_data, output_data, element_size, tp);
     } else {
       DoTransposeImpl(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, suffix_blocksize, stride,
-                      input_data, output_data, element_size);
+                      input_data, output_data, element_size, tp);
     }
   }
 
@@ -258,39 +257,90 @@ to the value of the axis being moved.
 This can be generalized for any input where only one axis is being moved, with the block size for each read/write
 being dependent on which axis is moving, what direction it's moving in, and where it's moving to.
 
-We use simple pointer arithmetic if the size of each read/write is a power of 2 and between 8 and 64 bits. 
-We use memcpy if the block size is larger.
+Either way the data of each of the num_loops outer items is a matrix of blocks that is transposed: when moving outwards
+the writers are the columns of the matrix, and when moving inwards the readers are its rows. The matrices are split
+into strips of rows that are transposed in parallel. The MLAS transpose kernels are used if the block size is 8, 16,
+32 or 64 bits. We use memcpy if the block size is larger.
 
 We fall back to the default implementation in all other cases, and if the input is std::string.
 */
 
-// moving a single axis outwards where the read/write size is a power of 2 and between 8 and 64 bits.
-template <typename T>
-static void SimpleTransposeSingleAxisOutwards(const T* input_data, T* output_data,
-                                              int64_t num_loops, int64_t num_writers,
-                                              int64_t writes_per_loop, int64_t writes_per_writer_per_loop) {
-  for (int64_t l = 0; l < num_loops; ++l) {
-    T* output_for_first_writer = output_data;
+// TransposeStrip: transposes num_rows rows of a matrix with num_cols columns of blocks of block_size bytes.
+// The rows of the target matrix hold target_stride blocks.
+static void TransposeStrip(int64_t num_rows, int64_t num_cols, const uint8_t* input_data, uint8_t* output_data,
+                           int64_t target_stride, int64_t block_size) {
+  const auto M = static_cast<size_t>(num_rows);
+  const auto N = static_cast<size_t>(num_cols);
+  const auto ldb = static_cast<size_t>(target_stride);
 
-    for (auto wwpl = 0; wwpl < writes_per_writer_per_loop; ++wwpl) {
-      T* output_for_current_writer = output_for_first_writer;
+  switch (block_size) {
+    case (sizeof(uint8_t)): {
+      MlasTranspose(M, N, input_data, N, output_data, ldb);
+      break;
+    }
+    case (sizeof(uint16_t)): {
+      MlasTranspose(M, N, reinterpret_cast<const uint16_t*>(input_data), N,
+                    reinterpret_cast<uint16_t*>(output_data), ldb);
+      break;
+    }
+    case (sizeof(uint32_t)): {
+      MlasTranspose(M, N, reinterpret_cast<const uint32_t*>(input_data), N,
+                    reinterpret_cast<uint32_t*>(output_data), ldb);
+      break;
+    }
+    case (sizeof(uint64_t)): {
+      MlasTranspose(M, N, reinterpret_cast<const uint64_t*>(input_data), N,
+                    reinterpret_cast<uint64_t*>(output_data), ldb);
+      break;
+    }
+    default: {
+      // we need to use memcpy for each block
+      for (int64_t r = 0; r < num_rows; ++r) {
+        uint8_t* output_for_current_row = output_data + r * block_size;
 
-      for (int64_t w = 0; w < num_writers; ++w) {
-        *output_for_current_writer = *input_data++;
+        for (int64_t c = 0; c < num_cols; ++c) {
+          memcpy(output_for_current_row, input_data, block_size);
+          input_data += block_size;
 
-        // skip to output position for next writer
-        output_for_current_writer += writes_per_writer_per_loop;
+          // skip to output position for next column
+          output_for_current_row += target_stride * block_size;
+        }
       }
-
-      ++output_for_first_writer;
     }
-
-    output_data += writes_per_loop;
   }
 }
 
+// TransposeMatrices: transposes num_matrices consecutive matrices with num_rows rows and num_cols columns of blocks
+// of block_size bytes.
+static void TransposeMatrices(const uint8_t* input_data, uint8_t* output_data, int64_t num_matrices,
+                              int64_t num_rows, int64_t num_cols, int64_t block_size, concurrency::ThreadPool* tp) {
+  // rows transposed by one unit of work. It is a multiple of the tile size of the MLAS transpose kernels.
+  constexpr int64_t rows_per_strip = 16;
+
+  const int64_t strips_per_matrix = (num_rows + rows_per_strip - 1) / rows_per_strip;
+  const int64_t bytes_per_matrix = num_rows * num_cols * block_size;
+  const auto bytes_per_strip = static_cast<double>(std::min(num_rows, rows_per_strip) * num_cols * block_size);
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(num_matrices * strips_per_matrix),
+      TensorOpCost{bytes_per_strip, bytes_per_strip, bytes_per_strip / block_size},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          const int64_t matrix = i / strips_per_matrix;
+          const int64_t first_row = (i % strips_per_matrix) * rows_per_strip;
+          const int64_t strip_rows = std::min(rows_per_strip, num_rows - first_row);
+
+          TransposeStrip(strip_rows, num_cols,
+                         input_data + matrix * bytes_per_matrix + first_row * num_cols * block_size,
+                         output_data + matrix * bytes_per_matrix + first_row * block_size,
+                         num_rows, block_size);
+        }
+      });
+}
+
+// moving a single axis outwards. The input of each loop is a (writes_per_writer_per_loop, num_writers) matrix.
 static void TransposeSingleAxisOutwards(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
-                                        int64_t from, int64_t to) {
+                                        int64_t from, int64_t to, concurrency::ThreadPool* tp) {
   ORT_UNUSED_PARAMETER(permutations);
 
   const auto& input_shape = input.Shape();
@@ -308,80 +358,12 @@ static void TransposeSingleAxisOutwards(const std::vector<size_t>& permutations,
   auto writes_per_writer_per_loop = int64_t(writes_per_loop / num_writers);
   const int64_t bytes_per_write = block_size * element_size;
 
-  switch (bytes_per_write) {
-    case (sizeof(uint8_t)): {
-      SimpleTransposeSingleAxisOutwards(input_data, output_data,
-                                        num_loops, num_writers, writes_per_loop, writes_per_writer_per_loop);
-      break;
-    }
-    case (sizeof(uint16_t)): {
-      SimpleTransposeSingleAxisOutwards(reinterpret_cast<const uint16_t*>(input_data),
-                                        reinterpret_cast<uint16_t*>(output_data),
-                                        num_loops, num_writers, writes_per_loop, writes_per_writer_per_loop);
-      break;
-    }
-    case (sizeof(uint32_t)): {
-      SimpleTransposeSingleAxisOutwards(reinterpret_cast<const uint32_t*>(input_data),
-                                        reinterpret_cast<uint32_t*>(output_data),
-                                        num_loops, num_writers, writes_per_loop, writes_per_writer_per_loop);
-      break;
-    }
-    case (sizeof(uint64_t)): {
-      SimpleTransposeSingleAxisOutwards(reinterpret_cast<const uint64_t*>(input_data),
-                                        reinterpret_cast<uint64_t*>(output_data),
-                                        num_loops, num_writers, writes_per_loop, writes_per_writer_per_loop);
-      break;
-    }
-    default: {
-      // we need to use memcpy for each block
-      for (int64_t l = 0; l < num_loops; ++l) {
-        uint8_t* output_for_first_writer = output_data;
-
-        for (auto wwpl = 0; wwpl < writes_per_writer_per_loop; ++wwpl) {
-          uint8_t* output_for_current_writer = output_for_first_writer;
-
-          for (int64_t w = 0; w < num_writers; ++w) {
-            memcpy(output_for_current_writer, input_data, bytes_per_write);
-            // skip to output position for next writer
-            output_for_current_writer += (writes_per_writer_per_loop * bytes_per_write);
-            input_data += bytes_per_write;
-          }
-
-          output_for_first_writer += bytes_per_write;
-        }
-
-        output_data += writes_per_loop * bytes_per_write;
-      }
-    }
-  }
+  TransposeMatrices(input_data, output_data, num_loops, writes_per_writer_per_loop, num_writers, bytes_per_write, tp);
 }
 
-template <typename T>
-static void SimpleTransposeSingleAxisInwards(const T* input_data, T* output_data,
-                                             int64_t num_loops, int64_t num_readers,
-                                             int64_t reads_per_loop, int64_t reads_per_reader_per_loop) {
-  for (int64_t l = 0; l < num_loops; ++l) {
-    const T* input_for_first_reader = input_data;
-
-    for (auto rrpl = 0; rrpl < reads_per_reader_per_loop; ++rrpl) {
-      const T* input_for_current_reader = input_for_first_reader;
-
-      for (int64_t r = 0; r < num_readers; ++r) {
-        *output_data++ = *input_for_current_reader;
-        // skip to input position for next reader
-        input_for_current_reader += reads_per_reader_per_loop;
-      }
-
-      ++input_for_first_reader;
-    }
-
-    input_data += reads_per_loop;
-  }
-}
-
-// moving a single axis inwards where the read/write size is a power of 2 and between 8 and 64 bits.
+// moving a single axis inwards. The input of each loop is a (num_readers, reads_per_reader_per_loop) matrix.
 static void TransposeSingleAxisInwards(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
-                                       int64_t from, int64_t to) {
+                                       int64_t from, int64_t to, concurrency::ThreadPool* tp) {
   ORT_UNUSED_PARAMETER(permutations);
 
   const auto& input_shape = input.Shape();
@@ -399,61 +381,15 @@ static void TransposeSingleAxisInwards(const std::vector<size_t>& permutations,
   auto reads_per_reader_per_loop = int64_t(reads_per_loop / num_readers);
   const int64_t bytes_per_read = block_size * element_size;
 
-  switch (bytes_per_read) {
-    case (sizeof(uint8_t)): {
-      SimpleTransposeSingleAxisInwards(input_data, output_data,
-                                       num_loops, num_readers, reads_per_loop, reads_per_reader_per_loop);
-      break;
-    }
-    case (sizeof(uint16_t)): {
-      SimpleTransposeSingleAxisInwards(reinterpret_cast<const uint16_t*>(input_data),
-                                       reinterpret_cast<uint16_t*>(output_data),
-                                       num_loops, num_readers, reads_per_loop, reads_per_reader_per_loop);
-      break;
-    }
-    case (sizeof(uint32_t)): {
-      SimpleTransposeSingleAxisInwards(reinterpret_cast<const uint32_t*>(input_data),
-                                       reinterpret_cast<uint32_t*>(output_data),
-                                       num_loops, num_readers, reads_per_loop, reads_per_reader_per_loop);
-      break;
-    }
-    case (sizeof(uint64_t)): {
-      SimpleTransposeSingleAxisInwards(reinterpret_cast<const uint64_t*>(input_data),
-                                       reinterpret_cast<uint64_t*>(output_data),
-                                       num_loops, num_readers, reads_per_loop, reads_per_reader_per_loop);
-      break;
-    }
-    default: {
-      // we need to use memcpy for each block
-      for (int64_t l = 0; l < num_loops; ++l) {
-        const uint8_t* input_for_first_reader = input_data;
-
-        for (auto rrpl = 0; rrpl < reads_per_reader_per_loop; ++rrpl) {
-          const uint8_t* input_for_current_reader = input_for_first_reader;
-
-          for (int64_t r = 0; r < num_readers; ++r) {
-            memcpy(output_data, input_for_current_reader, bytes_per_read);
-            output_data += bytes_per_read;
-
-            // skip to input position for next reader
-            input_for_current_reader += (reads_per_reader_per_loop * bytes_per_read);
-          }
-
-          input_for_first_reader += bytes_per_read;
-        }
-
-        input_data += reads_per_loop * bytes_per_read;
-      }
-    }
-  }
+  TransposeMatrices(input_data, output_data, num_loops, num_readers, reads_per_reader_per_loop, bytes_per_read, tp);
 }
 
 static void SingleAxisTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
-                                size_t from, size_t to) {
+                                size_t from, size_t to, concurrency::ThreadPool* tp) {
   if (from > to) {
-    TransposeSingleAxisOutwards(permutations, input, output, from, to);
+    TransposeSingleAxisOutwards(permutations, input, output, from, to, tp);
   } else {
-    TransposeSingleAxisInwards(permutations, input, output, from, to);
+    TransposeSingleAxisInwards(permutations, input, output, from, to, tp);
   }
 }
 
@@ -526,7 +462,8 @@ static bool IsMovingSingleAxis(const std::vector<size_t>& permutations, size_t&
   return single_axis_moved;
 }
 
-Status TransposeBase::DoTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output) {
+Status TransposeBase::DoTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
+                                  concurrency::ThreadPool* tp) {
   Status status = Status::OK();
 
   auto input_type = input.DataType();
@@ -540,10 +477,10 @@ Status TransposeBase::DoTranspose(const std::vector<size_t>& permutations, const
     bool moving_single_axis = IsMovingSingleAxis(permutations, from, to);
 
     if (moving_single_axis && !input.IsDataTypeString()) {
-      SingleAxisTranspose(permutations, input, output, from, to);
+      SingleAxisTranspose(permutations, input, output, from, to, tp);
     } else {
       // fall back to default implementation
-      status = DoUntypedTranspose(permutations, input, output);
+      status = DoUntypedTranspose(permutations, input, output, tp);
     }
   }
 
@@ -571,17 +508,7 @@ Status Transpose::Compute(OpKernelContext* ctx) const {
   if (output_shape.Size() == 0)
     return Status::OK();
 
-  size_t from = 0, to = 0;
-  bool moving_single_axis = IsMovingSingleAxis(*p_perm, from, to);
-
-  if (moving_single_axis && !X.IsDataTypeString()) {
-    SingleAxisTranspose(*p_perm, X, Y, from, to);
-  } else {
-    // fall back to default implementation
-    status = DoUntypedTranspose(*p_perm, X, Y);
-  }
-
-  return status;
+  return DoTranspose(*p_perm, X, Y, ctx->GetOperatorThreadPool());
 }
 
 ONNX_CPU_OPERATOR_KERNEL(
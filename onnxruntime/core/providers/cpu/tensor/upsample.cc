@@ -2,7 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/tensor/upsample.h"
-#include "core/common/safeint.h"
+#include "core/platform/threadpool.h"
 #include <sstream>
 
 using namespace onnxruntime::common;
@@ -278,6 +278,199 @@ Status UpsampleLinear(const T* input,
   return Status::OK();
 }
 
+// Interpolation table of one dimension for the separable linear and cubic modes. Every output index
+// is a weighted sum of 'Taps' input indices, which are clamped to the input range.
+template <size_t Taps>
+struct InterpolationTable {
+  std::vector<int64_t> index;
+  std::vector<float> weight;
+  // true if the original coordinate of the output index is outside of the input range
+  std::vector<bool> outside;
+
+  explicit InterpolationTable(int64_t output_length)
+      : index(static_cast<size_t>(output_length) * Taps),
+        weight(static_cast<size_t>(output_length) * Taps),
+        outside(static_cast<size_t>(output_length)) {}
+};
+
+static InterpolationTable<2> ComputeLinearInterpolationTable(int64_t output_length,
+                                                             int64_t input_length,
+                                                             float scale,
+                                                             float roi_start,
+                                                             float roi_end,
+                                                             GetOriginalCoordinateFunc get_original_coordinate) {
+  InterpolationTable<2> table(output_length);
+  for (int64_t o = 0; o < output_length; ++o) {
+    float in = get_original_coordinate(static_cast<float>(o), scale,
+                                       static_cast<float>(output_length), static_cast<float>(input_length),
+                                       roi_start, roi_end);
+    table.outside[o] = in < 0 || in > static_cast<float>(input_length - 1);
+    in = std::max(0.0f, std::min(in, static_cast<float>(input_length - 1)));
+
+    const int64_t in1 = std::min(static_cast<int64_t>(in), input_length - 1);
+    const int64_t in2 = std::min(in1 + 1, input_length - 1);
+    float d1 = std::fabs(in - in1);
+    float d2 = std::fabs(in - in2);
+    if (in1 == in2) {
+      d1 = 0.5f;
+      d2 = 0.5f;
+    }
+
+    table.index[2 * o] = in1;
+    table.index[2 * o + 1] = in2;
+    table.weight[2 * o] = d2;
+    table.weight[2 * o + 1] = d1;
+  }
+  return table;
+}
+
+// Calculates cubic coeff based on Robert Keys approach
+// https://ieeexplore.ieee.org/document/1163711
+std::array<float, CubicModeGridLength> GetCubicCoeffs(float s, float cubic_coeff_a = -0.75) {
+  auto abs_s = std::abs(s);
+  std::array<float, CubicModeGridLength> coeffs;
+  coeffs[0] = static_cast<float>(((cubic_coeff_a * (abs_s + 1) - 5 * cubic_coeff_a) * (abs_s + 1) + 8 * cubic_coeff_a) * (abs_s + 1) - 4 * cubic_coeff_a);
+  coeffs[1] = static_cast<float>(((cubic_coeff_a + 2) * abs_s - (cubic_coeff_a + 3)) * abs_s * abs_s + 1);
+  coeffs[2] = static_cast<float>(((cubic_coeff_a + 2) * (1 - abs_s) - (cubic_coeff_a + 3)) * (1 - abs_s) * (1 - abs_s) + 1);
+  coeffs[3] = static_cast<float>(((cubic_coeff_a * (2 - abs_s) - 5 * cubic_coeff_a) * (2 - abs_s) + 8 * cubic_coeff_a) * (2 - abs_s) - 4 * cubic_coeff_a);
+  return coeffs;
+}
+
+static InterpolationTable<CubicModeGridLength> ComputeCubicInterpolationTable(
+    int64_t output_length,
+    int64_t input_length,
+    float scale,
+    float roi_start,
+    float roi_end,
+    float cubic_coeff_a,
+    bool exclude_outside,
+    GetOriginalCoordinateFunc get_original_coordinate) {
+  InterpolationTable<CubicModeGridLength> table(output_length);
+  for (int64_t o = 0; o < output_length; ++o) {
+    const float in = get_original_coordinate(static_cast<float>(o), scale,
+                                             static_cast<float>(output_length), static_cast<float>(input_length),
+                                             roi_start, roi_end);
+    table.outside[o] = in < 0 || in > static_cast<float>(input_length - 1);
+
+    const auto in_int = static_cast<int64_t>(std::floor(in));
+    auto coeffs = GetCubicCoeffs(in - in_int, cubic_coeff_a);
+    float coeff_sum = 1;
+
+    if (exclude_outside) {
+      // When true, the weight of sampling locations outside the grid will be set to 0
+      // and the weight will be renormalized so that their sum is 1.0
+      coeff_sum = 0;
+      for (int64_t i = 0, in_val = in_int - 1; in_val <= in_int + 2; in_val++, i++) {
+        if (in_val < 0 || in_val >= input_length) {
+          coeffs[i] = 0.0f;
+        }
+        coeff_sum += coeffs[i];
+      }
+    }
+
+    // the 4 samples are taken from 1 before to 2 after the original coordinate, clamped to the input
+    for (int64_t i = 0, in_val = in_int - 1; in_val <= in_int + 2; in_val++, i++) {
+      table.index[CubicModeGridLength * o + i] = std::max(static_cast<int64_t>(0), std::min(in_val, input_length - 1));
+      table.weight[CubicModeGridLength * o + i] = coeffs[i] / coeff_sum;
+    }
+  }
+  return table;
+}
+
+// Resizes the innermost 2 dimensions of 'num_channels' images in two separable passes. The input rows
+// are first interpolated along the width into a per-thread cache, and each output row is then a weighted
+// sum of 'Taps' cached rows. The output rows are produced in order, so the input rows needed by an output
+// row are consecutive and never evict each other from the cache, while consecutive output rows that read
+// the same input rows (as when upsampling) interpolate them only once.
+// The output rows of all the channels are split across the thread pool.
+template <typename T, size_t Taps>
+void ResizeSeparable(int64_t num_channels,
+                     int64_t input_height,
+                     int64_t input_width,
+                     int64_t output_height,
+                     int64_t output_width,
+                     const InterpolationTable<Taps>& y_table,
+                     const InterpolationTable<Taps>& x_table,
+                     bool use_extrapolation,
+                     float extrapolation_value,
+                     const T* Xdata,
+                     T* Ydata,
+                     concurrency::ThreadPool* tp) {
+  const int64_t input_size = input_height * input_width;
+  const int64_t output_size = output_height * output_width;
+  const int64_t* x_index = x_table.index.data();
+  const float* x_weight = x_table.weight.data();
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(num_channels * output_height),
+      TensorOpCost{static_cast<double>(Taps * output_width * sizeof(T)),
+                   static_cast<double>(output_width * sizeof(T)),
+                   static_cast<double>(4 * Taps * output_width)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<float> cached_rows(Taps * static_cast<size_t>(output_width));
+        std::array<int64_t, Taps> cached_row_index;
+        int64_t cached_channel = -1;
+
+        for (std::ptrdiff_t output_row = first; output_row < last; ++output_row) {
+          const int64_t channel = output_row / output_height;
+          const int64_t y = output_row % output_height;
+          T* Yrow = Ydata + channel * output_size + y * output_width;
+
+          // when use_extrapolation is set and original index of y is out of the dim range
+          // then use extrapolation_value as the output value.
+          if (use_extrapolation && y_table.outside[y]) {
+            std::fill_n(Yrow, output_width, static_cast<T>(extrapolation_value));
+            continue;
+          }
+
+          if (channel != cached_channel) {
+            cached_row_index.fill(-1);
+            cached_channel = channel;
+          }
+
+          // Interpolate the input rows along the width, unless they are cached already
+          const float* rows[Taps];
+          for (size_t i = 0; i < Taps; ++i) {
+            const int64_t in_y = y_table.index[Taps * y + i];
+            const size_t slot = static_cast<size_t>(in_y) % Taps;
+            float* row = cached_rows.data() + slot * output_width;
+            if (cached_row_index[slot] != in_y) {
+              const T* Xrow = Xdata + channel * input_size + in_y * input_width;
+              for (int64_t x = 0; x < output_width; ++x) {
+                float value = 0;
+                for (size_t j = 0; j < Taps; ++j) {
+                  value += x_weight[Taps * x + j] * Xrow[x_index[Taps * x + j]];
+                }
+                row[x] = value;
+              }
+              cached_row_index[slot] = in_y;
+            }
+            rows[i] = row;
+          }
+
+          // Interpolate the cached rows along the height
+          const float* y_weight = y_table.weight.data() + Taps * y;
+          for (int64_t x = 0; x < output_width; ++x) {
+            float value = 0;
+            for (size_t i = 0; i < Taps; ++i) {
+              value += y_weight[i] * rows[i][x];
+            }
+            Yrow[x] = static_cast<T>(value);
+          }
+
+          // when use_extrapolation is set and original index of x is out of the dim range
+          // then use extrapolation_value as the output value.
+          if (use_extrapolation) {
+            for (int64_t x = 0; x < output_width; ++x) {
+              if (x_table.outside[x]) {
+                Yrow[x] = static_cast<T>(extrapolation_value);
+              }
+            }
+          }
+        }
+      });
+}
+
 // The following method supports a 4-D input in 'Linear mode'
 // that amounts to 'Bilinear' Upsampling/Resizing in the sense that it assumes
 // the scale values for the outermost 2 dimensions are 1.
@@ -297,150 +490,20 @@ void UpsampleBilinear(int64_t batch_size,
                       float extrapolation_value,
                       const T* Xdata,
                       T* Ydata,
-                      AllocatorPtr& alloc,
-                      GetOriginalCoordinateFunc get_original_coordinate) {
-  std::vector<float> y_original;
-  std::vector<float> x_original;
-
-  SafeInt<size_t> idx_buffer_size = SafeInt<size_t>(2) * sizeof(int64_t) * (output_height + output_width);
-  SafeInt<size_t> scale_buffer_size = SafeInt<size_t>(2) * sizeof(float_t) * (output_height + output_width);
-  auto inx_scale_data_buffer = alloc->Alloc(idx_buffer_size + scale_buffer_size);
-  BufferUniquePtr idx_scale_data_buffer_holder(inx_scale_data_buffer, BufferDeleter(alloc));
-  auto* idx_data = static_cast<int64_t*>(idx_scale_data_buffer_holder.get());
-  int64_t* input_width_mul_y1 = idx_data;
-  int64_t* input_width_mul_y2 = idx_data + output_height;
-  int64_t* in_x1 = idx_data + 2 * output_height;
-  int64_t* in_x2 = idx_data + 2 * output_height + output_width;
-
-  auto* scale_data = reinterpret_cast<float*>(in_x2 + output_width);
-  float* dy1 = scale_data;
-  float* dy2 = scale_data + output_height;
-  float* dx1 = scale_data + 2 * output_height;
-  float* dx2 = scale_data + 2 * output_height + output_width;
-
+                      GetOriginalCoordinateFunc get_original_coordinate,
+                      concurrency::ThreadPool* tp) {
   auto roi_y_start = roi.size() / 2 - 2;
   auto roi_y_end = roi.size() - 2;
-  for (int64_t y = 0; y < output_height; ++y) {
-    float in_y = get_original_coordinate(static_cast<float>(y), height_scale,
-                                         static_cast<float>(output_height), static_cast<float>(input_height),
-                                         roi[roi_y_start], roi[roi_y_end]);
-    y_original.emplace_back(in_y);
-    in_y = std::max(0.0f, std::min(in_y, static_cast<float>(input_height - 1)));
-
-    const int64_t in_y1 = std::min(static_cast<int64_t>(in_y), input_height - 1);
-    const int64_t in_y2 = std::min(in_y1 + 1, input_height - 1);
-    dy1[y] = std::fabs(in_y - in_y1);
-    dy2[y] = std::fabs(in_y - in_y2);
-
-    if (in_y1 == in_y2) {
-      dy1[y] = 0.5f;
-      dy2[y] = 0.5f;
-    }
-
-    input_width_mul_y1[y] = input_width * in_y1;
-    input_width_mul_y2[y] = input_width * in_y2;
-  }
-
   auto roi_x_start = roi.size() / 2 - 1;
   auto roi_x_end = roi.size() - 1;
-  for (int64_t x = 0; x < output_width; ++x) {
-    float in_x = get_original_coordinate(static_cast<float>(x), width_scale,
-                                         static_cast<float>(output_width), static_cast<float>(input_width),
-                                         roi[roi_x_start], roi[roi_x_end]);
-    x_original.emplace_back(in_x);
-    in_x = std::max(0.0f, std::min(in_x, static_cast<float>(input_width - 1)));
-
-    in_x1[x] = std::min(static_cast<int64_t>(in_x), input_width - 1);
-    in_x2[x] = std::min(in_x1[x] + 1, input_width - 1);
-
-    dx1[x] = std::abs(in_x - in_x1[x]);
-    dx2[x] = std::abs(in_x - in_x2[x]);
-    if (in_x1[x] == in_x2[x]) {
-      dx1[x] = 0.5f;
-      dx2[x] = 0.5f;
-    }
-  }
-
-  for (int64_t n = 0; n < batch_size; ++n) {
-    for (int64_t c = 0; c < num_channels; ++c) {
-      for (int64_t y = 0; y < output_height; ++y) {
-        for (int64_t x = 0; x < output_width; ++x) {
-          // when use_extrapolation is set and original index of x or y is out of the dim range
-          // then use extrapolation_value as the output value.
-          if (use_extrapolation &&
-              ((y_original[y] < 0 || y_original[y] > static_cast<float>(input_height - 1)) ||
-               (x_original[x] < 0 || x_original[x] > static_cast<float>(input_width - 1)))) {
-            Ydata[output_width * y + x] = static_cast<T>(extrapolation_value);
-            continue;
-          }
-
-          T X11 = Xdata[input_width_mul_y1[y] + in_x1[x]];
-          T X21 = Xdata[input_width_mul_y1[y] + in_x2[x]];
-          T X12 = Xdata[input_width_mul_y2[y] + in_x1[x]];
-          T X22 = Xdata[input_width_mul_y2[y] + in_x2[x]];
-
-          Ydata[output_width * y + x] = static_cast<T>(dx2[x] * dy2[y] * X11 +
-                                                       dx1[x] * dy2[y] * X21 +
-                                                       dx2[x] * dy1[y] * X12 +
-                                                       dx1[x] * dy1[y] * X22);
-        }
-      }
-      Xdata += input_height * input_width;
-      Ydata += output_width * output_height;
-    }
-  }
-}
-
-// Calculates cubic coeff based on Robert Keys approach
-// https://ieeexplore.ieee.org/document/1163711
-std::array<float, CubicModeGridLength> GetCubicCoeffs(float s, float cubic_coeff_a = -0.75) {
-  auto abs_s = std::abs(s);
-  std::array<float, CubicModeGridLength> coeffs;
-  coeffs[0] = static_cast<float>(((cubic_coeff_a * (abs_s + 1) - 5 * cubic_coeff_a) * (abs_s + 1) + 8 * cubic_coeff_a) * (abs_s + 1) - 4 * cubic_coeff_a);
-  coeffs[1] = static_cast<float>(((cubic_coeff_a + 2) * abs_s - (cubic_coeff_a + 3)) * abs_s * abs_s + 1);
-  coeffs[2] = static_cast<float>(((cubic_coeff_a + 2) * (1 - abs_s) - (cubic_coeff_a + 3)) * (1 - abs_s) * (1 - abs_s) + 1);
-  coeffs[3] = static_cast<float>(((cubic_coeff_a * (2 - abs_s) - 5 * cubic_coeff_a) * (2 - abs_s) + 8 * cubic_coeff_a) * (2 - abs_s) - 4 * cubic_coeff_a);
-  return coeffs;
-}
 
-// Get the tensor data at the requested coordinate
-template <typename T>
-T GetDataForCoordinate(const T* Xdata,
-                       int64_t x, int64_t y,
-                       int64_t input_height, int64_t input_width) {
-  x = std::max(static_cast<int64_t>(0), std::min(x, input_width - 1));
-  y = std::max(static_cast<int64_t>(0), std::min(y, input_height - 1));
-  return Xdata[y * input_width + x];
-}
+  const auto y_table = ComputeLinearInterpolationTable(output_height, input_height, height_scale,
+                                                       roi[roi_y_start], roi[roi_y_end], get_original_coordinate);
+  const auto x_table = ComputeLinearInterpolationTable(output_width, input_width, width_scale,
+                                                       roi[roi_x_start], roi[roi_x_end], get_original_coordinate);
 
-// Computes cubic convolution interpolation in 1D
-template <typename T>
-float CubicInterpolation1D(const T* Xdata,
-                           int64_t x,
-                           int64_t y,
-                           int64_t input_height,
-                           int64_t input_width,
-                           std::array<float, CubicModeGridLength>& coeff_array,
-                           float coeff_sum,
-                           std::unordered_map<int64_t, float>& cache) {
-  // When calculating cubic interpolation we move the 4*4 grid across the original data and therefore there is
-  // opportunity to cache the results for previously seen combinations.
-  // Check if the result is already available in the cache
-  auto grid_start_pos = (y)*input_width + (x - 1);
-  if (cache.find(grid_start_pos) != cache.end()) {
-    return cache[grid_start_pos];
-  }
-
-  // get the neighbors in 1D and find interpolation for this dimension
-  // for 1D cubic interpolation 4 samples are used. 2 on the left and 2 on the right of x
-  float result = 0;
-  for (int i = 0, j = -1; i < static_cast<int>(CubicModeGridLength); i++, j++) {
-    auto orig_data = GetDataForCoordinate(Xdata, x + j, y, input_height, input_width);
-    result += coeff_array[i] / coeff_sum * orig_data;
-  }
-  cache[grid_start_pos] = result;
-
-  return result;
+  ResizeSeparable<T, 2>(batch_size * num_channels, input_height, input_width, output_height, output_width,
+                        y_table, x_table, use_extrapolation, extrapolation_value, Xdata, Ydata, tp);
 }
 
 template <typename T>
@@ -460,125 +523,23 @@ void ResizeBiCubic(
     const std::vector<float>& roi,
     const T* Xdata,
     T* Ydata,
-    GetOriginalCoordinateFunc get_original_coordinate) {
-  std::vector<float> y_original;
-  std::vector<float> x_original;
-  std::unordered_map<float, std::array<float, CubicModeGridLength>> cubic_coeffs;
-  std::unordered_map<float, std::unordered_map<int64_t, float>> coeff_to_1Dinterpolation_map;
+    GetOriginalCoordinateFunc get_original_coordinate,
+    concurrency::ThreadPool* tp) {
   auto roi_y_start = roi.size() / 2 - 2;
   auto roi_y_end = roi.size() - 2;
   auto roi_x_start = roi.size() / 2 - 1;
   auto roi_x_end = roi.size() - 1;
 
-  // generate coefficients in y direction
-  for (int64_t y = 0; y < output_height; ++y) {
-    float in_y = get_original_coordinate(static_cast<float>(y), height_scale,
-                                         static_cast<float>(output_height), static_cast<float>(input_height),
-                                         roi[roi_y_start], roi[roi_y_end]);
-    y_original.emplace_back(in_y);
-    auto s = y_original[y] - std::floor(y_original[y]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
-    }
-  }
-
-  // generate coefficients in x direction
-  for (int64_t x = 0; x < output_width; ++x) {
-    float in_x = get_original_coordinate(static_cast<float>(x), width_scale,
-                                         static_cast<float>(output_width), static_cast<float>(input_width),
-                                         roi[roi_x_start], roi[roi_x_end]);
-    x_original.emplace_back(in_x);
-    auto s = x_original[x] - std::floor(x_original[x]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
-    }
-  }
-
-  // setup up temp arrays to hold coefficients when exclude_outside is set to true
-  std::array<float, CubicModeGridLength> y_coeff_holder;
-  std::array<float, CubicModeGridLength> x_coeff_holder;
-  float y_coeff_sum = 1;
-  float x_coeff_sum = 1;
-
-  for (int64_t n = 0; n < batch_size; n++) {
-    for (int64_t c = 0; c < num_channels; c++) {
-      for (int64_t y = 0; y < output_height; ++y) {
-        auto in_y = y_original[y];
-
-        // when use_extrapolation is set and original index is out of the dim range
-        // then use extrapolation_value as the output value.
-        if (use_extrapolation && (in_y < 0 || in_y > static_cast<float>(input_height - 1))) {
-          for (int64_t x = 0; x < output_width; ++x) {
-            Ydata[y * output_width + x] = extrapolation_value;
-          }
-          continue;
-        }
-
-        auto y_int = static_cast<int64_t>(std::floor(in_y));
-        auto& coeff_y = exclude_outside ? y_coeff_holder : cubic_coeffs[in_y - y_int];
-        y_coeff_sum = 1;
-
-        if (exclude_outside) {
-          // When true, the weight of sampling locations outside the grid will be set to 0
-          // and the weight will be renormalized so that their sum is 1.0
-          y_coeff_sum = 0;
-          auto& orig_y_coeffs = cubic_coeffs[in_y - y_int];
-          for (int64_t i = 0, y_val = y_int - 1; y_val <= y_int + 2; y_val++, i++) {
-            y_coeff_holder[i] = (y_val < 0 || y_val >= static_cast<float>(input_height)) ? 0.0f : orig_y_coeffs[i];
-            y_coeff_sum += y_coeff_holder[i];
-          }
-        }
-
-        for (int64_t x = 0; x < output_width; ++x) {
-          auto in_x = x_original[x];
+  const auto y_table = ComputeCubicInterpolationTable(output_height, input_height, height_scale,
+                                                      roi[roi_y_start], roi[roi_y_end], cubic_coeff_a,
+                                                      exclude_outside, get_original_coordinate);
+  const auto x_table = ComputeCubicInterpolationTable(output_width, input_width, width_scale,
+                                                      roi[roi_x_start], roi[roi_x_end], cubic_coeff_a,
+                                                      exclude_outside, get_original_coordinate);
 
-          // when use_extrapolation is set and original index is out of the dim range
-          // then use extrapolation_value as the output value.
-          if (use_extrapolation && (in_x < 0 || in_x > static_cast<float>(input_width - 1))) {
-            Ydata[y * output_width + x] = extrapolation_value;
-            continue;
-          }
-
-          auto x_int = static_cast<int64_t>(std::floor(in_x));
-          auto s_x = static_cast<float>(in_x - x_int);
-          auto& coeff_x = exclude_outside ? x_coeff_holder : cubic_coeffs[s_x];
-          x_coeff_sum = 1;
-
-          if (exclude_outside) {
-            // When true, the weight of sampling locations outside the grid will be set to 0
-            // and the weight will be renormalized so that their sum is 1.0
-            x_coeff_sum = 0;
-            auto& orig_x_coeff = cubic_coeffs[s_x];
-            for (int64_t i = 0, x_val = x_int - 1; x_val <= x_int + 2; x_val++, i++) {
-              x_coeff_holder[i] = (x_val < 0 || x_val >= static_cast<float>(input_width)) ? 0.0f : orig_x_coeff[i];
-              x_coeff_sum += x_coeff_holder[i];
-            }
-          }
-
-          // Compute cubic interpolation in x dimension using the x coefficients.
-          // From the result of cubic interpolation in x dim, compute cubic interpolation in y dimension
-          auto& interpolation_result_cache = coeff_to_1Dinterpolation_map[s_x];
-          float result = 0;
-          for (int64_t y_val = y_int - 1, i = 0; y_val <= y_int + 2; y_val++, i++) {
-            auto x_interpolation_result = CubicInterpolation1D(Xdata, x_int, y_val,
-                                                               input_height, input_width, coeff_x, x_coeff_sum,
-                                                               interpolation_result_cache);
-            result += x_interpolation_result * coeff_y[i] / y_coeff_sum;
-          }
-
-          Ydata[y * output_width + x] = static_cast<T>(result);
-        }
-      }
-
-      Xdata += input_height * input_width;
-      Ydata += output_height * output_width;
-
-      // clear the cache when moving to the next channel
-      coeff_to_1Dinterpolation_map.clear();
-    }
-  }
+  ResizeSeparable<T, CubicModeGridLength>(batch_size * num_channels, input_height, input_width,
+                                          output_height, output_width, y_table, x_table,
+                                          use_extrapolation, extrapolation_value, Xdata, Ydata, tp);
 }
 
 template <typename T>
@@ -636,12 +597,10 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
       const int64_t output_height = is_2D ? output_dims[0] : output_dims[2];
       const int64_t output_width = is_2D ? output_dims[1] : output_dims[3];
 
-      AllocatorPtr alloc;
-      ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
       UpsampleBilinear(batch_size, num_channels, input_height, input_width, output_height, output_width,
                        is_2D ? scales[0] : scales[2], is_2D ? scales[1] : scales[3], roi,
                        use_extrapolation_, extrapolation_value_, X->template Data<T>(),
-                       Y->template MutableData<T>(), alloc, get_original_coordinate_);
+                       Y->template MutableData<T>(), get_original_coordinate_, context->GetOperatorThreadPool());
       return Status::OK();
     }
     case UpsampleMode::CUBIC: {
@@ -656,7 +615,7 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
       ResizeBiCubic(batch_size, num_channels, input_height, input_width, output_height, output_width,
                     is_2D ? scales[0] : scales[2], is_2D ? scales[1] : scales[3], cubic_coeff_a_, use_extrapolation_,
                     extrapolation_value_, exclude_outside_, roi, X->template Data<float>(), Y->template MutableData<float>(),
-                    get_original_coordinate_);
+                    get_original_coordinate_, context->GetOperatorThreadPool());
       return Status::OK();
     }
     default:
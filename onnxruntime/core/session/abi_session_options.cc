@@ -160,3 +160,41 @@ ORT_API_STATUS_IMPL(OrtApis::DisablePerSessionThreads, _In_ OrtSessionOptions* o
   options->value.use_per_session_threads = false;
   return nullptr;
 }
+
+ORT_API_STATUS_IMPL(OrtApis::EnableMmapModelLoading, _In_ OrtSessionOptions* options) {
+  options->value.use_mmap_for_model_loading = true;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::EnableColumnarZipMapOutput, _In_ OrtSessionOptions* options) {
+  options->value.use_columnar_zipmap_output = true;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::EnableCpuArenaThreadCache, _In_ OrtSessionOptions* options) {
+  options->value.enable_cpu_arena_thread_cache = true;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SetArenaExtendStrategy, _Inout_ OrtSessionOptions* options,
+                    OrtArenaExtendStrategy strategy) {
+  switch (strategy) {
+    case ORT_ARENA_EXTEND_NEXT_POWER_OF_TWO:
+    case ORT_ARENA_EXTEND_SAME_AS_REQUESTED:
+      options->value.cpu_arena_extend_strategy = strategy;
+      return nullptr;
+    default:
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "arena_extend_strategy is not valid");
+  }
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SetArenaShrinkHighWatermark, _Inout_ OrtSessionOptions* options, size_t bytes) {
+  options->value.arena_shrink_high_watermark = bytes;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SetOptimizedSessionStateFilePath, _Inout_ OrtSessionOptions* options,
+                    _In_ const ORTCHAR_T* path) {
+  options->value.optimized_session_state_filepath = path;
+  return nullptr;
+}
@@ -0,0 +1,167 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/columnar_zipmap_output.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+#include "core/graph/constants.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+
+namespace onnxruntime {
+
+namespace {
+
+// collect the names of the values consumed by the nodes of the graph, including the nodes of any subgraphs
+// as those may consume values from the outer scope.
+void CollectConsumedValues(const GraphProto& graph, std::unordered_set<std::string>& consumed_values) {
+  for (const auto& node : graph.node()) {
+    consumed_values.insert(node.input().cbegin(), node.input().cend());
+
+    for (const auto& attribute : node.attribute()) {
+      if (attribute.has_g()) {
+        CollectConsumedValues(attribute.g(), consumed_values);
+      }
+
+      for (const auto& subgraph : attribute.graphs()) {
+        CollectConsumedValues(subgraph, consumed_values);
+      }
+    }
+  }
+}
+
+void CollectValueNames(const GraphProto& graph, std::unordered_set<std::string>& names) {
+  const auto add_value_info_names = [&names](const google::protobuf::RepeatedPtrField<ValueInfoProto>& values) {
+    for (const auto& value : values) {
+      names.insert(value.name());
+    }
+  };
+
+  add_value_info_names(graph.input());
+  add_value_info_names(graph.output());
+  add_value_info_names(graph.value_info());
+
+  for (const auto& initializer : graph.initializer()) {
+    names.insert(initializer.name());
+  }
+
+  for (const auto& node : graph.node()) {
+    names.insert(node.output().cbegin(), node.output().cend());
+  }
+}
+
+const AttributeProto* FindAttribute(const NodeProto& node, const std::string& name) {
+  auto entry = std::find_if(node.attribute().cbegin(), node.attribute().cend(),
+                            [&name](const AttributeProto& attribute) { return attribute.name() == name; });
+  return entry != node.attribute().cend() ? &*entry : nullptr;
+}
+
+}  // namespace
+
+bool HasColumnarZipMapOutputs(const ModelProto& model_proto) {
+  return std::any_of(model_proto.metadata_props().cbegin(), model_proto.metadata_props().cend(),
+                     [](const StringStringEntryProto& prop) {
+                       return prop.key() == kColumnarZipMapOutputMetadataKey;
+                     });
+}
+
+Status ConvertZipMapOutputsToColumnar(ModelProto& model_proto) {
+  if (HasColumnarZipMapOutputs(model_proto)) {
+    return Status::OK();
+  }
+
+  GraphProto& graph = *model_proto.mutable_graph();
+  bool converted = false;
+
+  std::unordered_set<std::string> consumed_values;
+  CollectConsumedValues(graph, consumed_values);
+
+  std::unordered_set<std::string> value_names;
+  CollectValueNames(graph, value_names);
+
+  for (auto& node : *graph.mutable_node()) {
+    if (node.op_type() != "ZipMap" || node.domain() != kMLDomain ||
+        node.input_size() != 1 || node.output_size() != 1) {
+      continue;
+    }
+
+    const std::string output_name = node.output(0);
+    if (consumed_values.find(output_name) != consumed_values.cend()) {
+      continue;
+    }
+
+    auto* graph_outputs = graph.mutable_output();
+    auto graph_output = std::find_if(graph_outputs->begin(), graph_outputs->end(),
+                                     [&output_name](const ValueInfoProto& value) {
+                                       return value.name() == output_name;
+                                     });
+    if (graph_output == graph_outputs->end()) {
+      continue;
+    }
+
+    // leave invalid nodes alone so the ZipMap kernel reports the error
+    const auto* string_labels = FindAttribute(node, "classlabels_strings");
+    const auto* int64_labels = FindAttribute(node, "classlabels_int64s");
+    const bool using_strings = string_labels != nullptr && string_labels->strings_size() > 0;
+    const bool using_int64s = int64_labels != nullptr && int64_labels->ints_size() > 0;
+    if (using_strings == using_int64s) {
+      continue;
+    }
+
+    const std::string labels_name = output_name + "_labels";
+    if (!value_names.insert(labels_name).second) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Can't return the class labels of ZipMap node '",
+                             node.name(), "' in the output '", labels_name,
+                             "' as the model already contains a value with that name.");
+    }
+
+    // the probabilities are returned as is
+    graph_output->clear_type();
+    graph_output->mutable_type()->mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+
+    auto* value_info = graph.mutable_value_info();
+    value_info->erase(std::remove_if(value_info->begin(), value_info->end(),
+                                     [&output_name](const ValueInfoProto& value) {
+                                       return value.name() == output_name;
+                                     }),
+                      value_info->end());
+
+    // the labels are returned from an initializer
+    TensorProto& labels = *graph.add_initializer();
+    labels.set_name(labels_name);
+    if (using_strings) {
+      labels.set_data_type(TensorProto_DataType_STRING);
+      labels.add_dims(string_labels->strings_size());
+      *labels.mutable_string_data() = string_labels->strings();
+    } else {
+      labels.set_data_type(TensorProto_DataType_INT64);
+      labels.add_dims(int64_labels->ints_size());
+      *labels.mutable_int64_data() = int64_labels->ints();
+    }
+
+    // add the output last so the index of the existing outputs doesn't change
+    ValueInfoProto& labels_output = *graph.add_output();
+    labels_output.set_name(labels_name);
+    auto& labels_type = *labels_output.mutable_type()->mutable_tensor_type();
+    labels_type.set_elem_type(labels.data_type());
+    labels_type.mutable_shape()->add_dim()->set_dim_value(labels.dims(0));
+
+    node.set_op_type("Identity");
+    node.clear_domain();
+    node.clear_attribute();
+    converted = true;
+  }
+
+  if (converted) {
+    StringStringEntryProto& prop = *model_proto.add_metadata_props();
+    prop.set_key(kColumnarZipMapOutputMetadataKey);
+    prop.set_value("1");
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
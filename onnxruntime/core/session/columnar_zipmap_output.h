@@ -0,0 +1,36 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/graph/onnx_protobuf.h"
+
+namespace onnxruntime {
+
+/**
+Changes the ZipMap nodes that produce a graph output of the model so that the output is returned in columnar form
+instead of as a sequence of maps with one map per row. This is used when SessionOptions::use_columnar_zipmap_output
+is set.
+
+For a ZipMap node with input X producing the graph output Z:
+  - Z becomes a float tensor with the probabilities in X, so they are never exploded into per-row maps.
+  - the class labels are added as a 1D int64 or string tensor in a new graph output named "<Z>_labels".
+    It is backed by an initializer so the same tensor is returned by every run.
+    The order of the labels matches the order of the columns of Z.
+
+ZipMap nodes whose output is consumed by another node, or is not a graph output, are left unchanged.
+
+If any output is changed, the model is marked with the kColumnarZipMapOutputMetadataKey metadata property. The
+rewritten outputs are part of any model saved from the session, i.e. the optimized model written to
+SessionOptions::optimized_model_filepath and the saved session state, and the mark is used to reject loading such
+a model in a session without use_columnar_zipmap_output. Converting a model that is already marked does nothing.
+*/
+common::Status ConvertZipMapOutputsToColumnar(ONNX_NAMESPACE::ModelProto& model_proto);
+
+constexpr const char* kColumnarZipMapOutputMetadataKey = "onnxruntime.columnar_zipmap_output";
+
+// Returns true if the outputs of 'model_proto' were changed by ConvertZipMapOutputsToColumnar.
+bool HasColumnarZipMapOutputs(const ONNX_NAMESPACE::ModelProto& model_proto);
+
+}  // namespace onnxruntime
@@ -4,6 +4,7 @@
 #include "core/graph/onnx_protobuf.h"
 #include "core/session/inference_session.h"
 
+#include <algorithm>
 #include <memory>
 #include <sstream>
 #include <unordered_set>
@@ -12,6 +13,8 @@
 #include <thread>
 
 #include "core/common/logging/logging.h"
+#include "core/common/path.h"
+#include "core/common/path_string.h"
 #include "core/platform/threadpool.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/graph_utils.h"
@@ -26,6 +29,7 @@
 #include "core/framework/kernel_def_builder.h"
 #include "core/framework/kernel_registry.h"
 #include "core/framework/ort_value_pattern_planner.h"
+#include "core/framework/saved_session_state.h"
 #include "core/framework/mldata_type_utils.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/session_state_initializer.h"
@@ -42,6 +46,7 @@
 #include "core/providers/dml/DmlExecutionProvider/src/GraphTransformer.h"
 #endif
 #include "core/session/IOBinding.h"
+#include "core/session/columnar_zipmap_output.h"
 #include "core/session/custom_ops.h"
 #include "core/util/protobuf_parsing_utils.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
@@ -218,6 +223,7 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
                                                               session_options_.execution_mode == ExecutionMode::ORT_SEQUENTIAL,
                                                           GetIntraOpThreadPoolToUse(),
                                                           GetInterOpThreadPoolToUse());
+  session_state_->SetMemoryPatternCachePolicy(session_options_.mem_pattern_cache_policy);
   session_state_->SetLogger(*session_logger_);
   session_state_->SetDataTransferMgr(&data_transfer_mgr_);
   session_profiler_.Initialize(session_logger_);
@@ -245,7 +251,8 @@ InferenceSession::InferenceSession(const SessionOptions& session_options,
     : graph_transformation_mgr_(session_options.max_num_graph_transformation_steps),
       insert_cast_transformer_("CastFloat16Transformer") {
   model_location_ = ToWideString(model_uri);
-  auto status = Model::Load(model_location_, model_proto_);
+  auto status = session_options.use_mmap_for_model_loading ? Model::LoadMapped(model_location_, model_proto_)
+                                                           : Model::Load(model_location_, model_proto_);
   ORT_ENFORCE(status.IsOK(), "Given model could not be parsed while creating inference session. Error message: ",
               status.ErrorMessage());
   model_loaded_ = true;
@@ -260,7 +267,8 @@ InferenceSession::InferenceSession(const SessionOptions& session_options,
     : graph_transformation_mgr_(session_options.max_num_graph_transformation_steps),
       insert_cast_transformer_("CastFloat16Transformer") {
   model_location_ = ToWideString(model_uri);
-  auto status = Model::Load(model_location_, model_proto_);
+  auto status = session_options.use_mmap_for_model_loading ? Model::LoadMapped(model_location_, model_proto_)
+                                                           : Model::Load(model_location_, model_proto_);
   ORT_ENFORCE(status.IsOK(), "Given model could not be parsed while creating inference session. Error message: ",
               status.ErrorMessage());
   model_loaded_ = true;
@@ -426,6 +434,22 @@ common::Status InferenceSession::Load(std::function<common::Status(std::shared_p
   return status;
 }
 
+common::Status InferenceSession::LoadModelFromProto(ModelProto&& model_proto, const PathString& model_path,
+                                                    std::shared_ptr<Model>& model) {
+  if (session_options_.use_columnar_zipmap_output) {
+    ORT_RETURN_IF_ERROR(ConvertZipMapOutputsToColumnar(model_proto));
+  } else if (HasColumnarZipMapOutputs(model_proto)) {
+    // an optimized model or session state saved by a session with the option has the rewritten outputs
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "The model was saved by a session with use_columnar_zipmap_output and returns the ZipMap "
+                           "outputs in columnar form. Enable use_columnar_zipmap_output to load it, or load the "
+                           "original model.");
+  }
+
+  return onnxruntime::Model::Load(std::move(model_proto), model_path, model,
+                                  HasLocalSchema() ? &custom_schema_registries_ : nullptr, *session_logger_);
+}
+
 template <typename T>
 common::Status InferenceSession::Load(const std::basic_string<T>& model_uri) {
   model_location_ = ToWideString(model_uri);
@@ -436,8 +460,16 @@ common::Status InferenceSession::Load(const std::basic_string<T>& model_uri) {
       AddCustomOpDomains({domain.get()});
     }
 #endif
-    return onnxruntime::Model::Load(model_location_, model, HasLocalSchema() ? &custom_schema_registries_ : nullptr,
-                                    *session_logger_);
+    ModelProto model_proto;
+    if (SavedSessionState::IsSavedSessionStateFile(model_location_)) {
+      ORT_RETURN_IF_ERROR(SavedSessionState::Load(model_location_, model_proto, saved_session_state_));
+    } else if (session_options_.use_mmap_for_model_loading) {
+      ORT_RETURN_IF_ERROR(onnxruntime::Model::LoadMapped(model_location_, model_proto));
+    } else {
+      ORT_RETURN_IF_ERROR(onnxruntime::Model::Load(model_location_, model_proto));
+    }
+
+    return LoadModelFromProto(std::move(model_proto), model_location_, model);
   };
 
   common::Status st = Load(loader, "model_loading_uri");
@@ -485,9 +517,9 @@ common::Status InferenceSession::Load(const ModelProto& model_proto) {
       AddCustomOpDomains({domain.get()});
     }
 #endif
-    // This call will create a copy of model_proto and the constructed model instance will own the copy thereafter
-    return onnxruntime::Model::Load(model_proto, PathString(), model,
-                                    HasLocalSchema() ? &custom_schema_registries_ : nullptr, *session_logger_);
+    // The constructed model instance will own this copy of model_proto
+    ModelProto model_proto_copy{model_proto};
+    return LoadModelFromProto(std::move(model_proto_copy), PathString(), model);
   };
 
   return Load(loader, "model_loading_proto");
@@ -507,8 +539,7 @@ common::Status InferenceSession::Load(std::unique_ptr<ModelProto> p_model_proto)
       AddCustomOpDomains({domain.get()});
     }
 #endif
-    return onnxruntime::Model::Load(std::move(*p_model_proto), PathString(), model,
-                                    HasLocalSchema() ? &custom_schema_registries_ : nullptr, *session_logger_);
+    return LoadModelFromProto(std::move(*p_model_proto), PathString(), model);
   };
 
   return Load(loader, "model_loading_proto");
@@ -536,8 +567,7 @@ common::Status InferenceSession::Load(std::istream& model_istream) {
       AddCustomOpDomains({domain.get()});
     }
 #endif
-    return onnxruntime::Model::Load(std::move(model_proto), PathString(), model,
-                                    HasLocalSchema() ? &custom_schema_registries_ : nullptr, *session_logger_);
+    return LoadModelFromProto(std::move(model_proto), PathString(), model);
   };
 
   return Load(loader, "model_loading_istream");
@@ -565,8 +595,7 @@ common::Status InferenceSession::Load(const void* model_data, int model_data_len
     }
 #endif
 
-    return onnxruntime::Model::Load(std::move(model_proto), PathString(), model,
-                                    HasLocalSchema() ? &custom_schema_registries_ : nullptr, *session_logger_);
+    return LoadModelFromProto(std::move(model_proto), PathString(), model);
   };
 
   return Load(loader, "model_loading_array");
@@ -587,8 +616,7 @@ common::Status InferenceSession::Load() {
     }
 #endif
     // Pass on ownership of the parsed ModelProto to the Model instance (its job here is done by this stage)
-    return Model::Load(std::move(this->model_proto_), model_location_, model,
-                       HasLocalSchema() ? &custom_schema_registries_ : nullptr, *session_logger_);
+    return LoadModelFromProto(std::move(this->model_proto_), model_location_, model);
   };
 
   return Load(loader, "model_loading_from_saved_proto");
@@ -709,6 +737,7 @@ common::Status InferenceSession::CreateSubgraphSessionState(Graph& graph, Sessio
       auto subgraph_session_state =
           onnxruntime::make_unique<SessionState>(execution_providers_, session_state.GetEnableMemoryPattern(),
                                                  session_state.GetThreadPool(), session_state.GetInterOpThreadPool());
+      subgraph_session_state->SetMemoryPatternCachePolicy(session_state.GetMemoryPatternCachePolicy());
       subgraph_session_state->SetProfiler(session_profiler_);
       subgraph_session_state->SetLogger(*session_logger_);
       // Pass data transfer manager to subgraph.
@@ -756,7 +785,8 @@ common::Status InferenceSession::InitializeSubgraphSessions(Graph& graph, Sessio
 
       // setup everything required to execute the subgraph and save it in subgraph_session_state
       SessionStateInitializer initializer(session_options_.enable_mem_pattern, model_location_, subgraph,
-                                          *subgraph_session_state, execution_providers_, kernel_registry_manager_);
+                                          *subgraph_session_state, execution_providers_, kernel_registry_manager_,
+                                          session_options_.use_mmap_for_model_loading);
 
       const auto implicit_inputs = node.ImplicitInputDefs();
       ORT_RETURN_IF_ERROR_SESSIONID_(initializer.CreatePlan(&node, &implicit_inputs, session_options_.execution_mode));
@@ -846,6 +876,8 @@ common::Status InferenceSession::Initialize() {
     if (!execution_providers_.Get(onnxruntime::kCpuExecutionProvider)) {
       LOGS(*session_logger_, INFO) << "Adding default CPU execution provider.";
       CPUExecutionProviderInfo epi{session_options_.enable_cpu_mem_arena};
+      epi.arena_extend_strategy = session_options_.cpu_arena_extend_strategy;
+      epi.arena_use_thread_cache = session_options_.enable_cpu_arena_thread_cache;
       auto p_cpu_exec_provider = onnxruntime::make_unique<CPUExecutionProvider>(epi);
       ORT_RETURN_IF_ERROR_SESSIONID_(RegisterExecutionProvider(std::move(p_cpu_exec_provider)));
     }
@@ -876,16 +908,30 @@ common::Status InferenceSession::Initialize() {
     ORT_RETURN_IF_ERROR_SESSIONID_(kernel_registry_manager_.RegisterKernels(execution_providers_));
 
     SessionStateInitializer session_initializer(session_options_.enable_mem_pattern, model_location_, graph,
-                                                *session_state_, execution_providers_, kernel_registry_manager_);
+                                                *session_state_, execution_providers_, kernel_registry_manager_,
+                                                session_options_.use_mmap_for_model_loading);
+
+    // a model loaded from a saved session state is already optimized and partitioned
+    if (saved_session_state_) {
+      auto restore_status = saved_session_state_->AssignNodes(graph, execution_providers_);
+      if (!restore_status.IsOK()) {
+        LOGS(*session_logger_, WARNING) << "The saved session state can't be used with this session, "
+                                           "the model will be optimized again. "
+                                        << restore_status.ErrorMessage();
+        saved_session_state_.reset();
+      }
+    }
 
-    // create SessionState for subgraphs as it's needed by the transformers
-    ORT_RETURN_IF_ERROR_SESSIONID_(CreateSubgraphSessionState(graph, *session_state_));
+    if (!saved_session_state_) {
+      // create SessionState for subgraphs as it's needed by the transformers
+      ORT_RETURN_IF_ERROR_SESSIONID_(CreateSubgraphSessionState(graph, *session_state_));
 
-    // apply any transformations to the main graph and any subgraphs
-    ORT_RETURN_IF_ERROR_SESSIONID_(TransformGraph(graph, graph_transformation_mgr_,
-                                                  execution_providers_, kernel_registry_manager_,
-                                                  insert_cast_transformer_,
-                                                  *session_state_));
+      // apply any transformations to the main graph and any subgraphs
+      ORT_RETURN_IF_ERROR_SESSIONID_(TransformGraph(graph, graph_transformation_mgr_,
+                                                    execution_providers_, kernel_registry_manager_,
+                                                    insert_cast_transformer_,
+                                                    *session_state_));
+    }
 
     // now that all the transforms are done, call Resolve on the main graph. this will recurse into the subgraphs.
     ORT_RETURN_IF_ERROR_SESSIONID_(graph.Resolve());
@@ -897,17 +943,45 @@ common::Status InferenceSession::Initialize() {
         LOGS(*session_logger_, WARNING) << "Serializing Optimized ONNX model with Graph Optimization"
                                            " level greater than ORT_ENABLE_EXTENDED. The generated"
                                            " model may contain hardware and execution provider specific"
-                                           " optimizations, and should only be used in the same environment"
-                                           " the model was optimized for.";
+                                           " optimizations, such as weights reordered for the NCHWc layout of"
+                                           " this CPU, and should only be used in the same environment and on"
+                                           " the same hardware the model was optimized for.";
       }
     }
 
-    ORT_RETURN_IF_ERROR_SESSIONID_(session_initializer.CreatePlan(nullptr, nullptr, session_options_.execution_mode));
+    // take the optimized model for the saved session state. the initializers are removed from the graph by
+    // CreatePlan. it is released once the state has been saved, so the weights aren't held twice.
+    std::unique_ptr<ModelProto> optimized_model;
+    if (!session_options_.optimized_session_state_filepath.empty()) {
+      optimized_model = onnxruntime::make_unique<ModelProto>(model_->ToProto());
+    }
+
+    ORT_RETURN_IF_ERROR_SESSIONID_(session_initializer.CreatePlan(nullptr, nullptr, session_options_.execution_mode,
+                                                                  saved_session_state_.get()));
+    if (saved_session_state_) {
+      if (session_options_.enable_mem_pattern) {
+        ORT_RETURN_IF_ERROR_SESSIONID_(saved_session_state_->RestoreMemoryPatterns(*session_state_));
+      }
+      saved_session_state_.reset();
+    }
 
     // handle any subgraphs
     ORT_RETURN_IF_ERROR_SESSIONID_(InitializeSubgraphSessions(graph, *session_state_));
     is_inited_ = true;
 
+    if (optimized_model) {
+      ORT_RETURN_IF_ERROR_SESSIONID_(SaveSessionState(session_options_.optimized_session_state_filepath,
+                                                      *optimized_model));
+      optimized_model.reset();
+      if (session_options_.graph_optimization_level >= TransformerLevel::Level3) {
+        LOGS(*session_logger_, WARNING) << "Saving the session state with Graph Optimization level greater than "
+                                           "ORT_ENABLE_EXTENDED. The saved state may contain weights reordered "
+                                           "for the NCHWc layout of this CPU, which are specific to its hardware "
+                                           "as well as to this build, and should only be loaded on the same "
+                                           "hardware and build it was saved on.";
+      }
+    }
+
     // and log telemetry
     bool model_has_fp16_inputs = ModelHasFP16Inputs(graph);
     env.GetTelemetryProvider().LogSessionCreation(
@@ -944,6 +1018,95 @@ const SessionOptions& InferenceSession::GetSessionOptions() const {
   return session_options_;
 }
 
+MemoryPatternCacheStats InferenceSession::GetMemoryPatternCacheStats() const {
+  return session_state_ ? session_state_->GetMemoryPatternCacheStats() : MemoryPatternCacheStats{};
+}
+
+common::Status InferenceSession::GetArenaStats(const OrtMemoryInfo& mem_info, AllocatorStats& stats) const {
+  auto allocator = execution_providers_.GetAllocator(mem_info);
+  auto* arena = dynamic_cast<IArenaAllocator*>(allocator.get());
+  if (arena == nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "No arena allocator found for ", mem_info.ToString());
+  }
+
+  arena->GetStats(&stats);
+  return Status::OK();
+}
+
+common::Status InferenceSession::SaveSessionState(const std::basic_string<ORTCHAR_T>& path) const {
+  if (!is_inited_) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Session was not initialized.");
+  }
+
+  if (session_options_.optimized_session_state_filepath.empty()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
+                           "Saving the session state requires optimized_session_state_filepath to be set "
+                           "in the session options.");
+  }
+
+  // the optimized model isn't kept by the session, read it back from the state saved by Initialize
+  ModelProto optimized_model;
+  std::unique_ptr<SavedSessionState> saved_state;
+  ORT_RETURN_IF_ERROR(SavedSessionState::Load(session_options_.optimized_session_state_filepath, optimized_model,
+                                              saved_state));
+  return SaveSessionState(path, optimized_model);
+}
+
+// the directory the relative paths of external initializers are resolved against when loading the model at 'path'
+static common::Status GetModelDirectory(const PathString& path, PathString& directory) {
+  Path parsed_path;
+  ORT_RETURN_IF_ERROR(Path::Parse(path, parsed_path));
+  Path parent = parsed_path.ParentPath();
+  directory = parent.IsEmpty() ? PathString{ORT_TSTR(".")} : parent.Normalize().ToPathString();
+  return Status::OK();
+}
+
+common::Status InferenceSession::SaveSessionState(const std::basic_string<ORTCHAR_T>& path,
+                                                  const ModelProto& optimized_model) const {
+  const auto& initializers = optimized_model.graph().initializer();
+  const bool has_external_initializers =
+      std::any_of(initializers.cbegin(), initializers.cend(), [](const TensorProto& initializer) {
+        return initializer.data_location() == TensorProto_DataLocation_EXTERNAL;
+      });
+  if (has_external_initializers) {
+    PathString model_directory;
+    PathString state_directory;
+    ORT_RETURN_IF_ERROR(GetModelDirectory(model_location_, model_directory));
+    ORT_RETURN_IF_ERROR(GetModelDirectory(path, state_directory));
+    if (model_directory != state_directory) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The model has initializers in external files, which are ",
+                             "resolved relative to the directory of the saved session state. It must be saved in ",
+                             ToMBString(model_directory), " instead of ", ToMBString(state_directory), ".");
+    }
+  }
+
+  return SavedSessionState::Save(path, optimized_model, *session_state_);
+}
+
+common::Status InferenceSession::ShrinkMemoryArenas(size_t high_watermark) {
+  for (auto& xp : execution_providers_) {
+    for (const auto& allocator : xp->GetAllocators()) {
+      const auto& info = allocator->Info();
+      auto arena = std::dynamic_pointer_cast<IArenaAllocator>(xp->GetAllocator(info.id, info.mem_type));
+      if (arena == nullptr) {
+        continue;
+      }
+
+      if (high_watermark > 0) {
+        AllocatorStats stats;
+        arena->GetStats(&stats);
+        if (static_cast<size_t>(stats.total_allocated_bytes) <= high_watermark) {
+          continue;
+        }
+      }
+
+      ORT_RETURN_IF_ERROR(arena->Shrink());
+    }
+  }
+
+  return Status::OK();
+}
+
 common::Status InferenceSession::CheckShapes(const std::string& input_name, const TensorShape& input_shape,
                                              const TensorShape& expected_shape) const {
   auto input_shape_sz = input_shape.NumDimensions();
@@ -1148,6 +1311,13 @@ Status InferenceSession::Run(const RunOptions& run_options, const std::vector<st
     ORT_CHECK_AND_SET_RETVAL(utils::ExecuteGraph(*session_state_, feeds_fetches_manager, feeds, *p_fetches,
                                                  session_options_.execution_mode, run_options.terminate, run_logger));
 
+    // the execution frame has been released, so every chunk still in use is a fetch or an initializer
+    if (run_options.shrink_memory_arenas) {
+      ORT_CHECK_AND_SET_RETVAL(ShrinkMemoryArenas());
+    } else if (session_options_.arena_shrink_high_watermark > 0) {
+      ORT_CHECK_AND_SET_RETVAL(ShrinkMemoryArenas(session_options_.arena_shrink_high_watermark));
+    }
+
   } catch (const std::exception& e) {
     retval = Status(common::ONNXRUNTIME, common::FAIL, e.what());
   } catch (...) {
@@ -10,6 +10,7 @@
 #include "core/common/logging/logging.h"
 #include "core/common/profiler.h"
 #include "core/common/status.h"
+#include "core/framework/arena.h"
 #include "core/framework/execution_providers.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/iexecutor.h"
@@ -46,6 +47,7 @@ namespace onnxruntime {
 class IExecutionProvider;  // forward decl
 class IOBinding;
 class CustomRegistry;
+class SavedSessionState;
 struct Notification;
 
 namespace logging {
@@ -317,6 +319,32 @@ class InferenceSession {
    */
   const SessionOptions& GetSessionOptions() const;
 
+  /*
+   * Get the hit, miss and eviction counts of the memory pattern cache of the main graph.
+   */
+  MemoryPatternCacheStats GetMemoryPatternCacheStats() const;
+
+  /*
+   * Get the statistics of the arena allocator used for the memory described by mem_info.
+   * @return OK if the allocator for mem_info is an arena, an error otherwise.
+   */
+  common::Status GetArenaStats(const OrtMemoryInfo& mem_info, AllocatorStats& stats) const;
+
+  /*
+   * Return the memory that is not in use by the arena allocators of the registered execution providers
+   * to their devices. Only arenas that have allocated more than high_watermark bytes are shrunk;
+   * 0 shrinks every arena.
+   */
+  common::Status ShrinkMemoryArenas(size_t high_watermark = 0);
+
+  /*
+   * Save the initialized session state, including the memory patterns cached by the runs so far, to path.
+   * Loading the file instead of the model skips graph optimization, partitioning and planning.
+   * Requires SessionOptions::optimized_session_state_filepath to have been set when the session was initialized.
+   * The optimized model isn't kept in memory, it is read back from the state saved by Initialize().
+   */
+  common::Status SaveSessionState(const std::basic_string<ORTCHAR_T>& path) const;
+
   /**
     * Start profiling on this inference session. This simply turns on profiling events to be
     * recorded. A corresponding EndProfiling has to follow to write profiling data to a file.
@@ -394,6 +422,15 @@ class InferenceSession {
 
   common::Status Load(std::function<common::Status(std::shared_ptr<Model>&)> loader, const std::string& event_name);
 
+  // Saves the session state with 'optimized_model', the model taken after graph transformation, to 'path'.
+  common::Status SaveSessionState(const std::basic_string<ORTCHAR_T>& path,
+                                  const ONNX_NAMESPACE::ModelProto& optimized_model) const;
+
+  // Create the Model from a parsed ModelProto after applying the changes to the model requested by the
+  // session options.
+  common::Status LoadModelFromProto(ONNX_NAMESPACE::ModelProto&& model_proto, const PathString& model_path,
+                                    std::shared_ptr<Model>& model);
+
   common::Status TransformGraph(onnxruntime::Graph& graph,
                                 const onnxruntime::GraphTransformerManager& graph_transformer_mgr,
                                 const ExecutionProviders& providers,
@@ -546,6 +583,9 @@ class InferenceSession {
   // used to hold the ModelProto parsed in an applicable ctor to be used while calling parameter-less Load()
   ONNX_NAMESPACE::ModelProto model_proto_;
 
+  // the state read when the model was loaded from a saved session state. released once it has been applied.
+  std::unique_ptr<SavedSessionState> saved_session_state_;
+
   bool model_loaded_ = false;
 };
 }  // namespace onnxruntime
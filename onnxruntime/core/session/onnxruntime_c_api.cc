@@ -693,6 +693,39 @@ ORT_API_STATUS_IMPL(OrtApis::SessionGetModelMetadata, _In_ const OrtSession* ses
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::SessionSaveState, _In_ const OrtSession* sess, _In_ const ORTCHAR_T* path) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+  return ToOrtStatus(session->SaveSessionState(path));
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SessionGetArenaStats, _In_ const OrtSession* sess, _In_ const OrtMemoryInfo* mem_info,
+                    _Out_ OrtArenaStats* out) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+  AllocatorStats stats;
+  auto status = session->GetArenaStats(*mem_info, stats);
+  if (!status.IsOK())
+    return ToOrtStatus(status);
+
+  out->num_allocs = stats.num_allocs;
+  out->bytes_in_use = stats.bytes_in_use;
+  out->total_allocated_bytes = stats.total_allocated_bytes;
+  out->max_bytes_in_use = stats.max_bytes_in_use;
+  out->max_alloc_size = stats.max_alloc_size;
+  out->bytes_limit = stats.bytes_limit;
+  out->num_arena_extensions = stats.num_arena_extensions;
+  out->bytes_in_thread_caches = stats.bytes_in_thread_caches;
+  out->num_thread_cache_hits = stats.num_thread_cache_hits;
+  out->num_lock_contentions = stats.num_lock_contentions;
+  out->lock_wait_ns = stats.lock_wait_ns;
+  out->free_bytes = stats.free_bytes;
+  out->largest_free_block = stats.largest_free_block;
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtApis::ModelMetadataGetProducerName,
                     _In_ const OrtModelMetadata* model_metadata,
                     _Inout_ OrtAllocator* allocator, _Outptr_ char** value) {
@@ -1515,7 +1548,16 @@ static constexpr OrtApi ort_api_1_to_3 = {
     &OrtApis::CreateEnvWithGlobalThreadPools,
     &OrtApis::DisablePerSessionThreads,
     &OrtApis::CreateThreadingOptions,
-    &OrtApis::ReleaseThreadingOptions};
+    &OrtApis::ReleaseThreadingOptions,
+    &OrtApis::EnableMmapModelLoading,
+    &OrtApis::SessionGetArenaStats,
+    &OrtApis::RunOptionsSetArenaShrinkage,
+    &OrtApis::SetArenaExtendStrategy,
+    &OrtApis::SetArenaShrinkHighWatermark,
+    &OrtApis::SetOptimizedSessionStateFilePath,
+    &OrtApis::SessionSaveState,
+    &OrtApis::EnableColumnarZipMapOutput,
+    &OrtApis::EnableCpuArenaThreadCache};
 
 // Assert to do a limited check to ensure Version 1 of OrtApi never changes (will detect an addition or deletion but not if they cancel out each other)
 // If this assert hits, read the above 'Rules on how to add a new Ort API version'
@@ -185,4 +185,14 @@ ORT_ALL_ARGS_NONNULL;
 ORT_API_STATUS_IMPL(DisablePerSessionThreads, _In_ OrtSessionOptions* options);
 ORT_API_STATUS_IMPL(CreateThreadingOptions, _Outptr_ OrtThreadingOptions** out);
 ORT_API(void, ReleaseThreadingOptions, _Frees_ptr_opt_ OrtThreadingOptions*);
+ORT_API_STATUS_IMPL(EnableMmapModelLoading, _In_ OrtSessionOptions* options);
+ORT_API_STATUS_IMPL(SessionGetArenaStats, _In_ const OrtSession* sess, _In_ const OrtMemoryInfo* mem_info,
+                    _Out_ OrtArenaStats* out);
+ORT_API_STATUS_IMPL(RunOptionsSetArenaShrinkage, _Inout_ OrtRunOptions* options, int value);
+ORT_API_STATUS_IMPL(SetArenaExtendStrategy, _Inout_ OrtSessionOptions* options, OrtArenaExtendStrategy strategy);
+ORT_API_STATUS_IMPL(SetArenaShrinkHighWatermark, _Inout_ OrtSessionOptions* options, size_t bytes);
+ORT_API_STATUS_IMPL(SetOptimizedSessionStateFilePath, _Inout_ OrtSessionOptions* options, _In_ const ORTCHAR_T* path);
+ORT_API_STATUS_IMPL(SessionSaveState, _In_ const OrtSession* sess, _In_ const ORTCHAR_T* path);
+ORT_API_STATUS_IMPL(EnableColumnarZipMapOutput, _In_ OrtSessionOptions* options);
+ORT_API_STATUS_IMPL(EnableCpuArenaThreadCache, _In_ OrtSessionOptions* options);
 }  // namespace OrtApis
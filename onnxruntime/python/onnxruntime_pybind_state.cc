@@ -558,6 +558,10 @@ void addObjectMethods(py::module& m, Environment& env) {
       .value("ORT_SEQUENTIAL", ExecutionMode::ORT_SEQUENTIAL)
       .value("ORT_PARALLEL", ExecutionMode::ORT_PARALLEL);
 
+  py::enum_<OrtArenaExtendStrategy>(m, "ArenaExtendStrategy")
+      .value("ORT_ARENA_EXTEND_NEXT_POWER_OF_TWO", OrtArenaExtendStrategy::ORT_ARENA_EXTEND_NEXT_POWER_OF_TWO)
+      .value("ORT_ARENA_EXTEND_SAME_AS_REQUESTED", OrtArenaExtendStrategy::ORT_ARENA_EXTEND_SAME_AS_REQUESTED);
+
   py::class_<SessionOptions>
       sess(m, "SessionOptions", R"pbdoc(Configuration information for a session.)pbdoc");
   sess
@@ -569,8 +573,28 @@ Set this option to false if you don't want it. Default is True.)pbdoc")
                      R"pbdoc(Enable profiling for this session. Default is false.)pbdoc")
       .def_readwrite("optimized_model_filepath", &SessionOptions::optimized_model_filepath,
                      R"pbdoc(File path to serialize optimized model. By default, optimized model is not serialized if optimized_model_filepath is not provided.)pbdoc")
+      .def_readwrite("optimized_session_state_filepath", &SessionOptions::optimized_session_state_filepath,
+                     R"pbdoc(File path to save the initialized session state to. A session created from that file
+skips graph optimization, partitioning and planning. By default, the session state is not saved.)pbdoc")
       .def_readwrite("enable_mem_pattern", &SessionOptions::enable_mem_pattern,
                      R"pbdoc(Enable the memory pattern optimization. Default is true.)pbdoc")
+      .def_readwrite("use_mmap_for_model_loading", &SessionOptions::use_mmap_for_model_loading,
+                     R"pbdoc(Memory-map the model file and use large initializers in place instead of copying them.
+The model file must not be modified while the session is alive. Default is false.)pbdoc")
+      .def_readwrite("use_columnar_zipmap_output", &SessionOptions::use_columnar_zipmap_output,
+                     R"pbdoc(Return the output of ZipMap nodes as a float tensor with the probabilities, plus a tensor
+with the class labels in an additional output named '<output name>_labels', instead of as a list of dictionaries.
+An optimized model saved by such a session keeps these outputs and can only be loaded with this option.
+Default is false.)pbdoc")
+      .def_readwrite("cpu_arena_extend_strategy", &SessionOptions::cpu_arena_extend_strategy,
+                     R"pbdoc(How the CPU memory arena grows. ORT_ARENA_EXTEND_SAME_AS_REQUESTED limits each new region
+to the size of the request. Default is ORT_ARENA_EXTEND_NEXT_POWER_OF_TWO.)pbdoc")
+      .def_readwrite("enable_cpu_arena_thread_cache", &SessionOptions::enable_cpu_arena_thread_cache,
+                     R"pbdoc(Give each thread allocating from the CPU memory arena a cache of small freed chunks, so
+concurrent runs of a shared session don't serialize on the arena lock. Default is false.)pbdoc")
+      .def_readwrite("arena_shrink_high_watermark", &SessionOptions::arena_shrink_high_watermark,
+                     R"pbdoc(At the end of each run, return the unused memory of the arenas holding more than
+this many bytes. Default is 0, which disables the check.)pbdoc")
       .def_readwrite("logid", &SessionOptions::session_logid,
                      R"pbdoc(Logger id to use for session output.)pbdoc")
       .def_readwrite("log_severity_level", &SessionOptions::session_log_severity_level,
@@ -647,7 +671,10 @@ Applies to a particular Run() invocation. Default is 0.)pbdoc")
                      "To identify logs generated by a particular Run() invocation.")
       .def_readwrite("terminate", &RunOptions::terminate,
                      R"pbdoc(Set to True to terminate any currently executing calls that are using this
-RunOptions instance. The individual calls will exit gracefully and return an error status.)pbdoc");
+RunOptions instance. The individual calls will exit gracefully and return an error status.)pbdoc")
+      .def_readwrite("shrink_memory_arenas", &RunOptions::shrink_memory_arenas,
+                     R"pbdoc(Set to True to return the unused memory of the session's arenas at the end of the run.
+Default is False.)pbdoc");
 
   py::class_<ModelMetadata>(m, "ModelMetadata", R"pbdoc(Pre-defined and custom metadata about the model.
 It is usually used to identify the model used to run the prediction and
@@ -792,6 +819,9 @@ including arg name, arg type (contains both type and shape).)pbdoc")
       .def("end_profiling", [](InferenceSession* sess) -> std::string {
         return sess->EndProfiling();
       })
+      .def("save_session_state", [](const InferenceSession* sess, const std::basic_string<ORTCHAR_T>& path) -> void {
+        OrtPybindThrowIfError(sess->SaveSessionState(path));
+      })
       .def("get_providers", [](InferenceSession* sess) -> const std::vector<std::string>& {
         return sess->GetRegisteredProviderTypes();
       })
@@ -161,3 +161,12 @@ class InferenceSession:
         :meth:`onnxruntime.SessionOptions.enable_profiling`.
         """
         return self._sess.end_profiling()
+
+    def save_session_state(self, path):
+        """
+        Save the session state, including the memory patterns of the runs so far, to a file
+        that can be loaded instead of the model.
+
+        Requires :meth:`onnxruntime.SessionOptions.optimized_session_state_filepath` to be set.
+        """
+        self._sess.save_session_state(path)
@@ -16,6 +16,7 @@ __producer__ = "onnx.quantize"
 __version__ = "0.1.0"
 onnx_domain = "ai.onnx"
 onnx_op_set_version = 11
+ms_domain = "com.microsoft"
 
 type_to_name = {
     1: "FLOAT",
@@ -36,8 +37,17 @@ type_to_name = {
 }
 
 # Quantization mode
-# IntegerOps: Use IntegerOps in quantized model. Only ConvInteger and MatMulInteger ops are supported now.
-# QLinearOps: Use QLinearOps in quantized model. Only QLinearConv and QLinearMatMul ops are supported now.
+# IntegerOps: Use IntegerOps in quantized model. Only ConvInteger and MatMulInteger ops, and the QAttention and
+#             QEmbedLayerNormalization contrib ops are supported now.
+# QLinearOps: Use QLinearOps in quantized model. Only QLinearConv and QLinearMatMul ops, and the QLinearAdd,
+#             QLinearMul, QLinearAveragePool and QLinearReduceMean contrib ops are supported now.
+
+
+# Ops which are replaced by the com.microsoft QLinear contrib op of the same name in QLinearOps mode.
+qlinear_contrib_op_types = ['Add', 'Mul', 'AveragePool', 'ReduceMean']
+
+# com.microsoft BERT ops which are replaced by their quantized version in IntegerOps mode.
+integer_contrib_op_types = {'Attention': 'QAttention', 'EmbedLayerNormalization': 'QEmbedLayerNormalization'}
 
 
 class QuantizationMode():
@@ -304,7 +314,13 @@ class ONNXQuantizer:
             # if a list of ops to be quantized is provided then only quantize those ops
             if self.nodes_to_quantize is not None and node.name not in self.nodes_to_quantize:
                 new_list += self._handle_other_ops(node, new_list)
-            # only onnx domain ops can be quantized today
+            elif self.mode == QuantizationMode.IntegerOps and node.domain == ms_domain and \
+                    node.op_type in integer_contrib_op_types:
+                if node.op_type == 'Attention':
+                    new_list += self._quantize_attention(node, new_list)
+                else:
+                    new_list += self._quantize_embed_layer_norm(node, new_list)
+            # only onnx domain and the BERT contrib ops above can be quantized today
             elif node.domain != "ai.onnx" and node.domain != '':
                 new_list += self._handle_other_ops(node, new_list)
             else:
@@ -316,6 +332,8 @@ class ONNXQuantizer:
                     new_list += self._quantize_gather_ops(node, new_list)
                 elif node.op_type == 'Relu' or node.op_type == 'Clip':
                     new_list += self._handle_activation_ops(node, new_list)
+                elif node.op_type in qlinear_contrib_op_types:
+                    new_list += self._quantize_qlinear_contrib_ops(node, new_list)
                 else:
                     new_list += self._handle_other_ops(node, new_list)
 
@@ -335,6 +353,9 @@ class ONNXQuantizer:
         if opset_info is not None:
             self.model.opset_import.remove(opset_info)
         self.model.opset_import.extend([onnx.helper.make_opsetid(onnx_domain, onnx_op_set_version)])
+        if any(node.domain == ms_domain for node in self.model.graph.node) and \
+                not any(opset.domain == ms_domain for opset in self.model.opset_import):
+            self.model.opset_import.extend([onnx.helper.make_opsetid(ms_domain, 1)])
 
         return self.model
 
@@ -485,6 +506,43 @@ class ONNXQuantizer:
 
         return weight
 
+    def _get_quantized_weight_per_column(self, initializer, qType):
+        '''
+            :param initializer: 2D initializer TypeProto to quantize
+            :param qType: type to quantize to. Only INT8 is supported, so that the zero point of all columns is 0.
+            :return: Weight class object with a scale for each column of the initializer
+        '''
+        assert (qType == onnx_proto.TensorProto.INT8)
+        weights = self.find_weight_data(initializer)
+        np_data = np.reshape(weights, initializer.dims)
+        column_count = initializer.dims[1]
+        rmin_list = []
+        rmax_list = []
+        zero_point_list = []
+        scale_list = []
+        quantized_columns = []
+        for i in range(column_count):
+            rmin, rmax, zero_point, scale, quantized_column = quantize_data(np_data[:, i].tolist(),
+                                                                            _get_qrange_for_qType(qType), qType)
+            rmin_list.append(rmin)
+            rmax_list.append(rmax)
+            zero_point_list.append(zero_point)
+            scale_list.append(scale)
+            quantized_columns.append(quantized_column)
+        quantized_weights = np.stack(quantized_columns, axis=1)
+
+        weight = QuantizedInitializer(initializer.name, initializer, rmin_list, rmax_list, zero_point_list, scale_list,
+                                      weights,
+                                      quantized_weights.flatten().tolist(), 1, qType)
+
+        # Make entry for this quantized weight
+        assert (weight.name not in self.quantized_value_map)
+        quantized_value = QuantizedValue(weight.name, weight.name + "_quantized", weight.name + "_scale",
+                                         weight.name + "_zero_point", QuantizedValueType.Initializer, 1, qType)
+        self.quantized_value_map[weight.name] = quantized_value
+
+        return weight
+
     def _get_dynamic_input_quantization_params(self, input_name, nodes_list, qType):
         '''
         Create nodes for dynamic quantization of input and add them to nodes_list.
@@ -744,7 +802,10 @@ class ONNXQuantizer:
             return: List of new nodes created.
         '''
         nodes_using_weight = _find_nodes_using_initializer(self.model.graph, weight.initializer)
-        unsupported_nodes = [node for node in nodes_using_weight if node.op_type not in ["Conv", "MatMul", "Gather"]]
+        supported_op_types = ["Conv", "MatMul", "Gather"]
+        if self.mode == QuantizationMode.IntegerOps:
+            supported_op_types += list(integer_contrib_op_types.keys())
+        unsupported_nodes = [node for node in nodes_using_weight if node.op_type not in supported_op_types]
 
         nodes_list = []
         dequantize_linear_name = weight.name + "_DequantizeLinear"
@@ -875,7 +936,8 @@ class ONNXQuantizer:
                      List of scale names used for input quantization,
                      List of new QuantizeLinear nodes created)
         '''
-        assert (node.op_type == "Conv" or node.op_type == "MatMul" or node.op_type == "Gather")
+        assert (node.op_type == "Conv" or node.op_type == "MatMul" or node.op_type == "Gather"
+                or node.op_type in qlinear_contrib_op_types or node.op_type == "Attention")
 
         quantized_input_names = []
         zero_point_names = []
@@ -1150,6 +1212,94 @@ class ONNXQuantizer:
         nodes.append(_get_mul_node([cast_op_output, scales_mul_op_output], node.output[0], output_scale_mul_op))
         return nodes
 
+    def _quantize_attention(self, node, new_nodes_list):
+        '''
+        Used when self.mode is QuantizationMode.IntegerOps. Replaces Attention by QAttention, which takes the
+        dynamically quantized input and the quantized weight. When per_channel is set and weights are signed, the
+        weight is quantized per column.
+            parameter node: Attention node.
+            parameter new_nodes_list: List of new nodes created before processing this node.
+            return: a list of nodes in topological order that represents quantized Attention node.
+        '''
+        assert (node.op_type == "Attention")
+
+        # QAttention takes an unsigned input, a constant weight and doesn't support the past state.
+        if self.input_qType != onnx_proto.TensorProto.UINT8 or len(node.input) > 4 or len(node.output) > 1 or \
+                _find_by_name(node.input[1], self.model.graph.initializer) is None:
+            return self._handle_other_ops(node, new_nodes_list)
+
+        weight_zero_point_name = None
+        nodes = []
+        if self.per_channel and self.weight_qType == onnx_proto.TensorProto.INT8 and \
+                node.input[1] not in self.quantized_value_map:
+            initializer = _find_by_name(node.input[1], self.model.graph.initializer)
+            weight = self._get_quantized_weight_per_column(initializer, self.weight_qType)
+            nodes.extend(self._update_unsupported_nodes_using_weight(weight, new_nodes_list))
+            self._update_graph(weight)
+            # All columns have a zero point of 0, so QAttention takes a scalar zero point.
+            _add_initializer_if_not_present(self.model.graph, self.fixed_zero_zp_name, [0], [],
+                                            onnx_proto.TensorProto.INT8)
+            weight_zero_point_name = self.fixed_zero_zp_name
+
+        (quantized_input_names, zero_point_names, scale_names, input_nodes) = \
+            self._quantize_inputs(node, [0, 1], new_nodes_list + nodes)
+        nodes.extend(input_nodes)
+        if weight_zero_point_name is not None:
+            zero_point_names[1] = weight_zero_point_name
+
+        mask_index_name = node.input[3] if len(node.input) > 3 else ""
+        inputs = quantized_input_names + [node.input[2]] + scale_names + [mask_index_name] + zero_point_names
+
+        kwargs = {}
+        for attribute in node.attribute:
+            kwargs.update(_attribute_to_kwarg(attribute))
+        kwargs["domain"] = ms_domain
+        qattention_name = "" if node.name == "" else node.name + "_quant"
+        nodes.append(onnx.helper.make_node("QAttention", inputs, node.output, qattention_name, **kwargs))
+        return nodes
+
+    def _quantize_embed_layer_norm(self, node, new_nodes_list):
+        '''
+        Used when self.mode is QuantizationMode.IntegerOps. Replaces EmbedLayerNormalization by
+        QEmbedLayerNormalization, which takes the word, position and segment embeddings quantized to uint8.
+            parameter node: EmbedLayerNormalization node.
+            parameter new_nodes_list: List of new nodes created before processing this node.
+            return: a list of nodes in topological order that represents quantized EmbedLayerNormalization node.
+        '''
+        assert (node.op_type == "EmbedLayerNormalization")
+
+        qType = onnx_proto.TensorProto.UINT8
+        embedding_names = node.input[2:5]
+        for embedding_name in embedding_names:
+            if _find_by_name(embedding_name, self.model.graph.initializer) is None or \
+                    (embedding_name in self.quantized_value_map and
+                     self.quantized_value_map[embedding_name].qType != qType):
+                return self._handle_other_ops(node, new_nodes_list)
+
+        nodes = []
+        quantized_names = []
+        scale_names = []
+        zero_point_names = []
+        for embedding_name in embedding_names:
+            if embedding_name not in self.quantized_value_map:
+                initializer = _find_by_name(embedding_name, self.model.graph.initializer)
+                weight = self._get_quantized_weight(initializer, qType)
+                nodes.extend(self._update_unsupported_nodes_using_weight(weight, new_nodes_list + nodes))
+                self._update_graph(weight)
+            quantized_value = self.quantized_value_map[embedding_name]
+            quantized_names.append(quantized_value.q_name)
+            scale_names.append(quantized_value.scale_name)
+            zero_point_names.append(quantized_value.zp_name)
+
+        mask_name = node.input[7] if len(node.input) > 7 else ""
+        inputs = list(node.input[0:2]) + quantized_names + list(node.input[5:7]) + [mask_name] + \
+            scale_names + zero_point_names
+
+        qembed_name = "" if node.name == "" else node.name + "_quant"
+        nodes.append(
+            onnx.helper.make_node("QEmbedLayerNormalization", inputs, node.output, qembed_name, domain=ms_domain))
+        return nodes
+
     def _quantize_convolution_qlinear_ops(self, node, new_nodes_list):
         '''
         Used when self.mode is QuantizationMode.QLinearOps.
@@ -1255,6 +1405,71 @@ class ONNXQuantizer:
 
         return nodes
 
+    def _quantize_qlinear_contrib_ops(self, node, new_nodes_list):
+        '''
+        Used for Add, Mul, AveragePool and ReduceMean nodes. When self.mode is QuantizationMode.QLinearOps and
+        the quantization parameters of the output are specified, the node is replaced by the com.microsoft
+        QLinear op of the same name so that its inputs and output stay quantized. Otherwise the node is handled
+        like any other op. These ops only support uint8 data.
+            parameter node: Add, Mul, AveragePool or ReduceMean node.
+            parameter new_nodes_list: List of new nodes created before processing this node.
+            return: a list of nodes in topological order that represents the quantized node.
+        '''
+        assert (node.op_type in qlinear_contrib_op_types)
+
+        input_indices = [0, 1] if node.op_type in ['Add', 'Mul'] else [0]
+        if self.mode != QuantizationMode.QLinearOps or self.input_qType != onnx_proto.TensorProto.UINT8:
+            return self._handle_other_ops(node, new_nodes_list)
+
+        # Every input must be quantized already, be an initializer that can be quantized to uint8 or have its
+        # quantization parameters specified.
+        for i in input_indices:
+            node_input = node.input[i]
+            if node_input in self.quantized_value_map:
+                continue
+            if _find_by_name(node_input, self.model.graph.initializer) is not None:
+                if self.weight_qType != onnx_proto.TensorProto.UINT8:
+                    return self._handle_other_ops(node, new_nodes_list)
+            elif self.quantization_params is None or node_input not in self.quantization_params:
+                return self._handle_other_ops(node, new_nodes_list)
+
+        data_found, output_scale_name, output_zp_name, _, _ = \
+            self._get_quantization_params(node.output[0])
+        if not data_found:
+            return self._handle_other_ops(node, new_nodes_list)
+
+        (quantized_input_names, zero_point_names, scale_names, nodes) = \
+            self._quantize_inputs(node, input_indices, new_nodes_list)
+
+        qlinear_output = node.output[0] + "_quantized"
+        qlinear_name = ""
+        if node.name != "":
+            qlinear_name = node.name + "_quant"
+        kwargs = {}
+        for attribute in node.attribute:
+            kwargs.update(_attribute_to_kwarg(attribute))
+        kwargs["domain"] = ms_domain
+
+        qlinear_inputs = []
+        for i in range(len(input_indices)):
+            qlinear_inputs.append(quantized_input_names[i])
+            qlinear_inputs.append(scale_names[i])
+            qlinear_inputs.append(zero_point_names[i])
+        # Output
+        qlinear_inputs.append(output_scale_name)
+        qlinear_inputs.append(output_zp_name)
+
+        qlinear_node = onnx.helper.make_node("QLinear" + node.op_type, qlinear_inputs, [qlinear_output],
+                                             qlinear_name, **kwargs)
+        nodes.append(qlinear_node)
+
+        # Create an entry for this quantized value
+        q_output = QuantizedValue(node.output[0], qlinear_output, output_scale_name, output_zp_name,
+                                  QuantizedValueType.Input)
+        self.quantized_value_map[node.output[0]] = q_output
+
+        return nodes
+
     def _quantize_convolution(self, node, new_nodes_list):
         '''
             https://github.com/onnx/onnx/blob/master/docs/Operators.md#Conv
@@ -1336,13 +1551,19 @@ def quantize(model,
         Given an onnx model, create a quantized onnx model and save it into a file
 
     :param model: ModelProto to quantize
-    :param per_channel: quantize weights per channel
+    :param per_channel: quantize weights per channel. The weight of Attention is quantized per column when
+        symmetric_weight is True.
     :param nbits: number of bits to represent quantized data. Currently only supporting 8-bit types
     :param quantization_mode: Can be one of the QuantizationMode types.
         IntegerOps:
             the function will use integer ops. Only ConvInteger and MatMulInteger ops are supported now.
+            The Attention and EmbedLayerNormalization contrib ops of an optimized BERT model are replaced by
+            the QAttention and QEmbedLayerNormalization contrib ops.
         QLinearOps:
             the function will use QLinear ops. Only QLinearConv and QLinearMatMul ops are supported now.
+            Add, Mul, AveragePool and ReduceMean nodes are replaced by the QLinearAdd, QLinearMul,
+            QLinearAveragePool and QLinearReduceMean contrib ops when quantization_params specifies the
+            quantization parameters of their output and activations are unsigned.
     :param static:
         True: The inputs/activations are quantized using static scale and zero point values
               specified through quantization_params.
@@ -114,5 +114,53 @@ TEST(BiasGeluTest, Two_One_Dim) {
   RunBiasGeluTest(input_a_data, input_b_data, {2, 4}, {4});
 }
 
+TEST(FusedElementwiseTest, MulAddTanhSub) {
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+  // Y = 1 - tanh(X * 0.5 + B)
+  test.AddAttribute("ops", std::vector<std::string>{"Mul", "Add", "Tanh", "Sub"});
+  test.AddAttribute("operand_positions", std::vector<int64_t>{1, 1, -1, 0});
+
+  std::vector<float> X = {-2.0f, -1.0f, 0.0f, 0.5f, 1.0f, 3.0f};
+  std::vector<float> B = {0.1f, -0.2f, 0.3f, -0.4f, 0.5f, -0.6f};
+  std::vector<float> Y(X.size());
+  for (size_t i = 0; i < X.size(); ++i) {
+    Y[i] = 1.0f - std::tanh(X[i] * 0.5f + B[i]);
+  }
+
+  test.AddInput<float>("X", {2, 3}, X);
+  test.AddInput<float>("scale", {1}, {0.5f});
+  test.AddInput<float>("B", {2, 3}, B);
+  test.AddInput<float>("one", {}, {1.0f});
+  test.AddOutput<float>("Y", {2, 3}, Y);
+  test.Run();
+}
+
+TEST(FusedElementwiseTest, MultipleTiles) {
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+  // Y = sigmoid(relu(sqrt(abs(X)) / D)) * M, over more elements than a single tile of the kernel.
+  test.AddAttribute("ops", std::vector<std::string>{"Abs", "Sqrt", "Div", "Relu", "Sigmoid", "Mul"});
+  test.AddAttribute("operand_positions", std::vector<int64_t>{-1, -1, 1, -1, -1, 1});
+
+  const int64_t rows = 5;
+  const int64_t cols = 1000;
+  std::vector<float> X(rows * cols);
+  std::vector<float> D(rows * cols);
+  std::vector<float> M(rows * cols);
+  std::vector<float> Y(rows * cols);
+  for (size_t i = 0; i < X.size(); ++i) {
+    X[i] = static_cast<float>(static_cast<int>(i % 97) - 48) / 8.0f;
+    D[i] = (i % 3 == 0) ? -2.0f : 4.0f;
+    M[i] = static_cast<float>(i % 7) - 3.0f;
+    float v = std::max(std::sqrt(std::abs(X[i])) / D[i], 0.0f);
+    Y[i] = M[i] / (1.0f + std::exp(-v));
+  }
+
+  test.AddInput<float>("X", {rows, cols}, X);
+  test.AddInput<float>("D", {rows, cols}, D);
+  test.AddInput<float>("M", {rows, cols}, M);
+  test.AddOutput<float>("Y", {rows, cols}, Y);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -423,5 +423,52 @@ TEST(EmbedLayerNormTest, EmbedLayerNormLargeBatchSmallHiddenSize) {
           sequence_length,
           hidden_size);
 }
+
+TEST(EmbedLayerNormTest, QEmbedLayerNormBatch1) {
+  int batch_size = 1;
+  int sequence_length = 2;
+  int hidden_size = 4;
+
+  // The quantized embeddings dequantize to the embeddings of EmbedLayerNormBatch1.
+  std::vector<uint8_t> word_embedding_data = {
+      130, 129, 132, 122,
+      131, 130, 133, 134,
+      134, 135, 128, 127,
+      136, 134, 137, 140,
+      129, 131, 133, 137,
+      138, 108, 139, 136};
+
+  std::vector<uint8_t> position_embedding_data = {
+      129, 129, 132, 134,
+      134, 128, 136, 134,
+      131, 137, 108, 136};
+
+  std::vector<uint8_t> segment_embedding_data = {
+      6, 8, 18, 2,
+      14, 6, 10, 4};
+
+  std::vector<float> output_data = {
+      0.36917170882225037, 0.061503000557422638, 1.1598974466323853, -0.85092413425445557,
+      0.74301940202713013, -0.057434864342212677, 0.84324657917022705, -0.85171419382095337};
+
+  OpTester tester("QEmbedLayerNormalization", 1, onnxruntime::kMSDomain);
+  tester.AddInput<int32_t>("input_ids", {batch_size, sequence_length}, {1, 3});
+  tester.AddInput<int32_t>("segment_ids", {batch_size, sequence_length}, {0, 1});
+  tester.AddInput<uint8_t>("word_embedding_quant", {6, hidden_size}, word_embedding_data);
+  tester.AddInput<uint8_t>("position_embedding_quant", {3, hidden_size}, position_embedding_data);
+  tester.AddInput<uint8_t>("segment_embedding_quant", {2, hidden_size}, segment_embedding_data);
+  tester.AddInput<float>("gamma", {hidden_size}, {0.25f, 0.15f, 0.45f, -0.66f});
+  tester.AddInput<float>("beta", {hidden_size}, {0.6f, 0.2f, 0.5f, -0.6f});
+  tester.AddInput<int32_t>("mask", {batch_size, sequence_length}, {1, 1});
+  tester.AddInput<float>("word_embedding_scale", {}, {0.1f});
+  tester.AddInput<float>("position_embedding_scale", {}, {0.1f});
+  tester.AddInput<float>("segment_embedding_scale", {}, {0.05f});
+  tester.AddInput<uint8_t>("word_embedding_zero_point", {}, {128});
+  tester.AddInput<uint8_t>("position_embedding_zero_point", {}, {128});
+  tester.AddInput<uint8_t>("segment_embedding_zero_point", {}, {0});
+  tester.AddOutput<float>("output", {batch_size, sequence_length, hidden_size}, output_data);
+  tester.AddOutput<int32_t>("mask_index", {batch_size}, {2});
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {kCudaExecutionProvider, kTensorrtExecutionProvider});
+}
 }  // namespace test
 }  // namespace onnxruntime
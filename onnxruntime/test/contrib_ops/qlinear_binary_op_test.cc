@@ -0,0 +1,132 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+struct QuantizationParameters {
+  float scale;
+  uint8_t zero_point;
+};
+
+std::vector<uint8_t> GenerateInput(int64_t size, uint8_t seed) {
+  std::vector<uint8_t> data(static_cast<size_t>(size));
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<uint8_t>((i * 37 + seed) % 256);
+  }
+  return data;
+}
+
+// Maps an index of the output to the index of an input, with numpy style broadcasting.
+int64_t BroadcastIndex(int64_t output_index, const std::vector<int64_t>& output_dims,
+                       const std::vector<int64_t>& input_dims) {
+  int64_t input_index = 0;
+  int64_t input_stride = 1;
+  const size_t offset = output_dims.size() - input_dims.size();
+  for (size_t i = output_dims.size(); i-- > 0;) {
+    const int64_t coordinate = output_index % output_dims[i];
+    output_index /= output_dims[i];
+    if (i >= offset) {
+      const int64_t input_dim = input_dims[i - offset];
+      input_index += (input_dim == 1 ? 0 : coordinate) * input_stride;
+      input_stride *= input_dim;
+    }
+  }
+  return input_index;
+}
+
+void RunQLinearBinaryOpTest(const char* op_type,
+                            const std::function<float(int32_t, int32_t, QuantizationParameters,
+                                                      QuantizationParameters, QuantizationParameters)>& reference,
+                            const std::vector<int64_t>& A_dims, QuantizationParameters A_params,
+                            const std::vector<int64_t>& B_dims, QuantizationParameters B_params,
+                            const std::vector<int64_t>& C_dims, QuantizationParameters C_params) {
+  const auto A = GenerateInput(TensorShape(A_dims).Size(), 3);
+  const auto B = GenerateInput(TensorShape(B_dims).Size(), 101);
+
+  std::vector<uint8_t> C(static_cast<size_t>(TensorShape(C_dims).Size()));
+  for (size_t i = 0; i < C.size(); ++i) {
+    const int32_t a = A[static_cast<size_t>(BroadcastIndex(static_cast<int64_t>(i), C_dims, A_dims))];
+    const int32_t b = B[static_cast<size_t>(BroadcastIndex(static_cast<int64_t>(i), C_dims, B_dims))];
+    const float value = reference(a, b, A_params, B_params, C_params);
+    const float clamped = std::min(std::max(value, 0.0f - C_params.zero_point), 255.0f - C_params.zero_point);
+    C[i] = static_cast<uint8_t>(static_cast<int32_t>(std::nearbyintf(clamped)) + C_params.zero_point);
+  }
+
+  OpTester test(op_type, 1, onnxruntime::kMSDomain);
+  test.AddInput<uint8_t>("A", A_dims, A);
+  test.AddInput<float>("A_scale", {}, {A_params.scale});
+  test.AddInput<uint8_t>("A_zero_point", {}, {A_params.zero_point});
+  test.AddInput<uint8_t>("B", B_dims, B);
+  test.AddInput<float>("B_scale", {}, {B_params.scale});
+  test.AddInput<uint8_t>("B_zero_point", {}, {B_params.zero_point});
+  test.AddInput<float>("C_scale", {}, {C_params.scale});
+  test.AddInput<uint8_t>("C_zero_point", {}, {C_params.zero_point});
+  test.AddOutput<uint8_t>("C", C_dims, C);
+  test.Run();
+}
+
+// The ratios of the scales are powers of two, so the fixed point addition is exact.
+float AddReference(int32_t a, int32_t b, QuantizationParameters A_params, QuantizationParameters B_params,
+                   QuantizationParameters C_params) {
+  return ((a - A_params.zero_point) * A_params.scale + (b - B_params.zero_point) * B_params.scale) /
+         C_params.scale;
+}
+
+float MulReference(int32_t a, int32_t b, QuantizationParameters A_params, QuantizationParameters B_params,
+                   QuantizationParameters C_params) {
+  const float scale = A_params.scale * B_params.scale / C_params.scale;
+  return static_cast<float>((a - A_params.zero_point) * (b - B_params.zero_point)) * scale;
+}
+
+}  // namespace
+
+TEST(QLinearBinaryOpTest, AddSameShape) {
+  RunQLinearBinaryOpTest("QLinearAdd", AddReference,
+                         {3, 13}, {0.25f, 128}, {3, 13}, {0.5f, 120}, {3, 13}, {0.25f, 130});
+}
+
+TEST(QLinearBinaryOpTest, AddScalar) {
+  RunQLinearBinaryOpTest("QLinearAdd", AddReference,
+                         {2, 19}, {0.5f, 100}, {}, {0.25f, 20}, {2, 19}, {0.25f, 128});
+  RunQLinearBinaryOpTest("QLinearAdd", AddReference,
+                         {1}, {0.25f, 100}, {37}, {1.0f, 64}, {37}, {0.25f, 0});
+}
+
+TEST(QLinearBinaryOpTest, AddBroadcast) {
+  RunQLinearBinaryOpTest("QLinearAdd", AddReference,
+                         {2, 3, 9}, {0.25f, 128}, {9}, {0.125f, 7}, {2, 3, 9}, {0.125f, 128});
+  RunQLinearBinaryOpTest("QLinearAdd", AddReference,
+                         {2, 3, 1}, {0.5f, 3}, {1, 3, 17}, {0.25f, 250}, {2, 3, 17}, {0.25f, 128});
+}
+
+TEST(QLinearBinaryOpTest, MulSameShape) {
+  RunQLinearBinaryOpTest("QLinearMul", MulReference,
+                         {3, 13}, {0.05f, 128}, {3, 13}, {0.02f, 120}, {3, 13}, {0.1f, 130});
+}
+
+TEST(QLinearBinaryOpTest, MulScalar) {
+  RunQLinearBinaryOpTest("QLinearMul", MulReference,
+                         {2, 19}, {0.03f, 100}, {}, {0.07f, 20}, {2, 19}, {0.5f, 128});
+  RunQLinearBinaryOpTest("QLinearMul", MulReference,
+                         {1}, {0.25f, 100}, {37}, {0.01f, 64}, {37}, {0.2f, 10});
+}
+
+TEST(QLinearBinaryOpTest, MulBroadcast) {
+  RunQLinearBinaryOpTest("QLinearMul", MulReference,
+                         {2, 3, 9}, {0.02f, 128}, {9}, {0.04f, 7}, {2, 3, 9}, {0.3f, 128});
+  RunQLinearBinaryOpTest("QLinearMul", MulReference,
+                         {2, 3, 1}, {0.1f, 3}, {1, 3, 17}, {0.02f, 250}, {2, 3, 17}, {0.25f, 128});
+}
+
+}  // namespace test
+}  // namespace onnxruntime
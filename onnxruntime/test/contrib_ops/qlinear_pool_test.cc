@@ -0,0 +1,79 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(QLinearPoolTest, AveragePool2D) {
+  OpTester test("QLinearAveragePool", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("kernel_shape", std::vector<int64_t>{2, 2});
+  test.AddAttribute("strides", std::vector<int64_t>{2, 2});
+
+  // Dequantized input:
+  //  1  2  3  4
+  //  5  6  7  8
+  //  9 10 11 12
+  // 13 14 15 16
+  test.AddInput<uint8_t>("X", {1, 1, 4, 4},
+                         {12, 14, 16, 18,
+                          20, 22, 24, 26,
+                          28, 30, 32, 34,
+                          36, 38, 40, 42});
+  test.AddInput<float>("x_scale", {}, {0.5f});
+  test.AddInput<uint8_t>("x_zero_point", {}, {10});
+  test.AddInput<float>("y_scale", {}, {0.25f});
+  test.AddInput<uint8_t>("y_zero_point", {}, {5});
+
+  // Averages 3.5, 5.5, 11.5, 13.5.
+  test.AddOutput<uint8_t>("Y", {1, 1, 2, 2}, {19, 27, 51, 59});
+  test.Run();
+}
+
+TEST(QLinearPoolTest, AveragePool2DPads) {
+  for (int64_t count_include_pad : {0, 1}) {
+    OpTester test("QLinearAveragePool", 1, onnxruntime::kMSDomain);
+    test.AddAttribute("kernel_shape", std::vector<int64_t>{2, 2});
+    test.AddAttribute("pads", std::vector<int64_t>{1, 1, 0, 0});
+    test.AddAttribute("count_include_pad", count_include_pad);
+
+    // Dequantized input:
+    // 4 8
+    // 2 6
+    test.AddInput<uint8_t>("X", {1, 1, 2, 2}, {8, 16, 4, 12});
+    test.AddInput<float>("x_scale", {}, {0.5f});
+    test.AddInput<uint8_t>("x_zero_point", {}, {0});
+    test.AddInput<float>("y_scale", {}, {0.5f});
+    test.AddInput<uint8_t>("y_zero_point", {}, {1});
+
+    if (count_include_pad) {
+      // Averages 1, 3, 1.5, 5.
+      test.AddOutput<uint8_t>("Y", {1, 1, 2, 2}, {3, 7, 4, 11});
+    } else {
+      // Averages 4, 6, 3, 5.
+      test.AddOutput<uint8_t>("Y", {1, 1, 2, 2}, {9, 13, 7, 11});
+    }
+    test.Run();
+  }
+}
+
+TEST(QLinearPoolTest, AveragePool1D) {
+  OpTester test("QLinearAveragePool", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("kernel_shape", std::vector<int64_t>{3});
+
+  test.AddInput<uint8_t>("X", {1, 2, 5}, {0, 3, 6, 9, 12,
+                                          100, 100, 103, 250, 255});
+  test.AddInput<float>("x_scale", {}, {1.0f});
+  test.AddMissingOptionalInput<uint8_t>();
+  test.AddInput<float>("y_scale", {}, {1.0f});
+  test.AddMissingOptionalInput<uint8_t>();
+
+  test.AddOutput<uint8_t>("Y", {1, 2, 3}, {3, 6, 9,
+                                           101, 151, 203});
+  test.Run();
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,66 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+void RunQLinearReduceMeanTest(const std::vector<int64_t>& axes, int64_t keepdims,
+                              const std::vector<int64_t>& output_dims, const std::vector<uint8_t>& output) {
+  std::vector<uint8_t> input(24);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<uint8_t>(i * 10);
+  }
+
+  OpTester test("QLinearReduceMean", 1, onnxruntime::kMSDomain);
+  if (!axes.empty()) {
+    test.AddAttribute("axes", axes);
+  }
+  test.AddAttribute("keepdims", keepdims);
+  test.AddInput<uint8_t>("data", {2, 3, 4}, input);
+  test.AddInput<float>("data_scale", {}, {1.0f});
+  test.AddMissingOptionalInput<uint8_t>();
+  test.AddInput<float>("reduced_scale", {}, {1.0f});
+  test.AddMissingOptionalInput<uint8_t>();
+  test.AddOutput<uint8_t>("reduced", output_dims, output);
+  test.Run();
+}
+
+}  // namespace
+
+TEST(QLinearReduceMeanTest, Axes) {
+  RunQLinearReduceMeanTest({1}, 1, {2, 1, 4}, {40, 50, 60, 70, 160, 170, 180, 190});
+  RunQLinearReduceMeanTest({0, -1}, 0, {3}, {75, 115, 155});
+  RunQLinearReduceMeanTest({2}, 1, {2, 3, 1}, {15, 55, 95, 135, 175, 215});
+}
+
+TEST(QLinearReduceMeanTest, AllAxes) {
+  RunQLinearReduceMeanTest({}, 0, {}, {115});
+  RunQLinearReduceMeanTest({}, 1, {1, 1, 1}, {115});
+}
+
+TEST(QLinearReduceMeanTest, Requantize) {
+  OpTester test("QLinearReduceMean", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("axes", std::vector<int64_t>{-1});
+  test.AddAttribute("keepdims", static_cast<int64_t>(0));
+
+  // Dequantized input:
+  // 0  1  2  3
+  // 5 10 15 20
+  test.AddInput<uint8_t>("data", {2, 4}, {10, 12, 14, 16, 20, 30, 40, 50});
+  test.AddInput<float>("data_scale", {}, {0.5f});
+  test.AddInput<uint8_t>("data_zero_point", {}, {10});
+  test.AddInput<float>("reduced_scale", {}, {1.0f});
+  test.AddInput<uint8_t>("reduced_zero_point", {}, {3});
+
+  // Means 1.5 and 12.5 are rounded to even.
+  test.AddOutput<uint8_t>("reduced", {2}, {5, 15});
+  test.Run();
+}
+
+}  // namespace test
+}  // namespace onnxruntime
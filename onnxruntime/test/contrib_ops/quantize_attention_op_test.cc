@@ -0,0 +1,139 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+template <typename TWeight>
+static void RunQAttentionTest(
+    const std::vector<uint8_t>& input_data,       // input:       [batch_size, sequence_length, hidden_size]
+    const std::vector<TWeight>& weights_data,     // weights:     [hidden_size, 3 * hidden_size]
+    const std::vector<float>& bias_data,          // bias:        [3 * hidden_size]
+    float input_scale,
+    const std::vector<float>& weight_scale_data,  // weight_scale: [1] or [3 * hidden_size]
+    uint8_t input_zero_point,
+    TWeight weight_zero_point,
+    const std::vector<int32_t>& mask_index_data,  // mask_index:  [batch_size] or empty if there is no mask
+    const std::vector<float>& output_data,        // output:      [batch_size, sequence_length, hidden_size]
+    int batch_size,
+    int sequence_length,
+    int hidden_size,
+    int number_of_heads) {
+  OpTester tester("QAttention", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<int64_t>("num_heads", static_cast<int64_t>(number_of_heads));
+
+  std::vector<int64_t> input_dims = {batch_size, sequence_length, hidden_size};
+  std::vector<int64_t> weights_dims = {hidden_size, 3 * hidden_size};
+  std::vector<int64_t> bias_dims = {3 * hidden_size};
+  std::vector<int64_t> weight_scale_dims = {static_cast<int64_t>(weight_scale_data.size())};
+  std::vector<int64_t> mask_index_dims = {batch_size};
+
+  tester.AddInput<uint8_t>("input", input_dims, input_data);
+  tester.AddInput<TWeight>("weight", weights_dims, weights_data);
+  tester.AddInput<float>("bias", bias_dims, bias_data);
+  tester.AddInput<float>("input_scale", {1}, {input_scale});
+  tester.AddInput<float>("weight_scale", weight_scale_dims, weight_scale_data);
+  if (mask_index_data.empty()) {
+    tester.AddMissingOptionalInput<int32_t>();
+  } else {
+    tester.AddInput<int32_t>("mask_index", mask_index_dims, mask_index_data);
+  }
+  tester.AddInput<uint8_t>("input_zero_point", {1}, {input_zero_point});
+  tester.AddInput<TWeight>("weight_zero_point", {1}, {weight_zero_point});
+  tester.AddOutput<float>("output", input_dims, output_data);
+
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {kCudaExecutionProvider, kTensorrtExecutionProvider});
+}
+
+// The quantized input and weights below dequantize to the input and weights of AttentionTest.AttentionBatch1.
+static const std::vector<uint8_t> kInputData = {
+    136, 123, 128, 138,
+    133, 130, 131, 122};
+
+static const std::vector<int8_t> kWeightData = {
+    1, -2, 3, 10, 11, 3, 5, 2, 3, -6, 15, 20,
+    5, 1, 4, 16, 10, 20, 4, 8, 9, 1, -13, 7,
+    3, 2, 40, 22, 16, 11, 7, 2, 4, 10, 12, 5,
+    2, 1, 4, 16, 24, 33, 21, 42, 84, 0, 21, 32};
+
+static const std::vector<float> kBiasData = {
+    -0.5f, 0.6f, 1.2f, 2.1f, 0.5f, 0.7f, 0.2f, 1.2f, 0.5f, 0.4f, 0.3f, 1.2f};
+
+TEST(QAttentionTest, QAttentionBatch1) {
+  int batch_size = 1;
+  int sequence_length = 2;
+  int hidden_size = 4;
+  int number_of_heads = 2;
+
+  std::vector<int32_t> mask_index_data = {2L};
+
+  std::vector<float> output_data = {
+      3.1496f, 0.10844f, 4.25f, 5.65f,
+      3.96968f, 0.07314f, 4.25f, 5.65f};
+
+  RunQAttentionTest<int8_t>(kInputData, kWeightData, kBiasData, 0.1f, {0.1f}, 128, 0, mask_index_data,
+                            output_data, batch_size, sequence_length, hidden_size, number_of_heads);
+}
+
+TEST(QAttentionTest, QAttentionNoMask) {
+  int batch_size = 1;
+  int sequence_length = 2;
+  int hidden_size = 4;
+  int number_of_heads = 2;
+
+  std::vector<float> output_data = {
+      3.1496f, 0.10844f, 4.25f, 5.65f,
+      3.96968f, 0.07314f, 4.25f, 5.65f};
+
+  RunQAttentionTest<int8_t>(kInputData, kWeightData, kBiasData, 0.1f, {0.1f}, 128, 0, {}, output_data,
+                            batch_size, sequence_length, hidden_size, number_of_heads);
+}
+
+TEST(QAttentionTest, QAttentionMaskPartialSequence) {
+  int batch_size = 1;
+  int sequence_length = 2;
+  int hidden_size = 4;
+  int number_of_heads = 2;
+
+  std::vector<int32_t> mask_index_data = {1L};
+
+  std::vector<float> output_data = {
+      8.69f, -0.13f, 4.25f, 5.65f,
+      8.69f, -0.13f, 4.25f, 5.65f};
+
+  RunQAttentionTest<int8_t>(kInputData, kWeightData, kBiasData, 0.1f, {0.1f}, 128, 0, mask_index_data,
+                            output_data, batch_size, sequence_length, hidden_size, number_of_heads);
+}
+
+TEST(QAttentionTest, QAttentionPerColumnUint8Weights) {
+  int batch_size = 1;
+  int sequence_length = 2;
+  int hidden_size = 4;
+  int number_of_heads = 2;
+
+  // Same weights as above quantized per column with a zero point of 128.
+  std::vector<uint8_t> weight_data = {
+      130, 124, 134, 148, 150, 134, 138, 132, 131, 116, 158, 168,
+      138, 130, 136, 160, 148, 168, 136, 144, 137, 130, 102, 142,
+      134, 132, 208, 172, 160, 150, 142, 132, 132, 148, 152, 138,
+      132, 130, 136, 160, 176, 194, 170, 212, 212, 128, 170, 192};
+
+  std::vector<float> weight_scale_data = {
+      0.05f, 0.05f, 0.05f, 0.05f, 0.05f, 0.05f, 0.05f, 0.05f, 0.1f, 0.05f, 0.05f, 0.05f};
+
+  std::vector<int32_t> mask_index_data = {2L};
+
+  std::vector<float> output_data = {
+      3.1496f, 0.10844f, 4.25f, 5.65f,
+      3.96968f, 0.07314f, 4.25f, 5.65f};
+
+  RunQAttentionTest<uint8_t>(kInputData, weight_data, kBiasData, 0.1f, weight_scale_data, 128, 128,
+                             mask_index_data, output_data, batch_size, sequence_length, hidden_size,
+                             number_of_heads);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
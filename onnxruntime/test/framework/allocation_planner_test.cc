@@ -312,6 +312,11 @@ TEST_F(PlannerTest, ChainTest) {
   CheckFreed(1, {});
   CheckFreed(2, {"B"});
   CheckFreed(3, {"X"});
+
+  // critical path priority is the number of nodes from each node to the graph output
+  for (size_t i = 0; i < GetPlan().execution_plan.size(); ++i) {
+    EXPECT_EQ(GetPlan().NodePriority(GetPlan().execution_plan[i].node_index), static_cast<int>(4 - i));
+  }
 }
 
 /* InputOutputTest: Test that:
@@ -2,8 +2,10 @@
 // Licensed under the MIT License.
 
 #include "core/framework/bfc_arena.h"
+#include "test/util/include/asserts.h"
 #include "gtest/gtest.h"
 #include <cstdlib>
+#include <thread>
 
 namespace onnxruntime {
 namespace test {
@@ -234,5 +236,176 @@ TEST(BFCArenaTest, TestReserve) {
   a.GetStats(&stats);
   EXPECT_EQ(stats.total_allocated_bytes, 1048576);
 }
+TEST(BFCArenaTest, ThreadCacheReusesFreedChunks) {
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30, true);
+
+  void* first_ptr = a.Alloc(1000);
+  a.Free(first_ptr);
+  void* second_ptr = a.Alloc(1000);
+  EXPECT_EQ(first_ptr, second_ptr);
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_allocs, 2);
+  EXPECT_EQ(stats.num_thread_cache_hits, 1);
+  EXPECT_EQ(stats.bytes_in_use, 1024);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 0);
+
+  a.Free(second_ptr);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 1024);
+
+  // Large chunks bypass the thread cache.
+  void* large_ptr = a.Alloc(1 << 20);
+  a.Free(large_ptr);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 1024);
+}
+
+TEST(BFCArenaTest, ThreadCacheDrainedBeforeExtend) {
+  // Configure a 1MiB byte limit so that the arena can't grow past its first region.
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 20, true);
+
+  std::vector<void*> ptrs;
+  for (int i = 0; i < 48; i++) {
+    void* raw = a.Alloc(16 << 10);
+    ASSERT_NE(raw, nullptr);
+    ptrs.push_back(raw);
+  }
+  for (void* raw : ptrs) {
+    a.Free(raw);
+  }
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 48 * (16 << 10));
+
+  // Only possible if the cached chunks are coalesced back into the bins.
+  void* large_ptr = a.Alloc(512 << 10);
+  EXPECT_NE(large_ptr, nullptr);
+  a.Free(large_ptr);
+
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 0);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_EQ(stats.num_arena_extensions, 1);
+}
+
+TEST(BFCArenaTest, ThreadCacheConcurrentAllocations) {
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30, true);
+
+  std::vector<void*> shared_ptrs(4, nullptr);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < shared_ptrs.size(); t++) {
+    threads.emplace_back([&a, &shared_ptrs, t]() {
+      std::vector<void*> ptrs;
+      for (int i = 0; i < 2000; i++) {
+        size_t size = 64 + ((i * 7919 + t * 104729) % (48 << 10));
+        void* raw = a.Alloc(size);
+        memset(raw, static_cast<int>(t), size);
+        ptrs.push_back(raw);
+        if (ptrs.size() > 16) {
+          a.Free(ptrs.front());
+          ptrs.erase(ptrs.begin());
+        }
+      }
+      // Leave one chunk to be freed by another thread.
+      shared_ptrs[t] = ptrs.back();
+      ptrs.pop_back();
+      for (void* raw : ptrs) {
+        a.Free(raw);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (void* raw : shared_ptrs) {
+    a.Free(raw);
+  }
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_GT(stats.num_thread_cache_hits, 0);
+  EXPECT_EQ(stats.num_allocs, 4 * 2000);
+}
+
+TEST(BFCArenaTest, ThreadCacheReleasedOnThreadExit) {
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30, true);
+
+  std::thread thread([&a]() {
+    a.Free(a.Alloc(1000));
+
+    AllocatorStats stats;
+    a.GetStats(&stats);
+    EXPECT_EQ(stats.bytes_in_thread_caches, 1024);
+  });
+  thread.join();
+
+  // The chunks cached by the thread are back in the bins once it has exited.
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 0);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_EQ(stats.num_thread_cache_hits, 0);
+}
+
+TEST(BFCArenaTest, ShrinkReleasesFreeRegions) {
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30, true);
+
+  // The first allocation creates a 1MiB region, the second one a 4MiB region.
+  void* small_ptr = a.Alloc(1000);
+  void* large_ptr = a.Alloc(4 << 20);
+  ASSERT_NE(small_ptr, nullptr);
+  ASSERT_NE(large_ptr, nullptr);
+  a.Free(large_ptr);
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_arena_extensions, 2);
+  EXPECT_EQ(stats.total_allocated_bytes, (1 << 20) + (4 << 20));
+
+  // The first region still has a chunk in use.
+  ASSERT_STATUS_OK(a.Shrink());
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.total_allocated_bytes, 1 << 20);
+
+  // Chunks held in the thread cache don't keep their region alive.
+  a.Free(small_ptr);
+  ASSERT_STATUS_OK(a.Shrink());
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.total_allocated_bytes, 0);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 0);
+  EXPECT_EQ(stats.free_bytes, 0);
+
+  // The arena grows again after being shrunk.
+  void* ptr = a.Alloc(1000);
+  ASSERT_NE(ptr, nullptr);
+  a.Free(ptr);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_arena_extensions, 3);
+}
+
+TEST(BFCArenaTest, ExtendSameAsRequested) {
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30, false,
+             ORT_ARENA_EXTEND_SAME_AS_REQUESTED);
+
+  void* first_ptr = a.Alloc(1000);
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.total_allocated_bytes, 1024);
+
+  void* second_ptr = a.Alloc(3000);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.total_allocated_bytes, 1024 + 3072);
+  EXPECT_EQ(stats.num_arena_extensions, 2);
+
+  a.Free(first_ptr);
+  a.Free(second_ptr);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -37,6 +37,8 @@
 #include "test/test_environment.h"
 #include "test/providers/provider_test_utils.h"
 #include "test/optimizer/dummy_graph_transformer.h"
+#include "test/util/include/asserts.h"
+#include "test/util/include/file_util.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
 #include "gtest/gtest.h"
 #include "core/session/environment.h"
@@ -426,6 +428,54 @@ TEST(InferenceSessionTests, TestModelSerialization) {
   ASSERT_TRUE(session_object_emptyValidation.Initialize().IsOK());
 }
 
+TEST(InferenceSessionTests, SaveAndLoadSessionState) {
+  std::basic_string<ORTCHAR_T> state_file = ORT_TSTR("mul_1_ortstate_XXXXXX");
+  FILE* fp;
+  CreateTestFile(fp, state_file);
+  ASSERT_EQ(0, fclose(fp));
+  ScopedFileDeleter file_deleter{state_file};
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.SaveAndLoadSessionState";
+  so.optimized_session_state_filepath = state_file;
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  // save again after a run so the memory pattern of that run is part of the state
+  RunOptions run_options;
+  RunModel(session_object, run_options);
+  ASSERT_STATUS_OK(session_object.SaveSessionState(state_file));
+
+  SessionOptions so_restored;
+  so_restored.session_logid = "InferenceSessionTests.SaveAndLoadSessionState.Restored";
+  InferenceSession restored_session_object{so_restored, GetEnvironment()};
+  ASSERT_STATUS_OK(restored_session_object.Load(state_file));
+  ASSERT_STATUS_OK(restored_session_object.Initialize());
+  ASSERT_EQ(restored_session_object.GetMemoryPatternCacheStats().num_entries, 1u);
+
+  RunModel(restored_session_object, run_options);
+  auto stats = restored_session_object.GetMemoryPatternCacheStats();
+  ASSERT_GT(stats.hits, 0u);
+  ASSERT_EQ(stats.misses, 0u);
+
+  // saving requires the optimized model, which is only kept if the option was set
+  ASSERT_FALSE(restored_session_object.SaveSessionState(state_file).IsOK());
+
+  // a truncated state must be rejected
+  size_t length = 0;
+  ASSERT_STATUS_OK(Env::Default().GetFileLength(state_file.c_str(), length));
+  std::vector<char> buffer(length);
+  ASSERT_STATUS_OK(Env::Default().ReadFileIntoBuffer(state_file.c_str(), 0, length, gsl::make_span(buffer)));
+  {
+    std::ofstream truncated(state_file, std::ios::out | std::ios::binary | std::ios::trunc);
+    truncated.write(buffer.data(), length / 2);
+  }
+
+  InferenceSession truncated_session_object{so_restored, GetEnvironment()};
+  ASSERT_FALSE(truncated_session_object.Load(state_file).IsOK());
+}
+
 #ifdef ORT_RUN_EXTERNAL_ONNX_TESTS
 static bool Compare(const InputDefList& f_arg, const InputDefList& s_arg) {
   if (f_arg.size() != s_arg.size()) {
@@ -737,6 +787,160 @@ TEST(InferenceSessionTests, TestWithIstream) {
   RunModel(session_object, run_options);
 }
 
+TEST(InferenceSessionTests, TestMmapModelLoading) {
+  // uint8 data is always aligned, so the large initializer can be used in place from the mapped model file
+  constexpr int64_t x_size = 4;
+  constexpr int64_t w_size = 8192;
+
+  onnxruntime::Model model("mmap_model_loading", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto x_type;
+  x_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_UINT8);
+  x_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(x_size);
+  TypeProto w_type;
+  w_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_UINT8);
+  w_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(w_size);
+
+  auto& x_arg = graph.GetOrCreateNodeArg("X", &x_type);
+  auto& w_arg = graph.GetOrCreateNodeArg("W", &w_type);
+  auto& y_arg = graph.GetOrCreateNodeArg("Y", nullptr);
+  std::vector<onnxruntime::NodeArg*> inputs = {&x_arg, &w_arg};
+  std::vector<onnxruntime::NodeArg*> outputs = {&y_arg};
+  auto& concat_node = graph.AddNode("concat", "Concat", "concat", inputs, outputs);
+  concat_node.AddAttribute("axis", int64_t{0});
+
+  std::vector<uint8_t> w_data(w_size);
+  for (size_t i = 0; i < w_data.size(); ++i) {
+    w_data[i] = static_cast<uint8_t>(i * 7);
+  }
+
+  ONNX_NAMESPACE::TensorProto w_proto;
+  w_proto.set_name("W");
+  w_proto.add_dims(w_size);
+  w_proto.set_data_type(TensorProto_DataType_UINT8);
+  w_proto.set_raw_data(w_data.data(), w_data.size());
+  graph.AddInitializedTensor(w_proto);
+
+  ASSERT_STATUS_OK(graph.Resolve());
+  const PathString model_file_name = ORT_TSTR("mmap_model_loading_test.onnx");
+  ASSERT_STATUS_OK(onnxruntime::Model::Save(model, model_file_name));
+
+#ifndef _WIN32
+  // the initializer should now refer to its data within the model file
+  ONNX_NAMESPACE::ModelProto model_proto;
+  ASSERT_STATUS_OK(onnxruntime::Model::LoadMapped(model_file_name, model_proto));
+  ASSERT_EQ(model_proto.graph().initializer_size(), 1);
+  const auto& mapped_w_proto = model_proto.graph().initializer(0);
+  EXPECT_EQ(mapped_w_proto.data_location(), TensorProto_DataLocation_EXTERNAL);
+  EXPECT_FALSE(mapped_w_proto.has_raw_data());
+#endif
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.TestMmapModelLoading";
+  so.use_mmap_for_model_loading = true;
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(model_file_name));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  std::vector<uint8_t> x_data = {1, 2, 3, 4};
+  OrtValue ml_value_x;
+  CreateMLValue<uint8_t>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {x_size}, x_data,
+                         &ml_value_x);
+  NameMLValMap feeds;
+  feeds.insert(std::make_pair("X", ml_value_x));
+
+  std::vector<std::string> output_names{"Y"};
+  std::vector<OrtValue> fetches;
+  RunOptions run_options;
+  run_options.run_tag = so.session_logid;
+  ASSERT_STATUS_OK(session_object.Run(run_options, feeds, output_names, &fetches));
+
+  ASSERT_EQ(fetches.size(), 1u);
+  const auto& y = fetches[0].Get<Tensor>();
+  ASSERT_EQ(y.Shape().Size(), x_size + w_size);
+  std::vector<uint8_t> expected_y(x_data);
+  expected_y.insert(expected_y.end(), w_data.cbegin(), w_data.cend());
+  const uint8_t* y_data = y.Data<uint8_t>();
+  EXPECT_TRUE(std::equal(expected_y.cbegin(), expected_y.cend(), y_data));
+}
+
+TEST(InferenceSessionTests, TestColumnarZipMapOutput) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.TestColumnarZipMapOutput";
+  so.use_columnar_zipmap_output = true;
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(ORT_TSTR("testdata/zipmap_int64float.onnx")));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  // the ZipMap output is now a float tensor, followed by the new output with the labels
+  auto outputs = session_object.GetModelOutputs();
+  ASSERT_STATUS_OK(outputs.first);
+  ASSERT_EQ(outputs.second->size(), 2u);
+  EXPECT_EQ(outputs.second->at(0)->Name(), "Z");
+  EXPECT_EQ(*outputs.second->at(0)->Type(), "tensor(float)");
+  EXPECT_EQ(outputs.second->at(1)->Name(), "Z_labels");
+  EXPECT_EQ(*outputs.second->at(1)->Type(), "tensor(int64)");
+
+  std::vector<float> x_data = {1.f, 0.f, 3.f, 44.f, 23.f, 11.f};
+  OrtValue ml_value_x;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {2, 3}, x_data,
+                       &ml_value_x);
+  NameMLValMap feeds;
+  feeds.insert(std::make_pair("X", ml_value_x));
+
+  std::vector<std::string> output_names{"Z", "Z_labels"};
+  std::vector<OrtValue> fetches;
+  RunOptions run_options;
+  run_options.run_tag = so.session_logid;
+  ASSERT_STATUS_OK(session_object.Run(run_options, feeds, output_names, &fetches));
+
+  ASSERT_EQ(fetches.size(), 2u);
+  const auto& z = fetches[0].Get<Tensor>();
+  ASSERT_EQ(z.Shape(), TensorShape({2, 3}));
+  EXPECT_TRUE(std::equal(x_data.cbegin(), x_data.cend(), z.Data<float>()));
+
+  const auto& labels = fetches[1].Get<Tensor>();
+  std::vector<int64_t> expected_labels = {10, 20, 30};
+  ASSERT_EQ(labels.Shape(), TensorShape({3}));
+  EXPECT_TRUE(std::equal(expected_labels.cbegin(), expected_labels.cend(), labels.Data<int64_t>()));
+}
+
+TEST(InferenceSessionTests, TestColumnarZipMapOutputSavedModel) {
+  std::basic_string<ORTCHAR_T> optimized_model = ORT_TSTR("zipmap_columnar_XXXXXX");
+  FILE* fp;
+  CreateTestFile(fp, optimized_model);
+  ASSERT_EQ(0, fclose(fp));
+  ScopedFileDeleter file_deleter{optimized_model};
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.TestColumnarZipMapOutputSavedModel";
+  so.use_columnar_zipmap_output = true;
+  so.optimized_model_filepath = optimized_model;
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(ORT_TSTR("testdata/zipmap_int64float.onnx")));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  // the saved model has the columnar outputs, so it can't be loaded without the option
+  SessionOptions so_default;
+  so_default.session_logid = so.session_logid;
+  InferenceSession session_default{so_default, GetEnvironment()};
+  EXPECT_FALSE(session_default.Load(optimized_model).IsOK());
+
+  SessionOptions so_columnar;
+  so_columnar.session_logid = so.session_logid;
+  so_columnar.use_columnar_zipmap_output = true;
+  InferenceSession session_columnar{so_columnar, GetEnvironment()};
+  ASSERT_STATUS_OK(session_columnar.Load(optimized_model));
+  ASSERT_STATUS_OK(session_columnar.Initialize());
+
+  auto outputs = session_columnar.GetModelOutputs();
+  ASSERT_STATUS_OK(outputs.first);
+  ASSERT_EQ(outputs.second->size(), 2u);
+  EXPECT_EQ(*outputs.second->at(0)->Type(), "tensor(float)");
+  EXPECT_EQ(outputs.second->at(1)->Name(), "Z_labels");
+}
+
 TEST(InferenceSessionTests, TestRegisterExecutionProvider) {
   SessionOptions so;
 
@@ -166,5 +166,68 @@ TEST_P(SessionStateTestP, TestInitializerProcessing) {
 }
 
 INSTANTIATE_TEST_SUITE_P(SessionStateTests, SessionStateTestP, testing::ValuesIn(param_list));
+
+// Test the bucketing, reuse and eviction of cached memory patterns
+TEST(SessionStateTest, MemoryPatternCachePolicy) {
+  ExecutionProviders execution_providers;
+  SessionState s{execution_providers, true, nullptr, nullptr};
+
+  MemoryPatternCachePolicy policy;
+  policy.max_num_entries = 2;
+  policy.enable_shape_bucketing = true;
+  policy.bucketed_dim_params = {"seq"};
+  s.SetMemoryPatternCachePolicy(policy);
+
+  onnxruntime::Model model("graph_1", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+  TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("batch");
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("seq");
+  auto& input_arg = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& output_arg = graph.GetOrCreateNodeArg("Y", &float_tensor);
+  std::vector<onnxruntime::NodeArg*> inputs{&input_arg};
+  std::vector<onnxruntime::NodeArg*> outputs{&output_arg};
+  graph.AddNode("node_1", "Identity", "node 1.", inputs, outputs);
+  ASSERT_STATUS_OK(graph.Resolve());
+  ASSERT_STATUS_OK(s.SetGraph(graph));
+
+  int x_idx;
+  ASSERT_STATUS_OK(s.GetOrtValueNameIdxMap().GetIdx("X", x_idx));
+  const std::vector<int> feed_mlvalue_idxs{x_idx};
+
+  auto get = [&](const TensorShape& shape) {
+    return s.GetMemoryPatternGroup({std::cref(shape)}, feed_mlvalue_idxs);
+  };
+  auto update = [&](const TensorShape& shape) {
+    ASSERT_STATUS_OK(s.UpdateMemoryPatternGroupCache({std::cref(shape)}, feed_mlvalue_idxs,
+                                                     onnxruntime::make_unique<MemoryPatternGroup>()));
+  };
+
+  update(TensorShape({1, 7}));
+  auto patterns = get(TensorShape({1, 5}));
+  // a smaller sequence length in the same bucket reuses the pattern
+  EXPECT_NE(patterns, nullptr);
+  // a larger one in the same bucket doesn't fit in it
+  EXPECT_EQ(get(TensorShape({1, 8})), nullptr);
+  update(TensorShape({1, 8}));
+  auto larger_patterns = get(TensorShape({1, 6}));
+  EXPECT_NE(larger_patterns, nullptr);
+  EXPECT_NE(larger_patterns, patterns);
+  // batch is not bucketed
+  EXPECT_EQ(get(TensorShape({2, 5})), nullptr);
+
+  // adding 2 more patterns evicts the least recently used one
+  update(TensorShape({2, 5}));
+  update(TensorShape({3, 5}));
+  EXPECT_EQ(get(TensorShape({1, 6})), nullptr);
+  EXPECT_NE(get(TensorShape({2, 5})), nullptr);
+
+  auto stats = s.GetMemoryPatternCacheStats();
+  EXPECT_EQ(stats.num_entries, 2u);
+  EXPECT_EQ(stats.hits, 3u);
+  EXPECT_EQ(stats.misses, 3u);
+  EXPECT_EQ(stats.evictions, 1u);
+}
 }  // namespace test
 }  // namespace onnxruntime
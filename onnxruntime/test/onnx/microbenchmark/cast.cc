@@ -0,0 +1,97 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+#include <core/graph/onnx_protobuf.h>
+#include <core/session/onnxruntime_c_api.h>
+#include <core/session/ort_env.h>
+
+#include <string>
+#include <vector>
+
+extern OrtEnv* env;
+extern const OrtApi* g_ort;
+
+#define ORT_BREAK_ON_ERROR(expr)                                \
+  do {                                                          \
+    OrtStatus* onnx_status = (expr);                            \
+    if (onnx_status != NULL) {                                  \
+      state.SkipWithError(g_ort->GetErrorMessage(onnx_status)); \
+      g_ort->ReleaseStatus(onnx_status);                        \
+      return;                                                   \
+    }                                                           \
+  } while (0);
+
+// Serializes a model with a single Cast node from a 1D tensor of from_type to to_type.
+static std::string CreateCastModel(ONNX_NAMESPACE::TensorProto_DataType from_type,
+                                   ONNX_NAMESPACE::TensorProto_DataType to_type) {
+  ONNX_NAMESPACE::ModelProto model;
+  model.set_ir_version(ONNX_NAMESPACE::IR_VERSION);
+  model.add_opset_import()->set_version(9);
+
+  auto& graph = *model.mutable_graph();
+  graph.set_name("cast");
+  auto& node = *graph.add_node();
+  node.set_op_type("Cast");
+  node.add_input("X");
+  node.add_output("Y");
+  auto& to = *node.add_attribute();
+  to.set_name("to");
+  to.set_type(ONNX_NAMESPACE::AttributeProto_AttributeType_INT);
+  to.set_i(to_type);
+
+  const auto add_value_info = [](ONNX_NAMESPACE::ValueInfoProto& value, const char* name,
+                                 ONNX_NAMESPACE::TensorProto_DataType type) {
+    value.set_name(name);
+    auto& tensor_type = *value.mutable_type()->mutable_tensor_type();
+    tensor_type.set_elem_type(type);
+    tensor_type.mutable_shape()->add_dim()->set_dim_param("N");
+  };
+  add_value_info(*graph.add_input(), "X", from_type);
+  add_value_info(*graph.add_output(), "Y", to_type);
+
+  return model.SerializeAsString();
+}
+
+// In-range float to int32 casts, which take the saturating path of the Cast kernel.
+static void BM_CastFloatToInt32(benchmark::State& state) {
+  const int64_t count = state.range(0);
+  const std::string model = CreateCastModel(ONNX_NAMESPACE::TensorProto_DataType_FLOAT,
+                                            ONNX_NAMESPACE::TensorProto_DataType_INT32);
+
+  std::vector<float> input(static_cast<size_t>(count));
+  for (int64_t i = 0; i < count; ++i) {
+    input[i] = static_cast<float>(i % 2000) * 0.75f - 750.0f;
+  }
+  std::vector<int32_t> output(static_cast<size_t>(count));
+
+  OrtSessionOptions* session_options;
+  ORT_BREAK_ON_ERROR(g_ort->CreateSessionOptions(&session_options));
+  OrtSession* session;
+  ORT_BREAK_ON_ERROR(g_ort->CreateSessionFromArray(env, model.data(), model.size(), session_options, &session));
+  OrtMemoryInfo* memory_info;
+  ORT_BREAK_ON_ERROR(g_ort->CreateCpuMemoryInfo(OrtArenaAllocator, OrtMemTypeDefault, &memory_info));
+
+  OrtValue* input_tensor = nullptr;
+  ORT_BREAK_ON_ERROR(g_ort->CreateTensorWithDataAsOrtValue(memory_info, input.data(), input.size() * sizeof(float),
+                                                           &count, 1, ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT,
+                                                           &input_tensor));
+  OrtValue* output_tensor = nullptr;
+  ORT_BREAK_ON_ERROR(g_ort->CreateTensorWithDataAsOrtValue(memory_info, output.data(), output.size() * sizeof(int32_t),
+                                                           &count, 1, ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32,
+                                                           &output_tensor));
+
+  const char* input_name = "X";
+  const char* output_name = "Y";
+  for (auto _ : state) {
+    ORT_BREAK_ON_ERROR(g_ort->Run(session, nullptr, &input_name, &input_tensor, 1, &output_name, 1, &output_tensor));
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+
+  g_ort->ReleaseValue(output_tensor);
+  g_ort->ReleaseValue(input_tensor);
+  g_ort->ReleaseMemoryInfo(memory_info);
+  g_ort->ReleaseSession(session);
+  g_ort->ReleaseSessionOptions(session_options);
+}
+BENCHMARK(BM_CastFloatToInt32)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20)->UseRealTime();
@@ -34,6 +34,7 @@
 #include "core/optimizer/reshape_fusion.h"
 #include "core/optimizer/attention_fusion.h"
 #include "core/optimizer/fast_gelu_fusion.h"
+#include "core/optimizer/elementwise_fusion.h"
 #include "core/optimizer/utils.h"
 #include "core/platform/env.h"
 #include "core/util/math.h"
@@ -1663,6 +1664,80 @@ TEST(GraphTransformationTests, EmbedLayerNormFusionFormat5) {
   }
 }
 
+TEST(GraphTransformationTests, ElementwiseFusionTest) {
+  Model model("ElementwiseFusion", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto tensor_type;
+  tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+
+  TypeProto scalar_type;
+  scalar_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  scalar_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+  TypeProto bias_type;
+  bias_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  bias_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+
+  // x * w + b -> Tanh -> * x -> + bias
+  // The last Add broadcasts its 1D bias, so it is left out of the chain.
+  auto& x = graph.GetOrCreateNodeArg("x", &tensor_type);
+  auto& w = graph.GetOrCreateNodeArg("w", &tensor_type);
+  auto& b = graph.GetOrCreateNodeArg("b", &scalar_type);
+  auto& bias = graph.GetOrCreateNodeArg("bias", &bias_type);
+  auto& mul0_out = graph.GetOrCreateNodeArg("mul0_out", &tensor_type);
+  auto& add0_out = graph.GetOrCreateNodeArg("add0_out", &tensor_type);
+  auto& tanh_out = graph.GetOrCreateNodeArg("tanh_out", &tensor_type);
+  auto& mul1_out = graph.GetOrCreateNodeArg("mul1_out", &tensor_type);
+  auto& output = graph.GetOrCreateNodeArg("output", &tensor_type);
+
+  graph.AddNode("mul0", "Mul", "", {&x, &w}, {&mul0_out});
+  graph.AddNode("add0", "Add", "", {&b, &mul0_out}, {&add0_out});
+  graph.AddNode("tanh", "Tanh", "", {&add0_out}, {&tanh_out});
+  graph.AddNode("mul1", "Mul", "", {&tanh_out, &x}, {&mul1_out});
+  graph.AddNode("add1", "Add", "", {&mul1_out, &bias}, {&output});
+
+  auto status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(onnxruntime::make_unique<ElementwiseFusion>(), TransformerLevel::Level3);
+  status = graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level3, DefaultLoggingManager().DefaultLogger());
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  EXPECT_EQ(op_to_count["FusedElementwise"], 1);
+  EXPECT_EQ(op_to_count["Mul"], 0);
+  EXPECT_EQ(op_to_count["Tanh"], 0);
+  EXPECT_EQ(op_to_count["Add"], 1);
+
+  for (const Node& node : graph.Nodes()) {
+    if (node.OpType() == "FusedElementwise") {
+      const auto& inputs = node.InputDefs();
+      ASSERT_EQ(inputs.size(), 4u);
+      EXPECT_EQ(inputs[0]->Name(), "x");
+      EXPECT_EQ(inputs[1]->Name(), "w");
+      EXPECT_EQ(inputs[2]->Name(), "b");
+      EXPECT_EQ(inputs[3]->Name(), "x");
+      EXPECT_EQ(node.OutputDefs()[0]->Name(), "mul1_out");
+
+      const auto* ops = graph_utils::GetNodeAttribute(node, "ops");
+      ASSERT_TRUE(ops != nullptr);
+      ASSERT_EQ(ops->strings_size(), 4);
+      EXPECT_EQ(ops->strings(0), "Mul");
+      EXPECT_EQ(ops->strings(1), "Add");
+      EXPECT_EQ(ops->strings(2), "Tanh");
+      EXPECT_EQ(ops->strings(3), "Mul");
+
+      std::vector<int64_t> operand_positions;
+      ASSERT_TRUE(graph_utils::GetRepeatedNodeAttributeValues(node, "operand_positions", operand_positions));
+      EXPECT_EQ(operand_positions, (std::vector<int64_t>{1, 0, -1, 1}));
+    }
+  }
+}
+
 #endif
 
 }  // namespace test
@@ -64,7 +64,7 @@ TEST(OptimizerTest, Basic) {
     nodes.push_back(&node);
   }
 
-  OptimizerExecutionFrame::Info info(nodes, initialized_tensor_set);
+  OptimizerExecutionFrame::Info info(nodes, initialized_tensor_set, graph.ModelPath());
   std::vector<int> fetch_mlvalue_idxs{info.GetMLValueIndex("out")};
   OptimizerExecutionFrame frame(info, fetch_mlvalue_idxs);
   const logging::Logger& logger = DefaultLoggingManager().DefaultLogger();
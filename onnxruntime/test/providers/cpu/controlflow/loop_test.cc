@@ -470,6 +470,116 @@ TEST(Loop, ZeroIterations) {
           {});
 }
 
+// run enough iterations for the buffer the Loop collects the scan output in to grow,
+// and for the buffers of the loop carried variable to be recycled many times.
+TEST(Loop, ManyIterations) {
+  auto create_subgraph = [](const RunOptions&) {
+    Model model("Many iterations subgraph", false, DefaultLoggingManager().DefaultLogger());
+    auto& graph = model.MainGraph();
+
+    std::vector<NodeArg*> inputs;
+    std::vector<NodeArg*> outputs;
+
+    /*
+            Inputs: iter_num, cond_in, loop carried state variables.
+
+         iter_num_in    cond_in    loop_var_0_in  [outer_scope_0]
+           (unused)        |                  |     /
+                       [Identity]            [Add]
+                           |                   |
+                        cond_out         loop_var_0_out
+                                               |
+                                          [Identity]
+                                               |
+                                          loop_out_0
+    */
+
+    // graph inputs types.
+    TypeProto int64_scalar;
+    int64_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+    int64_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    TypeProto bool_scalar;
+    bool_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_BOOL);
+    bool_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    TypeProto float_tensor;
+    float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    float_tensor.mutable_tensor_type()->mutable_shape()->add_dim();
+
+    // graph inputs
+    auto& iter_num_in = graph.GetOrCreateNodeArg("iter_num_in", &int64_scalar);
+    auto& cond_in = graph.GetOrCreateNodeArg("cond_in", &bool_scalar);
+    auto& loop_var_0_in = graph.GetOrCreateNodeArg("loop_var_0_in", &float_tensor);
+
+    // outer scope value. need type but not shape.
+    auto& outer_scope_0 = graph.GetOrCreateNodeArg("outer_scope_0", &float_tensor);
+
+    // add so that we don't end up with it being considered a graph input
+    graph.AddOuterScopeNodeArg("outer_scope_0");
+
+    // graph outputs
+    auto& cond_out = graph.GetOrCreateNodeArg("cond_out", &bool_scalar);
+    auto& loop_var_0_out = graph.GetOrCreateNodeArg("loop_var_0_out", &float_tensor);
+    auto& loop_out_0 = graph.GetOrCreateNodeArg("loop_out_0", &float_tensor);
+
+    // cond_in -> cond_out
+    {
+      inputs = {&cond_in};
+      outputs = {&cond_out};
+
+      graph.AddNode("cond_in_identity", "Identity", "Forward cond_in to cond_out", inputs, outputs);
+    }
+
+    // loop_var_0_in + outer_scope_0 -> loop_var_0_out
+    {
+      inputs = {&loop_var_0_in, &outer_scope_0};
+      outputs = {&loop_var_0_out};
+
+      graph.AddNode("add", "Add", "Add outer_scope_0 to loop_var_0_in", inputs, outputs);
+    }
+
+    // loop_var_0_out -> loop_out_0
+    {
+      inputs = {&loop_var_0_out};
+      outputs = {&loop_out_0};
+
+      graph.AddNode("loop_out_identity", "Identity", "Forward loop_var_0_out to loop_out_0", inputs, outputs);
+    }
+
+    graph.SetInputs({&iter_num_in, &cond_in, &loop_var_0_in});
+    graph.SetOutputs({&cond_out, &loop_var_0_out, &loop_out_0});
+
+    auto status = graph.Resolve();
+    EXPECT_EQ(status, Status::OK());
+
+    return graph.ToGraphProto();
+  };
+
+  const int64_t num_iterations = 40;
+
+  std::vector<float> loop_out_0_final;
+  loop_out_0_final.reserve(num_iterations * 2);
+  for (int64_t i = 1; i <= num_iterations; ++i) {
+    loop_out_0_final.push_back(kOuterNodeAddValue * i);
+    loop_out_0_final.push_back(10.f + kOuterNodeAddValue * i);
+  }
+
+  LoopOpTester test{{}, create_subgraph};
+
+  test.AddInput<int64_t>("M", {1}, {num_iterations});
+  test.AddInput<bool>("cond", {1}, {true});
+  test.AddInput<float>("loop_var_0_orig", {2}, {0.f, 10.f});
+  test.AddInput<float>("outer_scope_0", {1}, {kOuterNodeAddValue});
+
+  test.AddOutput<float>("loop_var_0_final", {2}, {kOuterNodeAddValue * num_iterations,
+                                                  10.f + kOuterNodeAddValue * num_iterations});
+  test.AddOutput<float>("loop_out_0_final", {num_iterations, 2}, loop_out_0_final);
+  test.AddOutput<int64_t>("outer_scope_0_out", {1}, {int64_t(kOuterNodeAddValue)});
+
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
 TEST(Loop, InfiniteLoopTermination) {
   auto create_subgraph = [](const RunOptions&) {
     Model model("Infinite Loop subgraph", false, DefaultLoggingManager().DefaultLogger());
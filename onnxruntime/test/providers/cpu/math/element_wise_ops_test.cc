@@ -276,6 +276,35 @@ TEST(MathOpTest, Add_Broadcast_2x1x1_3x4) {
 #endif
 }
 
+// Large enough to be split across threads, including within a span and in the middle of a broadcast row
+TEST(MathOpTest, Add_Broadcast_Large) {
+  const int64_t batch = 3, rows = 67, cols = 129;
+  std::vector<float> a(batch * rows * cols);
+  std::vector<float> b(rows);
+  std::vector<float> c(batch * rows * cols);
+  std::vector<float> same_shape_c(batch * rows * cols);
+  for (int64_t r = 0; r < rows; ++r) {
+    b[r] = static_cast<float>(r) * 1000.0f;
+  }
+  for (int64_t i = 0; i < batch * rows * cols; ++i) {
+    a[i] = static_cast<float>(i % 997);
+    c[i] = a[i] + b[(i / cols) % rows];
+    same_shape_c[i] = a[i] + a[i];
+  }
+
+  OpTester test("Add");
+  test.AddInput<float>("A", {batch, rows, cols}, a);
+  test.AddInput<float>("B", {rows, 1}, b);
+  test.AddOutput<float>("C", {batch, rows, cols}, c);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+
+  OpTester same_shape_test("Add");
+  same_shape_test.AddInput<float>("A", {batch, rows, cols}, a);
+  same_shape_test.AddInput<float>("B", {batch, rows, cols}, a);
+  same_shape_test.AddOutput<float>("C", {batch, rows, cols}, same_shape_c);
+  same_shape_test.Run();
+}
+
 // Validate runtime failure has useful error message when ORT_ENFORCE is used
 TEST(MathOpTest, Add_Invalid_Broadcast) {
   OpTester test("Add");
@@ -105,6 +105,24 @@ TEST(MathOpTest, MatMulFloatType) {
   RunMatMulTest<float>(7);
 }
 
+TEST(MathOpTest, MatMulFloatTypeInitializer) {
+  // B is a constant initializer so the CPU kernel may prepack it at session initialization.
+  OpTester test("MatMul");
+  test.AddInput<float>("A", {2, 4},
+                       {1.0f, 2.0f, 3.0f, 4.0f,
+                        -1.0f, -2.0f, -3.0f, -4.0f});
+  test.AddInput<float>("B", {4, 3},
+                       {1.0f, 0.0f, 2.0f,
+                        0.0f, 1.0f, 1.0f,
+                        1.0f, 1.0f, 0.0f,
+                        2.0f, 0.0f, 1.0f},
+                       true);
+  test.AddOutput<float>("Y", {2, 3},
+                        {12.0f, 5.0f, 8.0f,
+                         -12.0f, -5.0f, -8.0f});
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
 TEST(MathOpTest, MatMulDoubleType) {
   RunMatMulTest<double>(7);
 }
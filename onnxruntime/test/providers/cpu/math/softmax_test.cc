@@ -179,6 +179,33 @@ TEST(SoftmaxOperator, ThreeDimsNegativeAxis) {
   RunTest(x_vals_3dims, expected_vals, three_dimensions, /*axis*/ -1);
 }
 
+// Large enough for the rows to be split across threads.
+TEST(SoftmaxOperator, ManyRows) {
+  const int64_t N = 256;
+  const int64_t D = 130;
+  std::vector<float> x_vals(N * D);
+  std::vector<float> expected_vals(N * D);
+
+  for (int64_t i = 0; i < N * D; ++i) {
+    x_vals[i] = static_cast<float>((i * 7) % 41) * 0.25f - 5.0f;
+  }
+
+  for (int64_t n = 0; n < N; ++n) {
+    const float* x = x_vals.data() + n * D;
+    float* y = expected_vals.data() + n * D;
+    const float max = *std::max_element(x, x + D);
+    double sum = 0.0;
+    for (int64_t d = 0; d < D; ++d) {
+      sum += std::exp(static_cast<double>(x[d] - max));
+    }
+    for (int64_t d = 0; d < D; ++d) {
+      y[d] = static_cast<float>(std::exp(static_cast<double>(x[d] - max)) / sum);
+    }
+  }
+
+  RunTest(x_vals, expected_vals, {N, D});
+}
+
 TEST(SoftmaxOperator, InvalidAxis) {
   std::vector<float> x_vals = {-1.0f, 0.0f, 1.0f};
   std::vector<float> expected_vals = {0.0f, 0.0f, 0.0f};
@@ -462,10 +462,6 @@ TEST(TopKOperator, SelectFirstSortNextInt64) {
 }
 
 TEST(TopKOperator, SortedSelection) {
-  // in this test, we will use sorted selection (using heap)
-  // Select + Sort  = O(n + k * ln(k)) = 10 + 5 * ln(5) = 18.04
-  // Sorted selection: O(n * ln(k)) = 10 * ln(5) = 16.09
-  // The algorithm used will be Sorted selection
   std::vector<float> input_vals = {10.0f, 8.0f, 7.0f, 4.0f, 5.0f, 6.0f, 1.0f, 2.0f, 9.0f, 3.0};
   std::vector<int64_t> input_dimensions = {10};
   std::vector<float> expected_vals = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f};
@@ -532,5 +528,64 @@ TEST(TopKOperator, BigArrayBigTopKSorted) {
   RunTest(11, 9000, input_vals, input_dimensions, expected_vals, expected_indices, expected_dimensions, false, 0, 1, 1);
 }
 
+// k is small compared to the axis size, so the threshold filter is used.
+// Ties must keep the lowest indices.
+TEST(TopKOperator, LargeAxisSmallKThresholdFilter) {
+  const int64_t rows = 3;
+  const int64_t vocab_size = 5000;
+  const int64_t k = 4;
+  std::vector<float> input_vals(rows * vocab_size);
+  for (int64_t i = 0; i < rows; ++i) {
+    for (int64_t j = 0; j < vocab_size; ++j) {
+      input_vals[i * vocab_size + j] = static_cast<float>((j * 37 + i) % 1000);
+    }
+  }
+  std::vector<int64_t> input_dimensions = {rows, vocab_size};
+  std::vector<float> expected_vals;
+  std::vector<int64_t> expected_indices;
+  for (int64_t i = 0; i < rows; ++i) {
+    std::vector<int64_t> order(vocab_size);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int64_t a, int64_t b) {
+      return input_vals[i * vocab_size + a] > input_vals[i * vocab_size + b];
+    });
+    for (int64_t l = 0; l < k; ++l) {
+      expected_vals.push_back(input_vals[i * vocab_size + order[l]]);
+      expected_indices.push_back(order[l]);
+    }
+  }
+  std::vector<int64_t> expected_dimensions = {rows, k};
+  RunTest(11, k, input_vals, input_dimensions, expected_vals, expected_indices, expected_dimensions, false);
+}
+
+// k is large and the axis is long, so the radix select is used.
+// The axis is not the innermost one, and ties must keep the lowest indices.
+TEST(TopKOperator, LargeAxisLargeKRadixSelect) {
+  const int64_t axis_size = 2000;
+  const int64_t inner = 2;
+  const int64_t k = 700;
+  std::vector<int64_t> input_vals(axis_size * inner);
+  for (int64_t l = 0; l < axis_size; ++l) {
+    input_vals[l * inner] = (l * 7) % 100 - 50;
+    input_vals[l * inner + 1] = -((l * 13) % 300) * 1000000000000LL;
+  }
+  std::vector<int64_t> input_dimensions = {axis_size, inner};
+  std::vector<int64_t> expected_vals(k * inner);
+  std::vector<int64_t> expected_indices(k * inner);
+  for (int64_t j = 0; j < inner; ++j) {
+    std::vector<int64_t> order(axis_size);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int64_t a, int64_t b) {
+      return input_vals[a * inner + j] < input_vals[b * inner + j];
+    });
+    for (int64_t l = 0; l < k; ++l) {
+      expected_vals[l * inner + j] = input_vals[order[l] * inner + j];
+      expected_indices[l * inner + j] = order[l];
+    }
+  }
+  std::vector<int64_t> expected_dimensions = {k, inner};
+  RunTest(11, k, input_vals, input_dimensions, expected_vals, expected_indices, expected_dimensions, false, 0, 0);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -59,8 +59,9 @@ void GenTreeAndRunTest(const std::vector<T>& X, const std::vector<float>& base_v
     test.AddInput<T>("X", {1, 3}, X1);
     test.AddOutput<float>("Y", {1, 2}, results1);
   } else {
-    test.AddInput<T>("X", {8, 3}, X);
-    test.AddOutput<float>("Y", {8, 2}, results);
+    int64_t n_rows = static_cast<int64_t>(X.size() / 3);
+    test.AddInput<T>("X", {n_rows, 3}, X);
+    test.AddOutput<float>("Y", {n_rows, 2}, results);
   }
   test.Run();
 }  // namespace test
@@ -73,6 +74,17 @@ TEST(MLOpTest, TreeRegressorMultiTargetAverage) {
   GenTreeAndRunTest<float>(X, base_values, results, "AVERAGE", true);
 }
 
+TEST(MLOpTest, TreeRegressorMultiTargetAverageManyRows) {
+  // more rows than evaluated together through a tree, the last block is partial
+  std::vector<float> X = {1.f, 0.0f, 0.4f, 3.0f, 44.0f, -3.f, 12.0f, 12.9f, -312.f, 23.0f, 11.3f, -222.f, 23.0f, 11.3f, -222.f, 23.0f, 3311.3f, -222.f, 23.0f, 11.3f, -222.f, 43.0f, 413.3f, -114.f};
+  std::vector<float> results = {1.33333333f, 29.f, 3.f, 14.f, 2.f, 23.f, 2.f, 23.f, 2.f, 23.f, 2.66666667f, 17.f, 2.f, 23.f, 3.f, 14.f};
+  std::vector<float> X_head(X.begin(), X.begin() + 9);
+  std::vector<float> results_head(results.begin(), results.begin() + 6);
+  X.insert(X.end(), X_head.begin(), X_head.end());
+  results.insert(results.end(), results_head.begin(), results_head.end());
+  GenTreeAndRunTest<float>(X, {0.f, 0.f}, results, "AVERAGE");
+}
+
 TEST(MLOpTest, TreeRegressorMultiTargetMin) {
   std::vector<float> X = {1.f, 0.0f, 0.4f, 3.0f, 44.0f, -3.f, 12.0f, 12.9f, -312.f, 23.0f, 11.3f, -222.f, 23.0f, 11.3f, -222.f, 23.0f, 3311.3f, -222.f, 23.0f, 11.3f, -222.f, 43.0f, 413.3f, -114.f};
   std::vector<float> results = {5.f, 28.f, 8.f, 19.f, 7.f, 28.f, 7.f, 28.f, 7.f, 28.f, 7.f, 19.f, 7.f, 28.f, 8.f, 19.f};
@@ -383,5 +383,48 @@ TEST(NonMaxSuppressionOpTest, WithIOUThresholdOpset11) {
   test.Run();
 }
 
+// More selected boxes than are compared against a candidate at once, for several batches and classes.
+// Boxes 0-19 are disjoint unit boxes and boxes 20-39 are shifted copies of them.
+TEST(NonMaxSuppressionOpTest, ManyBoxesTwoBatchesTwoClasses) {
+  const int64_t num_pairs = 20;
+  std::vector<float> boxes;
+  for (int64_t batch = 0; batch < 2; ++batch) {
+    for (int64_t copy = 0; copy < 2; ++copy) {
+      for (int64_t i = 0; i < num_pairs; ++i) {
+        const float x = 2.0f * i + 0.1f * copy + batch;
+        boxes.insert(boxes.end(), {0.0f, x, 1.0f, x + 1.0f});
+      }
+    }
+  }
+  // class 0 prefers the original boxes, class 1 prefers the copies
+  std::vector<float> scores;
+  for (int64_t batch = 0; batch < 2; ++batch) {
+    for (int64_t class_index = 0; class_index < 2; ++class_index) {
+      for (int64_t copy = 0; copy < 2; ++copy) {
+        for (int64_t i = 0; i < num_pairs; ++i) {
+          scores.push_back((copy == class_index ? 0.9f : 0.5f) - 0.01f * i);
+        }
+      }
+    }
+  }
+  std::vector<int64_t> expected;
+  for (int64_t batch = 0; batch < 2; ++batch) {
+    for (int64_t class_index = 0; class_index < 2; ++class_index) {
+      for (int64_t i = 0; i < num_pairs; ++i) {
+        expected.insert(expected.end(), {batch, class_index, class_index * num_pairs + i});
+      }
+    }
+  }
+
+  OpTester test("NonMaxSuppression", 11, kOnnxDomain);
+  test.AddInput<float>("boxes", {2, 2 * num_pairs, 4}, boxes);
+  test.AddInput<float>("scores", {2, 2, 2 * num_pairs}, scores);
+  test.AddInput<int64_t>("max_output_boxes_per_class", {}, {30L});
+  test.AddInput<float>("iou_threshold", {}, {0.5f});
+  test.AddInput<float>("score_threshold", {}, {0.0f});
+  test.AddOutput<int64_t>("selected_indices", {4 * num_pairs, 3}, expected);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -1835,6 +1835,83 @@ TEST(ReductionOpTest, ArgMin_int32_neg_axis) {
   test.Run();
 }
 
+// Reduces a {d0, d1, d2} tensor on 'axes' with a straightforward loop and compares it with the kernel. The shapes
+// used below exercise the full, contiguous inner and strided outer reductions, and the transposed fallback.
+static void TestReduceLayout(const std::string& op, const std::vector<int64_t>& dims,
+                             const std::vector<int64_t>& axes) {
+  std::default_random_engine generator(0);
+  std::uniform_real_distribution<float> distribution(0.5f, 1.5f);
+  std::vector<float> X(static_cast<size_t>(dims[0] * dims[1] * dims[2]));
+  for (auto& x : X) {
+    x = distribution(generator);
+  }
+
+  std::vector<bool> reduced(3, false);
+  for (auto axis : axes) {
+    reduced[axis] = true;
+  }
+  std::vector<int64_t> output_dims(3);
+  for (size_t i = 0; i < 3; ++i) {
+    output_dims[i] = reduced[i] ? 1 : dims[i];
+  }
+  const int64_t reduce_count = static_cast<int64_t>(X.size()) / (output_dims[0] * output_dims[1] * output_dims[2]);
+
+  std::vector<double> accumulators(static_cast<size_t>(output_dims[0] * output_dims[1] * output_dims[2]),
+                                   op == "ReduceMax" ? std::numeric_limits<double>::lowest() : 0.0);
+  for (int64_t i = 0; i < dims[0]; ++i) {
+    for (int64_t j = 0; j < dims[1]; ++j) {
+      for (int64_t k = 0; k < dims[2]; ++k) {
+        const double x = X[static_cast<size_t>((i * dims[1] + j) * dims[2] + k)];
+        const int64_t o = ((reduced[0] ? 0 : i) * output_dims[1] + (reduced[1] ? 0 : j)) * output_dims[2] +
+                          (reduced[2] ? 0 : k);
+        auto& accumulator = accumulators[static_cast<size_t>(o)];
+        if (op == "ReduceMax") {
+          accumulator = std::max(accumulator, x);
+        } else if (op == "ReduceL2") {
+          accumulator += x * x;
+        } else {
+          accumulator += x;
+        }
+      }
+    }
+  }
+
+  std::vector<float> Y(accumulators.size());
+  for (size_t o = 0; o < Y.size(); ++o) {
+    double value = accumulators[o];
+    if (op == "ReduceMean") {
+      value /= static_cast<double>(reduce_count);
+    } else if (op == "ReduceL2") {
+      value = std::sqrt(value);
+    }
+    Y[o] = static_cast<float>(value);
+  }
+
+  OpTester test(op.c_str());
+  test.AddAttribute("keepdims", static_cast<int64_t>(1));
+  test.AddAttribute("axes", axes);
+  test.AddInput<float>("data", dims, X);
+  test.AddOutput<float>("reduced", output_dims, Y);
+  test.SetOutputRelErr("reduced", 1e-4f);
+  test.Run();
+}
+
+TEST(ReductionOpTest, ReduceLayouts) {
+  for (const char* op : {"ReduceSum", "ReduceMean", "ReduceMax", "ReduceL2"}) {
+    // full reduction, spanning several chunks
+    TestReduceLayout(op, {3, 100, 129}, {0, 1, 2});
+    // contiguous inner reduction
+    TestReduceLayout(op, {7, 5, 301}, {1, 2});
+    TestReduceLayout(op, {1, 40, 3}, {2});
+    // strided outer reduction, with and without an outer dimension
+    TestReduceLayout(op, {37, 3, 1100}, {0});
+    TestReduceLayout(op, {4, 37, 1100}, {1});
+    TestReduceLayout(op, {1, 9, 7}, {1});
+    // the reduced axes aren't adjacent
+    TestReduceLayout(op, {6, 5, 33}, {0, 2});
+  }
+}
+
 // test that PrepareForReduce handles this case. Called by all reduction ops so any op can be used in the test
 TEST(ReductionOpTest, ReduceDimWithZero) {
   auto run = [](OpTester& tester, const std::string& error_msg = "") {
@@ -325,5 +325,53 @@ TEST(GatherOpTest, Gather_axis1_neg_indices2d_int8) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});  //TensorRT: Assertion `regionRanges != nullptr' failed
 }
 
+// Gathers rows of a (rows, embedding_size) table. The row sizes cover the fixed size block copies and the generic one.
+static void RunEmbeddingLookupTest(int64_t embedding_size) {
+  const int64_t rows = 97;
+  const int64_t lookups = 300;
+
+  std::vector<float> table(rows * embedding_size);
+  for (size_t i = 0; i < table.size(); ++i) {
+    table[i] = static_cast<float>(i);
+  }
+
+  std::vector<int64_t> indices(lookups);
+  std::vector<float> output;
+  output.reserve(lookups * embedding_size);
+  for (int64_t i = 0; i < lookups; ++i) {
+    int64_t row = (i * 31) % rows;
+    indices[i] = (i % 2 == 0) ? row : row - rows;
+    output.insert(output.end(), table.begin() + row * embedding_size, table.begin() + (row + 1) * embedding_size);
+  }
+
+  OpTester test("Gather", 11);
+  test.AddAttribute<int64_t>("axis", 0LL);
+  test.AddInput<float>("data", {rows, embedding_size}, table);
+  test.AddInput<int64_t>("indices", {3, lookups / 3}, indices);
+  test.AddOutput<float>("output", {3, lookups / 3, embedding_size}, output);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
+TEST(GatherOpTest, Gather_embedding_lookup) {
+  for (int64_t embedding_size : {1, 2, 3, 4, 8, 16, 17}) {
+    RunEmbeddingLookupTest(embedding_size);
+  }
+}
+
+TEST(GatherOpTest, Gather_axis0_string_block) {
+  OpTester test("Gather");
+  test.AddAttribute<int64_t>("axis", 0LL);
+  test.AddInput<std::string>("data", {3, 2},
+                             {"a", "b",
+                              "c", "d",
+                              "e", "f"});
+  test.AddInput<int64_t>("indices", {3}, {2LL, 0LL, -2LL});
+  test.AddOutput<std::string>("output", {3, 2},
+                              {"e", "f",
+                               "a", "b",
+                               "c", "d"});
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -841,5 +841,50 @@ TEST(UpsampleOpTest, ResizeOpNearestNoScaleTest_Ver10) {
   test.Run();
 }
 
+// Bilinear interpolation reproduces a linear function of the coordinates exactly, so the expected output
+// of a larger multi-channel image can be computed directly from the original coordinates.
+TEST(ResizeOpTest, ResizeOpLinearUpSampleTest_4DBilinear_MultiChannelRamp) {
+  OpTester test("Resize", 11);
+  std::vector<float> roi{};
+  std::vector<float> scales{};
+
+  test.AddAttribute("mode", "linear");
+  test.AddAttribute("coordinate_transformation_mode", "align_corners");
+
+  const int64_t N = 2, C = 3, H = 7, W = 11;
+  const int64_t output_height = 19, output_width = 26;
+  std::vector<int64_t> sizes{N, C, output_height, output_width};
+
+  auto ramp = [](int64_t channel, float y, float x) {
+    return static_cast<float>(channel) * 10.0f + 0.3f * y - 0.2f * x;
+  };
+
+  std::vector<float> X;
+  for (int64_t channel = 0; channel < N * C; ++channel) {
+    for (int64_t y = 0; y < H; ++y) {
+      for (int64_t x = 0; x < W; ++x) {
+        X.push_back(ramp(channel, static_cast<float>(y), static_cast<float>(x)));
+      }
+    }
+  }
+
+  std::vector<float> Y;
+  for (int64_t channel = 0; channel < N * C; ++channel) {
+    for (int64_t y = 0; y < output_height; ++y) {
+      for (int64_t x = 0; x < output_width; ++x) {
+        Y.push_back(ramp(channel, static_cast<float>(y) * (H - 1) / (output_height - 1),
+                         static_cast<float>(x) * (W - 1) / (output_width - 1)));
+      }
+    }
+  }
+
+  test.AddInput<float>("X", {N, C, H, W}, X);
+  test.AddInput<float>("roi", {0}, roi);
+  test.AddInput<float>("scales", {0}, scales);
+  test.AddInput<int64_t>("sizes", {4}, sizes);
+  test.AddOutput<float>("Y", {N, C, output_height, output_width}, Y);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
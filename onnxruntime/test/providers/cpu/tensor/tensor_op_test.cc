@@ -263,6 +263,77 @@ TEST(TensorOpTest, CastFromFloat16) {
   TestCastOp(input, int64_t_data, shape, TensorProto::INT64);
 }
 
+TEST(TensorOpTest, CastFloat16RoundTrip) {
+  // odd element count so the vectorized conversions also hit their partial vector paths
+  const std::vector<int64_t> shape{1003};
+  std::vector<float> float_data(1003);
+  std::vector<MLFloat16> float16_data(1003);
+  for (size_t i = 0; i < float_data.size(); ++i) {
+    float_data[i] = static_cast<float>(i) * 0.25f - 100.0f;
+    float16_data[i] = MLFloat16(math::floatToHalf(float_data[i]));
+  }
+
+  OpTester to_float16("Cast", 9);
+  to_float16.AddAttribute("to", int64_t{TensorProto::FLOAT16});
+  to_float16.AddInput<float>("input", shape, float_data);
+  to_float16.AddOutput<MLFloat16>("output", shape, float16_data);
+  to_float16.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+
+  OpTester from_float16("Cast", 9);
+  from_float16.AddAttribute("to", int64_t{TensorProto::FLOAT});
+  from_float16.AddInput<MLFloat16>("input", shape, float16_data);
+  from_float16.AddOutput<float>("output", shape, float_data);
+  from_float16.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
+TEST(TensorOpTest, CastFloatToIntSaturates) {
+  const std::vector<int64_t> shape{2, 3};
+  const std::vector<float> input = {NAN, -1000.0f, 1000.0f, 1.5f, -1.5f, 127.0f};
+
+  OpTester to_int8("Cast", 9);
+  to_int8.AddAttribute("to", int64_t{TensorProto::INT8});
+  to_int8.AddInput<float>("input", shape, input);
+  to_int8.AddOutput<int8_t>("output", shape, {0, -128, 127, 1, -1, 127});
+  to_int8.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kCudaExecutionProvider});
+
+  OpTester to_uint8("Cast", 9);
+  to_uint8.AddAttribute("to", int64_t{TensorProto::UINT8});
+  to_uint8.AddInput<float>("input", shape, input);
+  to_uint8.AddOutput<uint8_t>("output", shape, {0, 0, 255, 1, 0, 127});
+  to_uint8.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kCudaExecutionProvider});
+}
+
+TEST(TensorOpTest, CastFloatToInt32Saturates) {
+  // INT32_MAX rounds up to 2^31 as a float, so the largest float below it must still convert exactly. The size is
+  // large enough for the cast to be split across the thread pool and to hit the partial vector paths.
+  const int64_t count = 4099;
+  const std::vector<int64_t> shape{count};
+  std::vector<float> input(count);
+  std::vector<int32_t> output(count);
+  for (int64_t i = 0; i < count; ++i) {
+    input[i] = static_cast<float>(i) * 0.5f - 1000.25f;
+    output[i] = static_cast<int32_t>(input[i]);
+  }
+  input[0] = NAN;
+  output[0] = 0;
+  input[1] = 2147483648.0f;
+  output[1] = std::numeric_limits<int32_t>::max();
+  input[2] = 2147483520.0f;
+  output[2] = 2147483520;
+  input[3] = -2147483648.0f;
+  output[3] = std::numeric_limits<int32_t>::lowest();
+  input[4] = -1e20f;
+  output[4] = std::numeric_limits<int32_t>::lowest();
+  input[5] = INFINITY;
+  output[5] = std::numeric_limits<int32_t>::max();
+
+  OpTester test("Cast", 9);
+  test.AddAttribute("to", int64_t{TensorProto::INT32});
+  test.AddInput<float>("input", shape, input);
+  test.AddOutput<int32_t>("output", shape, output);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kCudaExecutionProvider});
+}
+
 TEST(TensorOpTest, CastFromString) {
   const std::vector<int64_t> shape{2, 2, 2};
   std::initializer_list<std::string> string_data = {"-inf", "+INF", "0.9767611f", "0.28280696f",
@@ -279,6 +350,15 @@ TEST(TensorOpTest, CastFromString) {
   std::initializer_list<std::string> int_64_string_data = {"0", "1", "2", "3", "4", "5", "-9223372036854775808", "9223372036854775807"};
   const std::initializer_list<int64_t> int_64_output = {0, 1, 2, 3, 4, 5, LLONG_MIN, LLONG_MAX};
   TestCastOp(int_64_string_data, int_64_output, shape, TensorProto::INT64);
+
+  // strings that are not plain decimal integers are parsed by the standard library
+  std::initializer_list<std::string> int_32_string_data = {" 12", "+7", "-3", "0042", "12abc", "0x10", "-0", "2147483647"};
+  const std::initializer_list<int32_t> int_32_output = {12, 7, -3, 42, 12, 0, 0, INT_MAX};
+  TestCastOp(int_32_string_data, int_32_output, shape, TensorProto::INT32);
+
+  std::initializer_list<std::string> uint_8_string_data = {"0", "1", "+2", "255", "-1", " 7", "8x", "009"};
+  const std::initializer_list<uint8_t> uint_8_output = {0, 1, 2, 255, 255, 7, 8, 9};
+  TestCastOp(uint_8_string_data, uint_8_output, shape, TensorProto::UINT8);
 }
 
 TEST(TensorOpTest, CastToString) {
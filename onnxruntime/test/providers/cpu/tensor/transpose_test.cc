@@ -414,5 +414,70 @@ TEST(TransposeOpTest, SingleAxisMovingInwardsBlockCopy) {
 
   TransposeTest(input_shape, input_vals, &perm, expected_shape, expected_vals, false, false);
 }
+
+// Transposes a tensor of the given shape filled with 0, 1, 2, ... and checks it against a reference transpose.
+template <typename T>
+static void TransposeSequenceTest(const std::vector<int64_t>& input_shape, const std::vector<int64_t>& perm) {
+  const size_t rank = input_shape.size();
+  std::vector<int64_t> input_strides(rank, 1);
+  for (size_t i = rank - 1; i > 0; --i) {
+    input_strides[i - 1] = input_strides[i] * input_shape[i];
+  }
+  const int64_t size = input_strides[0] * input_shape[0];
+
+  std::vector<T> input_vals(size);
+  for (int64_t i = 0; i < size; ++i) {
+    input_vals[i] = static_cast<T>(i);
+  }
+
+  std::vector<int64_t> expected_shape(rank);
+  for (size_t i = 0; i < rank; ++i) {
+    expected_shape[i] = input_shape[perm[i]];
+  }
+
+  std::vector<T> expected_vals(size);
+  std::vector<int64_t> index(rank, 0);
+  for (int64_t i = 0; i < size; ++i) {
+    int64_t input_offset = 0;
+    for (size_t j = 0; j < rank; ++j) {
+      input_offset += index[j] * input_strides[perm[j]];
+    }
+    expected_vals[i] = input_vals[input_offset];
+    for (size_t j = rank; j-- > 0;) {
+      if (++index[j] < expected_shape[j]) break;
+      index[j] = 0;
+    }
+  }
+
+  OpTester test("Transpose");
+  test.AddAttribute("perm", perm);
+  test.AddInput<T>("X", input_shape, input_vals);
+  test.AddOutput<T>("Y", expected_shape, expected_vals);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
+}
+
+// test to cover the tiled transpose kernels, including the partial tiles at the edges of the matrices
+TEST(TransposeOpTest, SingleAxisTiledTranspose) {
+  // swap of the last two axes
+  TransposeSequenceTest<float>({3, 37, 19}, {0, 2, 1});
+  TransposeSequenceTest<uint8_t>({3, 37, 19}, {0, 2, 1});
+  TransposeSequenceTest<int16_t>({3, 37, 19}, {0, 2, 1});
+  TransposeSequenceTest<double>({3, 37, 19}, {0, 2, 1});
+
+  // NCHW to NHWC and back
+  TransposeSequenceTest<float>({2, 13, 9, 5}, {0, 2, 3, 1});
+  TransposeSequenceTest<uint8_t>({2, 13, 9, 5}, {0, 2, 3, 1});
+  TransposeSequenceTest<float>({2, 9, 5, 13}, {0, 3, 1, 2});
+  TransposeSequenceTest<uint8_t>({2, 9, 5, 13}, {0, 3, 1, 2});
+
+  // attention heads: (batch, sequence, heads, head_size) to (batch, heads, sequence, head_size)
+  TransposeSequenceTest<float>({2, 33, 4, 3}, {0, 2, 1, 3});
+}
+
+// test to cover the element-wise path that splits the elements across threads
+TEST(TransposeOpTest, MultiAxisTranspose) {
+  TransposeSequenceTest<float>({3, 5, 7, 9}, {3, 1, 0, 2});
+  TransposeSequenceTest<int64_t>({3, 5, 7, 9}, {2, 3, 0, 1});
+}
 }  // namespace test
 }  // namespace onnxruntime
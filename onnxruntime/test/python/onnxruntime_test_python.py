@@ -369,6 +369,21 @@ class TestInferenceSession(unittest.TestCase):
         res = sess.run([output_name], {x_name: x})
         self.assertEqual(output_expected, res[0])
 
+    def testZipMapColumnarOutput(self):
+        so = onnxrt.SessionOptions()
+        so.use_columnar_zipmap_output = True
+        sess = onnxrt.InferenceSession(self.get_name("zipmap_stringfloat.onnx"), sess_options=so)
+        x = np.array([1.0, 0.0, 3.0, 44.0, 23.0, 11.0], dtype=np.float32).reshape((2, 3))
+
+        outputs = sess.get_outputs()
+        self.assertEqual([output.name for output in outputs], ["Z", "Z_labels"])
+        self.assertEqual(outputs[0].type, 'tensor(float)')
+        self.assertEqual(outputs[1].type, 'tensor(string)')
+
+        res = sess.run(None, {"X": x})
+        np.testing.assert_equal(x, res[0])
+        np.testing.assert_equal(np.array(['class1', 'class2', 'class3'], dtype=object), res[1])
+
     def testRaiseWrongNumInputs(self):
         with self.assertRaises(ValueError) as context:
             sess = onnxrt.InferenceSession(self.get_name("logicaland.onnx"))
@@ -476,6 +476,61 @@ TEST(CApiTest, end_profiling) {
   ASSERT_TRUE(std::string(profile_file) == std::string());
 }
 
+// The CPU arena is only created on x64.
+#if defined(__amd64__) || defined(_M_AMD64)
+TEST(CApiTest, arena_stats) {
+  Ort::SessionOptions session_options;
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+  std::vector<Input> inputs(1);
+  Input& input = inputs.back();
+  input.name = "X";
+  input.dims = {3, 2};
+  input.values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+
+  auto default_allocator = onnxruntime::make_unique<MockedOrtAllocator>();
+  RunSession<float>(default_allocator.get(), session, inputs, "Y", {3, 2}, {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f},
+                    nullptr);
+
+  Ort::MemoryInfo info("Cpu", OrtArenaAllocator, 0, OrtMemTypeDefault);
+  OrtArenaStats stats = session.GetArenaStats(info);
+  EXPECT_GT(stats.num_allocs, 0);
+  EXPECT_GT(stats.total_allocated_bytes, 0);
+  EXPECT_GE(stats.max_bytes_in_use, stats.bytes_in_use);
+  EXPECT_LE(stats.largest_free_block, stats.free_bytes);
+}
+
+TEST(CApiTest, arena_shrinkage) {
+  Ort::SessionOptions session_options;
+  session_options.SetArenaExtendStrategy(ORT_ARENA_EXTEND_SAME_AS_REQUESTED);
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+  std::vector<int64_t> dims = {3, 2};
+  std::vector<float> values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  Ort::MemoryInfo input_info = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeCPU);
+  Ort::Value input = Ort::Value::CreateTensor<float>(input_info, values.data(), values.size(),
+                                                     dims.data(), dims.size());
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+
+  Ort::MemoryInfo info("Cpu", OrtArenaAllocator, 0, OrtMemTypeDefault);
+  session.Run(Ort::RunOptions{}, input_names, &input, 1, output_names, 1);
+  OrtArenaStats before = session.GetArenaStats(info);
+
+  Ort::RunOptions run_options;
+  run_options.SetArenaShrinkage(true);
+  auto outputs = session.Run(run_options, input_names, &input, 1, output_names, 1);
+  ASSERT_EQ(outputs.size(), 1u);
+  const float* y = outputs[0].GetTensorMutableData<float>();
+  for (size_t i = 0; i < values.size(); i++) {
+    EXPECT_EQ(y[i], values[i] * values[i]);
+  }
+
+  OrtArenaStats after = session.GetArenaStats(info);
+  EXPECT_LE(after.total_allocated_bytes, before.total_allocated_bytes);
+}
+#endif
+
 TEST(CApiTest, model_metadata) {
   Ort::MemoryInfo info("Cpu", OrtDeviceAllocator, 0, OrtMemTypeDefault);
   auto allocator = onnxruntime::make_unique<MockedOrtAllocator>();
@@ -0,0 +1,347 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <sstream>
+
+#include "batch_scheduler.h"
+#include "environment.h"
+#include "executor.h"
+#include "util.h"
+
+namespace onnxruntime {
+namespace server {
+
+namespace protobufutil = google::protobuf::util;
+
+// Returns the size in bytes of a fixed size tensor element, or 0 if the type cannot be batched.
+static size_t GetElementSize(ONNXTensorElementDataType type) {
+  switch (type) {
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT32:
+      return 4;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT64:
+      return 8;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BFLOAT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT16:
+      return 2;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL:
+      return 1;
+    default:
+      return 0;
+  }
+}
+
+static size_t FindInput(const std::vector<std::string>& input_names, const std::string& name) {
+  return static_cast<size_t>(std::find(input_names.begin(), input_names.end(), name) - input_names.begin());
+}
+
+BatchScheduler::BatchScheduler(ServerEnvironment* server_env, size_t max_batch_size,
+                               std::chrono::microseconds batch_timeout)
+    : env_(server_env), max_batch_size_(max_batch_size), batch_timeout_(batch_timeout) {}
+
+bool BatchScheduler::GetBatchKey(const std::string& model_name,
+                                 const std::string& model_version,
+                                 const std::vector<std::string>& input_names,
+                                 std::vector<Ort::Value>& input_values,
+                                 const std::vector<std::string>& output_names,
+                                 /* out */ std::string& key,
+                                 /* out */ int64_t& batch_size) {
+  if (input_values.empty()) {
+    return false;
+  }
+
+  // Requests carry their inputs in map order, so the key is built from the inputs sorted by name.
+  std::vector<size_t> order(input_names.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&input_names](size_t a, size_t b) { return input_names[a] < input_names[b]; });
+
+  std::ostringstream key_stream;
+  key_stream << model_name.size() << ':' << model_name << model_version.size() << ':' << model_version;
+
+  batch_size = -1;
+  for (auto i : order) {
+    auto& value = input_values[i];
+    if (!value.IsTensor()) {
+      return false;
+    }
+
+    auto type_and_shape = value.GetTensorTypeAndShapeInfo();
+    auto type = type_and_shape.GetElementType();
+    auto shape = type_and_shape.GetShape();
+    if (GetElementSize(type) == 0 || shape.empty() || shape[0] <= 0) {
+      return false;
+    }
+
+    if (batch_size == -1) {
+      batch_size = shape[0];
+    } else if (batch_size != shape[0]) {
+      return false;
+    }
+
+    key_stream << input_names[i].size() << ':' << input_names[i] << '|' << static_cast<int>(type);
+    for (size_t d = 1; d < shape.size(); ++d) {
+      key_stream << ',' << shape[d];
+    }
+    key_stream << ';';
+  }
+
+  key_stream << "->";
+  for (const auto& name : output_names) {
+    key_stream << name.size() << ':' << name;
+  }
+
+  key = key_stream.str();
+  return true;
+}
+
+protobufutil::Status BatchScheduler::Schedule(const std::string& model_name,
+                                              const std::string& model_version,
+                                              const std::string& request_id,
+                                              const std::vector<std::string>& input_names,
+                                              std::vector<Ort::Value>& input_values,
+                                              const std::vector<std::string>& output_names,
+                                              /* out */ std::vector<Ort::Value>& outputs) {
+  auto request = std::make_shared<PendingRequest>();
+  request->input_names = &input_names;
+  request->input_values = &input_values;
+  request->request_id = request_id;
+  request->outputs = &outputs;
+  request->enqueue_time = std::chrono::steady_clock::now();
+
+  std::string key;
+  bool batchable = false;
+  try {
+    batchable = env_->ModelSupportsBatching(model_name, model_version) &&
+                GetBatchKey(model_name, model_version, input_names, input_values, output_names, key,
+                            request->batch_size) &&
+                static_cast<size_t>(request->batch_size) < max_batch_size_;
+  } catch (const Ort::Exception& e) {
+    return GenerateProtobufStatus(e.GetOrtErrorCode(), e.what());
+  }
+
+  const auto run_directly = [&]() {
+    BatchQueue direct;
+    direct.model_name = model_name;
+    direct.model_version = model_version;
+    direct.output_names = output_names;
+    ExecuteSingle(direct, *request);
+    return request->status;
+  };
+
+  if (!batchable) {
+    return run_directly();
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (unsplittable_keys_.count(key) != 0) {
+    lock.unlock();
+    return run_directly();
+  }
+
+  auto& queue_slot = queues_[key];
+  if (queue_slot == nullptr) {
+    queue_slot = std::make_shared<BatchQueue>();
+    queue_slot->model_name = model_name;
+    queue_slot->model_version = model_version;
+    queue_slot->output_names = output_names;
+  }
+
+  // Hold a reference so the queue outlives its removal from queues_ while we are waiting on it.
+  std::shared_ptr<BatchQueue> queue = queue_slot;
+  queue->pending.push_back(request);
+  queue->pending_rows += request->batch_size;
+  queue->cv.notify_all();
+
+  while (!request->done) {
+    if (queue->has_leader || request->in_batch) {
+      queue->cv.wait(lock);
+      continue;
+    }
+
+    // Lead the next batch: wait for it to fill up or for the oldest request to time out.
+    queue->has_leader = true;
+    auto deadline = queue->pending.front()->enqueue_time + batch_timeout_;
+    queue->cv.wait_until(lock, deadline, [this, &queue]() {
+      return static_cast<size_t>(queue->pending_rows) >= max_batch_size_;
+    });
+
+    auto batch = TakeBatch(*queue);
+    for (auto& batched_request : batch) {
+      batched_request->in_batch = true;
+    }
+    bool split_outputs = unsplittable_keys_.count(key) == 0;
+
+    // Let the next batch form and run while this one executes.
+    queue->has_leader = false;
+    queue->cv.notify_all();
+    lock.unlock();
+
+    if (split_outputs) {
+      split_outputs = ExecuteBatch(*queue, batch);
+    } else {
+      for (auto& batched_request : batch) {
+        ExecuteSingle(*queue, *batched_request);
+      }
+    }
+
+    lock.lock();
+    if (!split_outputs) {
+      unsplittable_keys_.insert(key);
+    }
+    for (auto& batched_request : batch) {
+      batched_request->done = true;
+    }
+    queue->cv.notify_all();
+
+    if (queue->pending.empty() && !queue->has_leader) {
+      auto it = queues_.find(key);
+      if (it != queues_.end() && it->second == queue) {
+        queues_.erase(it);
+      }
+    }
+  }
+
+  return request->status;
+}
+
+std::vector<std::shared_ptr<BatchScheduler::PendingRequest>> BatchScheduler::TakeBatch(BatchQueue& queue) {
+  std::vector<std::shared_ptr<PendingRequest>> batch;
+  int64_t rows = 0;
+  size_t count = 0;
+  for (const auto& request : queue.pending) {
+    if (count > 0 && static_cast<size_t>(rows + request->batch_size) > max_batch_size_) {
+      break;
+    }
+    rows += request->batch_size;
+    ++count;
+  }
+
+  batch.assign(queue.pending.begin(), queue.pending.begin() + count);
+  queue.pending.erase(queue.pending.begin(), queue.pending.begin() + count);
+  queue.pending_rows -= rows;
+  return batch;
+}
+
+void BatchScheduler::ExecuteSingle(const BatchQueue& queue, PendingRequest& request) {
+  Ort::RunOptions run_options{};
+  run_options.SetRunLogVerbosityLevel(static_cast<int>(env_->GetLogSeverity()));
+  run_options.SetRunTag(request.request_id.c_str());
+
+  try {
+    *request.outputs = Run(env_->GetSession(queue.model_name, queue.model_version), run_options,
+                           *request.input_names, *request.input_values, queue.output_names);
+    request.status = protobufutil::Status::OK;
+  } catch (const Ort::Exception& e) {
+    request.status = GenerateProtobufStatus(e.GetOrtErrorCode(), e.what());
+  }
+}
+
+bool BatchScheduler::ExecuteBatch(const BatchQueue& queue, std::vector<std::shared_ptr<PendingRequest>>& batch) {
+  if (batch.size() == 1) {
+    ExecuteSingle(queue, *batch.front());
+    return true;
+  }
+
+  const auto& leader = *batch.front();
+  auto logger = env_->GetLogger(leader.request_id);
+
+  int64_t total_rows = 0;
+  for (const auto& request : batch) {
+    total_rows += request->batch_size;
+  }
+
+  std::vector<std::vector<Ort::Value>> split_outputs(batch.size());
+  bool splittable = true;
+  try {
+    Ort::AllocatorWithDefaultOptions allocator;
+
+    // Concatenate every input along the batch dimension, using the leader's input order.
+    const auto& input_names = *leader.input_names;
+    std::vector<Ort::Value> batched_inputs;
+    batched_inputs.reserve(input_names.size());
+    for (size_t i = 0; i < input_names.size(); ++i) {
+      auto type_and_shape = (*leader.input_values)[i].GetTensorTypeAndShapeInfo();
+      auto type = type_and_shape.GetElementType();
+      auto shape = type_and_shape.GetShape();
+      shape[0] = total_rows;
+
+      auto batched = Ort::Value::CreateTensor(allocator, shape.data(), shape.size(), type);
+      auto* dst = batched.GetTensorMutableData<uint8_t>();
+      for (const auto& request : batch) {
+        auto& src = (*request->input_values)[FindInput(*request->input_names, input_names[i])];
+        size_t bytes = src.GetTensorTypeAndShapeInfo().GetElementCount() * GetElementSize(type);
+        memcpy(dst, src.GetTensorMutableData<uint8_t>(), bytes);
+        dst += bytes;
+      }
+      batched_inputs.push_back(std::move(batched));
+    }
+
+    Ort::RunOptions run_options{};
+    run_options.SetRunLogVerbosityLevel(static_cast<int>(env_->GetLogSeverity()));
+    run_options.SetRunTag(leader.request_id.c_str());
+
+    auto outputs = Run(env_->GetSession(queue.model_name, queue.model_version), run_options,
+                       input_names, batched_inputs, queue.output_names);
+
+    // Scatter each output back to the requests in the order they were concatenated.
+    for (size_t o = 0; o < outputs.size(); ++o) {
+      auto& output = outputs[o];
+      if (!output.IsTensor()) {
+        splittable = false;
+        throw Ort::Exception("Output " + queue.output_names[o] + " is not a tensor", ORT_NOT_IMPLEMENTED);
+      }
+
+      auto type_and_shape = output.GetTensorTypeAndShapeInfo();
+      auto type = type_and_shape.GetElementType();
+      auto shape = type_and_shape.GetShape();
+      size_t element_size = GetElementSize(type);
+      if (element_size == 0 || shape.empty() || shape[0] != total_rows) {
+        splittable = false;
+        throw Ort::Exception("Output " + queue.output_names[o] + " cannot be split along the batch dimension",
+                             ORT_NOT_IMPLEMENTED);
+      }
+
+      size_t row_bytes = type_and_shape.GetElementCount() / static_cast<size_t>(total_rows) * element_size;
+      const auto* src = output.GetTensorMutableData<uint8_t>();
+      for (size_t r = 0; r < batch.size(); ++r) {
+        shape[0] = batch[r]->batch_size;
+        auto slice = Ort::Value::CreateTensor(allocator, shape.data(), shape.size(), type);
+        size_t bytes = row_bytes * static_cast<size_t>(batch[r]->batch_size);
+        memcpy(slice.GetTensorMutableData<uint8_t>(), src, bytes);
+        src += bytes;
+        split_outputs[r].push_back(std::move(slice));
+      }
+    }
+  } catch (const Ort::Exception& e) {
+    // Don't let one bad request fail its neighbours: run each request on its own instead.
+    logger->warn("Batched run of {} requests failed, running them individually. Error Message: {}", batch.size(),
+                 e.what());
+    if (!splittable) {
+      logger->warn("Outputs of model {} version {} can't be split, its later requests won't be batched",
+                   queue.model_name, queue.model_version);
+    }
+    for (auto& request : batch) {
+      ExecuteSingle(queue, *request);
+    }
+    return splittable;
+  }
+
+  for (size_t r = 0; r < batch.size(); ++r) {
+    *batch[r]->outputs = std::move(split_outputs[r]);
+    batch[r]->status = protobufutil::Status::OK;
+  }
+  return true;
+}
+
+}  // namespace server
+}  // namespace onnxruntime
@@ -0,0 +1,108 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <google/protobuf/stubs/status.h>
+
+#include "onnxruntime_cxx_api.h"
+
+namespace onnxruntime {
+namespace server {
+
+class ServerEnvironment;
+
+// Dynamic batching stage in front of Session::Run.
+//
+// Requests for the same model, version, output filter and input signature (input names, element types
+// and every dimension except the first) are queued together. The first request of a queue becomes the
+// leader: it waits until either max_batch_size rows are pending or the oldest pending request has waited
+// for batch_timeout, concatenates the inputs along dimension 0, runs the session once and splits each
+// output back into per-request tensors. Followers block until the leader has filled in their outputs.
+// A new leader can form the next batch of the queue while the previous one is still running.
+//
+// Requests that cannot be batched (string or scalar inputs, inputs whose first dimensions disagree, or
+// models whose inputs/outputs do not have a symbolic batch dimension) are run directly, as are the later
+// requests of a queue whose batched outputs turned out not to be splittable along dimension 0.
+class BatchScheduler {
+ public:
+  BatchScheduler(ServerEnvironment* server_env, size_t max_batch_size, std::chrono::microseconds batch_timeout);
+  ~BatchScheduler() = default;
+  BatchScheduler(const BatchScheduler&) = delete;
+  BatchScheduler& operator=(const BatchScheduler&) = delete;
+
+  // Runs the request, possibly as part of a larger batch. Blocks until the outputs are available.
+  google::protobuf::util::Status Schedule(const std::string& model_name,
+                                          const std::string& model_version,
+                                          const std::string& request_id,
+                                          const std::vector<std::string>& input_names,
+                                          std::vector<Ort::Value>& input_values,
+                                          const std::vector<std::string>& output_names,
+                                          /* out */ std::vector<Ort::Value>& outputs);
+
+  size_t MaxBatchSize() const { return max_batch_size_; }
+
+ private:
+  struct PendingRequest {
+    const std::vector<std::string>* input_names;
+    std::vector<Ort::Value>* input_values;
+    std::string request_id;
+    int64_t batch_size = 0;
+    std::chrono::steady_clock::time_point enqueue_time;
+
+    // Set once a leader has taken the request into a batch, and once the batch has run.
+    bool in_batch = false;
+    bool done = false;
+    google::protobuf::util::Status status;
+    std::vector<Ort::Value>* outputs;
+  };
+
+  struct BatchQueue {
+    std::string model_name;
+    std::string model_version;
+    std::vector<std::string> output_names;
+
+    std::vector<std::shared_ptr<PendingRequest>> pending;
+    int64_t pending_rows = 0;
+    bool has_leader = false;
+    std::condition_variable cv;
+  };
+
+  // Builds the queue key, or returns false when the request cannot be merged with others.
+  static bool GetBatchKey(const std::string& model_name,
+                          const std::string& model_version,
+                          const std::vector<std::string>& input_names,
+                          std::vector<Ort::Value>& input_values,
+                          const std::vector<std::string>& output_names,
+                          /* out */ std::string& key,
+                          /* out */ int64_t& batch_size);
+
+  // Removes the oldest requests from the queue, up to max_batch_size_ rows (at least one request).
+  std::vector<std::shared_ptr<PendingRequest>> TakeBatch(BatchQueue& queue);
+
+  // Runs a batch and fills in the status and outputs of every request in it. Returns false when the outputs
+  // can't be split along the batch dimension, in which case the requests were run one at a time.
+  bool ExecuteBatch(const BatchQueue& queue, std::vector<std::shared_ptr<PendingRequest>>& batch);
+  void ExecuteSingle(const BatchQueue& queue, PendingRequest& request);
+
+  ServerEnvironment* env_;
+  const size_t max_batch_size_;
+  const std::chrono::microseconds batch_timeout_;
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::shared_ptr<BatchQueue>> queues_;
+  // Keys of the queues whose batched outputs couldn't be split. Their requests are always run directly.
+  std::unordered_set<std::string> unsplittable_keys_;
+};
+
+}  // namespace server
+}  // namespace onnxruntime
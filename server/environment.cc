@@ -49,6 +49,16 @@ static spdlog::level::level_enum Convert(OrtLoggingLevel in) {
   }
 }
 
+static bool HasSymbolicBatchDimension(const Ort::TypeInfo& type_info) {
+  if (type_info.GetONNXType() != ONNX_TYPE_TENSOR) {
+    return false;
+  }
+
+  // Symbolic and unknown dimensions are reported as -1.
+  auto shape = type_info.GetTensorTypeAndShapeInfo().GetShape();
+  return !shape.empty() && shape[0] < 0;
+}
+
 void ORT_API_CALL Log(void* param, OrtLoggingLevel severity, const char* category, const char* logid, const char* code_location,
                       const char* message) {
   spdlog::logger* logger = static_cast<spdlog::logger*>(param);
@@ -103,6 +113,34 @@ void ServerEnvironment::InitializeModel(const std::string& model_path, const std
     (iterator->second).output_names.push_back(name);
     allocator.Free(name);
   }
+
+  bool supports_batching = true;
+  auto input_count = (iterator->second).session.GetInputCount();
+  for (size_t i = 0; i < input_count && supports_batching; i++) {
+    supports_batching = HasSymbolicBatchDimension((iterator->second).session.GetInputTypeInfo(i));
+  }
+  for (size_t i = 0; i < output_count && supports_batching; i++) {
+    supports_batching = HasSymbolicBatchDimension((iterator->second).session.GetOutputTypeInfo(i));
+  }
+  (iterator->second).supports_batching = supports_batching;
+}
+
+bool ServerEnvironment::ModelSupportsBatching(const std::string& model_name, const std::string& model_version) const {
+  auto identifier = std::make_pair(model_name, model_version);
+  auto it = sessions_.find(identifier);
+  return it != sessions_.end() && it->second.supports_batching;
+}
+
+void ServerEnvironment::EnableBatching(size_t max_batch_size, std::chrono::microseconds batch_timeout) {
+  if (max_batch_size > 1) {
+    batch_scheduler_ = std::make_unique<BatchScheduler>(this, max_batch_size, batch_timeout);
+  } else {
+    batch_scheduler_ = nullptr;
+  }
+}
+
+BatchScheduler* ServerEnvironment::GetBatchScheduler() const {
+  return batch_scheduler_.get();
 }
 
 const std::vector<std::string>& ServerEnvironment::GetModelOutputNames(const std::string& model_name, const std::string& model_version) const {
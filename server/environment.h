@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <memory>
 #include <vector>
 
@@ -11,6 +12,8 @@
 #include <unordered_map>
 #include <boost/functional/hash.hpp>
 
+#include "batch_scheduler.h"
+
 namespace onnxruntime {
 namespace server {
 
@@ -25,11 +28,19 @@ class ServerEnvironment {
   const Ort::Session& GetSession(const std::string& model_name, const std::string& model_version) const;
   void InitializeModel(const std::string& model_path, const std::string& model_name, const std::string& model_version);
   const std::vector<std::string>& GetModelOutputNames(const std::string& model_name, const std::string& model_version) const;
+  // True if every input and output of the model has a symbolic first dimension, so requests can be concatenated.
+  bool ModelSupportsBatching(const std::string& model_name, const std::string& model_version) const;
   std::shared_ptr<spdlog::logger> GetLogger(const std::string& request_id) const;
   std::shared_ptr<spdlog::logger> GetAppLogger() const;
   void UnloadModel(const std::string& model_name, const std::string& model_version);
   void RegisterExecutionProviders();
 
+  // Queue compatible requests and run them together, up to max_batch_size rows or batch_timeout.
+  // A max_batch_size of 0 or 1 disables batching.
+  void EnableBatching(size_t max_batch_size, std::chrono::microseconds batch_timeout);
+  // Returns nullptr when batching is disabled.
+  BatchScheduler* GetBatchScheduler() const;
+
  private:
   const OrtLoggingLevel severity_;
   const std::string logger_id_;
@@ -42,6 +53,7 @@ class ServerEnvironment {
   struct SessionHolder {
     Ort::Session session;
     std::vector<std::string> output_names;
+    bool supports_batching = false;
     explicit SessionHolder(Ort::Env& env, std::string path, const Ort::SessionOptions& options) : session(nullptr) {
       session = Ort::Session(env, path.c_str(), options);
     };
@@ -52,6 +64,9 @@ class ServerEnvironment {
   };
 
   std::unordered_map<std::pair<std::string, std::string>, ServerEnvironment::SessionHolder, boost::hash<std::pair<std::string, std::string>>> sessions_;
+
+  // Declared after sessions_ so that it is destroyed first.
+  std::unique_ptr<BatchScheduler> batch_scheduler_;
 };
 
 }  // namespace server
@@ -8,6 +8,7 @@
 #include "onnx-ml.pb.h"
 #include "predict.pb.h"
 
+#include "batch_scheduler.h"
 #include "converter.h"
 #include "executor.h"
 #include "util.h"
@@ -129,10 +130,18 @@ protobufutil::Status Executor::Predict(const std::string& model_name,
   }
 
   std::vector<Ort::Value> outputs;
-  try {
-    outputs = Run(env_->GetSession(model_name, model_version), run_options, input_names, input_values, output_names);
-  } catch (const Ort::Exception& e) {
-    return GenerateProtobufStatus(e.GetOrtErrorCode(), e.what());
+  auto* batch_scheduler = env_->GetBatchScheduler();
+  if (batch_scheduler != nullptr) {
+    auto run_status = batch_scheduler->Schedule(model_name, model_version, request_id_, input_names, input_values, output_names, outputs);
+    if (run_status != protobufutil::Status::OK) {
+      return run_status;
+    }
+  } else {
+    try {
+      outputs = Run(env_->GetSession(model_name, model_version), run_options, input_names, input_values, output_names);
+    } catch (const Ort::Exception& e) {
+      return GenerateProtobufStatus(e.GetOrtErrorCode(), e.what());
+    }
   }
 
   // Build the response
@@ -13,6 +13,13 @@
 namespace onnxruntime {
 namespace server {
 
+// Runs the session on the given inputs and returns the requested outputs. Throws Ort::Exception on failure.
+std::vector<Ort::Value> Run(const Ort::Session& session,
+                            const Ort::RunOptions& options,
+                            const std::vector<std::string>& input_names,
+                            const std::vector<Ort::Value>& input_values,
+                            const std::vector<std::string>& output_names);
+
 class Executor {
  public:
   Executor(ServerEnvironment* server_env, std::string request_id) : env_(server_env),
@@ -67,6 +67,10 @@ int main(int argc, char* argv[]) {
   try {
     env->InitializeModel(config.model_path, config.model_name, config.model_version);
     logger->debug("Initialize Model Successfully!");
+    if (config.max_batch_size > 1) {
+      env->EnableBatching(config.max_batch_size, std::chrono::microseconds(config.batch_timeout_micros));
+      logger->info("Request batching enabled. Max batch size: {}, batch timeout: {}us", config.max_batch_size, config.batch_timeout_micros);
+    }
   } catch (const Ort::Exception& ex) {
     logger->critical("Initialize Model Failed: {} ---- Error: [{}]", ex.GetOrtErrorCode(), ex.what());
     exit(EXIT_FAILURE);
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include <iostream>
+#include <thread>
 
 #include "gtest/gtest.h"
 
@@ -52,6 +53,85 @@ TEST_F(ExecutorTest, TestMul_1) {
   EXPECT_EQ(expected, body);
 }
 
+TEST_F(ExecutorTest, TestMul_1_BatchingUnsupportedModel) {
+  // mul_1.onnx has a fixed batch dimension so the request is run directly.
+  const static auto input_json = R"({"inputs":{"X":{"dims":[3,2],"dataType":1,"floatData":[1,2,3,4,5,6]}},"outputFilter":["Y"]})";
+  const static auto expected = R"({"outputs":{"Y":{"dims":["3","2"],"dataType":1,"floatData":[1,4,9,16,25,36]}}})";
+
+  onnxruntime::server::ServerEnvironment* env = ServerEnv();
+  EXPECT_FALSE(env->ModelSupportsBatching("Name", "version"));
+  env->EnableBatching(8, std::chrono::microseconds(1000));
+
+  onnxruntime::server::Executor executor(env, "RequestId");
+  onnxruntime::server::PredictRequest request{};
+  onnxruntime::server::PredictResponse response{};
+
+  auto protostatus = onnxruntime::server::GetRequestFromJson(input_json, request);
+  EXPECT_TRUE(protostatus.ok());
+
+  auto prediction_res = executor.Predict("Name", "version", request, response);
+  env->EnableBatching(0, std::chrono::microseconds(0));
+  EXPECT_TRUE(prediction_res.ok());
+
+  std::string body;
+  protostatus = GenerateResponseInJson(response, body);
+  EXPECT_EQ(expected, body);
+}
+
+TEST(ExecutorBatchingTest, ConcurrentRequestsAreBatched) {
+  // square_batch.onnx computes Y = X * X with X and Y of shape [batch, 2].
+  onnxruntime::server::ServerEnvironment* env = ServerEnv();
+  env->InitializeModel("testdata/square_batch.onnx", "Square", "1");
+  EXPECT_TRUE(env->ModelSupportsBatching("Square", "1"));
+
+  // The requests below send 1 + 2 + 3 + 1 rows. A long timeout makes the leader wait until they have all been queued.
+  constexpr int num_requests = 4;
+  env->EnableBatching(7, std::chrono::microseconds(200000));
+
+  std::vector<onnxruntime::server::PredictResponse> responses(num_requests);
+  std::vector<bool> succeeded(num_requests, false);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_requests; ++i) {
+    threads.emplace_back([env, i, &responses, &succeeded]() {
+      // Request i sends i + 1 rows, except for the last one which sends a single row.
+      int rows = i + 1 < num_requests ? i + 1 : 1;
+      onnxruntime::server::PredictRequest request{};
+      onnx::TensorProto tensor{};
+      tensor.set_data_type(onnx::TensorProto_DataType_FLOAT);
+      tensor.add_dims(rows);
+      tensor.add_dims(2);
+      for (int j = 0; j < rows * 2; ++j) {
+        tensor.add_float_data(static_cast<float>(i * 10 + j));
+      }
+      (*request.mutable_inputs())["X"] = tensor;
+
+      onnxruntime::server::Executor executor(env, "RequestId" + std::to_string(i));
+      succeeded[i] = executor.Predict("Square", "1", request, responses[i]).ok();
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  env->EnableBatching(0, std::chrono::microseconds(0));
+  env->UnloadModel("Square", "1");
+
+  for (int i = 0; i < num_requests; ++i) {
+    ASSERT_TRUE(succeeded[i]);
+    int rows = i + 1 < num_requests ? i + 1 : 1;
+    const auto& output = responses[i].outputs().at("Y");
+    ASSERT_EQ(output.dims_size(), 2);
+    EXPECT_EQ(output.dims(0), rows);
+    EXPECT_EQ(output.dims(1), 2);
+
+    ASSERT_EQ(output.float_data_size(), rows * 2);
+    for (int j = 0; j < rows * 2; ++j) {
+      float x = static_cast<float>(i * 10 + j);
+      EXPECT_EQ(output.float_data(j), x * x);
+    }
+  }
+}
+
 }  // namespace test
 }  // namespace server
 }  // namespace onnxruntime